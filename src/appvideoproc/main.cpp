@@ -3,14 +3,19 @@
 
 #include <sys/ioctl.h>
 
+#include <algorithm>
 #include <any>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <memory>
 #include <regex>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #ifdef USE_TCMALLOC
 #include <gperftools/malloc_extension.h>
@@ -27,10 +32,19 @@
 #include <libcvpg/imageproc/scripting/image_processor.hpp>
 #include <libcvpg/imageproc/scripting/diagnostics/markdown_formatter.hpp>
 #include <libcvpg/imageproc/scripting/diagnostics/typedefs.hpp>
-#include <libcvpg/videoproc/any_stage.hpp>
-#include <libcvpg/videoproc/pipelines/any_pipeline.hpp>
-#include <libcvpg/videoproc/pipelines/file_to_file.hpp>
-#include <libcvpg/videoproc/pipelines/rtsp_to_file.hpp>
+#include <libcvpg/videoproc/latency_statistics.hpp>
+#include <libcvpg/videoproc/memory_budget.hpp>
+#include <libcvpg/videoproc/pipelines/host.hpp>
+#include <libcvpg/videoproc/pipelines/host_parameters.hpp>
+#include <libcvpg/videoproc/processors/background_parameters.hpp>
+#include <libcvpg/videoproc/processors/gating_parameters.hpp>
+#include <libcvpg/videoproc/sinks/encoder_parameters.hpp>
+#include <libcvpg/videoproc/sinks/file.hpp>
+#include <libcvpg/videoproc/sources/decoder_parameters.hpp>
+#include <libcvpg/videoproc/sources/file.hpp>
+#include <libcvpg/videoproc/sources/live_parameters.hpp>
+#include <libcvpg/videoproc/sources/rtsp_parameters.hpp>
+#include <libcvpg/videoproc/sources/synthetic_parameters.hpp>
 
 #ifdef USE_TENSORFLOW_CC
 #include <libcvpg/imageproc/algorithms/tfpredict.hpp>
@@ -56,18 +70,67 @@ int main(int argc, char * argv[])
     namespace po = boost::program_options;
 
     // general options
-    std::string input_uri;
-    std::string output_filename;
+    std::vector<std::string> input_uris;
+    std::vector<std::string> output_filenames;
+    std::string record_filename;
     std::string diagnostics_filename;
+    std::string sink = "file";
+    std::string raw_format = "y4m";
+    std::string frame_format = "rgb";
     std::uint32_t timeout = 60;
     bool quiet = false;
 
     // video processing options
     std::string frame_script_filename;
     std::string interframe_script_filename;
+    std::size_t interframe_window = 2;
+    std::string background_method = "none";
+    std::string background_output = "mask";
+    float background_rate = 0.01f;
+    float background_threshold = 25.0f;
+    std::string gating_mode = "off";
+    float gating_static_threshold = 2.0f;
+    float gating_motion_threshold = 4.0f;
+    std::size_t gating_max_skipped = 25;
     std::size_t buffered_input_frames = 20;
     std::size_t buffered_processing_frames = 50;
     std::size_t buffered_output_frames = 20;
+    std::uint32_t live_latency = 500;
+    std::string live_drop = "frames";
+    std::string analytics_policy = "block";
+    std::string sampling = "all";
+    std::size_t sampling_nth = 1;
+    double sampling_fps = 1.0;
+    double range_start = 0.0;
+    double range_end = -1.0;
+    std::string range_unit = "seconds";
+
+    // stream options
+    std::string rtsp_transport = "tcp";
+    std::size_t rtsp_buffer_size = 0;
+    int rtsp_reorder_queue = -1;
+    std::uint32_t rtsp_timeout = 5000;
+    std::size_t rtsp_packet_queue = 256;
+    std::size_t rtsp_reconnects = 0;
+    std::uint32_t rtsp_reconnect_delay = 1000;
+
+    // synthetic input options
+    std::string synthetic_size = "1920x1080";
+    double synthetic_fps = 25.0;
+    std::int64_t synthetic_frames = 250;
+    std::uint32_t synthetic_seed = 0;
+
+    // video encoding options
+    std::string encoder_codec;
+    std::string encoder_preset;
+    std::string encoder_tune;
+    int encoder_crf = -1;
+    std::int64_t encoder_bitrate = 0;
+    int encoder_gop = -1;
+    std::uint32_t encoder_threads = 0;
+    std::string encoder_thread_type = "both";
+    std::uint32_t encoder_segments = 0;
+    std::uint32_t encoder_segment_frames = 250;
 
 #ifdef USE_TENSORFLOW_CC
     // TensorFlow inferencing options
@@ -83,6 +146,14 @@ int main(int argc, char * argv[])
     std::uint32_t xcutoff = 512;
     std::uint32_t ycutoff = 512;
     std::uint32_t threads = 0;
+    std::uint32_t decoder_threads = 0;
+    std::string decoder_thread_type = "both";
+    std::uint32_t decoder_segments = 0;
+    std::size_t memory_budget_mb = 0;
+    std::string stream_weights;
+    std::size_t stream_groups = 1;
+    std::size_t fair_queue_depth = 0;
+    std::size_t chunks = 1;
 
     // determine width of console
     struct winsize window;
@@ -91,8 +162,11 @@ int main(int argc, char * argv[])
     po::options_description general_options("general options", window.ws_col, window.ws_col / 2);
     general_options.add_options()
         ("help,h", "show this help text")
-        ("input,i", po::value<std::string>(&input_uri), "filename of input video (MP4 format supported only) or URI of RTSP stream")
-        ("output,o", po::value<std::string>(&output_filename)->default_value("output.mp4"), "filename of output video")
+        ("input,i", po::value<std::vector<std::string> >(&input_uris)->composing(), "filename of input video (MP4 format supported only), URI of RTSP stream or 'synthetic://<pattern>' with pattern 'bars', 'gradient', 'moving-shapes' or 'noise' ; repeat to process multiple streams at once")
+        ("output,o", po::value<std::vector<std::string> >(&output_filenames)->composing(), "filename of output video (default 'output.mp4') ; the container is chosen by the extension, '.h264' writes an elementary stream ; repeat for each input or set once to number the outputs of multiple streams")
+        ("sink", po::value<std::string>(&sink)->default_value("file"), "output of the processed frames ('file' to encode them, 'raw' to write uncompressed frames or 'null' to count them only)")
+        ("raw-format", po::value<std::string>(&raw_format)->default_value("y4m"), "format of sink 'raw' ('y4m' or 'planes' without any header)")
+        ("frame-format", po::value<std::string>(&frame_format)->default_value("rgb"), "format of the frames passed through the pipeline ('rgb', 'yuv420' to keep the planes of the decoder or 'gray' to keep its luma plane only) ; scripts starting with 'input(\"rgb\", 8)' convert 'yuv420' frames at each evaluation and convert the result back with half of the chroma resolution")
         ("diagnostics", po::value<std::string>(&diagnostics_filename), "filename where programm diagnostics (in 'Markdown' format) will be generated")
         ("timeout", po::value<std::uint32_t>(&timeout)->default_value(10), "timeout in seconds the processing will be aborted")
         ("quiet", "suppress all normal (non-error) outputs at console")
@@ -101,10 +175,67 @@ int main(int argc, char * argv[])
     po::options_description video_processing_options("video processing options", window.ws_col, window.ws_col / 2);
     video_processing_options.add_options()
         ("frame-script", po::value<std::string>(&frame_script_filename), "name of script file that should be processed for each frame")
-        ("interframe-script", po::value<std::string>(&interframe_script_filename), "name of script file that should be processed for each pair of input images")
+        ("interframe-script", po::value<std::string>(&interframe_script_filename), "name of script file that should be processed for each window of input images")
+        ("interframe-window", po::value<std::size_t>(&interframe_window)->default_value(2), "amount of the last frames the inter-frame script gets by 'input(k)' (k = 0 is the newest frame)")
+        ("background", po::value<std::string>(&background_method)->default_value("none"), "background subtraction replacing the inter-frame script ('none', 'running-average' or 'gaussian-mixture')")
+        ("background-output", po::value<std::string>(&background_output)->default_value("mask"), "output of the background subtraction ('mask' to replace the frames by the foreground masks or 'frame' to add the masks to the meta data of the frames)")
+        ("background-rate", po::value<float>(&background_rate)->default_value(0.01f), "learning rate of the background model")
+        ("background-threshold", po::value<float>(&background_threshold)->default_value(25.0f), "minimum difference of the intensity of a foreground pixel to the background (background 'running-average')")
+        ("gating", po::value<std::string>(&gating_mode)->default_value("off"), "frames without motion skip the frame script ('off', 'previous-result' to repeat the last result or 'raw-frame' to pass them unprocessed)")
+        ("gating-static-threshold", po::value<float>(&gating_static_threshold)->default_value(2.0f), "maximum mean intensity difference of the most changed block of a frame of a static scene")
+        ("gating-motion-threshold", po::value<float>(&gating_motion_threshold)->default_value(4.0f), "minimum mean intensity difference of the most changed block of a frame that starts motion in a static scene")
+        ("gating-max-skipped", po::value<std::size_t>(&gating_max_skipped)->default_value(25), "maximum amount of subsequently skipped frames")
         ("input-buffer", po::value<std::size_t>(&buffered_input_frames)->default_value(50), "amount of buffered frames when reading video frames")
         ("processing-buffer", po::value<std::size_t>(&buffered_processing_frames)->default_value(50), "amount of buffered frames at each processing stage (minimum size is size of input buffer)")
         ("output-buffer", po::value<std::size_t>(&buffered_output_frames)->default_value(50), "amount of buffered frames when writing video frames")
+        ("sampling", po::value<std::string>(&sampling)->default_value("all"), "frames read from the input ('all', 'every-nth', 'fps' or 'keyframes' to decode keyframes only)")
+        ("sampling-nth", po::value<std::size_t>(&sampling_nth)->default_value(1), "distance of read frames for sampling 'every-nth'")
+        ("sampling-fps", po::value<double>(&sampling_fps)->default_value(1.0), "frame rate of read frames for sampling 'fps'")
+        ("range-start", po::value<double>(&range_start)->default_value(0.0), "position of the first frame read from a video file")
+        ("range-end", po::value<double>(&range_end)->default_value(-1.0), "position after the last frame read from a video file (negative = until the end)")
+        ("range-unit", po::value<std::string>(&range_unit)->default_value("seconds"), "unit of the range positions ('seconds' or 'frames')")
+        ("live", "live mode for RTSP streams: read at the pace of the stream and drop frames that exceed the latency")
+        ("live-latency", po::value<std::uint32_t>(&live_latency)->default_value(500), "maximum latency in milliseconds between capturing and processing a frame in live mode")
+        ("live-drop", po::value<std::string>(&live_drop)->default_value("frames"), "frames dropped in live mode ('frames', 'non-reference' or 'keyframes' to skip until the next keyframe)")
+        ("record", po::value<std::string>(&record_filename), "filename of an additional video recorded from the decoded input frames in parallel to the processing (numbered for multiple streams)")
+        ("analytics-policy", po::value<std::string>(&analytics_policy)->default_value("block"), "behaviour of the processing if it is slower than the recording ('block' to slow down the recording or 'drop' to drop frames at the processing)")
+        ("memory-budget", po::value<std::size_t>(&memory_budget_mb)->default_value(0), "maximum amount of megabytes of buffered frames at all stages ; the buffers shrink and grow within this budget (0 = unlimited)")
+        ;
+
+    po::options_description stream_options("RTSP stream options", window.ws_col, window.ws_col / 2);
+    stream_options.add_options()
+        ("as-stream", "handle the input like a RTSP stream, e.g. to test with a local video file played in a loop by '--rtsp-reconnects'")
+        ("rtsp-transport", po::value<std::string>(&rtsp_transport)->default_value("tcp"), "lower transport protocol ('tcp', 'udp', 'udp_multicast' or 'http')")
+        ("rtsp-buffer-size", po::value<std::size_t>(&rtsp_buffer_size)->default_value(0), "size of the socket receive buffer in bytes (0 = system default)")
+        ("rtsp-reorder-queue", po::value<int>(&rtsp_reorder_queue)->default_value(-1), "amount of packets buffered to reorder received packets (-1 = default)")
+        ("rtsp-timeout", po::value<std::uint32_t>(&rtsp_timeout)->default_value(5000), "timeout in milliseconds until a connection is treated as lost (0 = no timeout)")
+        ("rtsp-low-latency", "disable buffering at the demuxer and the decoder")
+        ("rtsp-packet-queue", po::value<std::size_t>(&rtsp_packet_queue)->default_value(256), "amount of received packets waiting for the decoder")
+        ("rtsp-reconnects", po::value<std::size_t>(&rtsp_reconnects)->default_value(0), "amount of attempts to reconnect after the connection was lost or the stream ended (0 = no reconnect) ; loops local files")
+        ("rtsp-reconnect-delay", po::value<std::uint32_t>(&rtsp_reconnect_delay)->default_value(1000), "delay in milliseconds before each attempt to reconnect")
+        ;
+
+    po::options_description synthetic_options("synthetic input options", window.ws_col, window.ws_col / 2);
+    synthetic_options.add_options()
+        ("synthetic-size", po::value<std::string>(&synthetic_size)->default_value("1920x1080"), "size of the generated frames")
+        ("synthetic-fps", po::value<double>(&synthetic_fps)->default_value(25.0), "frame rate of the generated video")
+        ("synthetic-frames", po::value<std::int64_t>(&synthetic_frames)->default_value(250), "amount of generated frames (0 = endless)")
+        ("synthetic-seed", po::value<std::uint32_t>(&synthetic_seed)->default_value(0), "seed of pattern 'noise'")
+        ;
+
+    po::options_description video_encoding_options("video encoding options", window.ws_col, window.ws_col / 2);
+    video_encoding_options.add_options()
+        ("encoder", po::value<std::string>(&encoder_codec), "name of the video encoder (default is the H.264 encoder)")
+        ("encoder-preset", po::value<std::string>(&encoder_preset), "encoder preset, e.g. 'veryfast' for live outputs or 'slow' for archival outputs")
+        ("encoder-tune", po::value<std::string>(&encoder_tune), "encoder tuning, e.g. 'zerolatency' for live outputs")
+        ("encoder-crf", po::value<int>(&encoder_crf)->default_value(-1), "constant rate factor (-1 = not used)")
+        ("encoder-bitrate", po::value<std::int64_t>(&encoder_bitrate)->default_value(0), "average bit rate in bits per second if no constant rate factor is set (0 = encoder default)")
+        ("encoder-gop", po::value<int>(&encoder_gop)->default_value(-1), "maximum distance of keyframes in frames (-1 = encoder default)")
+        ("encoder-threads", po::value<std::uint32_t>(&encoder_threads)->default_value(0), "amount of threads used by the video encoder (0 = chosen by encoder)")
+        ("encoder-thread-type", po::value<std::string>(&encoder_thread_type)->default_value("both"), "threading of the video encoder ('frame', 'slice', 'both' or 'none')")
+        ("encoder-segments", po::value<std::uint32_t>(&encoder_segments)->default_value(0), "amount of segments encoded in parallel by independent encoders (0 = sequential encoding)")
+        ("encoder-segment-frames", po::value<std::uint32_t>(&encoder_segment_frames)->default_value(250), "amount of frames of a segment encoded in parallel")
+        ("encoder-passthrough", "write GOPs without modified frames with the packets of the input video instead of encoding them (requires closed GOPs)")
         ;
 
 #ifdef USE_TENSORFLOW_CC
@@ -124,11 +255,21 @@ int main(int argc, char * argv[])
         ("xcutoff", po::value<std::uint32_t>(&xcutoff)->default_value(512), "horizontal cutoff")
         ("ycutoff", po::value<std::uint32_t>(&ycutoff)->default_value(512), "vertical cutoff")
         ("threads", po::value<std::uint32_t>(&threads)->default_value(0), "amount of threads at threadpool (0 = all available)")
+        ("decoder-threads", po::value<std::uint32_t>(&decoder_threads)->default_value(0), "amount of threads used by the video decoder (0 = chosen by decoder)")
+        ("decoder-thread-type", po::value<std::string>(&decoder_thread_type)->default_value("both"), "threading of the video decoder ('frame', 'slice', 'both' or 'none')")
+        ("decoder-segments", po::value<std::uint32_t>(&decoder_segments)->default_value(0), "amount of segments of a video file (split at keyframes) that are decoded in parallel (0 = sequential decoding)")
+        ("stream-weights", po::value<std::string>(&stream_weights), "comma separated list of weights of the streams at the shared threadpool (default is an equal weight for all streams)")
+        ("stream-groups", po::value<std::size_t>(&stream_groups)->default_value(1), "amount of scheduler groups (threads for sources, processors and sinks) the streams are distributed to")
+        ("fair-queue-depth", po::value<std::size_t>(&fair_queue_depth)->default_value(0), "maximum amount of frame evaluations of all streams running at the threadpool at once (0 = twice the amount of threads)")
+        ("chunks", po::value<std::size_t>(&chunks)->default_value(1), "amount of time ranges of a single video file that are processed in parallel and concatenated to one output afterwards ; sink 'file' needs an elementary stream output (e.g. '.h264')")
         ;
 
     po::options_description cmdline_options("usage: videoproc [options]", window.ws_col, window.ws_col / 2);
     cmdline_options.add(general_options)
                    .add(video_processing_options)
+                   .add(stream_options)
+                   .add(synthetic_options)
+                   .add(video_encoding_options)
 #ifdef USE_TENSORFLOW_CC
                    .add(tf_inferencing_options)
 #endif
@@ -144,17 +285,113 @@ int main(int argc, char * argv[])
         return 1;
     }
 
-    if (variables.count("input"))
+    if (input_uris.empty())
     {
-        input_uri = variables["input"].as<std::string>();
+        std::cerr << "No input video set." << std::endl;
+        return 1;
     }
-    else
+
+    if (output_filenames.empty())
     {
-        std::cerr << "No input video set." << std::endl;
+        output_filenames.push_back("output.mp4");
+    }
+
+    // number the files of the streams, e.g. 'output_0.mp4', 'output_1.mp4', ...
+    auto numbered_filenames =
+        [count = input_uris.size()](std::string const & filename)
+        {
+            std::vector<std::string> filenames;
+
+            if (count == 1)
+            {
+                filenames.push_back(filename);
+
+                return filenames;
+            }
+
+            const std::size_t pos = filename.find_last_of('.');
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (pos == std::string::npos)
+                {
+                    filenames.push_back(filename + "_" + std::to_string(i));
+                }
+                else
+                {
+                    filenames.push_back(filename.substr(0, pos) + "_" + std::to_string(i) + filename.substr(pos));
+                }
+            }
+
+            return filenames;
+        };
+
+    if (output_filenames.size() == 1 && input_uris.size() > 1)
+    {
+        output_filenames = numbered_filenames(output_filenames.front());
+    }
+    else if (output_filenames.size() != input_uris.size())
+    {
+        std::cerr << "Amount of outputs (" << output_filenames.size() << ") doesn't match amount of inputs (" << input_uris.size() << ")." << std::endl;
         return 1;
     }
 
-    output_filename = variables["output"].as<std::string>();
+    std::vector<double> weights(input_uris.size(), 1.0);
+
+    if (!stream_weights.empty())
+    {
+        std::vector<std::string> tokens;
+        boost::split(tokens, stream_weights, [](char c){ return c == ','; });
+
+        if (tokens.size() != input_uris.size())
+        {
+            std::cerr << "Amount of stream weights (" << tokens.size() << ") doesn't match amount of inputs (" << input_uris.size() << ")." << std::endl;
+            return 1;
+        }
+
+        for (std::size_t i = 0; i < tokens.size(); ++i)
+        {
+            try
+            {
+                weights[i] = std::stod(tokens[i]);
+            }
+            catch (...)
+            {
+                weights[i] = 0.0;
+            }
+
+            if (weights[i] <= 0.0)
+            {
+                std::cerr << "Invalid stream weight '" << tokens[i] << "'." << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    std::vector<std::string> record_filenames;
+
+    if (!record_filename.empty())
+    {
+        record_filenames = numbered_filenames(record_filename);
+    }
+
+    cvpg::videoproc::pipelines::branch_policy analytics_branch_policy = cvpg::videoproc::pipelines::branch_policy::block;
+
+    if (analytics_policy == "drop")
+    {
+        analytics_branch_policy = cvpg::videoproc::pipelines::branch_policy::drop;
+    }
+    else if (analytics_policy != "block")
+    {
+        std::cerr << "Invalid analytics policy '" << analytics_policy << "'." << std::endl;
+        return 1;
+    }
+
+    if (stream_groups == 0)
+    {
+        std::cerr << "At least one stream group is needed." << std::endl;
+        return 1;
+    }
 
     if (variables.count("diagnostics"))
     {
@@ -177,12 +414,81 @@ int main(int argc, char * argv[])
     {
         interframe_script_filename = variables["interframe-script"].as<std::string>();
     }
-    else
+    else if (background_method == "none")
     {
         std::cerr << "No inter-frame script filename set." << std::endl;
         return 1;
     }
 
+    if (interframe_window == 0)
+    {
+        std::cerr << "Window of inter-frame script must contain at least one frame." << std::endl;
+        return 1;
+    }
+
+    cvpg::videoproc::processors::background_parameters background;
+    background.learning_rate = background_rate;
+    background.threshold = background_threshold;
+
+    if (background_method == "running-average")
+    {
+        background.method = cvpg::videoproc::processors::background_method::running_average;
+    }
+    else if (background_method == "gaussian-mixture")
+    {
+        background.method = cvpg::videoproc::processors::background_method::gaussian_mixture;
+    }
+    else if (background_method != "none")
+    {
+        std::cerr << "Invalid background subtraction '" << background_method << "'." << std::endl;
+        return 1;
+    }
+
+    if (background_output == "mask" || background_output == "frame")
+    {
+        background.output = background_output == "frame" ? cvpg::videoproc::processors::background_output::frame : cvpg::videoproc::processors::background_output::mask;
+    }
+    else
+    {
+        std::cerr << "Invalid background output '" << background_output << "'." << std::endl;
+        return 1;
+    }
+
+    if (background_rate <= 0.0f || background_rate > 1.0f)
+    {
+        std::cerr << "Learning rate of background model must be greater than 0 and at most 1." << std::endl;
+        return 1;
+    }
+
+    cvpg::videoproc::processors::gating_parameters gating;
+    gating.static_threshold = gating_static_threshold;
+    gating.motion_threshold = gating_motion_threshold;
+    gating.max_skipped = gating_max_skipped;
+
+    if (gating_mode == "off")
+    {
+        gating.mode = cvpg::videoproc::processors::gating_mode::off;
+    }
+    else if (gating_mode == "previous-result")
+    {
+        gating.mode = cvpg::videoproc::processors::gating_mode::previous_result;
+    }
+    else if (gating_mode == "raw-frame")
+    {
+        gating.mode = cvpg::videoproc::processors::gating_mode::raw_frame;
+    }
+    else
+    {
+        std::cerr << "Invalid gating '" << gating_mode << "'." << std::endl;
+        return 1;
+    }
+
+    if (gating_motion_threshold < gating_static_threshold)
+    {
+        std::cerr << "Motion threshold of gating must be at least the static threshold." << std::endl;
+        return 1;
+    }
+
     if (buffered_processing_frames < buffered_input_frames)
     {
         if (!quiet)
@@ -207,6 +513,164 @@ int main(int argc, char * argv[])
         threads = std::thread::hardware_concurrency();
     }
 
+    cvpg::videoproc::sources::decoder_parameters decoder;
+    decoder.threads = decoder_threads;
+    decoder.parallel_segments = decoder_segments;
+
+    if (decoder_thread_type == "none" || decoder_thread_type == "frame" || decoder_thread_type == "slice" || decoder_thread_type == "both")
+    {
+        decoder.frame_threading = decoder_thread_type == "frame" || decoder_thread_type == "both";
+        decoder.slice_threading = decoder_thread_type == "slice" || decoder_thread_type == "both";
+    }
+    else
+    {
+        std::cerr << "Invalid decoder thread type '" << decoder_thread_type << "'." << std::endl;
+        return 1;
+    }
+
+    if (sampling == "all")
+    {
+        decoder.sampling.mode = cvpg::videoproc::sources::sampling_mode::all;
+    }
+    else if (sampling == "every-nth")
+    {
+        decoder.sampling.mode = cvpg::videoproc::sources::sampling_mode::every_nth;
+    }
+    else if (sampling == "fps")
+    {
+        decoder.sampling.mode = cvpg::videoproc::sources::sampling_mode::fps;
+    }
+    else if (sampling == "keyframes")
+    {
+        decoder.sampling.mode = cvpg::videoproc::sources::sampling_mode::keyframes;
+    }
+    else
+    {
+        std::cerr << "Invalid sampling '" << sampling << "'." << std::endl;
+        return 1;
+    }
+
+    decoder.sampling.every_nth = sampling_nth;
+    decoder.sampling.fps = sampling_fps;
+
+    if (range_unit == "seconds" || range_unit == "frames")
+    {
+        decoder.range.unit = range_unit == "frames" ? cvpg::videoproc::sources::range_unit::frames : cvpg::videoproc::sources::range_unit::seconds;
+        decoder.range.start = range_start;
+        decoder.range.end = range_end;
+    }
+    else
+    {
+        std::cerr << "Invalid range unit '" << range_unit << "'." << std::endl;
+        return 1;
+    }
+
+    cvpg::videoproc::sources::rtsp_parameters stream;
+    stream.transport = rtsp_transport;
+    stream.buffer_size = rtsp_buffer_size;
+    stream.reorder_queue_size = rtsp_reorder_queue;
+    stream.timeout = std::chrono::milliseconds(rtsp_timeout);
+    stream.low_latency = variables.count("rtsp-low-latency");
+    stream.packet_queue_size = rtsp_packet_queue;
+    stream.reconnect_attempts = rtsp_reconnects;
+    stream.reconnect_delay = std::chrono::milliseconds(rtsp_reconnect_delay);
+    stream.sampling = decoder.sampling;
+
+    cvpg::videoproc::sources::live_parameters live;
+    live.enabled = variables.count("live");
+    live.max_latency = std::chrono::milliseconds(live_latency);
+
+    if (live_drop == "frames")
+    {
+        live.policy = cvpg::videoproc::sources::drop_policy::frames;
+    }
+    else if (live_drop == "non-reference")
+    {
+        live.policy = cvpg::videoproc::sources::drop_policy::non_reference;
+    }
+    else if (live_drop == "keyframes")
+    {
+        live.policy = cvpg::videoproc::sources::drop_policy::keyframes;
+    }
+    else
+    {
+        std::cerr << "Invalid drop policy '" << live_drop << "'." << std::endl;
+        return 1;
+    }
+
+    cvpg::videoproc::sources::synthetic_parameters synthetic;
+    synthetic.framerate = synthetic_fps;
+    synthetic.frames = synthetic_frames;
+    synthetic.seed = synthetic_seed;
+
+    if (std::sscanf(synthetic_size.c_str(), "%ux%u", &(synthetic.width), &(synthetic.height)) != 2 || synthetic.width == 0 || synthetic.height == 0)
+    {
+        std::cerr << "Invalid size of synthetic frames '" << synthetic_size << "'." << std::endl;
+        return 1;
+    }
+
+    if (synthetic.framerate <= 0.0 || synthetic.frames < 0)
+    {
+        std::cerr << "Invalid frame rate or amount of synthetic frames." << std::endl;
+        return 1;
+    }
+
+    if (sink != "file" && sink != "raw" && sink != "null")
+    {
+        std::cerr << "Invalid sink '" << sink << "'." << std::endl;
+        return 1;
+    }
+
+    if (raw_format != "y4m" && raw_format != "planes")
+    {
+        std::cerr << "Invalid raw format '" << raw_format << "'." << std::endl;
+        return 1;
+    }
+
+    if (frame_format != "rgb" && frame_format != "yuv420" && frame_format != "gray")
+    {
+        std::cerr << "Invalid frame format '" << frame_format << "'." << std::endl;
+        return 1;
+    }
+
+    if (sink == "raw" && raw_format == "y4m" && frame_format == "rgb")
+    {
+        std::cerr << "Raw format 'y4m' needs frame format 'yuv420' or 'gray'." << std::endl;
+        return 1;
+    }
+
+    cvpg::videoproc::sinks::encoder_parameters encoder;
+    encoder.codec = encoder_codec;
+    encoder.preset = encoder_preset;
+    encoder.tune = encoder_tune;
+    encoder.crf = encoder_crf;
+    encoder.bit_rate = encoder_bitrate;
+    encoder.gop_size = encoder_gop;
+    encoder.threads = encoder_threads;
+    encoder.parallel_segments = encoder_segments;
+    encoder.segment_frames = encoder_segment_frames;
+    encoder.passthrough = variables.count("encoder-passthrough");
+
+    if (encoder.passthrough && sink != "file")
+    {
+        std::cerr << "Passthrough of the input video requires sink 'file'." << std::endl;
+        return 1;
+    }
+
+    // the source attaches its packets to the frames, so the sink could write them again
+    decoder.forward_packets = encoder.passthrough;
+
+    if (encoder_thread_type == "none" || encoder_thread_type == "frame" || encoder_thread_type == "slice" || encoder_thread_type == "both")
+    {
+        encoder.frame_threading = encoder_thread_type == "frame" || encoder_thread_type == "both";
+        encoder.slice_threading = encoder_thread_type == "slice" || encoder_thread_type == "both";
+    }
+    else
+    {
+        std::cerr << "Invalid encoder thread type '" << encoder_thread_type << "'." << std::endl;
+        return 1;
+    }
+
 #ifdef USE_TENSORFLOW_CC
     if (variables.count("tfmodel"))
     {
@@ -366,51 +830,152 @@ int main(int argc, char * argv[])
     {
         undefined,
         video,
-        stream
+        stream,
+        synthetic
     };
 
-    input_mode_types input_mode = input_mode_types::undefined;
+    auto determine_input_mode =
+        [&variables](std::string const & input_uri)
+        {
+            input_mode_types input_mode = input_mode_types::undefined;
+
+            // check if input is a synthetic video
+            {
+                std::regex rx("synthetic:\\/\\/(bars|gradient|moving-shapes|noise)");
+
+                if (std::regex_match(input_uri, rx))
+                {
+                    return input_mode_types::synthetic;
+                }
+            }
+
+            // check if input is a video
+            {
+                std::regex rx(".*\\.mp4$");
+
+                if (std::regex_match(input_uri, rx))
+                {
+                    input_mode = input_mode_types::video;
+                }
+            }
+
+            // check if input is a RTSP stream
+            {
+                std::regex rx("(rtsp?):\\/\\/(?:([^\\s@\\/]+?)[@])?([^\\s\\/:]+)(?:[:]([0-9]+))?(?:(\\/[^\\s?#]+)([?][^\\s#]+)?)?([#]\\S*)?");
+
+                if (std::regex_match(input_uri, rx) || variables.count("as-stream"))
+                {
+                    input_mode = input_mode_types::stream;
+                }
+            }
+
+            return input_mode;
+        };
+
+    std::vector<input_mode_types> input_modes;
 
-    // check if input is a video
+    for (auto const & input_uri : input_uris)
     {
-        std::regex rx(".*\\.mp4$");
+        input_modes.push_back(determine_input_mode(input_uri));
 
-        if (std::regex_match(input_uri, rx))
+        if (!quiet)
         {
-            input_mode = input_mode_types::video;
+            std::cout << "Start processing ";
+
+            switch (input_modes.back())
+            {
+                case input_mode_types::undefined:
+                    std::cout << "undefined input";
+                    break;
+
+                case input_mode_types::video:
+                    std::cout << "video file";
+                    break;
+
+                case input_mode_types::stream:
+                    std::cout << "RTSP stream";
+                    break;
+
+                case input_mode_types::synthetic:
+                    std::cout << "synthetic video";
+                    break;
+            }
+
+            std::cout << " from '" << input_uri << "'" << std::endl;
+        }
+
+        if (input_modes.back() == input_mode_types::undefined)
+        {
+            std::cerr << "Unsupported input '" << input_uri << "'." << std::endl;
+            return 1;
         }
     }
 
-    // check if input is a RTSP stream
+    // a single video file could be split into time ranges (chunks) that are processed like separate streams
+    std::vector<cvpg::videoproc::sources::range_parameters> chunk_ranges;
+    std::vector<std::string> chunk_filenames;
+
+    if (chunks > 1)
     {
-        std::regex rx("(rtsp?):\\/\\/(?:([^\\s@\\/]+?)[@])?([^\\s\\/:]+)(?:[:]([0-9]+))?(?:(\\/[^\\s?#]+)([?][^\\s#]+)?)?([#]\\S*)?");
+        if (input_uris.size() != 1 || input_modes.front() != input_mode_types::video)
+        {
+            std::cerr << "Chunks are only supported for a single video file." << std::endl;
+            return 1;
+        }
 
-        if (std::regex_match(input_uri, rx))
+        if (decoder.range.enabled() || !record_filenames.empty())
         {
-            input_mode = input_mode_types::stream;
+            std::cerr << "Chunks could not be combined with a range or a recording." << std::endl;
+            return 1;
         }
-    }
 
-    if (!quiet)
-    {
-        std::cout << "Start processing ";
+        // Y4M outputs have a header, so only outputs without a header could be concatenated
+        if (sink == "null" || (sink == "raw" && raw_format == "y4m"))
+        {
+            std::cerr << "Chunks need sink 'file' or sink 'raw' with format 'planes'." << std::endl;
+            return 1;
+        }
 
-        switch (input_mode)
+        // containers have a header too, so the chunks are written as elementary streams
+        if (sink == "file" && cvpg::videoproc::sinks::writes_container(output_filenames.front()))
         {
-            case input_mode_types::undefined:
-                std::cout << "undefined input";
-                break;
+            std::cerr << "Chunks of sink 'file' need an elementary stream output (e.g. '.h264')." << std::endl;
+            return 1;
+        }
 
-            case input_mode_types::video:
-                std::cout << "video file";
-                break;
+        try
+        {
+            chunk_ranges = cvpg::videoproc::sources::split_into_ranges(input_uris.front(), chunks);
+        }
+        catch (std::exception const & e)
+        {
+            std::cerr << "Failed to split input into chunks. Error: '" << e.what() << "'" << std::endl;
+            return 1;
+        }
 
-            case input_mode_types::stream:
-                std::cout << "RTSP stream";
-                break;
+        // each chunk is written to an own file, the files are concatenated to the output afterwards
+        for (std::size_t i = 0; i < chunks; ++i)
+        {
+            chunk_filenames.push_back(output_filenames.front() + ".chunk" + std::to_string(i));
         }
 
-        std::cout << " from '" << input_uri << "'" << std::endl;
+        input_uris.assign(chunks, input_uris.front());
+        input_modes.assign(chunks, input_mode_types::video);
+        weights.assign(chunks, 1.0);
+
+        // each chunk is decoded at an own thread if not set otherwise
+        if (variables["stream-groups"].defaulted())
+        {
+            stream_groups = chunks;
+        }
+    }
+
+    // names of the streams used at messages
+    std::vector<std::string> stream_names = input_uris;
+
+    for (std::size_t i = 0; i < chunk_filenames.size(); ++i)
+    {
+        stream_names[i].append(" (chunk ").append(std::to_string(i)).append(")");
     }
 
     // read frame script file
@@ -429,29 +994,47 @@ int main(int argc, char * argv[])
         std::cout << "Loaded frame script '" << frame_script_filename << "'" << std::endl;
     }
 
+    // the background subtraction replaces the inter-frame script
+    const bool subtract_background = background_method != "none";
+
     // read inter-frame script file
-    std::ifstream interframe_script_file(interframe_script_filename);
-    std::string interframe_script { std::istreambuf_iterator<char>(interframe_script_file), std::istreambuf_iterator<char>() };
-    interframe_script_file.close();
+    std::string interframe_script;
 
-    if (!interframe_script_file.good())
+    if (!subtract_background)
     {
-        std::cerr << "Error while loading inter-frame script '" << interframe_script_filename << "'." << std::endl;
-        return 1;
-    }
+        std::ifstream interframe_script_file(interframe_script_filename);
+        interframe_script.assign(std::istreambuf_iterator<char>(interframe_script_file), std::istreambuf_iterator<char>());
+        interframe_script_file.close();
 
-    if (!quiet)
-    {
-        std::cout << "Loaded inter-frame script '" << interframe_script_filename << "'" << std::endl;
+        if (!interframe_script_file.good())
+        {
+            std::cerr << "Error while loading inter-frame script '" << interframe_script_filename << "'." << std::endl;
+            return 1;
+        }
+
+        if (!quiet)
+        {
+            std::cout << "Loaded inter-frame script '" << interframe_script_filename << "'" << std::endl;
+        }
     }
 
     // use own logging callback
     av_log_set_callback(avlog_cb);
 
-    // create a thread pool
-    auto thread_pool = boost::asynchronous::make_shared_scheduler_proxy<
-                           boost::asynchronous::multiqueue_threadpool_scheduler<
-                               boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(threads, std::string("threadpool"));
+    // create the host of the streams ; all streams share its threadpool, memory budget and fair queue
+    cvpg::videoproc::pipelines::host_parameters host_parameters;
+    host_parameters.threads = threads;
+    host_parameters.stream_groups = stream_groups;
+    host_parameters.fair_sharing = input_uris.size() > 1;
+    host_parameters.fair_queue_depth = fair_queue_depth;
+    host_parameters.memory_budget = memory_budget_mb * 1024 * 1024;
+    host_parameters.buffered_input_frames = buffered_input_frames;
+    host_parameters.buffered_processing_frames = buffered_processing_frames;
+    host_parameters.buffered_output_frames = buffered_output_frames;
+
+    cvpg::videoproc::pipelines::host host(host_parameters);
+
+    auto thread_pool = host.thread_pool();
 
     if (!quiet)
     {
@@ -539,6 +1122,7 @@ int main(int argc, char * argv[])
     }
 
     // compiling inter-frame script
+    if (!subtract_background)
     {
         auto promise_compile = std::make_shared<std::promise<compile_result> >();
         auto future_compile = promise_compile->get_future();
@@ -583,123 +1167,258 @@ int main(int argc, char * argv[])
         }
     }
 
-    // create a scheduler for the source stage
-    auto source_stage_scheduler = boost::asynchronous::make_shared_scheduler_proxy<
-                                      boost::asynchronous::single_thread_scheduler<
-                                          boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >();
-
-    // create a frame and interframe processor
-    auto processors_scheduler = boost::asynchronous::make_shared_scheduler_proxy<
-                                    boost::asynchronous::single_thread_scheduler<
-                                        boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(std::string("processors"));
+    const auto pipeline_frame_format = frame_format == "yuv420" ? cvpg::videoproc::pipelines::frame_format::yuv420 :
+                                       frame_format == "gray" ? cvpg::videoproc::pipelines::frame_format::gray :
+                                                                cvpg::videoproc::pipelines::frame_format::rgb;
 
-    cvpg::videoproc::any_stage<cvpg::image_rgb_8bit> frame_processor = std::make_shared<cvpg::videoproc::processors::image_rgb_8bit_frame_proxy>(processors_scheduler, buffered_processing_frames, image_processor);
-    cvpg::videoproc::any_stage<cvpg::image_rgb_8bit> interframe_processor = std::make_shared<cvpg::videoproc::processors::image_rgb_8bit_interframe_proxy>(processors_scheduler, buffered_processing_frames, image_processor);
+    const auto pipeline_sink = sink == "raw" ? cvpg::videoproc::pipelines::sink_type::raw :
+                               sink == "null" ? cvpg::videoproc::pipelines::sink_type::null :
+                                                cvpg::videoproc::pipelines::sink_type::file;
 
-    // create a video file producer
-    auto file_out_scheduler = boost::asynchronous::make_shared_scheduler_proxy<
-                                  boost::asynchronous::single_thread_scheduler<
-                                      boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >();
-
-    cvpg::videoproc::any_stage<cvpg::image_rgb_8bit> file_producer = std::make_shared<cvpg::videoproc::sinks::image_rgb_8bit_file_proxy>(file_out_scheduler, buffered_output_frames);
-
-    // create a progress monitor
+    // create a progress monitor ; progress bars are only printed for a single stream
     auto progress_monitor_scheduler = boost::asynchronous::make_shared_scheduler_proxy<
                                           boost::asynchronous::single_thread_scheduler<
                                               boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >();
 
-    auto progress_monitor = std::make_shared<progress_monitor_proxy>(progress_monitor_scheduler, !quiet);
+    for (std::size_t i = 0; i < input_uris.size(); ++i)
+    {
+        cvpg::videoproc::pipelines::stream_parameters stream_parameters;
 
-    // create a pipeline for the stages
-    auto pipeline_scheduler = boost::asynchronous::make_shared_scheduler_proxy<
-                                  boost::asynchronous::single_thread_scheduler<
-                                      boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >();
+        stream_parameters.name = stream_names[i];
+        stream_parameters.weight = weights[i];
+        stream_parameters.format = pipeline_frame_format;
 
-    auto promise_pipeline = std::make_shared<std::promise<std::string> >();
+        stream_parameters.uri = input_uris[i];
+        stream_parameters.decoder = decoder;
+        stream_parameters.stream = stream;
+        stream_parameters.live = live;
+        stream_parameters.synthetic = synthetic;
 
-    cvpg::videoproc::any_stage<cvpg::image_rgb_8bit> source_stage;
+        switch (input_modes[i])
+        {
+            // undefined inputs are rejected above
+            case input_mode_types::undefined:
+            case input_mode_types::video:
+                stream_parameters.input = cvpg::videoproc::pipelines::input_type::video;
 
-    cvpg::videoproc::pipelines::any_pipeline pipeline;
+                if (!chunk_ranges.empty())
+                {
+                    stream_parameters.decoder.range = chunk_ranges[i];
+                }
+                break;
 
-    switch (input_mode)
-    {
-        case input_mode_types::undefined:
-            break;
+            case input_mode_types::stream:
+                stream_parameters.input = cvpg::videoproc::pipelines::input_type::stream;
+                break;
 
-        case input_mode_types::video:
-        {
-            source_stage = std::make_shared<cvpg::videoproc::sources::image_rgb_8bit_file_proxy>(source_stage_scheduler, buffered_input_frames);
-            pipeline = std::make_shared<cvpg::videoproc::pipelines::image_rgb_8bit_file_to_file_proxy>(pipeline_scheduler, source_stage, frame_processor, interframe_processor, file_producer);
-            break;
+            case input_mode_types::synthetic:
+            {
+                stream_parameters.input = cvpg::videoproc::pipelines::input_type::synthetic;
+
+                const std::string pattern = input_uris[i].substr(input_uris[i].find("://") + 3);
+
+                if (pattern == "gradient")
+                {
+                    stream_parameters.synthetic.pattern = cvpg::videoproc::sources::synthetic_pattern::gradient;
+                }
+                else if (pattern == "moving-shapes")
+                {
+                    stream_parameters.synthetic.pattern = cvpg::videoproc::sources::synthetic_pattern::moving_shapes;
+                }
+                else if (pattern == "noise")
+                {
+                    stream_parameters.synthetic.pattern = cvpg::videoproc::sources::synthetic_pattern::noise;
+                }
+                else
+                {
+                    stream_parameters.synthetic.pattern = cvpg::videoproc::sources::synthetic_pattern::bars;
+                }
+                break;
+            }
         }
 
-        case input_mode_types::stream:
+        stream_parameters.frame_script = frame_script;
+        stream_parameters.gating = gating;
+
+        stream_parameters.interframe_script = interframe_script;
+        stream_parameters.interframe_window = interframe_window;
+        stream_parameters.subtract_background = subtract_background;
+        stream_parameters.background = background;
+
+        stream_parameters.sink = pipeline_sink;
+        stream_parameters.raw_format = raw_format == "planes" ? cvpg::videoproc::sinks::raw_format::planes : cvpg::videoproc::sinks::raw_format::y4m;
+        stream_parameters.encoder = encoder;
+        stream_parameters.output = chunk_filenames.empty() ? output_filenames[i] : chunk_filenames[i];
+
+        // only the last chunk ends the concatenated output with a sequence end code
+        stream_parameters.encoder.end_code = chunk_filenames.empty() || i + 1 == chunk_filenames.size();
+
+        if (!record_filenames.empty())
         {
-            source_stage = std::make_shared<cvpg::videoproc::sources::image_rgb_8bit_rtsp_proxy>(source_stage_scheduler, buffered_input_frames);
-            pipeline = std::make_shared<cvpg::videoproc::pipelines::image_rgb_8bit_rtsp_to_file_proxy>(pipeline_scheduler, source_stage, frame_processor, interframe_processor, file_producer);
-            break;
+            stream_parameters.record = record_filenames[i];
+            stream_parameters.analytics_policy = analytics_branch_policy;
         }
-    }
 
-    (*pipeline).start(
-        // stage parameters
-        {
-            input_uri,              // source stage
-            frame_script,           // frame stage
-            interframe_script,      // interframe stage
-            output_filename         // sink stage
-        },
-        // callbacks
-        {
-            [promise_pipeline]()
-            {
-                promise_pipeline->set_value("");
-            },
-            [progress_monitor](std::size_t context_id, std::int64_t frames)
-            {
-                progress_monitor->init(context_id, frames);
-            },
-            [promise_pipeline, progress_monitor](std::size_t context_id, std::string error)
-            {
-                progress_monitor->finish(context_id);
-                promise_pipeline->set_value(std::move(error));
-            },
-            [progress_monitor](std::size_t context_id, cvpg::videoproc::update_indicator update) mutable
+        auto progress_monitor = std::make_shared<progress_monitor_proxy>(progress_monitor_scheduler, !quiet && input_uris.size() == 1);
+
+        host.add_stream(
+            std::move(stream_parameters),
+            image_processor,
             {
-                progress_monitor->update(context_id, std::move(update));
+                // the host waits for the stream to finish
+                nullptr,
+                [progress_monitor](std::size_t context_id, std::int64_t frames)
+                {
+                    progress_monitor->init(context_id, frames);
+                },
+                [progress_monitor](std::size_t context_id, std::string)
+                {
+                    progress_monitor->finish(context_id);
+                },
+                [progress_monitor](std::size_t context_id, cvpg::videoproc::update_indicator update)
+                {
+                    progress_monitor->update(context_id, std::move(update));
+                }
             }
-        }
-    );
+        );
+    }
 
-    auto future_pipeline = promise_pipeline->get_future();
+    if (!quiet && host.streams() > 1)
+    {
+        std::cout << "Processing " << host.streams() << " streams in " << host.groups() << " groups with up to " << host.fair_queue_depth() << " frame evaluations at once" << std::endl;
+    }
 
-    auto status = future_pipeline.wait_for(std::chrono::seconds(timeout));
+    const auto processing_started = std::chrono::steady_clock::now();
+
+    host.start();
+
+    // all streams share the same timeout
+    const auto results = host.wait_until(processing_started + std::chrono::seconds(timeout));
 
     bool finished_with_errors = false;
 
-    if (status == std::future_status::deferred)
+    // a failed chunk invalidates the whole output
+    bool chunks_failed = false;
+
+    for (std::size_t i = 0; i < results.size(); ++i)
     {
-        std::cerr << "Execution aborted in defered state" << std::endl;
+        // prefix messages with the input in case of multiple streams
+        const std::string prefix = results.size() > 1 ? std::string("'").append(stream_names[i]).append("': ") : std::string();
+
+        switch (results[i].state)
+        {
+            case cvpg::videoproc::pipelines::host::stream_state::deferred:
+                std::cerr << prefix << "Execution aborted in defered state" << std::endl;
+
+                finished_with_errors = true;
+                break;
+
+            case cvpg::videoproc::pipelines::host::stream_state::timed_out:
+                std::cerr << prefix << "Execution timed out" << std::endl;
+
+                finished_with_errors = true;
+                break;
+
+            case cvpg::videoproc::pipelines::host::stream_state::failed:
+                std::cerr << prefix << "Processing failed. Error: '" << results[i].error << "'" << std::endl;
 
-        finished_with_errors = true;
+                chunks_failed = true;
+                break;
+
+            case cvpg::videoproc::pipelines::host::stream_state::finished:
+                if (!quiet)
+                {
+                    std::cout << prefix << "Processing done" << std::endl;
+                }
+                break;
+        }
     }
-    else if (status == std::future_status::timeout)
+
+    // concatenate the chunks in order ; each chunk is a complete stream starting with a keyframe
+    if (!chunk_filenames.empty())
     {
-        std::cerr << "Execution timed out" << std::endl;
+        if (!finished_with_errors && !chunks_failed)
+        {
+            std::ofstream out(output_filenames.front(), std::ios::binary);
+
+            for (auto const & chunk_filename : chunk_filenames)
+            {
+                std::ifstream in(chunk_filename, std::ios::binary);
+                out << in.rdbuf();
+            }
 
-        finished_with_errors = true;
+            if (!quiet)
+            {
+                std::cout << "Concatenated " << chunk_filenames.size() << " chunks to '" << output_filenames.front() << "'" << std::endl;
+            }
+        }
+        else
+        {
+            std::cerr << "Chunks are not concatenated because of errors." << std::endl;
+
+            finished_with_errors = true;
+        }
+
+        for (auto const & chunk_filename : chunk_filenames)
+        {
+            std::remove(chunk_filename.c_str());
+        }
     }
-    else
+
+    if (!quiet)
     {
-        auto error = future_pipeline.get();
+        if (auto memory_budget = host.memory_budget())
+        {
+            std::cout << "Peak of buffered frames: " << (memory_budget->peak() / (1024 * 1024)) << " of " << memory_budget_mb << " MB" << std::endl;
+        }
 
-        if (error.empty() && !quiet)
+        if (host.streams() > 1)
         {
-            std::cout << "Processing done" << std::endl;
+            const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - processing_started).count();
+
+            const auto statistics = host.statistics();
+
+            std::cout << "Streams:" << std::endl;
+
+            for (std::size_t i = 0; i < host.streams(); ++i)
+            {
+                const auto & statistic = statistics[i];
+
+                const std::size_t frames_saved = host.frames_saved(i);
+
+                const double mean_latency = statistic.completed > 0 ? std::chrono::duration<double, std::milli>(statistic.sum_latency).count() / statistic.completed : 0.0;
+                const double max_latency = std::chrono::duration<double, std::milli>(statistic.max_latency).count();
+
+                std::cout << "- '" << statistic.name << "' (weight " << statistic.weight << "): "
+                          << frames_saved << " frames, " << (elapsed > 0.0 ? frames_saved / elapsed : 0.0) << " fps, "
+                          << "evaluation latency mean " << mean_latency << " ms, max " << max_latency << " ms" << std::endl;
+            }
         }
-        else if (!error.empty())
+
+        // latencies of the frames written to the output(s) per stage
+        for (std::size_t i = 0; i < host.streams(); ++i)
         {
-            std::cerr << "Processing failed. Error: '" << error << "'" << std::endl;
+            auto const & latencies = *(host.latencies(i));
+
+            const auto stages = latencies.stages();
+
+            if (stages.empty())
+            {
+                continue;
+            }
+
+            std::cout << "Latencies" << (host.streams() > 1 ? std::string(" of '").append(stream_names[i]).append("'") : std::string()) << " (p50 / p90 / p99 / max):" << std::endl;
+
+            const auto to_ms = [](auto latency){ return std::chrono::duration<double, std::milli>(latency).count(); };
+
+            for (auto const & stage : stages)
+            {
+                std::cout << "- " << stage << ": "
+                          << to_ms(latencies.percentile(stage, 50.0)) << " / "
+                          << to_ms(latencies.percentile(stage, 90.0)) << " / "
+                          << to_ms(latencies.percentile(stage, 99.0)) << " / "
+                          << to_ms(latencies.max(stage)) << " ms" << std::endl;
+            }
         }
     }
 
@@ -17,9 +17,11 @@ struct progress_monitor::processing_context
 
     std::int64_t frames_load_done = 0;
     std::int64_t frames_load_failed = 0;
+    std::int64_t frames_load_dropped = 0;
 
     std::int64_t frames_process_done = 0;
     std::int64_t frames_process_failed = 0;
+    std::int64_t frames_process_skipped = 0;
 
     std::int64_t interframes_process_done = 0;
     std::int64_t interframes_process_failed = 0;
@@ -75,11 +77,21 @@ void progress_monitor::update(std::size_t context_id, cvpg::videoproc::update_in
             context->frames_load_done += update.processed();
             context->frames_load_failed += update.failed();
         }
+        else if (update.context() == "drop")
+        {
+            context->frames_load_dropped += update.processed();
+        }
         else if (update.context() == "frame")
         {
             context->frames_process_done += update.processed();
             context->frames_process_failed += update.failed();
         }
+        else if (update.context() == "skip")
+        {
+            // skipped frames are done without evaluating the frame script
+            context->frames_process_done += update.processed();
+            context->frames_process_skipped += update.processed();
+        }
         else if (update.context() == "interframe")
         {
             context->interframes_process_done += update.processed();
@@ -154,8 +166,22 @@ void progress_monitor::print_at_console(std::size_t context_id)
                     std::cout << title << ": " << amount << std::endl;
                 };
 
-            print_update("- load  ", (context->frames_load_done + context->frames_load_failed));
-            print_update("- frames", (context->frames_process_done + context->frames_process_failed));
+            if (context->frames_load_dropped > 0)
+            {
+                std::cout << "- load  : " << (context->frames_load_done + context->frames_load_failed) << " (dropped " << context->frames_load_dropped << ")" << std::endl;
+            }
+            else
+            {
+                print_update("- load  ", (context->frames_load_done + context->frames_load_failed));
+            }
+            if (context->frames_process_skipped > 0)
+            {
+                std::cout << "- frames: " << (context->frames_process_done + context->frames_process_failed) << " (skipped " << context->frames_process_skipped << ")" << std::endl;
+            }
+            else
+            {
+                print_update("- frames", (context->frames_process_done + context->frames_process_failed));
+            }
             print_update("- inters", (context->interframes_process_done + context->interframes_process_failed));
             print_update("- save  ", (context->frames_save_done + context->frames_save_failed));
         }
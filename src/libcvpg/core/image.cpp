@@ -51,6 +51,16 @@ template<class pixel, std::uint8_t channels> std::shared_ptr<typename image<pixe
     return m_data[channel];
 }
 
+template<class pixel, std::uint8_t channels> color_range image<pixel, channels>::range() const
+{
+    return m_range;
+}
+
+template<class pixel, std::uint8_t channels> void image<pixel, channels>::set_range(color_range range)
+{
+    m_range = range;
+}
+
 template<class pixel, std::uint8_t channels> void image<pixel, channels>::set_metadata(std::shared_ptr<cvpg::meta_data> metadata)
 {
     m_metadata = std::move(metadata);
@@ -66,6 +76,81 @@ template<class pixel, std::uint8_t channels> bool image<pixel, channels>::has_me
     return !!m_metadata;
 }
 
+template<class pixel> image_yuv420<pixel>::image_yuv420(std::uint32_t width, std::uint32_t height)
+    : m_width(width)
+    , m_height(height)
+    , m_data()
+    , m_strides({{ width, (width + 1) / 2, (width + 1) / 2 }})
+{
+    for (std::uint8_t p = 0; p < 3; ++p)
+    {
+        m_data[p] = std::shared_ptr<pixel_type>(static_cast<pixel_type *>(malloc(m_strides[p] * plane_height(p) * sizeof(pixel_type))), [](pixel_type * ptr){ free(ptr); });
+    }
+}
+
+template<class pixel> image_yuv420<pixel>::image_yuv420(std::uint32_t width, std::uint32_t height, plane_array_type data, stride_array_type strides, color_range range)
+    : m_width(width)
+    , m_height(height)
+    , m_data(std::move(data))
+    , m_strides(std::move(strides))
+    , m_range(range)
+{}
+
+template<class pixel> std::uint32_t image_yuv420<pixel>::width() const
+{
+    return m_width;
+}
+
+template<class pixel> std::uint32_t image_yuv420<pixel>::height() const
+{
+    return m_height;
+}
+
+template<class pixel> std::uint32_t image_yuv420<pixel>::plane_width(std::uint8_t plane) const
+{
+    return plane == 0 ? m_width : (m_width + 1) / 2;
+}
+
+template<class pixel> std::uint32_t image_yuv420<pixel>::plane_height(std::uint8_t plane) const
+{
+    return plane == 0 ? m_height : (m_height + 1) / 2;
+}
+
+template<class pixel> std::uint32_t image_yuv420<pixel>::stride(std::uint8_t plane) const
+{
+    return m_strides[plane];
+}
+
+template<class pixel> std::shared_ptr<typename image_yuv420<pixel>::pixel_type> image_yuv420<pixel>::data(std::uint8_t plane) const
+{
+    return m_data[plane];
+}
+
+template<class pixel> color_range image_yuv420<pixel>::range() const
+{
+    return m_range;
+}
+
+template<class pixel> void image_yuv420<pixel>::set_range(color_range range)
+{
+    m_range = range;
+}
+
+template<class pixel> void image_yuv420<pixel>::set_metadata(std::shared_ptr<cvpg::meta_data> metadata)
+{
+    m_metadata = std::move(metadata);
+}
+
+template<class pixel> std::shared_ptr<cvpg::meta_data> image_yuv420<pixel>::get_metadata() const noexcept
+{
+    return m_metadata;
+}
+
+template<class pixel> bool image_yuv420<pixel>::has_metadata() const noexcept
+{
+    return !!m_metadata;
+}
+
 image_gray_8bit read_gray_8bit_png(std::string const & filename)
 {
     int width = 0;
@@ -574,10 +659,18 @@ void write_png(image_rgb_8bit const & img, std::string const & filename)
 template class image<std::uint8_t, 1>;
 template class image<std::uint8_t, 3>;
 
+// manual instantation of image_yuv420<> for some types
+template class image_yuv420<std::uint8_t>;
+
 std::ostream & operator<<(std::ostream & out, image_gray_8bit const & i)
 {
     out << "width=" << i.width() << ",height=" << i.height() << ",channels=1";
 
+    if (i.range() == color_range::limited)
+    {
+        out << ",range=limited";
+    }
+
     if (i.has_metadata())
     {
         out << ",metadata=" << i.get_metadata()->size();
@@ -598,4 +691,21 @@ std::ostream & operator<<(std::ostream & out, image_rgb_8bit const & i)
     return out;
 }
 
+std::ostream & operator<<(std::ostream & out, image_yuv420_8bit const & i)
+{
+    out << "width=" << i.width() << ",height=" << i.height() << ",format=yuv420";
+
+    if (i.range() == color_range::full)
+    {
+        out << ",range=full";
+    }
+
+    if (i.has_metadata())
+    {
+        out << ",metadata=" << i.get_metadata()->size();
+    }
+
+    return out;
+}
+
 } // namespace cvpg
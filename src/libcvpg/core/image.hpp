@@ -16,6 +16,18 @@ namespace cvpg {
 
 class meta_data;
 
+// range of the samples of an image: limited (luma 16..235, chroma 16..240) or full (0..255)
+enum class color_range
+{
+    limited,
+    full
+};
+
+//
+// Grayscale and RGB images are in the full range unless stated otherwise. A grayscale image could wrap
+// the limited range luma plane of a decoder ; its values have to be expanded before they are used as
+// intensities.
+//
 template<class pixel = std::uint8_t, std::uint8_t channels = 1>
 class image
 {
@@ -42,6 +54,10 @@ public:
 
     std::shared_ptr<pixel_type> data(std::uint8_t channel) const;
 
+    color_range range() const;
+
+    void set_range(color_range range);
+
     void set_metadata(std::shared_ptr<cvpg::meta_data> metadata);
 
     std::shared_ptr<meta_data> get_metadata() const noexcept;
@@ -56,12 +72,80 @@ private:
 
     channel_array_type m_data;
 
+    color_range m_range = color_range::full;
+
     std::shared_ptr<cvpg::meta_data> m_metadata;
 };
 
 using image_gray_8bit = image<std::uint8_t, 1>;
 using image_rgb_8bit = image<std::uint8_t, 3>;
 
+//
+// Image in the planar YUV 4:2:0 format as delivered by most video decoders. The luma plane (Y) has the
+// full resolution, the chroma planes (U and V) have half of the width and height (rounded up).
+//
+// Lines of a plane are 'stride(plane)' pixels apart, so planes of a decoder can be used without copying.
+//
+// The color range tells whether the samples use the limited (luma 16..235, chroma 16..240) or the full
+// (0..255) range ; images are in the limited range unless stated otherwise.
+//
+template<class pixel = std::uint8_t>
+class image_yuv420
+{
+public:
+    using pixel_type = pixel;
+
+    using plane_array_type = std::array<std::shared_ptr<pixel_type>, 3>;
+
+    using stride_array_type = std::array<std::uint32_t, 3>;
+
+    image_yuv420(std::uint32_t width = 0, std::uint32_t height = 0);
+
+    image_yuv420(std::uint32_t width, std::uint32_t height, plane_array_type data, stride_array_type strides, color_range range = color_range::limited);
+
+    image_yuv420(image_yuv420 const &) = default;
+    image_yuv420(image_yuv420 &&) = default;
+
+    image_yuv420 & operator=(image_yuv420 const &) = default;
+    image_yuv420 & operator=(image_yuv420 &&) = default;
+
+    std::uint32_t width() const;
+
+    std::uint32_t height() const;
+
+    std::uint32_t plane_width(std::uint8_t plane) const;
+
+    std::uint32_t plane_height(std::uint8_t plane) const;
+
+    std::uint32_t stride(std::uint8_t plane) const;
+
+    std::shared_ptr<pixel_type> data(std::uint8_t plane) const;
+
+    color_range range() const;
+
+    void set_range(color_range range);
+
+    void set_metadata(std::shared_ptr<cvpg::meta_data> metadata);
+
+    std::shared_ptr<meta_data> get_metadata() const noexcept;
+
+    bool has_metadata() const noexcept;
+
+private:
+    std::uint32_t m_width = 0;
+    std::uint32_t m_height = 0;
+
+    plane_array_type m_data;
+
+    stride_array_type m_strides = {{ 0, 0, 0 }};
+
+    color_range m_range = color_range::limited;
+
+    std::shared_ptr<cvpg::meta_data> m_metadata;
+};
+
+using image_yuv420_8bit = image_yuv420<std::uint8_t>;
+
 image_gray_8bit read_gray_8bit_png(std::string const & filename);
 image_rgb_8bit read_rgb_8bit_png(std::string const & filename);
 
@@ -74,8 +158,12 @@ void write_png(image_rgb_8bit const & img, std::string const & filename);
 extern template class image<std::uint8_t, 1>;
 extern template class image<std::uint8_t, 3>;
 
+// suppress automatic instantiation of image_yuv420<> for some types
+extern template class image_yuv420<std::uint8_t>;
+
 std::ostream & operator<<(std::ostream & out, image_gray_8bit const & i);
 std::ostream & operator<<(std::ostream & out, image_rgb_8bit const & i);
+std::ostream & operator<<(std::ostream & out, image_yuv420_8bit const & i);
 
 } // namespace cvpg
 
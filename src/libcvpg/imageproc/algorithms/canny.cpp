@@ -0,0 +1,124 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/imageproc/algorithms/canny.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <libcvpg/imageproc/algorithms/tiling.hpp>
+#include <libcvpg/imageproc/algorithms/tiling/canny.hpp>
+
+namespace {
+
+struct canny_task : public boost::asynchronous::continuation_task<cvpg::image_gray_8bit>
+{
+    canny_task(cvpg::image_gray_8bit image, std::int32_t low_threshold, std::int32_t high_threshold, std::size_t cutoff_x, std::size_t cutoff_y)
+        : boost::asynchronous::continuation_task<cvpg::image_gray_8bit>("canny_task")
+        , m_image(std::move(image))
+        , m_low_threshold(low_threshold)
+        , m_high_threshold(high_threshold)
+        , m_cutoff_x(cutoff_x)
+        , m_cutoff_y(cutoff_y)
+    {}
+
+    void operator()()
+    {
+        try
+        {
+            const std::uint32_t width = m_image.width();
+            const std::uint32_t height = m_image.height();
+
+            // state of each pixel after the non-maximum suppression ; changed concurrently by the hysteresis
+            auto states = std::make_shared<std::vector<std::atomic<std::uint8_t> > >(static_cast<std::size_t>(width) * height);
+
+            // 1st pass: gradients, non-maximum suppression and thresholds
+            auto tf = cvpg::imageproc::algorithms::tiling_functors::image<cvpg::image_gray_8bit>({{ m_image }});
+            tf.parameters.image_width = width;
+            tf.parameters.image_height = height;
+            tf.parameters.cutoff_x = m_cutoff_x;
+            tf.parameters.cutoff_y = m_cutoff_y;
+            tf.parameters.signed_integer_numbers.push_back(m_low_threshold);
+            tf.parameters.signed_integer_numbers.push_back(m_high_threshold);
+
+            tf.tile_algorithm_task = [states](std::shared_ptr<cvpg::image_gray_8bit> src1, std::shared_ptr<cvpg::image_gray_8bit> /*src2*/, std::shared_ptr<cvpg::image_gray_8bit> dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+            {
+                cvpg::imageproc::algorithms::canny_gradient_gray_8bit(src1->data(0).get(), dst->data(0).get(), states->data(), from_x, to_x, from_y, to_y, std::move(parameters));
+            };
+
+            boost::asynchronous::create_callback_continuation(
+                [result = this->this_task_result(), states, width, height, cutoff_x = m_cutoff_x, cutoff_y = m_cutoff_y](auto cont_res) mutable
+                {
+                    try
+                    {
+                        auto mask = std::move(std::get<0>(cont_res).get());
+
+                        // 2nd pass: hysteresis ; the mask of the 1st pass is completed in place
+                        auto tf = cvpg::imageproc::algorithms::tiling_functors::image<cvpg::image_gray_8bit>({{ mask }});
+                        tf.parameters.image_width = width;
+                        tf.parameters.image_height = height;
+                        tf.parameters.cutoff_x = cutoff_x;
+                        tf.parameters.cutoff_y = cutoff_y;
+
+                        tf.create_output = [mask](std::uint32_t /*width*/, std::uint32_t /*height*/)
+                        {
+                            return mask;
+                        };
+
+                        tf.tile_algorithm_task = [states](std::shared_ptr<cvpg::image_gray_8bit> /*src1*/, std::shared_ptr<cvpg::image_gray_8bit> /*src2*/, std::shared_ptr<cvpg::image_gray_8bit> dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+                        {
+                            cvpg::imageproc::algorithms::canny_hysteresis_gray_8bit(dst->data(0).get(), states->data(), from_x, to_x, from_y, to_y, std::move(parameters));
+                        };
+
+                        boost::asynchronous::create_callback_continuation(
+                            [result = std::move(result), states](auto cont_res) mutable
+                            {
+                                try
+                                {
+                                    result.set_value(std::move(std::get<0>(cont_res).get()));
+                                }
+                                catch (...)
+                                {
+                                    result.set_exception(std::current_exception());
+                                }
+                            },
+                            cvpg::imageproc::algorithms::tiling(std::move(tf))
+                        );
+                    }
+                    catch (...)
+                    {
+                        result.set_exception(std::current_exception());
+                    }
+                },
+                cvpg::imageproc::algorithms::tiling(std::move(tf))
+            );
+        }
+        catch (...)
+        {
+            this->this_task_result().set_exception(std::current_exception());
+        }
+    }
+
+private:
+    cvpg::image_gray_8bit m_image;
+
+    std::int32_t m_low_threshold;
+    std::int32_t m_high_threshold;
+
+    std::size_t m_cutoff_x;
+    std::size_t m_cutoff_y;
+};
+
+}
+
+namespace cvpg::imageproc::algorithms {
+
+boost::asynchronous::detail::callback_continuation<image_gray_8bit> canny(image_gray_8bit image, std::int32_t low_threshold, std::int32_t high_threshold, std::size_t cutoff_x, std::size_t cutoff_y)
+{
+    return boost::asynchronous::top_level_callback_continuation<image_gray_8bit>(
+               canny_task(std::move(image), low_threshold, high_threshold, cutoff_x, cutoff_y)
+           );
+}
+
+} // namespace cvpg::imageproc::algorithms
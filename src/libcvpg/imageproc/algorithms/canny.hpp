@@ -0,0 +1,31 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_IMAGEPROC_ALGORITHMS_CANNY_HPP
+#define LIBCVPG_IMAGEPROC_ALGORITHMS_CANNY_HPP
+
+#include <cstdint>
+
+#include <boost/asynchronous/continuation_task.hpp>
+
+#include <libcvpg/core/image.hpp>
+
+namespace cvpg::imageproc::algorithms {
+
+//
+// Canny edge detector. Returns a mask with edge pixels set to 255 and all other pixels set to 0.
+//
+// The thresholds refer to the magnitude of the Sobel 3x3 gradient (up to ~1443 for 8 bit images). Pixels
+// with a magnitude above 'high_threshold' are edges, pixels with a magnitude above 'low_threshold' are
+// edges only if they are connected to another edge pixel. The image isn't smoothed, so noisy images
+// should be filtered by a Gaussian first.
+//
+boost::asynchronous::detail::callback_continuation<image_gray_8bit> canny(image_gray_8bit image,
+                                                                          std::int32_t low_threshold,
+                                                                          std::int32_t high_threshold,
+                                                                          std::size_t cutoff_x = 512,
+                                                                          std::size_t cutoff_y = 512);
+
+} // namespace cvpg::imageproc::algorithms
+
+#endif // LIBCVPG_IMAGEPROC_ALGORITHMS_CANNY_HPP
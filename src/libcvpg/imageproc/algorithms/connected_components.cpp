@@ -0,0 +1,494 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/imageproc/algorithms/connected_components.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <libcvpg/core/meta_data.hpp>
+#include <libcvpg/core/multi_array.hpp>
+#include <libcvpg/imageproc/algorithms/tiling.hpp>
+#include <libcvpg/imageproc/algorithms/tiling/functors/histogram.hpp>
+
+namespace {
+
+struct blob
+{
+    std::uint64_t area = 0;
+
+    std::uint32_t min_x = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t min_y = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t max_x = 0;
+    std::uint32_t max_y = 0;
+
+    std::uint64_t sum_x = 0;
+    std::uint64_t sum_y = 0;
+
+    void merge(blob const & other)
+    {
+        area += other.area;
+
+        min_x = std::min(min_x, other.min_x);
+        min_y = std::min(min_y, other.min_y);
+        max_x = std::max(max_x, other.max_x);
+        max_y = std::max(max_y, other.max_y);
+
+        sum_x += other.sum_x;
+        sum_y += other.sum_y;
+    }
+};
+
+// blobs of a part of the image, identified by the index of their root pixel
+using blob_map = std::unordered_map<std::uint32_t, blob>;
+
+//
+// Parent pointers of a union-find forest over all pixels. An entry stores the index of the parent pixel
+// plus one, so that a zero-initialized array is a forest of single roots. A parent has always a smaller
+// index than its child. So the root of a region is its first pixel in raster order.
+//
+using parents_type = std::vector<std::atomic<std::uint32_t> >;
+
+inline std::uint32_t find_root(parents_type & parents, std::uint32_t index)
+{
+    while (true)
+    {
+        std::uint32_t parent = parents[index].load(std::memory_order_relaxed);
+
+        if (parent == 0)
+        {
+            return index;
+        }
+
+        const std::uint32_t grandparent = parents[parent - 1].load(std::memory_order_relaxed);
+
+        // path halving ; a concurrent change of the parent is no problem because parents only move upwards
+        if (grandparent != 0)
+        {
+            parents[index].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+        }
+
+        index = parent - 1;
+    }
+}
+
+inline void unite(parents_type & parents, std::uint32_t a, std::uint32_t b)
+{
+    while (true)
+    {
+        a = find_root(parents, a);
+        b = find_root(parents, b);
+
+        if (a == b)
+        {
+            return;
+        }
+
+        if (a > b)
+        {
+            std::swap(a, b);
+        }
+
+        // link root 'b' below root 'a' ; fails if another thread linked 'b' in the meantime
+        std::uint32_t expected = 0;
+
+        if (parents[b].compare_exchange_strong(expected, a + 1, std::memory_order_acq_rel))
+        {
+            return;
+        }
+    }
+}
+
+//
+// Union all foreground pixels of a tile with their already visited neighbours. Neighbours outside of the
+// tile (to the left and above) are included, so the seams between the tiles are merged without an
+// additional merge step.
+//
+void label_tile(std::uint8_t const * mask, parents_type & parents, std::uint32_t image_width, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, bool eight_connected)
+{
+    for (std::size_t y = from_y; y <= to_y; ++y)
+    {
+        const std::size_t offset_y = y * image_width;
+
+        std::uint8_t const * line = mask + offset_y;
+        std::uint8_t const * prev_line = y > 0 ? (line - image_width) : nullptr;
+
+        for (std::size_t x = from_x; x <= to_x; ++x)
+        {
+            if (line[x] == 0)
+            {
+                continue;
+            }
+
+            const std::uint32_t index = static_cast<std::uint32_t>(offset_y + x);
+
+            const bool left = x > 0 && line[x - 1] != 0;
+            const bool up = prev_line != nullptr && prev_line[x] != 0;
+            const bool up_left = prev_line != nullptr && x > 0 && prev_line[x - 1] != 0;
+            const bool up_right = prev_line != nullptr && (x + 1) < image_width && prev_line[x + 1] != 0;
+
+            // skip unions with neighbours that are already connected through the processing of another pixel
+            if (eight_connected)
+            {
+                if (up)
+                {
+                    unite(parents, index, index - image_width);
+                }
+                else
+                {
+                    if (left)
+                    {
+                        unite(parents, index, index - 1);
+                    }
+                    else if (up_left)
+                    {
+                        unite(parents, index, index - image_width - 1);
+                    }
+
+                    if (up_right)
+                    {
+                        unite(parents, index, index - image_width + 1);
+                    }
+                }
+            }
+            else
+            {
+                if (up)
+                {
+                    unite(parents, index, index - image_width);
+                }
+
+                if (left && !(up && up_left))
+                {
+                    unite(parents, index, index - 1);
+                }
+            }
+        }
+    }
+}
+
+void collect_tile(std::uint8_t const * mask, parents_type & parents, std::uint32_t image_width, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, blob_map & blobs)
+{
+    // consecutive pixels mostly belong to the same blob, so the last lookup is cached
+    std::uint32_t last_root = std::numeric_limits<std::uint32_t>::max();
+    blob * last_blob = nullptr;
+
+    for (std::size_t y = from_y; y <= to_y; ++y)
+    {
+        const std::size_t offset_y = y * image_width;
+
+        std::uint8_t const * line = mask + offset_y;
+
+        for (std::size_t x = from_x; x <= to_x; ++x)
+        {
+            if (line[x] == 0)
+            {
+                continue;
+            }
+
+            const std::uint32_t root = find_root(parents, static_cast<std::uint32_t>(offset_y + x));
+
+            if (root != last_root)
+            {
+                last_root = root;
+                last_blob = &blobs[root];
+            }
+
+            last_blob->area += 1;
+
+            last_blob->min_x = std::min(last_blob->min_x, static_cast<std::uint32_t>(x));
+            last_blob->min_y = std::min(last_blob->min_y, static_cast<std::uint32_t>(y));
+            last_blob->max_x = std::max(last_blob->max_x, static_cast<std::uint32_t>(x));
+            last_blob->max_y = std::max(last_blob->max_y, static_cast<std::uint32_t>(y));
+
+            last_blob->sum_x += x;
+            last_blob->sum_y += y;
+        }
+    }
+}
+
+struct merge_blobs_task : public boost::asynchronous::continuation_task<std::shared_ptr<blob_map> >
+{
+    merge_blobs_task(std::shared_ptr<blob_map> a, std::shared_ptr<blob_map> b)
+        : boost::asynchronous::continuation_task<std::shared_ptr<blob_map> >("connected_components_task::merge_blobs")
+        , m_a(a)
+        , m_b(b)
+    {}
+
+    void operator()()
+    {
+        // insert the smaller map into the larger one
+        if (m_a->size() < m_b->size())
+        {
+            std::swap(m_a, m_b);
+        }
+
+        for (auto const & [root, b] : *m_b)
+        {
+            (*m_a)[root].merge(b);
+        }
+
+        this_task_result().set_value(std::move(m_a));
+    }
+
+private:
+    std::shared_ptr<blob_map> m_a;
+    std::shared_ptr<blob_map> m_b;
+};
+
+boost::asynchronous::detail::callback_continuation<std::shared_ptr<blob_map> > merge_blobs(std::shared_ptr<blob_map> a, std::shared_ptr<blob_map> b)
+{
+    return boost::asynchronous::top_level_callback_continuation<std::shared_ptr<blob_map> >(
+               merge_blobs_task(a, b)
+           );
+}
+
+void store_blobs(cvpg::image_gray_8bit & image, blob_map const & blobs, std::int32_t min_area, std::string const & key)
+{
+    // order blobs by their first pixel to get a reproducible result
+    std::vector<std::pair<std::uint32_t, blob> > sorted;
+    sorted.reserve(blobs.size());
+
+    for (auto const & [root, b] : blobs)
+    {
+        if (b.area >= static_cast<std::uint64_t>(std::max(min_area, 0)))
+        {
+            sorted.emplace_back(root, b);
+        }
+    }
+
+    std::sort(sorted.begin(),
+              sorted.end(),
+              [](auto const & a, auto const & b)
+              {
+                  return a.first < b.first;
+              });
+
+    const int entries = static_cast<int>(sorted.size());
+
+    const float width = static_cast<float>(image.width());
+    const float height = static_cast<float>(image.height());
+
+    // copy existing meta data, the input image could be used elsewhere
+    auto metadata = (image.has_metadata() && !!image.get_metadata()) ? std::make_shared<cvpg::meta_data>(*image.get_metadata()) : std::make_shared<cvpg::meta_data>();
+
+    // register a label for the blobs
+    using labels_type = std::unordered_map<std::size_t, std::string>;
+
+    std::size_t class_id = 0;
+
+    {
+        auto it = metadata->find("labels");
+
+        labels_type labels = (it != metadata->end()) ? std::any_cast<labels_type>(it->second) : labels_type();
+
+        auto label_it = std::find_if(labels.cbegin(),
+                                     labels.cend(),
+                                     [](auto const & entry)
+                                     {
+                                         return entry.second == "blob";
+                                     });
+
+        if (label_it != labels.cend())
+        {
+            class_id = label_it->first;
+        }
+        else
+        {
+            for (auto const & [id, label] : labels)
+            {
+                class_id = std::max(class_id, id + 1);
+            }
+
+            labels.insert({ class_id, "blob" });
+        }
+
+        if (it != metadata->end())
+        {
+            it->second = std::move(labels);
+        }
+        else
+        {
+            metadata->push("labels", std::move(labels));
+        }
+    }
+
+    std::vector<float> boxes;
+    std::vector<float> classes;
+    std::vector<float> scores;
+    std::vector<float> areas;
+    std::vector<float> centroids;
+
+    boxes.reserve(entries * 4);
+    classes.reserve(entries);
+    scores.reserve(entries);
+    areas.reserve(entries);
+    centroids.reserve(entries * 2);
+
+    for (auto const & [root, b] : sorted)
+    {
+        // use pixel centers to be robust against rounding errors when scaling back to image dimensions
+        boxes.push_back((b.min_y + 0.5f) / height);
+        boxes.push_back((b.min_x + 0.5f) / width);
+        boxes.push_back((b.max_y + 0.5f) / height);
+        boxes.push_back((b.max_x + 0.5f) / width);
+
+        classes.push_back(static_cast<float>(class_id));
+        scores.push_back(1.0f);
+        areas.push_back(static_cast<float>(b.area));
+
+        centroids.push_back((static_cast<float>(b.sum_y) / b.area + 0.5f) / height);
+        centroids.push_back((static_cast<float>(b.sum_x) / b.area + 0.5f) / width);
+    }
+
+    // 'paint_meta' iterates over the first plane of a 3-dimensional array, so all values are stored in a single plane
+    auto push_array =
+        [&metadata, &key](std::string name, std::vector<float> data, cvpg::multi_array<float> array, std::vector<int> dims)
+        {
+            array = std::move(data);
+
+            const std::string prefix = std::string(key).append(".").append(name);
+
+            metadata->push(std::string(prefix).append(".data"), std::move(array));
+            metadata->push(std::string(prefix).append(".dims"), std::move(dims));
+            metadata->push(std::string(prefix).append(".type"), std::string("float"));
+        };
+
+    push_array("boxes", std::move(boxes), cvpg::multi_array<float>(4, entries, 1), { 1, entries, 4 });
+    push_array("classes", std::move(classes), cvpg::multi_array<float>(1, entries), { 1, entries });
+    push_array("scores", std::move(scores), cvpg::multi_array<float>(1, entries), { 1, entries });
+    push_array("areas", std::move(areas), cvpg::multi_array<float>(1, entries), { 1, entries });
+    push_array("centroids", std::move(centroids), cvpg::multi_array<float>(2, entries, 1), { 1, entries, 2 });
+
+    image.set_metadata(std::move(metadata));
+}
+
+struct connected_components_task : public boost::asynchronous::continuation_task<cvpg::image_gray_8bit>
+{
+    connected_components_task(cvpg::image_gray_8bit image, std::int32_t connectivity, std::int32_t min_area, std::string key, std::size_t cutoff_x, std::size_t cutoff_y)
+        : boost::asynchronous::continuation_task<cvpg::image_gray_8bit>("connected_components_task")
+        , m_image(std::move(image))
+        , m_connectivity(connectivity)
+        , m_min_area(min_area)
+        , m_key(std::move(key))
+        , m_cutoff_x(cutoff_x)
+        , m_cutoff_y(cutoff_y)
+    {}
+
+    void operator()()
+    {
+        try
+        {
+            const std::uint32_t width = m_image.width();
+            const std::uint32_t height = m_image.height();
+
+            auto parents = std::make_shared<parents_type>(static_cast<std::size_t>(width) * height);
+
+            // 1st pass: union all neighbouring foreground pixels
+            auto tf = cvpg::imageproc::algorithms::tiling_functors::histogram<cvpg::image_gray_8bit, blob_map>({{ m_image }});
+            tf.parameters.image_width = width;
+            tf.parameters.image_height = height;
+            tf.parameters.cutoff_x = m_cutoff_x;
+            tf.parameters.cutoff_y = m_cutoff_y;
+
+            tf.tile_algorithm_task = [parents, eight_connected = (m_connectivity == 8)](std::shared_ptr<cvpg::image_gray_8bit> src1, std::shared_ptr<cvpg::image_gray_8bit> /*src2*/, std::shared_ptr<blob_map> /*dst*/, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters /*parameters*/)
+            {
+                label_tile(src1->data(0).get(), *parents, src1->width(), from_x, to_x, from_y, to_y, eight_connected);
+            };
+
+            boost::asynchronous::create_callback_continuation(
+                [result = this->this_task_result(), image = m_image, parents, min_area = m_min_area, key = m_key, cutoff_x = m_cutoff_x, cutoff_y = m_cutoff_y](auto cont_res) mutable
+                {
+                    try
+                    {
+                        std::get<0>(cont_res).get();
+
+                        // 2nd pass: resolve the root of each foreground pixel and collect the statistics of the blobs
+                        auto tf = cvpg::imageproc::algorithms::tiling_functors::histogram<cvpg::image_gray_8bit, blob_map>({{ image }});
+                        tf.parameters.image_width = image.width();
+                        tf.parameters.image_height = image.height();
+                        tf.parameters.cutoff_x = cutoff_x;
+                        tf.parameters.cutoff_y = cutoff_y;
+
+                        tf.tile_algorithm_task = [parents](std::shared_ptr<cvpg::image_gray_8bit> src1, std::shared_ptr<cvpg::image_gray_8bit> /*src2*/, std::shared_ptr<blob_map> dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters /*parameters*/)
+                        {
+                            collect_tile(src1->data(0).get(), *parents, src1->width(), from_x, to_x, from_y, to_y, *dst);
+                        };
+
+                        tf.horizontal_merge_task = [](std::shared_ptr<blob_map> dst1, std::shared_ptr<blob_map> dst2, std::size_t /*from_x*/, std::size_t /*to_x*/, std::size_t /*from_y*/, std::size_t /*to_y*/, cvpg::imageproc::algorithms::tiling_parameters /*parameters*/)
+                        {
+                            return merge_blobs(dst1, dst2);
+                        };
+
+                        tf.vertical_merge_task = [](std::shared_ptr<blob_map> dst1, std::shared_ptr<blob_map> dst2, std::size_t /*from_x*/, std::size_t /*to_x*/, std::size_t /*from_y*/, std::size_t /*to_y*/, cvpg::imageproc::algorithms::tiling_parameters /*parameters*/)
+                        {
+                            return merge_blobs(dst1, dst2);
+                        };
+
+                        boost::asynchronous::create_callback_continuation(
+                            [result = std::move(result), image = std::move(image), parents, min_area, key = std::move(key)](auto cont_res) mutable
+                            {
+                                try
+                                {
+                                    auto blobs = std::move(std::get<0>(cont_res).get());
+
+                                    store_blobs(image, blobs, min_area, key);
+
+                                    result.set_value(std::move(image));
+                                }
+                                catch (...)
+                                {
+                                    result.set_exception(std::current_exception());
+                                }
+                            },
+                            cvpg::imageproc::algorithms::tiling(std::move(tf))
+                        );
+                    }
+                    catch (...)
+                    {
+                        result.set_exception(std::current_exception());
+                    }
+                },
+                cvpg::imageproc::algorithms::tiling(std::move(tf))
+            );
+        }
+        catch (...)
+        {
+            this->this_task_result().set_exception(std::current_exception());
+        }
+    }
+
+private:
+    cvpg::image_gray_8bit m_image;
+
+    std::int32_t m_connectivity;
+    std::int32_t m_min_area;
+
+    std::string m_key;
+
+    std::size_t m_cutoff_x;
+    std::size_t m_cutoff_y;
+};
+
+}
+
+namespace cvpg::imageproc::algorithms {
+
+boost::asynchronous::detail::callback_continuation<image_gray_8bit> connected_components(image_gray_8bit image,
+                                                                                         std::int32_t connectivity,
+                                                                                         std::int32_t min_area,
+                                                                                         std::string key,
+                                                                                         std::size_t cutoff_x,
+                                                                                         std::size_t cutoff_y)
+{
+    return boost::asynchronous::top_level_callback_continuation<image_gray_8bit>(
+               connected_components_task(std::move(image), connectivity, min_area, std::move(key), cutoff_x, cutoff_y)
+           );
+}
+
+} // namespace cvpg::imageproc::algorithms
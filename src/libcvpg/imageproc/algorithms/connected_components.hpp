@@ -0,0 +1,38 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_IMAGEPROC_ALGORITHMS_CONNECTED_COMPONENTS_HPP
+#define LIBCVPG_IMAGEPROC_ALGORITHMS_CONNECTED_COMPONENTS_HPP
+
+#include <cstdint>
+#include <string>
+
+#include <boost/asynchronous/continuation_task.hpp>
+
+#include <libcvpg/core/image.hpp>
+
+namespace cvpg::imageproc::algorithms {
+
+//
+// Label all 4- or 8-connected regions of non-zero pixels of a mask.
+//
+// The returned image shares the pixels of the input mask. The found blobs (with an area of at least
+// 'min_area' pixels) are stored at the meta data of the returned image using the layout known from
+// 'paint_meta' (all entries are of type "float" and ordered by the first pixel of a blob):
+//
+// <key>.boxes      - [y_min, x_min, y_max, x_max] of the bounding box, relative to image dimensions
+// <key>.classes    - class ID of the entry "blob" at the label map "labels"
+// <key>.scores     - always 1.0
+// <key>.areas      - number of pixels
+// <key>.centroids  - [y, x] of the centroid, relative to image dimensions
+//
+boost::asynchronous::detail::callback_continuation<image_gray_8bit> connected_components(image_gray_8bit image,
+                                                                                         std::int32_t connectivity,
+                                                                                         std::int32_t min_area,
+                                                                                         std::string key,
+                                                                                         std::size_t cutoff_x = 512,
+                                                                                         std::size_t cutoff_y = 512);
+
+} // namespace cvpg::imageproc::algorithms
+
+#endif // LIBCVPG_IMAGEPROC_ALGORITHMS_CONNECTED_COMPONENTS_HPP
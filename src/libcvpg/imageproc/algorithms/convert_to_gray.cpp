@@ -3,8 +3,11 @@
 
 #include <libcvpg/imageproc/algorithms/convert_to_gray.hpp>
 
+#include <cstring>
+
 #include <libcvpg/imageproc/algorithms/tiling.hpp>
 #include <libcvpg/imageproc/algorithms/tiling/convert_to_gray.hpp>
+#include <libcvpg/imageproc/algorithms/tiling/convert_yuv420.hpp>
 
 namespace {
 
@@ -80,6 +83,138 @@ private:
     cvpg::imageproc::algorithms::rgb_conversion_mode m_mode;
 };
 
+struct convert_yuv420_to_gray_8bit_task : public boost::asynchronous::continuation_task<cvpg::image_gray_8bit>
+{
+    convert_yuv420_to_gray_8bit_task(cvpg::image_yuv420_8bit image)
+        : boost::asynchronous::continuation_task<cvpg::image_gray_8bit>("convert_yuv420_to_gray_8bit")
+        , m_image(std::move(image))
+    {}
+
+    void operator()()
+    {
+        const auto width = m_image.width();
+        const auto height = m_image.height();
+        const auto stride = m_image.stride(0);
+
+        if (m_image.range() == cvpg::color_range::limited)
+        {
+            // expand luma to the full range like the conversion to RGB does
+            auto metadata = m_image.get_metadata();
+
+            auto tf = cvpg::imageproc::algorithms::tiling_functors::image<cvpg::image_yuv420_8bit, cvpg::image_gray_8bit>({{ std::move(m_image) }});
+            tf.parameters.image_width = width;
+            tf.parameters.image_height = height;
+            tf.parameters.cutoff_x = 512;
+            tf.parameters.cutoff_y = 512;
+
+            tf.tile_algorithm_task = [](std::shared_ptr<cvpg::image_yuv420_8bit> src1, std::shared_ptr<cvpg::image_yuv420_8bit> /*src2*/, std::shared_ptr<cvpg::image_gray_8bit> dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+            {
+                cvpg::imageproc::algorithms::expand_luma_8bit(src1->data(0).get(), src1->stride(0), dst->data(0).get(), from_x, to_x, from_y, to_y, std::move(parameters));
+            };
+
+            boost::asynchronous::create_callback_continuation(
+                [task_result = this->this_task_result(), metadata = std::move(metadata)](auto result) mutable
+                {
+                    try
+                    {
+                        auto image = std::move(std::get<0>(result).get());
+                        image.set_metadata(std::move(metadata));
+
+                        task_result.set_value(std::move(image));
+                    }
+                    catch (...)
+                    {
+                        task_result.set_exception(std::current_exception());
+                    }
+                },
+                cvpg::imageproc::algorithms::tiling(std::move(tf))
+            );
+        }
+        else if (stride == width)
+        {
+            cvpg::image_gray_8bit image(width, height, 0, cvpg::image_gray_8bit::channel_array_type { m_image.data(0) });
+            image.set_metadata(m_image.get_metadata());
+
+            this->this_task_result().set_value(std::move(image));
+        }
+        else
+        {
+            cvpg::image_gray_8bit image(width, height);
+            image.set_metadata(m_image.get_metadata());
+
+            std::uint8_t const * src = m_image.data(0).get();
+            std::uint8_t * dst = image.data(0).get();
+
+            for (std::size_t y = 0; y < height; ++y)
+            {
+                std::memcpy(dst + y * width, src + y * stride, width);
+            }
+
+            this->this_task_result().set_value(std::move(image));
+        }
+    }
+
+private:
+    cvpg::image_yuv420_8bit m_image;
+};
+
+struct expand_gray_8bit_task : public boost::asynchronous::continuation_task<cvpg::image_gray_8bit>
+{
+    expand_gray_8bit_task(cvpg::image_gray_8bit image)
+        : boost::asynchronous::continuation_task<cvpg::image_gray_8bit>("expand_gray_8bit")
+        , m_image(std::move(image))
+    {}
+
+    void operator()()
+    {
+        if (m_image.range() == cvpg::color_range::full)
+        {
+            this->this_task_result().set_value(std::move(m_image));
+
+            return;
+        }
+
+        const auto width = m_image.width();
+        const auto height = m_image.height();
+
+        // the pixels of the source are never modified, they could be shared with a decoder
+        auto metadata = m_image.get_metadata();
+
+        auto tf = cvpg::imageproc::algorithms::tiling_functors::image<cvpg::image_gray_8bit, cvpg::image_gray_8bit>({{ std::move(m_image) }});
+        tf.parameters.image_width = width;
+        tf.parameters.image_height = height;
+        tf.parameters.cutoff_x = 512;
+        tf.parameters.cutoff_y = 512;
+
+        tf.tile_algorithm_task = [](std::shared_ptr<cvpg::image_gray_8bit> src1, std::shared_ptr<cvpg::image_gray_8bit> /*src2*/, std::shared_ptr<cvpg::image_gray_8bit> dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+        {
+            cvpg::imageproc::algorithms::expand_luma_8bit(src1->data(0).get(), src1->width() + src1->padding(), dst->data(0).get(), from_x, to_x, from_y, to_y, std::move(parameters));
+        };
+
+        boost::asynchronous::create_callback_continuation(
+            [task_result = this->this_task_result(), metadata = std::move(metadata)](auto result) mutable
+            {
+                try
+                {
+                    auto image = std::move(std::get<0>(result).get());
+                    image.set_range(cvpg::color_range::full);
+                    image.set_metadata(std::move(metadata));
+
+                    task_result.set_value(std::move(image));
+                }
+                catch (...)
+                {
+                    task_result.set_exception(std::current_exception());
+                }
+            },
+            cvpg::imageproc::algorithms::tiling(std::move(tf))
+        );
+    }
+
+private:
+    cvpg::image_gray_8bit m_image;
+};
+
 }
 
 namespace cvpg::imageproc::algorithms {
@@ -115,4 +250,18 @@ boost::asynchronous::detail::callback_continuation<image_gray_8bit> convert_to_g
            );
 }
 
+boost::asynchronous::detail::callback_continuation<image_gray_8bit> convert_to_gray(image_yuv420_8bit image)
+{
+    return boost::asynchronous::top_level_callback_continuation<image_gray_8bit>(
+               convert_yuv420_to_gray_8bit_task(std::move(image))
+           );
+}
+
+boost::asynchronous::detail::callback_continuation<image_gray_8bit> expand_to_full_range(image_gray_8bit image)
+{
+    return boost::asynchronous::top_level_callback_continuation<image_gray_8bit>(
+               expand_gray_8bit_task(std::move(image))
+           );
+}
+
 } // namespace cvpg::imageproc::algoritms
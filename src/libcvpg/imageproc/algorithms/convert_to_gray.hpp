@@ -24,6 +24,14 @@ std::ostream & operator<<(std::ostream & out, rgb_conversion_mode const & mode);
 
 boost::asynchronous::detail::callback_continuation<image_gray_8bit> convert_to_gray(image_rgb_8bit image, rgb_conversion_mode mode);
 
+// a full range luma plane is used as grayscale image and copied only if its lines are padded ; a limited range
+// luma plane is expanded to the full range
+boost::asynchronous::detail::callback_continuation<image_gray_8bit> convert_to_gray(image_yuv420_8bit image);
+
+// a limited range grayscale image (e.g. a wrapped luma plane of a decoder) is expanded to the full range into
+// a new image ; a full range image is used as it is
+boost::asynchronous::detail::callback_continuation<image_gray_8bit> expand_to_full_range(image_gray_8bit image);
+
 } // namespace cvpg::imageproc::algoritms
 
 #endif // LIBCVPG_IMAGEPROC_ALGORITHMS_CONVERT_TO_GRAY_HPP
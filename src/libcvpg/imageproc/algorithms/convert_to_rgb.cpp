@@ -4,6 +4,7 @@
 #include <libcvpg/imageproc/algorithms/convert_to_rgb.hpp>
 
 #include <libcvpg/imageproc/algorithms/tiling.hpp>
+#include <libcvpg/imageproc/algorithms/tiling/convert_yuv420.hpp>
 
 namespace {
 
@@ -26,6 +27,51 @@ private:
     cvpg::image_gray_8bit m_image;
 };
 
+struct convert_yuv420_to_rgb_8bit_task : public boost::asynchronous::continuation_task<cvpg::image_rgb_8bit>
+{
+    convert_yuv420_to_rgb_8bit_task(cvpg::image_yuv420_8bit image)
+        : boost::asynchronous::continuation_task<cvpg::image_rgb_8bit>("convert_yuv420_to_rgb_8bit")
+        , m_image(std::move(image))
+    {}
+
+    void operator()()
+    {
+        auto metadata = m_image.get_metadata();
+
+        auto tf = cvpg::imageproc::algorithms::tiling_functors::image<cvpg::image_yuv420_8bit, cvpg::image_rgb_8bit>({{ std::move(m_image) }});
+        tf.parameters.image_width = tf.inputs.front().width();
+        tf.parameters.image_height = tf.inputs.front().height();
+        tf.parameters.cutoff_x = 512;
+        tf.parameters.cutoff_y = 512;
+
+        tf.tile_algorithm_task = [](std::shared_ptr<cvpg::image_yuv420_8bit> src1, std::shared_ptr<cvpg::image_yuv420_8bit> /*src2*/, std::shared_ptr<cvpg::image_rgb_8bit> dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+        {
+            cvpg::imageproc::algorithms::convert_yuv420_to_rgb_8bit(src1->data(0).get(), src1->data(1).get(), src1->data(2).get(), src1->stride(0), src1->stride(1), src1->range(), dst->data(0).get(), dst->data(1).get(), dst->data(2).get(), from_x, to_x, from_y, to_y, std::move(parameters));
+        };
+
+        boost::asynchronous::create_callback_continuation(
+            [task_result = this->this_task_result(), metadata = std::move(metadata)](auto result) mutable
+            {
+                try
+                {
+                    auto image = std::move(std::get<0>(result).get());
+                    image.set_metadata(std::move(metadata));
+
+                    task_result.set_value(std::move(image));
+                }
+                catch (...)
+                {
+                    task_result.set_exception(std::current_exception());
+                }
+            },
+            cvpg::imageproc::algorithms::tiling(std::move(tf))
+        );
+    }
+
+private:
+    cvpg::image_yuv420_8bit m_image;
+};
+
 }
 
 namespace cvpg::imageproc::algorithms {
@@ -37,4 +83,11 @@ boost::asynchronous::detail::callback_continuation<image_rgb_8bit> convert_to_rg
            );
 }
 
+boost::asynchronous::detail::callback_continuation<image_rgb_8bit> convert_to_rgb(image_yuv420_8bit image)
+{
+    return boost::asynchronous::top_level_callback_continuation<image_rgb_8bit>(
+               convert_yuv420_to_rgb_8bit_task(std::move(image))
+           );
+}
+
 } // namespace cvpg::imageproc::algoritms
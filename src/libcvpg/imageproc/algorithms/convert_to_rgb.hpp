@@ -12,6 +12,8 @@ namespace cvpg::imageproc::algorithms {
 
 boost::asynchronous::detail::callback_continuation<image_rgb_8bit> convert_to_rgb(image_gray_8bit image);
 
+boost::asynchronous::detail::callback_continuation<image_rgb_8bit> convert_to_rgb(image_yuv420_8bit image);
+
 } // namespace cvpg::imageproc::algoritms
 
 #endif // LIBCVPG_IMAGEPROC_ALGORITHMS_CONVERT_TO_RGB_HPP
@@ -0,0 +1,108 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/imageproc/algorithms/convert_to_yuv420.hpp>
+
+#include <cstring>
+
+#include <libcvpg/imageproc/algorithms/tiling.hpp>
+#include <libcvpg/imageproc/algorithms/tiling/convert_yuv420.hpp>
+
+namespace {
+
+struct convert_gray_to_yuv420_8bit_task : public boost::asynchronous::continuation_task<cvpg::image_yuv420_8bit>
+{
+    convert_gray_to_yuv420_8bit_task(cvpg::image_gray_8bit image)
+        : boost::asynchronous::continuation_task<cvpg::image_yuv420_8bit>("convert_gray_to_yuv420_8bit")
+        , m_image(std::move(image))
+    {}
+
+    void operator()()
+    {
+        const std::uint32_t chroma_width = (m_image.width() + 1) / 2;
+        const std::uint32_t chroma_height = (m_image.height() + 1) / 2;
+
+        // a single neutral plane is shared by both chroma planes
+        auto chroma = std::shared_ptr<std::uint8_t>(static_cast<std::uint8_t *>(malloc(chroma_width * chroma_height)), [](std::uint8_t * ptr){ free(ptr); });
+
+        std::memset(chroma.get(), 128, chroma_width * chroma_height);
+
+        cvpg::image_yuv420_8bit image(m_image.width(),
+                                      m_image.height(),
+                                      cvpg::image_yuv420_8bit::plane_array_type {{ m_image.data(0), chroma, chroma }},
+                                      cvpg::image_yuv420_8bit::stride_array_type {{ m_image.width() + m_image.padding(), chroma_width, chroma_width }},
+                                      cvpg::color_range::full);
+
+        image.set_metadata(m_image.get_metadata());
+
+        this->this_task_result().set_value(std::move(image));
+    }
+
+private:
+    cvpg::image_gray_8bit m_image;
+};
+
+struct convert_rgb_to_yuv420_8bit_task : public boost::asynchronous::continuation_task<cvpg::image_yuv420_8bit>
+{
+    convert_rgb_to_yuv420_8bit_task(cvpg::image_rgb_8bit image)
+        : boost::asynchronous::continuation_task<cvpg::image_yuv420_8bit>("convert_rgb_to_yuv420_8bit")
+        , m_image(std::move(image))
+    {}
+
+    void operator()()
+    {
+        auto metadata = m_image.get_metadata();
+
+        auto tf = cvpg::imageproc::algorithms::tiling_functors::image<cvpg::image_rgb_8bit, cvpg::image_yuv420_8bit>({{ std::move(m_image) }});
+        tf.parameters.image_width = tf.inputs.front().width();
+        tf.parameters.image_height = tf.inputs.front().height();
+        tf.parameters.cutoff_x = 512;
+        tf.parameters.cutoff_y = 512;
+
+        tf.tile_algorithm_task = [](std::shared_ptr<cvpg::image_rgb_8bit> src1, std::shared_ptr<cvpg::image_rgb_8bit> /*src2*/, std::shared_ptr<cvpg::image_yuv420_8bit> dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+        {
+            cvpg::imageproc::algorithms::convert_rgb_to_yuv420_8bit(src1->data(0).get(), src1->data(1).get(), src1->data(2).get(), dst->data(0).get(), dst->data(1).get(), dst->data(2).get(), dst->stride(0), dst->stride(1), from_x, to_x, from_y, to_y, std::move(parameters));
+        };
+
+        boost::asynchronous::create_callback_continuation(
+            [task_result = this->this_task_result(), metadata = std::move(metadata)](auto result) mutable
+            {
+                try
+                {
+                    auto image = std::move(std::get<0>(result).get());
+                    image.set_metadata(std::move(metadata));
+
+                    task_result.set_value(std::move(image));
+                }
+                catch (...)
+                {
+                    task_result.set_exception(std::current_exception());
+                }
+            },
+            cvpg::imageproc::algorithms::tiling(std::move(tf))
+        );
+    }
+
+private:
+    cvpg::image_rgb_8bit m_image;
+};
+
+}
+
+namespace cvpg::imageproc::algorithms {
+
+boost::asynchronous::detail::callback_continuation<image_yuv420_8bit> convert_to_yuv420(image_gray_8bit image)
+{
+    return boost::asynchronous::top_level_callback_continuation<image_yuv420_8bit>(
+               convert_gray_to_yuv420_8bit_task(std::move(image))
+           );
+}
+
+boost::asynchronous::detail::callback_continuation<image_yuv420_8bit> convert_to_yuv420(image_rgb_8bit image)
+{
+    return boost::asynchronous::top_level_callback_continuation<image_yuv420_8bit>(
+               convert_rgb_to_yuv420_8bit_task(std::move(image))
+           );
+}
+
+} // namespace cvpg::imageproc::algoritms
@@ -0,0 +1,20 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_IMAGEPROC_ALGORITHMS_CONVERT_TO_YUV420_HPP
+#define LIBCVPG_IMAGEPROC_ALGORITHMS_CONVERT_TO_YUV420_HPP
+
+#include <boost/asynchronous/continuation_task.hpp>
+
+#include <libcvpg/core/image.hpp>
+
+namespace cvpg::imageproc::algorithms {
+
+// the grayscale image is used as (full range) luma plane without copying ; both chroma planes are neutral
+boost::asynchronous::detail::callback_continuation<image_yuv420_8bit> convert_to_yuv420(image_gray_8bit image);
+
+boost::asynchronous::detail::callback_continuation<image_yuv420_8bit> convert_to_yuv420(image_rgb_8bit image);
+
+} // namespace cvpg::imageproc::algoritms
+
+#endif // LIBCVPG_IMAGEPROC_ALGORITHMS_CONVERT_TO_YUV420_HPP
@@ -0,0 +1,243 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/imageproc/algorithms/gaussian.hpp>
+
+#include <memory>
+#include <vector>
+
+#include <libcvpg/core/exception.hpp>
+#include <libcvpg/imageproc/algorithms/tiling.hpp>
+#include <libcvpg/imageproc/algorithms/tiling/gaussian.hpp>
+
+namespace {
+
+struct gaussian_recursive_task : public boost::asynchronous::continuation_task<cvpg::image_gray_8bit>
+{
+    gaussian_recursive_task(cvpg::image_gray_8bit image, double sigma, cvpg::imageproc::algorithms::border_mode border_mode, std::size_t cutoff_x, std::size_t cutoff_y)
+        : boost::asynchronous::continuation_task<cvpg::image_gray_8bit>("gaussian_recursive_task")
+        , m_image(std::move(image))
+        , m_sigma(sigma)
+        , m_border_mode(border_mode)
+        , m_cutoff_x(cutoff_x)
+        , m_cutoff_y(cutoff_y)
+    {}
+
+    void operator()()
+    {
+        try
+        {
+            const std::uint32_t width = m_image.width();
+            const std::uint32_t height = m_image.height();
+
+            // result of the horizontal pass
+            auto buffer = std::make_shared<std::vector<float> >(static_cast<std::size_t>(width) * height);
+
+            // 1st pass: filter complete lines
+            auto tf = cvpg::imageproc::algorithms::tiling_functors::image<cvpg::image_gray_8bit>({{ m_image }});
+            tf.parameters.image_width = width;
+            tf.parameters.image_height = height;
+            tf.parameters.cutoff_x = width + 1;
+            tf.parameters.cutoff_y = m_cutoff_y;
+            tf.parameters.real_numbers.push_back(m_sigma);
+            tf.parameters.border_mode = m_border_mode;
+
+            tf.tile_algorithm_task = [buffer](std::shared_ptr<cvpg::image_gray_8bit> src1, std::shared_ptr<cvpg::image_gray_8bit> /*src2*/, std::shared_ptr<cvpg::image_gray_8bit> /*dst*/, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+            {
+                cvpg::imageproc::algorithms::gaussian_recursive_horizontal_gray_8bit(src1->data(0).get(), buffer->data(), from_x, to_x, from_y, to_y, std::move(parameters));
+            };
+
+            boost::asynchronous::create_callback_continuation(
+                [result = this->this_task_result(), image = m_image, buffer, sigma = m_sigma, border_mode = m_border_mode, cutoff_x = m_cutoff_x](auto cont_res) mutable
+                {
+                    try
+                    {
+                        // the (not yet filled) output image of the 1st pass is the output image of the 2nd pass
+                        auto output = std::move(std::get<0>(cont_res).get());
+
+                        // 2nd pass: filter complete columns
+                        auto tf = cvpg::imageproc::algorithms::tiling_functors::image<cvpg::image_gray_8bit>({{ image }});
+                        tf.parameters.image_width = image.width();
+                        tf.parameters.image_height = image.height();
+                        tf.parameters.cutoff_x = cutoff_x;
+                        tf.parameters.cutoff_y = image.height() + 1;
+                        tf.parameters.real_numbers.push_back(sigma);
+                        tf.parameters.border_mode = border_mode;
+
+                        tf.create_output = [output](std::uint32_t /*width*/, std::uint32_t /*height*/)
+                        {
+                            return output;
+                        };
+
+                        tf.tile_algorithm_task = [buffer](std::shared_ptr<cvpg::image_gray_8bit> src1, std::shared_ptr<cvpg::image_gray_8bit> /*src2*/, std::shared_ptr<cvpg::image_gray_8bit> dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+                        {
+                            cvpg::imageproc::algorithms::gaussian_recursive_vertical_gray_8bit(buffer->data(), src1->data(0).get(), dst->data(0).get(), from_x, to_x, from_y, to_y, std::move(parameters));
+                        };
+
+                        boost::asynchronous::create_callback_continuation(
+                            [result = std::move(result), buffer](auto cont_res) mutable
+                            {
+                                try
+                                {
+                                    result.set_value(std::move(std::get<0>(cont_res).get()));
+                                }
+                                catch (...)
+                                {
+                                    result.set_exception(std::current_exception());
+                                }
+                            },
+                            cvpg::imageproc::algorithms::tiling(std::move(tf))
+                        );
+                    }
+                    catch (...)
+                    {
+                        result.set_exception(std::current_exception());
+                    }
+                },
+                cvpg::imageproc::algorithms::tiling(std::move(tf))
+            );
+        }
+        catch (...)
+        {
+            this->this_task_result().set_exception(std::current_exception());
+        }
+    }
+
+private:
+    cvpg::image_gray_8bit m_image;
+
+    double m_sigma;
+
+    cvpg::imageproc::algorithms::border_mode m_border_mode;
+
+    std::size_t m_cutoff_x;
+    std::size_t m_cutoff_y;
+};
+
+struct gaussian_rgb_task : public boost::asynchronous::continuation_task<cvpg::image_rgb_8bit>
+{
+    gaussian_rgb_task(cvpg::image_rgb_8bit image, double sigma, cvpg::imageproc::algorithms::border_mode border_mode, cvpg::imageproc::algorithms::gaussian_mode mode, std::size_t cutoff_x, std::size_t cutoff_y)
+        : boost::asynchronous::continuation_task<cvpg::image_rgb_8bit>("gaussian_rgb_task")
+        , m_image(std::move(image))
+        , m_sigma(sigma)
+        , m_border_mode(border_mode)
+        , m_mode(mode)
+        , m_cutoff_x(cutoff_x)
+        , m_cutoff_y(cutoff_y)
+    {}
+
+    void operator()()
+    {
+        try
+        {
+            const auto image_width = m_image.width();
+            const auto image_height = m_image.height();
+            const auto image_padding = m_image.padding();
+
+            // filter all channels independently
+            std::vector<boost::asynchronous::detail::callback_continuation<cvpg::image_gray_8bit> > channels;
+            channels.reserve(3);
+
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                channels.emplace_back(cvpg::imageproc::algorithms::gaussian(cvpg::image_gray_8bit(image_width, image_height, image_padding, { m_image.data(i) }), m_sigma, m_border_mode, m_mode, m_cutoff_x, m_cutoff_y));
+            }
+
+            boost::asynchronous::create_callback_continuation(
+                [result = this->this_task_result(), image_width, image_height, image_padding](auto cont_res) mutable
+                {
+                    try
+                    {
+                        result.set_value(cvpg::image_rgb_8bit(image_width,
+                                                              image_height,
+                                                              image_padding,
+                                                              {
+                                                                  cont_res[0].get().data(0),
+                                                                  cont_res[1].get().data(0),
+                                                                  cont_res[2].get().data(0)
+                                                              }));
+                    }
+                    catch (...)
+                    {
+                        result.set_exception(std::current_exception());
+                    }
+                },
+                std::move(channels)
+            );
+        }
+        catch (...)
+        {
+            this->this_task_result().set_exception(std::current_exception());
+        }
+    }
+
+private:
+    cvpg::image_rgb_8bit m_image;
+
+    double m_sigma;
+
+    cvpg::imageproc::algorithms::border_mode m_border_mode;
+    cvpg::imageproc::algorithms::gaussian_mode m_mode;
+
+    std::size_t m_cutoff_x;
+    std::size_t m_cutoff_y;
+};
+
+}
+
+namespace cvpg::imageproc::algorithms {
+
+gaussian_mode to_gaussian_mode(std::string mode_str)
+{
+    if (mode_str == "auto")
+    {
+        return gaussian_mode::automatic;
+    }
+    else if (mode_str == "kernel")
+    {
+        return gaussian_mode::kernel;
+    }
+    else if (mode_str == "recursive")
+    {
+        return gaussian_mode::recursive;
+    }
+
+    throw cvpg::invalid_parameter_exception("invalid gaussian mode");
+}
+
+boost::asynchronous::detail::callback_continuation<image_gray_8bit> gaussian(image_gray_8bit image, double sigma, cvpg::imageproc::algorithms::border_mode border_mode, gaussian_mode mode, std::size_t cutoff_x, std::size_t cutoff_y)
+{
+    if (mode == gaussian_mode::kernel || (mode == gaussian_mode::automatic && sigma <= gaussian_max_kernel_sigma))
+    {
+        const auto image_width = image.width();
+        const auto image_height = image.height();
+
+        auto tf = cvpg::imageproc::algorithms::tiling_functors::image<cvpg::image_gray_8bit>({{ std::move(image) }});
+        tf.parameters.image_width = image_width;
+        tf.parameters.image_height = image_height;
+        tf.parameters.cutoff_x = cutoff_x;
+        tf.parameters.cutoff_y = cutoff_y;
+        tf.parameters.real_numbers.push_back(sigma);
+        tf.parameters.border_mode = border_mode;
+
+        tf.tile_algorithm_task = [](std::shared_ptr<cvpg::image_gray_8bit> src1, std::shared_ptr<cvpg::image_gray_8bit> /*src2*/, std::shared_ptr<cvpg::image_gray_8bit> dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+        {
+            cvpg::imageproc::algorithms::gaussian_gray_8bit(src1->data(0).get(), dst->data(0).get(), from_x, to_x, from_y, to_y, std::move(parameters));
+        };
+
+        return cvpg::imageproc::algorithms::tiling(std::move(tf));
+    }
+
+    return boost::asynchronous::top_level_callback_continuation<image_gray_8bit>(
+               gaussian_recursive_task(std::move(image), sigma, border_mode, cutoff_x, cutoff_y)
+           );
+}
+
+boost::asynchronous::detail::callback_continuation<image_rgb_8bit> gaussian(image_rgb_8bit image, double sigma, cvpg::imageproc::algorithms::border_mode border_mode, gaussian_mode mode, std::size_t cutoff_x, std::size_t cutoff_y)
+{
+    return boost::asynchronous::top_level_callback_continuation<image_rgb_8bit>(
+               gaussian_rgb_task(std::move(image), sigma, border_mode, mode, cutoff_x, cutoff_y)
+           );
+}
+
+} // namespace cvpg::imageproc::algorithms
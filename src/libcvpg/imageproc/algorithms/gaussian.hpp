@@ -0,0 +1,52 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_IMAGEPROC_ALGORITHMS_GAUSSIAN_HPP
+#define LIBCVPG_IMAGEPROC_ALGORITHMS_GAUSSIAN_HPP
+
+#include <string>
+
+#include <boost/asynchronous/continuation_task.hpp>
+
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/imageproc/algorithms/border_mode.hpp>
+
+namespace cvpg::imageproc::algorithms {
+
+enum class gaussian_mode
+{
+    automatic,  // integer kernel for small standard deviations, recursive filter otherwise
+    kernel,     // separable integer kernel ; costs grow with the standard deviation
+    recursive   // recursive filter (Young/van Vliet) ; costs independent of the standard deviation
+};
+
+gaussian_mode to_gaussian_mode(std::string mode_str);
+
+//
+// Largest standard deviation that is filtered with an integer kernel if the mode 'automatic' is used.
+//
+constexpr double gaussian_max_kernel_sigma = 3.0;
+
+//
+// Gaussian filter with standard deviation 'sigma'.
+//
+// The recursive filter needs two passes over the image. The 1st pass filters complete lines, the 2nd pass
+// complete columns. So the cutoffs are only used for the direction not affected by the current pass.
+//
+boost::asynchronous::detail::callback_continuation<image_gray_8bit> gaussian(image_gray_8bit image,
+                                                                             double sigma,
+                                                                             cvpg::imageproc::algorithms::border_mode border_mode = cvpg::imageproc::algorithms::border_mode::constant,
+                                                                             gaussian_mode mode = gaussian_mode::automatic,
+                                                                             std::size_t cutoff_x = 512,
+                                                                             std::size_t cutoff_y = 512);
+
+boost::asynchronous::detail::callback_continuation<image_rgb_8bit> gaussian(image_rgb_8bit image,
+                                                                            double sigma,
+                                                                            cvpg::imageproc::algorithms::border_mode border_mode = cvpg::imageproc::algorithms::border_mode::constant,
+                                                                            gaussian_mode mode = gaussian_mode::automatic,
+                                                                            std::size_t cutoff_x = 512,
+                                                                            std::size_t cutoff_y = 512);
+
+} // namespace cvpg::imageproc::algorithms
+
+#endif // LIBCVPG_IMAGEPROC_ALGORITHMS_GAUSSIAN_HPP
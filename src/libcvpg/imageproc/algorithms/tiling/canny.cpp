@@ -0,0 +1,219 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/imageproc/algorithms/tiling/canny.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// quantized gradient directions ; the neighbours compared by the non-maximum suppression are perpendicular to the edge
+enum direction : std::uint8_t
+{
+    direction_horizontal = 0,   // compare left and right neighbour
+    direction_vertical = 1,     // compare upper and lower neighbour
+    direction_falling = 2,      // compare upper left and lower right neighbour
+    direction_rising = 3        // compare upper right and lower left neighbour
+};
+
+//
+// Copy the region [from_x, to_x] x [from_y, to_y] (which can exceed the image) to a dense buffer. Pixels
+// outside of the image are replicated from the nearest border pixel.
+//
+void load_region(std::uint8_t const * src, std::int32_t image_width, std::int32_t image_height, std::int32_t from_x, std::int32_t to_x, std::int32_t from_y, std::int32_t to_y, std::uint8_t * region)
+{
+    const std::int32_t region_width = to_x - from_x + 1;
+
+    for (std::int32_t y = from_y; y <= to_y; ++y, region += region_width)
+    {
+        std::uint8_t const * src_line = src + static_cast<std::size_t>(image_width) * std::clamp(y, 0, image_height - 1);
+
+        if (from_x >= 0 && to_x < image_width)
+        {
+            std::memcpy(region, src_line + from_x, region_width);
+
+            continue;
+        }
+
+        for (std::int32_t x = from_x; x <= to_x; ++x)
+        {
+            region[x - from_x] = src_line[std::clamp(x, 0, image_width - 1)];
+        }
+    }
+}
+
+//
+// Sobel gradients of a line, their squared magnitudes and quantized directions.
+//
+void gradient_line(std::uint8_t const * line_m1, std::uint8_t const * line, std::uint8_t const * line_p1, std::int32_t * magnitudes, std::uint8_t * directions, std::int32_t width)
+{
+    for (std::int32_t x = 0; x < width; ++x)
+    {
+        // 'x' is the left neighbour of the current pixel
+        const std::int32_t gx = (line_m1[x + 2] - line_m1[x]) + 2 * (line[x + 2] - line[x]) + (line_p1[x + 2] - line_p1[x]);
+        const std::int32_t gy = (line_p1[x] - line_m1[x]) + 2 * (line_p1[x + 1] - line_m1[x + 1]) + (line_p1[x + 2] - line_m1[x + 2]);
+
+        magnitudes[x] = gx * gx + gy * gy;
+
+        // sectors of 45 degrees around the axes and diagonals ; tan(22.5) ~ 0.4142 and tan(67.5) ~ 2.4142
+        const std::int32_t ax = std::abs(gx);
+        const std::int32_t ay = std::abs(gy);
+
+        // image coordinates grow downwards, so gradients with equal signs point to the lower right
+        const std::uint8_t diagonal = ((gx ^ gy) >= 0) ? direction_falling : direction_rising;
+
+        // written without branches, so the loop can be vectorized
+        const std::uint8_t d = (ay * 10000 <= ax * 4142) ? direction_horizontal : ((ay * 10000 >= ax * 24142) ? direction_vertical : diagonal);
+
+        directions[x] = d;
+    }
+}
+
+}
+
+namespace cvpg::imageproc::algorithms {
+
+void canny_gradient_gray_8bit(std::uint8_t * src, std::uint8_t * dst, std::atomic<std::uint8_t> * states, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+{
+    const std::int32_t image_width = static_cast<std::int32_t>(parameters.image_width);
+    const std::int32_t image_height = static_cast<std::int32_t>(parameters.image_height);
+
+    const std::int32_t from_x_ = static_cast<std::int32_t>(from_x);
+    const std::int32_t to_x_ = static_cast<std::int32_t>(to_x);
+    const std::int32_t from_y_ = static_cast<std::int32_t>(from_y);
+    const std::int32_t to_y_ = static_cast<std::int32_t>(to_y);
+
+    // compare squared magnitudes to avoid the square root
+    const std::int32_t low = parameters.signed_integer_numbers.at(0);
+    const std::int32_t high = parameters.signed_integer_numbers.at(1);
+
+    const std::int32_t low_squared = low * low;
+    const std::int32_t high_squared = high * high;
+
+    const std::int32_t width = to_x_ - from_x_ + 1;
+    const std::int32_t height = to_y_ - from_y_ + 1;
+
+    // the gradients are needed for the tile plus a halo of one pixel, the source pixels for a halo of two pixels
+    const std::int32_t gradient_width = width + 2;
+    const std::int32_t gradient_height = height + 2;
+
+    const std::int32_t region_width = width + 4;
+    const std::int32_t region_height = height + 4;
+
+    std::vector<std::uint8_t> region(static_cast<std::size_t>(region_width) * region_height);
+
+    load_region(src, image_width, image_height, from_x_ - 2, to_x_ + 2, from_y_ - 2, to_y_ + 2, region.data());
+
+    std::vector<std::int32_t> magnitudes(static_cast<std::size_t>(gradient_width) * gradient_height);
+    std::vector<std::uint8_t> directions(static_cast<std::size_t>(gradient_width) * gradient_height);
+
+    for (std::int32_t y = 0; y < gradient_height; ++y)
+    {
+        std::uint8_t const * line_m1 = region.data() + static_cast<std::size_t>(region_width) * y;
+
+        gradient_line(line_m1,
+                      line_m1 + region_width,
+                      line_m1 + 2 * region_width,
+                      magnitudes.data() + static_cast<std::size_t>(gradient_width) * y,
+                      directions.data() + static_cast<std::size_t>(gradient_width) * y,
+                      gradient_width);
+    }
+
+    // the neighbours to compare with are at offsets -offset and +offset
+    const std::int32_t offsets[4] =
+    {
+        1,                      // horizontal
+        gradient_width,         // vertical
+        gradient_width + 1,     // falling
+        gradient_width - 1      // rising
+    };
+
+    for (std::int32_t y = 0; y < height; ++y)
+    {
+        const std::size_t offset_y = static_cast<std::size_t>(image_width) * (from_y_ + y) + from_x_;
+
+        std::uint8_t * dst_line = dst + offset_y;
+        std::atomic<std::uint8_t> * states_line = states + offset_y;
+
+        std::int32_t const * magnitude = magnitudes.data() + static_cast<std::size_t>(gradient_width) * (y + 1) + 1;
+        std::uint8_t const * direction = directions.data() + static_cast<std::size_t>(gradient_width) * (y + 1) + 1;
+
+        for (std::int32_t x = 0; x < width; ++x)
+        {
+            const std::int32_t m = magnitude[x];
+
+            std::uint8_t state = canny_none;
+
+            if (m > low_squared)
+            {
+                const std::int32_t offset = offsets[direction[x]];
+
+                // the asymmetric comparison keeps exactly one pixel of a plateau of two equal magnitudes
+                if (m >= magnitude[x - offset] && m > magnitude[x + offset])
+                {
+                    state = m > high_squared ? canny_strong : canny_weak;
+                }
+            }
+
+            states_line[x].store(state, std::memory_order_relaxed);
+
+            dst_line[x] = state == canny_strong ? 255 : 0;
+        }
+    }
+}
+
+void canny_hysteresis_gray_8bit(std::uint8_t * dst, std::atomic<std::uint8_t> * states, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+{
+    const std::int32_t image_width = static_cast<std::int32_t>(parameters.image_width);
+    const std::int32_t image_height = static_cast<std::int32_t>(parameters.image_height);
+
+    // pixels whose neighbours have to be visited
+    std::vector<std::uint32_t> pending;
+
+    for (std::size_t y = from_y; y <= to_y; ++y)
+    {
+        const std::size_t offset_y = static_cast<std::size_t>(image_width) * y;
+
+        for (std::size_t x = from_x; x <= to_x; ++x)
+        {
+            if (states[offset_y + x].load(std::memory_order_relaxed) != canny_strong)
+            {
+                continue;
+            }
+
+            pending.push_back(static_cast<std::uint32_t>(offset_y + x));
+
+            while (!pending.empty())
+            {
+                const std::uint32_t index = pending.back();
+                pending.pop_back();
+
+                const std::int32_t px = static_cast<std::int32_t>(index % image_width);
+                const std::int32_t py = static_cast<std::int32_t>(index / image_width);
+
+                for (std::int32_t ny = std::max(py - 1, 0); ny <= std::min(py + 1, image_height - 1); ++ny)
+                {
+                    for (std::int32_t nx = std::max(px - 1, 0); nx <= std::min(px + 1, image_width - 1); ++nx)
+                    {
+                        const std::uint32_t neighbour = static_cast<std::uint32_t>(ny) * image_width + nx;
+
+                        // claim the weak pixel ; fails if it isn't weak or another tile claimed it in the meantime
+                        std::uint8_t expected = canny_weak;
+
+                        if (states[neighbour].compare_exchange_strong(expected, canny_followed, std::memory_order_relaxed))
+                        {
+                            dst[neighbour] = 255;
+
+                            pending.push_back(neighbour);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace cvpg::imageproc::algorithms
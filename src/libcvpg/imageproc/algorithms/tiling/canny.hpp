@@ -0,0 +1,49 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_IMAGEPROC_ALGORITHMS_TILING_CANNY_HPP
+#define LIBCVPG_IMAGEPROC_ALGORITHMS_TILING_CANNY_HPP
+
+#include <atomic>
+#include <cstdint>
+
+#include <libcvpg/imageproc/algorithms/tiling/parameters.hpp>
+
+namespace cvpg::imageproc::algorithms {
+
+// state of a pixel after the non-maximum suppression
+enum canny_state : std::uint8_t
+{
+    canny_none = 0,
+    canny_weak = 1,
+    canny_strong = 2,
+
+    // weak pixel reached by the hysteresis ; not used as start of another edge following
+    canny_followed = 3
+};
+
+//
+// 1st pass of the Canny edge detector. The low and high thresholds of the gradient magnitude are expected
+// as signed integer numbers 0 and 1 of the tiling parameters.
+//
+// Gradients (Sobel 3x3), magnitudes and quantized directions are calculated in a single pass over the tile
+// plus a halo of one pixel, followed by the non-maximum suppression of the tile. So no gradients have to
+// be exchanged between tiles. Pixels outside of the image are replicated from the nearest border pixel.
+//
+// The state of each pixel is stored at 'states' (of image size). Strong pixels are set to 255 at 'dst',
+// all others to 0.
+//
+void canny_gradient_gray_8bit(std::uint8_t * src, std::uint8_t * dst, std::atomic<std::uint8_t> * states, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters);
+
+//
+// 2nd pass of the Canny edge detector (hysteresis). Edges are followed from all strong pixels of the tile
+// into weak 8-connected neighbours, even across the borders of the tile. Each weak pixel is claimed by an
+// atomic state change to 'canny_followed', so tiles can be processed in parallel. Only the strong pixels
+// of the 1st pass start a following, so the neighbours of every edge pixel are visited exactly once.
+// Claimed pixels are set to 255 at 'dst'.
+//
+void canny_hysteresis_gray_8bit(std::uint8_t * dst, std::atomic<std::uint8_t> * states, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters);
+
+} // namespace cvpg::imageproc::algorithms
+
+#endif // LIBCVPG_IMAGEPROC_ALGORITHMS_TILING_CANNY_HPP
@@ -0,0 +1,129 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/imageproc/algorithms/tiling/convert_yuv420.hpp>
+
+#include <algorithm>
+
+namespace {
+
+inline std::uint8_t clamp_8bit(std::int32_t v)
+{
+    return static_cast<std::uint8_t>(std::clamp(v, 0, 255));
+}
+
+}
+
+namespace cvpg::imageproc::algorithms {
+
+void convert_yuv420_to_rgb_8bit(std::uint8_t * src_y, std::uint8_t * src_u, std::uint8_t * src_v, std::size_t stride_y, std::size_t stride_uv, cvpg::color_range range, std::uint8_t * dst_r, std::uint8_t * dst_g, std::uint8_t * dst_b, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+{
+    const std::size_t image_width = parameters.image_width;
+
+    // fixed point coefficients scaled by 256 ; the full range omits the expansion of luma and uses the
+    // unscaled chroma coefficients
+    const bool full = range == cvpg::color_range::full;
+
+    const std::int32_t y_scale = full ? 256 : 298;
+    const std::int32_t y_offset = full ? 0 : 16;
+    const std::int32_t rv = full ? 359 : 409;
+    const std::int32_t gu = full ? 88 : 100;
+    const std::int32_t gv = full ? 183 : 208;
+    const std::int32_t bu = full ? 454 : 516;
+
+    for (std::size_t y = from_y; y <= to_y; ++y)
+    {
+        const std::size_t offset_y = image_width * y;
+
+        std::uint8_t const * y_line = src_y + stride_y * y;
+        std::uint8_t const * u_line = src_u + stride_uv * (y / 2);
+        std::uint8_t const * v_line = src_v + stride_uv * (y / 2);
+
+        std::uint8_t * r_line = dst_r + offset_y;
+        std::uint8_t * g_line = dst_g + offset_y;
+        std::uint8_t * b_line = dst_b + offset_y;
+
+        for (std::size_t x = from_x; x <= to_x; ++x)
+        {
+            const std::int32_t c = y_scale * (static_cast<std::int32_t>(y_line[x]) - y_offset) + 128;
+            const std::int32_t d = static_cast<std::int32_t>(u_line[x / 2]) - 128;
+            const std::int32_t e = static_cast<std::int32_t>(v_line[x / 2]) - 128;
+
+            r_line[x] = clamp_8bit((c + rv * e) >> 8);
+            g_line[x] = clamp_8bit((c - gu * d - gv * e) >> 8);
+            b_line[x] = clamp_8bit((c + bu * d) >> 8);
+        }
+    }
+}
+
+void expand_luma_8bit(std::uint8_t * src_y, std::size_t stride_y, std::uint8_t * dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+{
+    const std::size_t image_width = parameters.image_width;
+
+    for (std::size_t y = from_y; y <= to_y; ++y)
+    {
+        std::uint8_t const * y_line = src_y + stride_y * y;
+        std::uint8_t * dst_line = dst + image_width * y;
+
+        for (std::size_t x = from_x; x <= to_x; ++x)
+        {
+            dst_line[x] = clamp_8bit((298 * (static_cast<std::int32_t>(y_line[x]) - 16) + 128) >> 8);
+        }
+    }
+}
+
+void convert_rgb_to_yuv420_8bit(std::uint8_t * src_r, std::uint8_t * src_g, std::uint8_t * src_b, std::uint8_t * dst_y, std::uint8_t * dst_u, std::uint8_t * dst_v, std::size_t stride_y, std::size_t stride_uv, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+{
+    const std::size_t image_width = parameters.image_width;
+    const std::size_t image_height = parameters.image_height;
+
+    // luma
+    for (std::size_t y = from_y; y <= to_y; ++y)
+    {
+        const std::size_t offset_y = image_width * y;
+
+        std::uint8_t const * r_line = src_r + offset_y;
+        std::uint8_t const * g_line = src_g + offset_y;
+        std::uint8_t const * b_line = src_b + offset_y;
+
+        std::uint8_t * y_line = dst_y + stride_y * y;
+
+        for (std::size_t x = from_x; x <= to_x; ++x)
+        {
+            y_line[x] = static_cast<std::uint8_t>(((66 * r_line[x] + 129 * g_line[x] + 25 * b_line[x] + 128) >> 8) + 16);
+        }
+    }
+
+    // chroma of all 2x2 blocks starting inside of the tile ; a block at the right or lower border can be a single column or line
+    const std::size_t first_x = (from_x + 1) & ~static_cast<std::size_t>(1);
+    const std::size_t first_y = (from_y + 1) & ~static_cast<std::size_t>(1);
+
+    for (std::size_t y = first_y; y <= to_y; y += 2)
+    {
+        const std::size_t y1 = std::min(y + 1, image_height - 1);
+
+        std::uint8_t const * r_line0 = src_r + image_width * y;
+        std::uint8_t const * g_line0 = src_g + image_width * y;
+        std::uint8_t const * b_line0 = src_b + image_width * y;
+        std::uint8_t const * r_line1 = src_r + image_width * y1;
+        std::uint8_t const * g_line1 = src_g + image_width * y1;
+        std::uint8_t const * b_line1 = src_b + image_width * y1;
+
+        std::uint8_t * u_line = dst_u + stride_uv * (y / 2);
+        std::uint8_t * v_line = dst_v + stride_uv * (y / 2);
+
+        for (std::size_t x = first_x; x <= to_x; x += 2)
+        {
+            const std::size_t x1 = std::min(x + 1, image_width - 1);
+
+            const std::int32_t r = (r_line0[x] + r_line0[x1] + r_line1[x] + r_line1[x1] + 2) >> 2;
+            const std::int32_t g = (g_line0[x] + g_line0[x1] + g_line1[x] + g_line1[x1] + 2) >> 2;
+            const std::int32_t b = (b_line0[x] + b_line0[x1] + b_line1[x] + b_line1[x1] + 2) >> 2;
+
+            u_line[x / 2] = clamp_8bit(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            v_line[x / 2] = clamp_8bit(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+    }
+}
+
+} // namespace cvpg::imageproc::algorithms
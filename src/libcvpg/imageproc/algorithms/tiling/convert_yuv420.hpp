@@ -0,0 +1,37 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_IMAGEPROC_ALGORITHMS_TILING_CONVERT_YUV420_HPP
+#define LIBCVPG_IMAGEPROC_ALGORITHMS_TILING_CONVERT_YUV420_HPP
+
+#include <cstdint>
+
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/imageproc/algorithms/tiling/parameters.hpp>
+
+namespace cvpg::imageproc::algorithms {
+
+//
+// Convert the YUV 4:2:0 planes (BT.601) of a tile to RGB. The coefficients are chosen by the color range
+// of the planes. The lines of the luma plane are 'stride_y' pixels apart, the lines of both chroma planes
+// 'stride_uv' pixels. The RGB planes are expected without padding.
+//
+void convert_yuv420_to_rgb_8bit(std::uint8_t * src_y, std::uint8_t * src_u, std::uint8_t * src_v, std::size_t stride_y, std::size_t stride_uv, cvpg::color_range range, std::uint8_t * dst_r, std::uint8_t * dst_g, std::uint8_t * dst_b, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters);
+
+//
+// Convert the luma plane of a tile in the limited range to a full range grayscale image. The result is the
+// same as the RGB channels of a pixel without chroma converted by 'convert_yuv420_to_rgb_8bit'. The lines
+// of the luma plane are 'stride_y' pixels apart, the grayscale image is expected without padding.
+//
+void expand_luma_8bit(std::uint8_t * src_y, std::size_t stride_y, std::uint8_t * dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters);
+
+//
+// Convert the RGB planes of a tile to YUV 4:2:0 (BT.601, limited range). The chroma values are
+// calculated from the average of 2x2 pixels. A tile writes the chroma values whose upper left pixel
+// is part of the tile, so tiles never write the same chroma values.
+//
+void convert_rgb_to_yuv420_8bit(std::uint8_t * src_r, std::uint8_t * src_g, std::uint8_t * src_b, std::uint8_t * dst_y, std::uint8_t * dst_u, std::uint8_t * dst_v, std::size_t stride_y, std::size_t stride_uv, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters);
+
+} // namespace cvpg::imageproc::algorithms
+
+#endif // LIBCVPG_IMAGEPROC_ALGORITHMS_TILING_CONVERT_YUV420_HPP
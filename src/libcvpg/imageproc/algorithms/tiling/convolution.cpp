@@ -0,0 +1,662 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/imageproc/algorithms/tiling/convolution.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+
+#include <libcvpg/core/exception.hpp>
+
+namespace {
+
+inline std::int32_t wrap_around(std::int32_t value, std::int32_t size)
+{
+    const std::int32_t result = value % size;
+
+    return result < 0 ? result + size : result;
+}
+
+//
+// Copy the region [from_x, to_x] x [from_y, to_y] (which can exceed the image) to a dense buffer. Pixels
+// outside of the image are 0 for the border mode 'constant' and wrapped around for the border mode 'mirror'.
+//
+void load_region(std::uint8_t const * src, std::int32_t image_width, std::int32_t image_height, std::int32_t from_x, std::int32_t to_x, std::int32_t from_y, std::int32_t to_y, cvpg::imageproc::algorithms::border_mode border_mode, std::uint8_t * region)
+{
+    const std::int32_t region_width = to_x - from_x + 1;
+
+    const bool mirror = border_mode == cvpg::imageproc::algorithms::border_mode::mirror;
+
+    for (std::int32_t y = from_y; y <= to_y; ++y, region += region_width)
+    {
+        std::int32_t src_y = y;
+
+        if (y < 0 || y >= image_height)
+        {
+            if (!mirror)
+            {
+                std::memset(region, 0, region_width);
+
+                continue;
+            }
+
+            src_y = wrap_around(y, image_height);
+        }
+
+        std::uint8_t const * src_line = src + static_cast<std::size_t>(image_width) * src_y;
+
+        if (from_x >= 0 && to_x < image_width)
+        {
+            std::memcpy(region, src_line + from_x, region_width);
+
+            continue;
+        }
+
+        for (std::int32_t x = from_x; x <= to_x; ++x)
+        {
+            if (x >= 0 && x < image_width)
+            {
+                region[x - from_x] = src_line[x];
+            }
+            else
+            {
+                region[x - from_x] = mirror ? src_line[wrap_around(x, image_width)] : 0;
+            }
+        }
+    }
+}
+
+//
+// Set all pixels of a tile with a distance of less than 'half_width' / 'half_height' to the image border
+// to 0.
+//
+void clear_border(std::uint8_t * dst, std::int32_t image_width, std::int32_t image_height, std::int32_t from_x, std::int32_t to_x, std::int32_t from_y, std::int32_t to_y, std::int32_t half_width, std::int32_t half_height)
+{
+    for (std::int32_t y = from_y; y <= to_y; ++y)
+    {
+        std::uint8_t * dst_line = dst + static_cast<std::size_t>(image_width) * y;
+
+        if (y < half_height || y >= image_height - half_height)
+        {
+            std::memset(dst_line + from_x, 0, to_x - from_x + 1);
+
+            continue;
+        }
+
+        for (std::int32_t x = from_x; x <= std::min(to_x, half_width - 1); ++x)
+        {
+            dst_line[x] = 0;
+        }
+
+        for (std::int32_t x = std::max(from_x, image_width - half_width); x <= to_x; ++x)
+        {
+            dst_line[x] = 0;
+        }
+    }
+}
+
+//
+// dst[x] (+)= sum(coefficients[k] * src[x + k]) with k = [0, size)
+//
+// Specializations for a fixed size let the compiler unroll the inner loop completely and vectorize over 'x'.
+// The size 0 is used for all other sizes.
+//
+template<class Src, class Acc, std::int32_t Size>
+struct line_correlation
+{
+    template<bool Accumulate>
+    static void apply(Src const * src, Acc const * coefficients, std::int32_t /*size*/, Acc * dst, std::int32_t width)
+    {
+        Acc c[Size];
+
+        std::copy(coefficients, coefficients + Size, c);
+
+        for (std::int32_t x = 0; x < width; ++x)
+        {
+            Acc sum = Accumulate ? dst[x] : Acc(0);
+
+            for (std::int32_t k = 0; k < Size; ++k)
+            {
+                sum += c[k] * static_cast<Acc>(src[x + k]);
+            }
+
+            dst[x] = sum;
+        }
+    }
+};
+
+template<class Src, class Acc>
+struct line_correlation<Src, Acc, 0>
+{
+    template<bool Accumulate>
+    static void apply(Src const * src, Acc const * coefficients, std::int32_t size, Acc * dst, std::int32_t width)
+    {
+        if (!Accumulate)
+        {
+            std::fill(dst, dst + width, Acc(0));
+        }
+
+        for (std::int32_t k = 0; k < size; ++k)
+        {
+            const Acc c = coefficients[k];
+
+            if (c == Acc(0))
+            {
+                continue;
+            }
+
+            Src const * s = src + k;
+
+            for (std::int32_t x = 0; x < width; ++x)
+            {
+                dst[x] += c * static_cast<Acc>(s[x]);
+            }
+        }
+    }
+};
+
+template<class Src, class Acc, bool Accumulate>
+void correlate_line(Src const * src, Acc const * coefficients, std::int32_t size, Acc * dst, std::int32_t width)
+{
+    switch (size)
+    {
+        case 3:
+            line_correlation<Src, Acc, 3>::template apply<Accumulate>(src, coefficients, size, dst, width);
+            break;
+
+        case 5:
+            line_correlation<Src, Acc, 5>::template apply<Accumulate>(src, coefficients, size, dst, width);
+            break;
+
+        case 7:
+            line_correlation<Src, Acc, 7>::template apply<Accumulate>(src, coefficients, size, dst, width);
+            break;
+
+        default:
+            line_correlation<Src, Acc, 0>::template apply<Accumulate>(src, coefficients, size, dst, width);
+            break;
+    }
+}
+
+//
+// dst[x] = sum(coefficients[k] * lines[k][x]) with k = [0, size)
+//
+template<class Acc, std::int32_t Size>
+struct column_correlation
+{
+    static void apply(Acc const * const * lines, Acc const * coefficients, std::int32_t /*size*/, Acc * dst, std::int32_t width)
+    {
+        Acc c[Size];
+        Acc const * l[Size];
+
+        std::copy(coefficients, coefficients + Size, c);
+        std::copy(lines, lines + Size, l);
+
+        for (std::int32_t x = 0; x < width; ++x)
+        {
+            Acc sum = Acc(0);
+
+            for (std::int32_t k = 0; k < Size; ++k)
+            {
+                sum += c[k] * l[k][x];
+            }
+
+            dst[x] = sum;
+        }
+    }
+};
+
+template<class Acc>
+struct column_correlation<Acc, 0>
+{
+    static void apply(Acc const * const * lines, Acc const * coefficients, std::int32_t size, Acc * dst, std::int32_t width)
+    {
+        std::fill(dst, dst + width, Acc(0));
+
+        for (std::int32_t k = 0; k < size; ++k)
+        {
+            const Acc c = coefficients[k];
+
+            if (c == Acc(0))
+            {
+                continue;
+            }
+
+            Acc const * line = lines[k];
+
+            for (std::int32_t x = 0; x < width; ++x)
+            {
+                dst[x] += c * line[x];
+            }
+        }
+    }
+};
+
+template<class Acc>
+void correlate_lines(Acc const * const * lines, Acc const * coefficients, std::int32_t size, Acc * dst, std::int32_t width)
+{
+    switch (size)
+    {
+        case 3:
+            column_correlation<Acc, 3>::apply(lines, coefficients, size, dst, width);
+            break;
+
+        case 5:
+            column_correlation<Acc, 5>::apply(lines, coefficients, size, dst, width);
+            break;
+
+        case 7:
+            column_correlation<Acc, 7>::apply(lines, coefficients, size, dst, width);
+            break;
+
+        default:
+            column_correlation<Acc, 0>::apply(lines, coefficients, size, dst, width);
+            break;
+    }
+}
+
+template<class Acc>
+std::vector<Acc> to_coefficients(std::vector<double> const & values)
+{
+    std::vector<Acc> result(values.size());
+
+    std::transform(values.begin(), values.end(), result.begin(),
+                   [](double value)
+                   {
+                       if constexpr (std::is_integral_v<Acc>)
+                       {
+                           return static_cast<Acc>(std::lround(value));
+                       }
+                       else
+                       {
+                           return static_cast<Acc>(value);
+                       }
+                   });
+
+    return result;
+}
+
+//
+// Applies a kernel to a padded region, line by line. The lines have to be requested in increasing order,
+// because separable kernels keep the last 'height' horizontally filtered lines in a ring buffer.
+//
+template<class Acc>
+class tile_filter
+{
+public:
+    tile_filter(cvpg::imageproc::algorithms::convolution_kernel const & kernel, std::uint8_t const * region, std::int32_t region_width, std::int32_t width)
+        : m_kernel_width(kernel.width)
+        , m_kernel_height(kernel.height)
+        , m_separable(!kernel.horizontal.empty())
+        , m_region(region)
+        , m_region_width(region_width)
+        , m_width(width)
+    {
+        if (m_separable)
+        {
+            m_horizontal = to_coefficients<Acc>(kernel.horizontal);
+            m_vertical = to_coefficients<Acc>(kernel.vertical);
+
+            m_lines.resize(static_cast<std::size_t>(m_kernel_height) * m_width);
+            m_line_pointers.resize(m_kernel_height);
+        }
+        else
+        {
+            m_coefficients = to_coefficients<Acc>(kernel.coefficients);
+        }
+    }
+
+    void response(std::int32_t y, Acc * dst)
+    {
+        if (m_separable)
+        {
+            // horizontal pass for all region lines not filtered yet
+            for (; m_next_line < y + m_kernel_height; ++m_next_line)
+            {
+                correlate_line<std::uint8_t, Acc, false>(m_region + static_cast<std::size_t>(m_region_width) * m_next_line,
+                                                         m_horizontal.data(),
+                                                         m_kernel_width,
+                                                         m_lines.data() + static_cast<std::size_t>(m_next_line % m_kernel_height) * m_width,
+                                                         m_width);
+            }
+
+            // vertical pass
+            for (std::int32_t k = 0; k < m_kernel_height; ++k)
+            {
+                m_line_pointers[k] = m_lines.data() + static_cast<std::size_t>((y + k) % m_kernel_height) * m_width;
+            }
+
+            correlate_lines<Acc>(m_line_pointers.data(), m_vertical.data(), m_kernel_height, dst, m_width);
+        }
+        else
+        {
+            for (std::int32_t k = 0; k < m_kernel_height; ++k)
+            {
+                std::uint8_t const * line = m_region + static_cast<std::size_t>(m_region_width) * (y + k);
+                Acc const * coefficients = m_coefficients.data() + static_cast<std::size_t>(m_kernel_width) * k;
+
+                if (k == 0)
+                {
+                    correlate_line<std::uint8_t, Acc, false>(line, coefficients, m_kernel_width, dst, m_width);
+                }
+                else
+                {
+                    correlate_line<std::uint8_t, Acc, true>(line, coefficients, m_kernel_width, dst, m_width);
+                }
+            }
+        }
+    }
+
+private:
+    std::int32_t m_kernel_width;
+    std::int32_t m_kernel_height;
+
+    bool m_separable;
+
+    std::vector<Acc> m_coefficients;
+    std::vector<Acc> m_horizontal;
+    std::vector<Acc> m_vertical;
+
+    std::uint8_t const * m_region;
+    std::int32_t m_region_width;
+
+    std::int32_t m_width;
+
+    // ring buffer of horizontally filtered lines
+    std::vector<Acc> m_lines;
+    std::vector<Acc const *> m_line_pointers;
+    std::int32_t m_next_line = 0;
+};
+
+inline void to_gray_8bit(std::int32_t const * src, std::uint8_t * dst, std::int32_t width)
+{
+    for (std::int32_t x = 0; x < width; ++x)
+    {
+        dst[x] = static_cast<std::uint8_t>(std::clamp(src[x], 0, 255));
+    }
+}
+
+inline void to_gray_8bit(float const * src, std::uint8_t * dst, std::int32_t width)
+{
+    for (std::int32_t x = 0; x < width; ++x)
+    {
+        dst[x] = static_cast<std::uint8_t>(std::clamp(src[x], 0.0f, 255.0f) + 0.5f);
+    }
+}
+
+//
+// Tile of an image including the border needed by the kernels, copied to a dense buffer.
+//
+struct padded_tile
+{
+    std::int32_t from_x;
+    std::int32_t to_x;
+    std::int32_t from_y;
+    std::int32_t to_y;
+
+    std::int32_t padding_x;
+    std::int32_t padding_y;
+
+    std::int32_t region_width;
+
+    std::vector<std::uint8_t> region;
+
+    bool empty() const
+    {
+        return from_x > to_x || from_y > to_y;
+    }
+
+    // begin of the region needed by a kernel of the given size
+    std::uint8_t const * origin(std::int32_t kernel_width, std::int32_t kernel_height) const
+    {
+        return region.data() + static_cast<std::size_t>(region_width) * (padding_y - kernel_height / 2) + (padding_x - kernel_width / 2);
+    }
+};
+
+padded_tile load_tile(std::uint8_t const * src, std::uint8_t * dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters const & parameters, std::int32_t padding_x, std::int32_t padding_y)
+{
+    const std::int32_t image_width = static_cast<std::int32_t>(parameters.image_width);
+    const std::int32_t image_height = static_cast<std::int32_t>(parameters.image_height);
+
+    padded_tile tile;
+    tile.from_x = static_cast<std::int32_t>(from_x);
+    tile.to_x = static_cast<std::int32_t>(to_x);
+    tile.from_y = static_cast<std::int32_t>(from_y);
+    tile.to_y = static_cast<std::int32_t>(to_y);
+    tile.padding_x = padding_x;
+    tile.padding_y = padding_y;
+
+    if (parameters.border_mode == cvpg::imageproc::algorithms::border_mode::ignore)
+    {
+        clear_border(dst, image_width, image_height, tile.from_x, tile.to_x, tile.from_y, tile.to_y, padding_x, padding_y);
+
+        // only calculate pixels whose neighbourhood is completely inside of the image
+        tile.from_x = std::max(tile.from_x, padding_x);
+        tile.to_x = std::min(tile.to_x, image_width - padding_x - 1);
+        tile.from_y = std::max(tile.from_y, padding_y);
+        tile.to_y = std::min(tile.to_y, image_height - padding_y - 1);
+    }
+
+    if (tile.empty())
+    {
+        return tile;
+    }
+
+    tile.region_width = tile.to_x - tile.from_x + 1 + 2 * padding_x;
+
+    const std::int32_t region_height = tile.to_y - tile.from_y + 1 + 2 * padding_y;
+
+    tile.region.resize(static_cast<std::size_t>(tile.region_width) * region_height);
+
+    load_region(src, image_width, image_height, tile.from_x - padding_x, tile.to_x + padding_x, tile.from_y - padding_y, tile.to_y + padding_y, parameters.border_mode, tile.region.data());
+
+    return tile;
+}
+
+template<class Acc>
+void convolution_tile(std::uint8_t const * src, std::uint8_t * dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters const & parameters, cvpg::imageproc::algorithms::convolution_kernel const & kernel)
+{
+    auto tile = load_tile(src, dst, from_x, to_x, from_y, to_y, parameters, kernel.width / 2, kernel.height / 2);
+
+    if (tile.empty())
+    {
+        return;
+    }
+
+    const std::int32_t width = tile.to_x - tile.from_x + 1;
+
+    tile_filter<Acc> filter(kernel, tile.origin(kernel.width, kernel.height), tile.region_width, width);
+
+    std::vector<Acc> response(width);
+
+    for (std::int32_t y = tile.from_y; y <= tile.to_y; ++y)
+    {
+        filter.response(y - tile.from_y, response.data());
+
+        to_gray_8bit(response.data(), dst + static_cast<std::size_t>(parameters.image_width) * y + tile.from_x, width);
+    }
+}
+
+template<class Acc>
+void convolution_magnitude_tile(std::uint8_t const * src, std::uint8_t * dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters const & parameters, cvpg::imageproc::algorithms::convolution_kernel const & kernel_a, cvpg::imageproc::algorithms::convolution_kernel const & kernel_b, cvpg::imageproc::algorithms::convolution_magnitude_mode mode)
+{
+    auto tile = load_tile(src, dst, from_x, to_x, from_y, to_y, parameters, std::max(kernel_a.width, kernel_b.width) / 2, std::max(kernel_a.height, kernel_b.height) / 2);
+
+    if (tile.empty())
+    {
+        return;
+    }
+
+    const std::int32_t width = tile.to_x - tile.from_x + 1;
+
+    tile_filter<Acc> filter_a(kernel_a, tile.origin(kernel_a.width, kernel_a.height), tile.region_width, width);
+    tile_filter<Acc> filter_b(kernel_b, tile.origin(kernel_b.width, kernel_b.height), tile.region_width, width);
+
+    std::vector<Acc> response_a(width);
+    std::vector<Acc> response_b(width);
+
+    for (std::int32_t y = tile.from_y; y <= tile.to_y; ++y)
+    {
+        filter_a.response(y - tile.from_y, response_a.data());
+        filter_b.response(y - tile.from_y, response_b.data());
+
+        std::uint8_t * dst_line = dst + static_cast<std::size_t>(parameters.image_width) * y + tile.from_x;
+
+        if (mode == cvpg::imageproc::algorithms::convolution_magnitude_mode::sum_abs)
+        {
+            for (std::int32_t x = 0; x < width; ++x)
+            {
+                const Acc magnitude = std::abs(response_a[x]) + std::abs(response_b[x]);
+
+                dst_line[x] = static_cast<std::uint8_t>(std::min(magnitude, Acc(255)));
+            }
+        }
+        else
+        {
+            for (std::int32_t x = 0; x < width; ++x)
+            {
+                const float a = static_cast<float>(response_a[x]);
+                const float b = static_cast<float>(response_b[x]);
+
+                dst_line[x] = static_cast<std::uint8_t>(std::min(std::sqrt(a * a + b * b), 255.0f));
+            }
+        }
+    }
+}
+
+}
+
+namespace cvpg::imageproc::algorithms {
+
+convolution_kernel create_convolution_kernel(std::int32_t width, std::int32_t height, std::vector<double> coefficients)
+{
+    if (width <= 0 || height <= 0 || (width & 1) == 0 || (height & 1) == 0)
+    {
+        throw cvpg::invalid_parameter_exception("kernel size has to be positive and odd");
+    }
+
+    if (coefficients.size() != static_cast<std::size_t>(width) * height)
+    {
+        throw cvpg::invalid_parameter_exception("number of kernel coefficients doesn't match kernel size");
+    }
+
+    convolution_kernel kernel;
+    kernel.width = width;
+    kernel.height = height;
+    kernel.coefficients = std::move(coefficients);
+
+    auto const & k = kernel.coefficients;
+
+    // the largest possible absolute result has to fit into 32 bit to use integer arithmetic
+    const double abs_sum = std::accumulate(k.begin(), k.end(), 0.0, [](double sum, double value){ return sum + std::abs(value); });
+
+    kernel.integer = std::all_of(k.begin(), k.end(), [](double value){ return std::isfinite(value) && std::trunc(value) == value; })
+                     && abs_sum * 255.0 <= static_cast<double>(std::numeric_limits<std::int32_t>::max());
+
+    // rank-1 decomposition ; the row and the column of the largest coefficient are the factors
+    const auto pivot = static_cast<std::int32_t>(std::distance(k.begin(), std::max_element(k.begin(), k.end(), [](double a, double b){ return std::abs(a) < std::abs(b); })));
+    const std::int32_t pivot_x = pivot % width;
+    const std::int32_t pivot_y = pivot / width;
+    const double pivot_value = k[pivot];
+
+    if (pivot_value == 0.0)
+    {
+        // all coefficients are zero
+        kernel.horizontal.assign(width, 0.0);
+        kernel.vertical.assign(height, 0.0);
+
+        return kernel;
+    }
+
+    std::vector<double> horizontal(k.begin() + pivot_y * width, k.begin() + (pivot_y + 1) * width);
+    std::vector<double> vertical(height);
+
+    double scale = pivot_value;
+
+    if (kernel.integer)
+    {
+        // keep the factors integral by dividing the row by the greatest common divisor of its coefficients
+        std::int64_t divisor = 0;
+
+        for (double value : horizontal)
+        {
+            divisor = std::gcd(divisor, static_cast<std::int64_t>(std::llround(std::abs(value))));
+        }
+
+        for (double & value : horizontal)
+        {
+            value /= static_cast<double>(divisor);
+        }
+
+        scale = pivot_value / static_cast<double>(divisor);
+    }
+
+    for (std::int32_t y = 0; y < height; ++y)
+    {
+        vertical[y] = k[static_cast<std::size_t>(y) * width + pivot_x] / scale;
+    }
+
+    // check the decomposition
+    const double epsilon = 1e-9 * std::abs(pivot_value);
+
+    for (std::int32_t y = 0; y < height; ++y)
+    {
+        for (std::int32_t x = 0; x < width; ++x)
+        {
+            if (std::abs(k[static_cast<std::size_t>(y) * width + x] - vertical[y] * horizontal[x]) > epsilon)
+            {
+                return kernel;
+            }
+        }
+    }
+
+    if (kernel.integer)
+    {
+        const bool integral = std::all_of(vertical.begin(), vertical.end(), [](double value){ return std::trunc(value) == value; });
+
+        // the horizontal pass has to fit into 32 bit too
+        const double horizontal_sum = std::accumulate(horizontal.begin(), horizontal.end(), 0.0, [](double sum, double value){ return sum + std::abs(value); });
+        const double vertical_sum = std::accumulate(vertical.begin(), vertical.end(), 0.0, [](double sum, double value){ return sum + std::abs(value); });
+
+        if (!integral || horizontal_sum * vertical_sum * 255.0 > static_cast<double>(std::numeric_limits<std::int32_t>::max()))
+        {
+            return kernel;
+        }
+    }
+
+    kernel.horizontal = std::move(horizontal);
+    kernel.vertical = std::move(vertical);
+
+    return kernel;
+}
+
+void convolution_gray_8bit(std::uint8_t * src, std::uint8_t * dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters, convolution_kernel const & kernel)
+{
+    if (kernel.integer)
+    {
+        convolution_tile<std::int32_t>(src, dst, from_x, to_x, from_y, to_y, parameters, kernel);
+    }
+    else
+    {
+        convolution_tile<float>(src, dst, from_x, to_x, from_y, to_y, parameters, kernel);
+    }
+}
+
+void convolution_magnitude_gray_8bit(std::uint8_t * src, std::uint8_t * dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters, convolution_kernel const & kernel_a, convolution_kernel const & kernel_b, convolution_magnitude_mode mode)
+{
+    if (kernel_a.integer && kernel_b.integer)
+    {
+        convolution_magnitude_tile<std::int32_t>(src, dst, from_x, to_x, from_y, to_y, parameters, kernel_a, kernel_b, mode);
+    }
+    else
+    {
+        convolution_magnitude_tile<float>(src, dst, from_x, to_x, from_y, to_y, parameters, kernel_a, kernel_b, mode);
+    }
+}
+
+} // namespace cvpg::imageproc::algorithms
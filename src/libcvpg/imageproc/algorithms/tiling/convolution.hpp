@@ -0,0 +1,70 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_IMAGEPROC_ALGORITHMS_TILING_CONVOLUTION_HPP
+#define LIBCVPG_IMAGEPROC_ALGORITHMS_TILING_CONVOLUTION_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <libcvpg/imageproc/algorithms/tiling/parameters.hpp>
+
+namespace cvpg::imageproc::algorithms {
+
+//
+// Kernel of a convolution. The kernel is applied as it is written down (without flipping it), so the
+// coefficient at the top left is multiplied with the pixel at (x - width / 2, y - height / 2).
+//
+// Use 'create_convolution_kernel' to create a kernel. It analyzes the coefficients once, so the tiles
+// only have to pick the fastest implementation.
+//
+struct convolution_kernel
+{
+    std::int32_t width = 0;
+    std::int32_t height = 0;
+
+    // coefficients in row-major order
+    std::vector<double> coefficients;
+
+    // all coefficients are integers and the result can be calculated with 32 bit integers
+    bool integer = false;
+
+    // rank-1 decomposition 'coefficients = vertical * horizontal' ; both are empty if the kernel isn't separable
+    std::vector<double> horizontal;
+    std::vector<double> vertical;
+};
+
+//
+// Create a kernel of size 'width' x 'height' (both have to be odd). Throws an 'invalid_parameter_exception'
+// on invalid dimensions.
+//
+convolution_kernel create_convolution_kernel(std::int32_t width, std::int32_t height, std::vector<double> coefficients);
+
+enum class convolution_magnitude_mode
+{
+    sum_abs,    // |a| + |b|
+    sum_sqrt    // sqrt(a^2 + b^2)
+};
+
+//
+// Convolution of a tile with an arbitrary kernel. The result is rounded and saturated to [0, 255].
+//
+// The tile (and the border around it needed by the kernel) is copied once to a padded buffer, so the inner
+// loops don't have to care about the border mode. Separable kernels are applied as a horizontal and a
+// vertical pass. Kernels with a width or height of 3, 5 or 7 use loops specialized for that size, which
+// can be unrolled and vectorized by the compiler.
+//
+// If the border mode 'ignore' is used, pixels closer to the image border than half of the kernel size are
+// set to 0.
+//
+void convolution_gray_8bit(std::uint8_t * src, std::uint8_t * dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters, convolution_kernel const & kernel);
+
+//
+// Magnitude of the results of two kernels, e.g. the horizontal and the vertical gradient. The result is
+// saturated to [0, 255].
+//
+void convolution_magnitude_gray_8bit(std::uint8_t * src, std::uint8_t * dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters, convolution_kernel const & kernel_a, convolution_kernel const & kernel_b, convolution_magnitude_mode mode);
+
+} // namespace cvpg::imageproc::algorithms
+
+#endif // LIBCVPG_IMAGEPROC_ALGORITHMS_TILING_CONVOLUTION_HPP
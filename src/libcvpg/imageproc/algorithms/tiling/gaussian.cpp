@@ -0,0 +1,586 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/imageproc/algorithms/tiling/gaussian.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+inline std::int32_t wrap_around(std::int32_t value, std::int32_t size)
+{
+    const std::int32_t result = value % size;
+
+    return result < 0 ? result + size : result;
+}
+
+//
+// Map a coordinate outside of the image to a coordinate inside of the image. Returns -1 if the value at
+// this coordinate is constant (zero).
+//
+inline std::int32_t border_index(std::int32_t value, std::int32_t size, cvpg::imageproc::algorithms::border_mode border_mode)
+{
+    if (value >= 0 && value < size)
+    {
+        return value;
+    }
+
+    switch (border_mode)
+    {
+        case cvpg::imageproc::algorithms::border_mode::mirror:
+            return wrap_around(value, size);
+
+        case cvpg::imageproc::algorithms::border_mode::ignore:
+            // only used by the recursive filter ; the border pixels are replaced by the source pixels afterwards
+            return std::clamp(value, 0, size - 1);
+
+        default:
+        case cvpg::imageproc::algorithms::border_mode::constant:
+            return -1;
+    }
+}
+
+//
+// Copy all pixels of a tile with a distance of less than 'radius' to the image border from the source image.
+//
+void copy_border(std::uint8_t const * src, std::uint8_t * dst, std::int32_t image_width, std::int32_t image_height, std::int32_t from_x, std::int32_t to_x, std::int32_t from_y, std::int32_t to_y, std::int32_t radius)
+{
+    for (std::int32_t y = from_y; y <= to_y; ++y)
+    {
+        const std::size_t offset_y = static_cast<std::size_t>(image_width) * y;
+
+        if (y < radius || y >= image_height - radius)
+        {
+            std::memcpy(dst + offset_y + from_x, src + offset_y + from_x, to_x - from_x + 1);
+
+            continue;
+        }
+
+        for (std::int32_t x = from_x; x <= std::min(to_x, radius - 1); ++x)
+        {
+            dst[offset_y + x] = src[offset_y + x];
+        }
+
+        for (std::int32_t x = std::max(from_x, image_width - radius); x <= to_x; ++x)
+        {
+            dst[offset_y + x] = src[offset_y + x];
+        }
+    }
+}
+
+//
+// Load the line 'y' between 'from_x' and 'to_x' (both can be outside of the image) to a dense buffer.
+//
+void load_line(std::uint8_t const * src, std::int32_t image_width, std::int32_t image_height, std::int32_t from_x, std::int32_t to_x, std::int32_t y, cvpg::imageproc::algorithms::border_mode border_mode, std::uint8_t * line)
+{
+    const std::int32_t width = to_x - from_x + 1;
+    const std::int32_t src_y = border_index(y, image_height, border_mode);
+
+    if (src_y < 0)
+    {
+        std::memset(line, 0, width);
+
+        return;
+    }
+
+    std::uint8_t const * src_line = src + static_cast<std::size_t>(image_width) * src_y;
+
+    if (from_x >= 0 && to_x < image_width)
+    {
+        std::memcpy(line, src_line + from_x, width);
+
+        return;
+    }
+
+    for (std::int32_t x = from_x; x <= to_x; ++x)
+    {
+        const std::int32_t src_x = border_index(x, image_width, border_mode);
+
+        line[x - from_x] = src_x < 0 ? 0 : src_line[src_x];
+    }
+}
+
+//
+// Horizontal pass of the integer kernel. The weights sum up to 256, so the result fits into 16 bit.
+//
+void filter_horizontal(std::uint8_t const * line, std::uint16_t * dst, std::int32_t width, std::int32_t radius, std::uint32_t const * kernel)
+{
+    const std::uint16_t center = static_cast<std::uint16_t>(kernel[radius]);
+
+    for (std::int32_t x = 0; x < width; ++x)
+    {
+        dst[x] = center * line[x + radius];
+    }
+
+    for (std::int32_t k = 0; k < radius; ++k)
+    {
+        const std::uint16_t weight = static_cast<std::uint16_t>(kernel[k]);
+
+        if (weight == 0)
+        {
+            continue;
+        }
+
+        std::uint8_t const * left = line + k;
+        std::uint8_t const * right = line + 2 * radius - k;
+
+        for (std::int32_t x = 0; x < width; ++x)
+        {
+            dst[x] += weight * static_cast<std::uint16_t>(left[x] + right[x]);
+        }
+    }
+}
+
+//
+// Vertical pass of the integer kernel over (2 * radius + 1) horizontally filtered lines. The weights sum up
+// to 65536, so the sum fits into 32 bit.
+//
+void filter_vertical(std::uint16_t const * const * lines, std::uint32_t * sum, std::uint8_t * dst, std::int32_t width, std::int32_t radius, std::uint32_t const * kernel)
+{
+    {
+        const std::uint32_t weight = kernel[radius];
+
+        std::uint16_t const * center = lines[radius];
+
+        for (std::int32_t x = 0; x < width; ++x)
+        {
+            sum[x] = weight * center[x];
+        }
+    }
+
+    for (std::int32_t k = 0; k < radius; ++k)
+    {
+        const std::uint32_t weight = kernel[k];
+
+        if (weight == 0)
+        {
+            continue;
+        }
+
+        std::uint16_t const * top = lines[k];
+        std::uint16_t const * bottom = lines[2 * radius - k];
+
+        for (std::int32_t x = 0; x < width; ++x)
+        {
+            sum[x] += weight * static_cast<std::uint32_t>(top[x] + bottom[x]);
+        }
+    }
+
+    for (std::int32_t x = 0; x < width; ++x)
+    {
+        dst[x] = static_cast<std::uint8_t>((sum[x] + (1 << 23)) >> 24);
+    }
+}
+
+//
+// Coefficients of the recursive Gaussian filter of Young and van Vliet ("Recursive implementation of the
+// Gaussian filter", 1995). The filter is normalized to a gain of 1.
+//
+struct recursive_coefficients
+{
+    float b1;
+    float b2;
+    float b3;
+    float B;
+};
+
+recursive_coefficients young_van_vliet(double sigma)
+{
+    // the approximation is not valid for smaller values
+    sigma = std::max(sigma, 0.5);
+
+    const double q = sigma >= 2.5 ? (0.98711 * sigma - 0.96330) : (3.97156 - 4.14554 * std::sqrt(1.0 - 0.26891 * sigma));
+
+    const double q2 = q * q;
+    const double q3 = q2 * q;
+
+    const double b0 = 1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3;
+    const double b1 = (2.44413 * q + 2.85619 * q2 + 1.26661 * q3) / b0;
+    const double b2 = -(1.4281 * q2 + 1.26661 * q3) / b0;
+    const double b3 = (0.422205 * q3) / b0;
+
+    return
+    {
+        static_cast<float>(b1),
+        static_cast<float>(b2),
+        static_cast<float>(b3),
+        static_cast<float>(1.0 - (b1 + b2 + b3))
+    };
+}
+
+//
+// Number of pixels outside of the image that are filtered before the first (and after the last) pixel of
+// a line or column. This let the state of the recursive filter settle for the border modes 'constant'
+// and 'mirror'.
+//
+inline std::int32_t recursive_margin(double sigma)
+{
+    return static_cast<std::int32_t>(std::ceil(4.0 * sigma));
+}
+
+inline std::uint8_t to_gray_8bit(float value)
+{
+    return static_cast<std::uint8_t>(std::clamp(value + 0.5f, 0.0f, 255.0f));
+}
+
+}
+
+namespace cvpg::imageproc::algorithms {
+
+std::int32_t gaussian_radius(double sigma)
+{
+    return std::max(1, static_cast<std::int32_t>(std::ceil(3.0 * sigma)));
+}
+
+std::vector<std::uint32_t> gaussian_kernel(double sigma, std::int32_t radius, std::uint32_t scale)
+{
+    std::vector<double> weights(2 * radius + 1);
+
+    double sum = 0.0;
+
+    for (std::int32_t i = -radius; i <= radius; ++i)
+    {
+        weights[i + radius] = std::exp(-(i * i) / (2.0 * sigma * sigma));
+
+        sum += weights[i + radius];
+    }
+
+    std::vector<std::uint32_t> kernel(2 * radius + 1);
+
+    std::int64_t kernel_sum = 0;
+
+    for (std::int32_t i = 0; i <= radius; ++i)
+    {
+        const std::uint32_t weight = static_cast<std::uint32_t>(std::lround(weights[i] / sum * scale));
+
+        kernel[i] = weight;
+        kernel[2 * radius - i] = weight;
+
+        kernel_sum += i < radius ? 2 * static_cast<std::int64_t>(weight) : weight;
+    }
+
+    // the center weight is the largest one and takes the rounding errors, so the weights sum up to 'scale'
+    std::int64_t center = static_cast<std::int64_t>(kernel[radius]) + static_cast<std::int64_t>(scale) - kernel_sum;
+
+    // if the outer weights are too large, the largest pair of them is reduced until the center is the
+    // largest weight again
+    while (true)
+    {
+        const auto largest = std::max_element(kernel.begin(), kernel.begin() + radius);
+
+        if (center >= static_cast<std::int64_t>(*largest))
+        {
+            break;
+        }
+
+        const std::size_t i = static_cast<std::size_t>(largest - kernel.begin());
+
+        --kernel[i];
+        --kernel[2 * radius - i];
+
+        center += 2;
+    }
+
+    kernel[radius] = static_cast<std::uint32_t>(center);
+
+    return kernel;
+}
+
+void gaussian_gray_8bit(std::uint8_t * src, std::uint8_t * dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+{
+    std::int32_t from_x_ = static_cast<std::int32_t>(from_x);
+    std::int32_t to_x_ = static_cast<std::int32_t>(to_x);
+    std::int32_t from_y_ = static_cast<std::int32_t>(from_y);
+    std::int32_t to_y_ = static_cast<std::int32_t>(to_y);
+
+    const std::int32_t image_width = static_cast<std::int32_t>(parameters.image_width);
+    const std::int32_t image_height = static_cast<std::int32_t>(parameters.image_height);
+
+    const double sigma = parameters.real_numbers.at(0);
+
+    const std::int32_t radius = gaussian_radius(sigma);
+    const std::int32_t size = 2 * radius + 1;
+
+    if (parameters.border_mode == cvpg::imageproc::algorithms::border_mode::ignore)
+    {
+        copy_border(src, dst, image_width, image_height, from_x_, to_x_, from_y_, to_y_, radius);
+
+        from_x_ = std::max(from_x_, radius);
+        to_x_ = std::min(to_x_, image_width - 1 - radius);
+        from_y_ = std::max(from_y_, radius);
+        to_y_ = std::min(to_y_, image_height - 1 - radius);
+
+        if (from_x_ > to_x_ || from_y_ > to_y_)
+        {
+            return;
+        }
+    }
+
+    const auto horizontal_kernel = gaussian_kernel(sigma, radius, 1 << 8);
+    const auto vertical_kernel = gaussian_kernel(sigma, radius, 1 << 16);
+
+    const std::int32_t width = to_x_ - from_x_ + 1;
+
+    std::vector<std::uint8_t> line(width + 2 * radius);
+    std::vector<std::uint16_t> ring(static_cast<std::size_t>(size) * width);
+    std::vector<std::uint32_t> sum(width);
+
+    std::vector<std::uint16_t const *> lines(size);
+
+    for (std::int32_t y = from_y_ - radius; y <= to_y_ + radius; ++y)
+    {
+        const std::int32_t slot = (y - from_y_ + radius) % size;
+
+        load_line(src, image_width, image_height, from_x_ - radius, to_x_ + radius, y, parameters.border_mode, line.data());
+
+        filter_horizontal(line.data(), ring.data() + static_cast<std::size_t>(slot) * width, width, radius, horizontal_kernel.data());
+
+        // wait until all lines of the vertical kernel are available
+        if (y < from_y_ + radius)
+        {
+            continue;
+        }
+
+        const std::int32_t dst_y = y - radius;
+
+        for (std::int32_t k = 0; k < size; ++k)
+        {
+            lines[k] = ring.data() + static_cast<std::size_t>((dst_y - from_y_ + k) % size) * width;
+        }
+
+        filter_vertical(lines.data(), sum.data(), dst + static_cast<std::size_t>(image_width) * dst_y + from_x_, width, radius, vertical_kernel.data());
+    }
+}
+
+void gaussian_recursive_horizontal_gray_8bit(std::uint8_t * src, float * dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+{
+    const std::int32_t image_width = static_cast<std::int32_t>(parameters.image_width);
+
+    const double sigma = parameters.real_numbers.at(0);
+
+    const auto c = young_van_vliet(sigma);
+
+    const std::int32_t margin = recursive_margin(sigma);
+    const std::int32_t length = image_width + 2 * margin;
+
+    // The recursion along a line can't be vectorized. Instead a block of lines is stored interleaved, so
+    // that the filter runs over all lines of a block at once.
+    constexpr std::int32_t block_size = 8;
+
+    std::vector<float> block(static_cast<std::size_t>(length) * block_size);
+
+    for (std::size_t block_y = from_y; block_y <= to_y; block_y += block_size)
+    {
+        const std::int32_t lines = static_cast<std::int32_t>(std::min<std::size_t>(block_size, to_y - block_y + 1));
+
+        for (std::int32_t i = 0; i < lines; ++i)
+        {
+            std::uint8_t const * src_line = src + image_width * (block_y + i);
+
+            float * values = block.data() + static_cast<std::size_t>(margin) * block_size + i;
+
+            for (std::int32_t x = 0; x < image_width; ++x)
+            {
+                values[x * block_size] = static_cast<float>(src_line[x]);
+            }
+
+            for (std::int32_t x = -margin; x < 0; ++x)
+            {
+                const std::int32_t src_x = border_index(x, image_width, parameters.border_mode);
+
+                values[x * block_size] = src_x < 0 ? 0.0f : static_cast<float>(src_line[src_x]);
+            }
+
+            for (std::int32_t x = image_width; x < image_width + margin; ++x)
+            {
+                const std::int32_t src_x = border_index(x, image_width, parameters.border_mode);
+
+                values[x * block_size] = src_x < 0 ? 0.0f : static_cast<float>(src_line[src_x]);
+            }
+        }
+
+        float w1[block_size];
+        float w2[block_size];
+        float w3[block_size];
+
+        // causal filter ; the state is initialized for a constant signal
+        for (std::int32_t i = 0; i < block_size; ++i)
+        {
+            w1[i] = w2[i] = w3[i] = block[i];
+        }
+
+        for (std::int32_t x = 0; x < length; ++x)
+        {
+            float * values = block.data() + static_cast<std::size_t>(x) * block_size;
+
+            for (std::int32_t i = 0; i < block_size; ++i)
+            {
+                const float w = c.B * values[i] + c.b1 * w1[i] + c.b2 * w2[i] + c.b3 * w3[i];
+
+                values[i] = w;
+
+                w3[i] = w2[i];
+                w2[i] = w1[i];
+                w1[i] = w;
+            }
+        }
+
+        // anti-causal filter
+        for (std::int32_t i = 0; i < block_size; ++i)
+        {
+            w1[i] = w2[i] = w3[i] = block[static_cast<std::size_t>(length - 1) * block_size + i];
+        }
+
+        for (std::int32_t x = length - 1; x >= 0; --x)
+        {
+            float * values = block.data() + static_cast<std::size_t>(x) * block_size;
+
+            for (std::int32_t i = 0; i < block_size; ++i)
+            {
+                const float w = c.B * values[i] + c.b1 * w1[i] + c.b2 * w2[i] + c.b3 * w3[i];
+
+                values[i] = w;
+
+                w3[i] = w2[i];
+                w2[i] = w1[i];
+                w1[i] = w;
+            }
+        }
+
+        for (std::int32_t i = 0; i < lines; ++i)
+        {
+            float * dst_line = dst + image_width * (block_y + i);
+
+            for (std::size_t x = from_x; x <= to_x; ++x)
+            {
+                dst_line[x] = block[(x + margin) * block_size + i];
+            }
+        }
+    }
+}
+
+void gaussian_recursive_vertical_gray_8bit(float * src, std::uint8_t * original, std::uint8_t * dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+{
+    const std::int32_t image_width = static_cast<std::int32_t>(parameters.image_width);
+    const std::int32_t image_height = static_cast<std::int32_t>(parameters.image_height);
+
+    const double sigma = parameters.real_numbers.at(0);
+
+    const auto c = young_van_vliet(sigma);
+
+    const std::int32_t margin = recursive_margin(sigma);
+    const std::int32_t width = static_cast<std::int32_t>(to_x - from_x + 1);
+
+    std::vector<float> zeros(width, 0.0f);
+
+    // input line 'y' of this tile ; lines outside of the image are mapped depending on the border mode
+    auto input_line =
+        [&](std::int32_t y) -> float const *
+        {
+            const std::int32_t src_y = border_index(y, image_height, parameters.border_mode);
+
+            return src_y < 0 ? zeros.data() : (src + static_cast<std::size_t>(image_width) * src_y + from_x);
+        };
+
+    // the lines after the last line of the image have to be copied before the causal filter overwrites the source
+    std::vector<float> tail(static_cast<std::size_t>(margin) * width);
+
+    for (std::int32_t y = 0; y < margin; ++y)
+    {
+        float const * in = input_line(image_height + y);
+
+        std::copy(in, in + width, tail.begin() + static_cast<std::size_t>(y) * width);
+    }
+
+    std::vector<float> state(3 * width);
+
+    float * w1 = state.data();
+    float * w2 = w1 + width;
+    float * w3 = w2 + width;
+
+    // run the filter over a line ; the result is stored at 'out' and the state is updated
+    auto filter_line =
+        [&](float const * in, float * out)
+        {
+            for (std::int32_t x = 0; x < width; ++x)
+            {
+                out[x] = c.B * in[x] + c.b1 * w1[x] + c.b2 * w2[x] + c.b3 * w3[x];
+            }
+
+            // the oldest state is not needed anymore and takes the new values
+            std::copy(out, out + width, w3);
+            std::swap(w3, w2);
+            std::swap(w2, w1);
+        };
+
+    // causal filter ; the state is initialized for a constant signal
+    {
+        float const * first = input_line(-margin);
+
+        std::copy(first, first + width, w1);
+        std::copy(first, first + width, w2);
+        std::copy(first, first + width, w3);
+    }
+
+    std::vector<float> discard(width);
+
+    for (std::int32_t y = -margin; y < 0; ++y)
+    {
+        filter_line(input_line(y), discard.data());
+    }
+
+    for (std::int32_t y = 0; y < image_height; ++y)
+    {
+        float * line = src + static_cast<std::size_t>(image_width) * y + from_x;
+
+        filter_line(line, line);
+    }
+
+    for (std::int32_t y = 0; y < margin; ++y)
+    {
+        float * line = tail.data() + static_cast<std::size_t>(y) * width;
+
+        filter_line(line, line);
+    }
+
+    // anti-causal filter
+    {
+        float const * last = margin > 0 ? (tail.data() + static_cast<std::size_t>(margin - 1) * width) : (src + static_cast<std::size_t>(image_width) * (image_height - 1) + from_x);
+
+        std::copy(last, last + width, w1);
+        std::copy(last, last + width, w2);
+        std::copy(last, last + width, w3);
+    }
+
+    for (std::int32_t y = margin - 1; y >= 0; --y)
+    {
+        filter_line(tail.data() + static_cast<std::size_t>(y) * width, discard.data());
+    }
+
+    for (std::int32_t y = image_height - 1; y >= 0; --y)
+    {
+        float * line = src + static_cast<std::size_t>(image_width) * y + from_x;
+
+        filter_line(line, line);
+
+        if (y >= static_cast<std::int32_t>(from_y) && y <= static_cast<std::int32_t>(to_y))
+        {
+            std::uint8_t * dst_line = dst + static_cast<std::size_t>(image_width) * y + from_x;
+
+            for (std::int32_t x = 0; x < width; ++x)
+            {
+                dst_line[x] = to_gray_8bit(line[x]);
+            }
+        }
+    }
+
+    if (parameters.border_mode == cvpg::imageproc::algorithms::border_mode::ignore)
+    {
+        copy_border(original, dst, image_width, image_height, static_cast<std::int32_t>(from_x), static_cast<std::int32_t>(to_x), static_cast<std::int32_t>(from_y), static_cast<std::int32_t>(to_y), gaussian_radius(sigma));
+    }
+}
+
+} // namespace cvpg::imageproc::algorithms
@@ -0,0 +1,57 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_IMAGEPROC_ALGORITHMS_TILING_GAUSSIAN_HPP
+#define LIBCVPG_IMAGEPROC_ALGORITHMS_TILING_GAUSSIAN_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <libcvpg/imageproc/algorithms/tiling/parameters.hpp>
+
+namespace cvpg::imageproc::algorithms {
+
+//
+// Radius of the footprint of a Gaussian with standard deviation 'sigma'. Pixels closer to the image border
+// are copied from the source image if the border mode 'ignore' is used.
+//
+std::int32_t gaussian_radius(double sigma);
+
+//
+// Symmetric integer kernel of size (2 * radius + 1) whose weights sum up to 'scale' exactly. The weights
+// are rounded separately and the rounding error is corrected at the center weight, which stays the
+// largest one.
+//
+std::vector<std::uint32_t> gaussian_kernel(double sigma, std::int32_t radius, std::uint32_t scale);
+
+//
+// Gaussian filter with a separable integer kernel. The standard deviation is expected as real number 0 of
+// the tiling parameters.
+//
+// Each tile is processed in a single pass. Horizontally filtered lines are kept in a ring buffer of
+// (2 * radius + 1) lines, so the vertical pass works on data that is still in the cache. The inner loops
+// run over contiguous lines and can be vectorized by the compiler.
+//
+void gaussian_gray_8bit(std::uint8_t * src, std::uint8_t * dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters);
+
+//
+// Horizontal pass of a recursive Gaussian filter (Young/van Vliet). The costs per pixel are independent of
+// the standard deviation, which is expected as real number 0 of the tiling parameters.
+//
+// Complete lines are filtered, so tiles have to span the whole image width. The result is stored at a
+// floating point buffer of image size.
+//
+void gaussian_recursive_horizontal_gray_8bit(std::uint8_t * src, float * dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters);
+
+//
+// Vertical pass of a recursive Gaussian filter (Young/van Vliet) on the result of the horizontal pass.
+//
+// Complete columns are filtered, so tiles have to span the whole image height. All columns of a tile are
+// filtered at once line by line. The source image 'original' is used for border pixels if the border mode
+// 'ignore' is used.
+//
+void gaussian_recursive_vertical_gray_8bit(float * src, std::uint8_t * original, std::uint8_t * dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters);
+
+} // namespace cvpg::imageproc::algorithms
+
+#endif // LIBCVPG_IMAGEPROC_ALGORITHMS_TILING_GAUSSIAN_HPP
@@ -0,0 +1,394 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/imageproc/algorithms/tiling/morphology.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+struct min_operation
+{
+    // value that does not affect the result of the operation
+    static constexpr std::uint8_t neutral = 255;
+
+    inline std::uint8_t operator()(std::uint8_t a, std::uint8_t b) const
+    {
+        return a < b ? a : b;
+    }
+};
+
+struct max_operation
+{
+    // value that does not affect the result of the operation
+    static constexpr std::uint8_t neutral = 0;
+
+    inline std::uint8_t operator()(std::uint8_t a, std::uint8_t b) const
+    {
+        return a > b ? a : b;
+    }
+};
+
+inline std::int32_t wrap_around(std::int32_t value, std::int32_t size)
+{
+    const std::int32_t result = value % size;
+
+    return result < 0 ? result + size : result;
+}
+
+//
+// Copy the region [from_x, to_x] x [from_y, to_y] of the source image to a dense buffer. Parts of the
+// region outside of the image are filled depending on the border mode.
+//
+void load_region(std::uint8_t const * src, std::int32_t image_width, std::int32_t image_height, std::int32_t from_x, std::int32_t to_x, std::int32_t from_y, std::int32_t to_y, cvpg::imageproc::algorithms::border_mode border_mode, std::uint8_t constant_value, std::vector<std::uint8_t> & buffer)
+{
+    const std::int32_t width = to_x - from_x + 1;
+    const std::int32_t height = to_y - from_y + 1;
+
+    const bool wrap = border_mode == cvpg::imageproc::algorithms::border_mode::mirror;
+
+    buffer.resize(static_cast<std::size_t>(width) * height);
+
+    const std::int32_t inner_from_x = std::max(from_x, 0);
+    const std::int32_t inner_to_x = std::min(to_x, image_width - 1);
+
+    for (std::int32_t y = from_y; y <= to_y; ++y)
+    {
+        std::uint8_t * dst_line = buffer.data() + static_cast<std::size_t>(y - from_y) * width;
+
+        if ((y < 0 || y >= image_height) && !wrap)
+        {
+            std::fill(dst_line, dst_line + width, constant_value);
+
+            continue;
+        }
+
+        std::uint8_t const * src_line = src + static_cast<std::size_t>(image_width) * wrap_around(y, image_height);
+
+        if (inner_from_x <= inner_to_x)
+        {
+            std::memcpy(dst_line + (inner_from_x - from_x), src_line + inner_from_x, inner_to_x - inner_from_x + 1);
+        }
+
+        for (std::int32_t x = from_x; x <= std::min(to_x, -1); ++x)
+        {
+            dst_line[x - from_x] = wrap ? src_line[wrap_around(x, image_width)] : constant_value;
+        }
+
+        for (std::int32_t x = std::max(from_x, image_width); x <= to_x; ++x)
+        {
+            dst_line[x - from_x] = wrap ? src_line[wrap_around(x, image_width)] : constant_value;
+        }
+    }
+}
+
+//
+// Set all values of a dense buffer covering [from_x, to_x] x [from_y, to_y] that are outside of the image.
+//
+void fill_outside(std::vector<std::uint8_t> & buffer, std::int32_t image_width, std::int32_t image_height, std::int32_t from_x, std::int32_t to_x, std::int32_t from_y, std::int32_t to_y, std::uint8_t value)
+{
+    const std::int32_t width = to_x - from_x + 1;
+
+    for (std::int32_t y = from_y; y <= to_y; ++y)
+    {
+        std::uint8_t * line = buffer.data() + static_cast<std::size_t>(y - from_y) * width;
+
+        if (y < 0 || y >= image_height)
+        {
+            std::fill(line, line + width, value);
+
+            continue;
+        }
+
+        for (std::int32_t x = from_x; x <= std::min(to_x, -1); ++x)
+        {
+            line[x - from_x] = value;
+        }
+
+        for (std::int32_t x = std::max(from_x, image_width); x <= to_x; ++x)
+        {
+            line[x - from_x] = value;
+        }
+    }
+}
+
+void store_region(std::uint8_t const * buffer, std::uint8_t * dst, std::int32_t image_width, std::int32_t from_x, std::int32_t to_x, std::int32_t from_y, std::int32_t to_y)
+{
+    const std::int32_t width = to_x - from_x + 1;
+
+    for (std::int32_t y = from_y; y <= to_y; ++y)
+    {
+        std::memcpy(dst + static_cast<std::size_t>(image_width) * y + from_x, buffer + static_cast<std::size_t>(y - from_y) * width, width);
+    }
+}
+
+//
+// Running minimum/maximum of a dense buffer with the van Herk/Gil-Werman algorithm. The buffer is split
+// into blocks of the size of the structuring element. For each block a forward and a backward running
+// minimum/maximum is calculated. The result for a window is then the combination of the backward value
+// at the beginning of the window and the forward value at its end. Independent of the element size
+// this needs three comparisons per pixel and direction.
+//
+// The result has a size of (src_width - element_width + 1) x (src_height - element_height + 1).
+//
+template<class Operation>
+void van_herk_gil_werman(std::uint8_t const * src, std::int32_t src_width, std::int32_t src_height, std::int32_t element_width, std::int32_t element_height, std::vector<std::uint8_t> & dst, Operation op)
+{
+    const std::int32_t dst_width = src_width - element_width + 1;
+    const std::int32_t dst_height = src_height - element_height + 1;
+
+    // horizontal pass
+    std::vector<std::uint8_t> horizontal(static_cast<std::size_t>(dst_width) * src_height);
+
+    {
+        std::vector<std::uint8_t> forward(src_width);
+        std::vector<std::uint8_t> backward(src_width);
+
+        for (std::int32_t y = 0; y < src_height; ++y)
+        {
+            std::uint8_t const * src_line = src + static_cast<std::size_t>(y) * src_width;
+            std::uint8_t * dst_line = horizontal.data() + static_cast<std::size_t>(y) * dst_width;
+
+            for (std::int32_t block = 0; block < src_width; block += element_width)
+            {
+                const std::int32_t block_end = std::min(block + element_width, src_width) - 1;
+
+                forward[block] = src_line[block];
+
+                for (std::int32_t x = block + 1; x <= block_end; ++x)
+                {
+                    forward[x] = op(forward[x - 1], src_line[x]);
+                }
+
+                backward[block_end] = src_line[block_end];
+
+                for (std::int32_t x = block_end - 1; x >= block; --x)
+                {
+                    backward[x] = op(backward[x + 1], src_line[x]);
+                }
+            }
+
+            for (std::int32_t x = 0; x < dst_width; ++x)
+            {
+                dst_line[x] = op(backward[x], forward[x + element_width - 1]);
+            }
+        }
+    }
+
+    // vertical pass ; whole lines are processed at once so that the inner loops run over contiguous memory
+    dst.resize(static_cast<std::size_t>(dst_width) * dst_height);
+
+    {
+        std::vector<std::uint8_t> forward(horizontal.size());
+        std::vector<std::uint8_t> backward(horizontal.size());
+
+        for (std::int32_t block = 0; block < src_height; block += element_height)
+        {
+            const std::int32_t block_end = std::min(block + element_height, src_height) - 1;
+
+            std::memcpy(forward.data() + static_cast<std::size_t>(block) * dst_width, horizontal.data() + static_cast<std::size_t>(block) * dst_width, dst_width);
+
+            for (std::int32_t y = block + 1; y <= block_end; ++y)
+            {
+                std::uint8_t const * prev_line = forward.data() + static_cast<std::size_t>(y - 1) * dst_width;
+                std::uint8_t const * src_line = horizontal.data() + static_cast<std::size_t>(y) * dst_width;
+                std::uint8_t * dst_line = forward.data() + static_cast<std::size_t>(y) * dst_width;
+
+                for (std::int32_t x = 0; x < dst_width; ++x)
+                {
+                    dst_line[x] = op(prev_line[x], src_line[x]);
+                }
+            }
+
+            std::memcpy(backward.data() + static_cast<std::size_t>(block_end) * dst_width, horizontal.data() + static_cast<std::size_t>(block_end) * dst_width, dst_width);
+
+            for (std::int32_t y = block_end - 1; y >= block; --y)
+            {
+                std::uint8_t const * next_line = backward.data() + static_cast<std::size_t>(y + 1) * dst_width;
+                std::uint8_t const * src_line = horizontal.data() + static_cast<std::size_t>(y) * dst_width;
+                std::uint8_t * dst_line = backward.data() + static_cast<std::size_t>(y) * dst_width;
+
+                for (std::int32_t x = 0; x < dst_width; ++x)
+                {
+                    dst_line[x] = op(next_line[x], src_line[x]);
+                }
+            }
+        }
+
+        for (std::int32_t y = 0; y < dst_height; ++y)
+        {
+            std::uint8_t const * backward_line = backward.data() + static_cast<std::size_t>(y) * dst_width;
+            std::uint8_t const * forward_line = forward.data() + static_cast<std::size_t>(y + element_height - 1) * dst_width;
+            std::uint8_t * dst_line = dst.data() + static_cast<std::size_t>(y) * dst_width;
+
+            for (std::int32_t x = 0; x < dst_width; ++x)
+            {
+                dst_line[x] = op(backward_line[x], forward_line[x]);
+            }
+        }
+    }
+}
+
+template<class Operation>
+void morphology_gray_8bit_kernel_single(std::uint8_t * src, std::uint8_t * dst, std::int32_t from_x, std::int32_t to_x, std::int32_t from_y, std::int32_t to_y, std::int32_t image_width, std::int32_t image_height, std::int32_t element_width, std::int32_t element_height, cvpg::imageproc::algorithms::border_mode border_mode, Operation op)
+{
+    const std::int32_t half_element_width = element_width >> 1;
+    const std::int32_t half_element_height = element_height >> 1;
+
+    std::vector<std::uint8_t> region;
+    std::vector<std::uint8_t> result;
+
+    load_region(src, image_width, image_height, from_x - half_element_width, to_x + half_element_width, from_y - half_element_height, to_y + half_element_height, border_mode, Operation::neutral, region);
+
+    van_herk_gil_werman(region.data(), to_x - from_x + 1 + 2 * half_element_width, to_y - from_y + 1 + 2 * half_element_height, element_width, element_height, result, op);
+
+    store_region(result.data(), dst, image_width, from_x, to_x, from_y, to_y);
+}
+
+//
+// Fused opening/closing of a tile. The first operation is calculated for the tile plus a halo of half the
+// element size, which is then used as input of the second operation without writing it to an intermediate image.
+//
+template<class FirstOperation, class SecondOperation>
+void morphology_gray_8bit_kernel_composed(std::uint8_t * src, std::uint8_t * dst, std::int32_t from_x, std::int32_t to_x, std::int32_t from_y, std::int32_t to_y, std::int32_t image_width, std::int32_t image_height, std::int32_t element_width, std::int32_t element_height, cvpg::imageproc::algorithms::border_mode border_mode, FirstOperation first_op, SecondOperation second_op)
+{
+    const std::int32_t half_element_width = element_width >> 1;
+    const std::int32_t half_element_height = element_height >> 1;
+
+    std::vector<std::uint8_t> region;
+    std::vector<std::uint8_t> intermediate;
+    std::vector<std::uint8_t> result;
+
+    load_region(src, image_width, image_height, from_x - 2 * half_element_width, to_x + 2 * half_element_width, from_y - 2 * half_element_height, to_y + 2 * half_element_height, border_mode, FirstOperation::neutral, region);
+
+    van_herk_gil_werman(region.data(), to_x - from_x + 1 + 4 * half_element_width, to_y - from_y + 1 + 4 * half_element_height, element_width, element_height, intermediate, first_op);
+
+    // with constant borders the pixels outside of the image must not influence the second operation
+    if (border_mode == cvpg::imageproc::algorithms::border_mode::constant)
+    {
+        fill_outside(intermediate, image_width, image_height, from_x - half_element_width, to_x + half_element_width, from_y - half_element_height, to_y + half_element_height, SecondOperation::neutral);
+    }
+
+    van_herk_gil_werman(intermediate.data(), to_x - from_x + 1 + 2 * half_element_width, to_y - from_y + 1 + 2 * half_element_height, element_width, element_height, result, second_op);
+
+    store_region(result.data(), dst, image_width, from_x, to_x, from_y, to_y);
+}
+
+void morphology_gray_8bit_kernel_gradient(std::uint8_t * src, std::uint8_t * dst, std::int32_t from_x, std::int32_t to_x, std::int32_t from_y, std::int32_t to_y, std::int32_t image_width, std::int32_t image_height, std::int32_t element_width, std::int32_t element_height, cvpg::imageproc::algorithms::border_mode border_mode)
+{
+    const std::int32_t half_element_width = element_width >> 1;
+    const std::int32_t half_element_height = element_height >> 1;
+
+    const std::int32_t region_width = to_x - from_x + 1 + 2 * half_element_width;
+    const std::int32_t region_height = to_y - from_y + 1 + 2 * half_element_height;
+
+    std::vector<std::uint8_t> region;
+    std::vector<std::uint8_t> dilated;
+    std::vector<std::uint8_t> eroded;
+
+    load_region(src, image_width, image_height, from_x - half_element_width, to_x + half_element_width, from_y - half_element_height, to_y + half_element_height, border_mode, max_operation::neutral, region);
+
+    van_herk_gil_werman(region.data(), region_width, region_height, element_width, element_height, dilated, max_operation());
+
+    // constant borders need different values for dilation and erosion
+    if (border_mode == cvpg::imageproc::algorithms::border_mode::constant)
+    {
+        load_region(src, image_width, image_height, from_x - half_element_width, to_x + half_element_width, from_y - half_element_height, to_y + half_element_height, border_mode, min_operation::neutral, region);
+    }
+
+    van_herk_gil_werman(region.data(), region_width, region_height, element_width, element_height, eroded, min_operation());
+
+    for (std::size_t i = 0; i < dilated.size(); ++i)
+    {
+        dilated[i] = static_cast<std::uint8_t>(dilated[i] - eroded[i]);
+    }
+
+    store_region(dilated.data(), dst, image_width, from_x, to_x, from_y, to_y);
+}
+
+}
+
+namespace cvpg::imageproc::algorithms {
+
+void morphology_gray_8bit(std::uint8_t * src, std::uint8_t * dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters, morphology_operation operation)
+{
+    std::int32_t from_x_ = static_cast<std::int32_t>(from_x);
+    std::int32_t to_x_ = static_cast<std::int32_t>(to_x);
+    std::int32_t from_y_ = static_cast<std::int32_t>(from_y);
+    std::int32_t to_y_ = static_cast<std::int32_t>(to_y);
+
+    const std::int32_t image_width = static_cast<std::int32_t>(parameters.image_width);
+    const std::int32_t image_height = static_cast<std::int32_t>(parameters.image_height);
+
+    const std::int32_t element_width = static_cast<std::int32_t>(parameters.signed_integer_numbers.at(0));
+    const std::int32_t element_height = static_cast<std::int32_t>(parameters.signed_integer_numbers.at(1));
+
+    const bool composed = operation == morphology_operation::open || operation == morphology_operation::close;
+
+    // size of the neighbourhood that is needed around each pixel
+    const std::int32_t halo_x = (element_width >> 1) * (composed ? 2 : 1);
+    const std::int32_t halo_y = (element_height >> 1) * (composed ? 2 : 1);
+
+    if (parameters.border_mode == cvpg::imageproc::algorithms::border_mode::ignore)
+    {
+        // pixels without a complete neighbourhood keep their source values
+        for (std::int32_t y = from_y_; y <= to_y_; ++y)
+        {
+            const std::size_t offset_y = static_cast<std::size_t>(image_width) * y;
+
+            if (y < halo_y || y >= (image_height - halo_y))
+            {
+                std::memcpy(dst + offset_y + from_x_, src + offset_y + from_x_, to_x_ - from_x_ + 1);
+
+                continue;
+            }
+
+            for (std::int32_t x = from_x_; x <= std::min(to_x_, halo_x - 1); ++x)
+            {
+                dst[offset_y + x] = src[offset_y + x];
+            }
+
+            for (std::int32_t x = std::max(from_x_, image_width - halo_x); x <= to_x_; ++x)
+            {
+                dst[offset_y + x] = src[offset_y + x];
+            }
+        }
+
+        from_x_ = std::max(from_x_, halo_x);
+        to_x_ = std::min(to_x_, image_width - 1 - halo_x);
+        from_y_ = std::max(from_y_, halo_y);
+        to_y_ = std::min(to_y_, image_height - 1 - halo_y);
+
+        if (from_x_ > to_x_ || from_y_ > to_y_)
+        {
+            return;
+        }
+    }
+
+    switch (operation)
+    {
+        case morphology_operation::erode:
+            morphology_gray_8bit_kernel_single(src, dst, from_x_, to_x_, from_y_, to_y_, image_width, image_height, element_width, element_height, parameters.border_mode, min_operation());
+            break;
+
+        case morphology_operation::dilate:
+            morphology_gray_8bit_kernel_single(src, dst, from_x_, to_x_, from_y_, to_y_, image_width, image_height, element_width, element_height, parameters.border_mode, max_operation());
+            break;
+
+        case morphology_operation::open:
+            morphology_gray_8bit_kernel_composed(src, dst, from_x_, to_x_, from_y_, to_y_, image_width, image_height, element_width, element_height, parameters.border_mode, min_operation(), max_operation());
+            break;
+
+        case morphology_operation::close:
+            morphology_gray_8bit_kernel_composed(src, dst, from_x_, to_x_, from_y_, to_y_, image_width, image_height, element_width, element_height, parameters.border_mode, max_operation(), min_operation());
+            break;
+
+        case morphology_operation::gradient:
+            morphology_gray_8bit_kernel_gradient(src, dst, from_x_, to_x_, from_y_, to_y_, image_width, image_height, element_width, element_height, parameters.border_mode);
+            break;
+    }
+}
+
+} // namespace cvpg::imageproc::algorithms
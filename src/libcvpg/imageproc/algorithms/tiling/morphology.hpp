@@ -0,0 +1,34 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_IMAGEPROC_ALGORITHMS_TILING_MORPHOLOGY_HPP
+#define LIBCVPG_IMAGEPROC_ALGORITHMS_TILING_MORPHOLOGY_HPP
+
+#include <cstdint>
+
+#include <libcvpg/imageproc/algorithms/tiling/parameters.hpp>
+
+namespace cvpg::imageproc::algorithms {
+
+enum class morphology_operation
+{
+    erode,      // minimum over structuring element
+    dilate,     // maximum over structuring element
+    open,       // erosion followed by dilation
+    close,      // dilation followed by erosion
+    gradient    // difference of dilation and erosion
+};
+
+//
+// Morphological operation with a rectangular structuring element. Width and height of the element
+// are expected as signed integer numbers 0 and 1 of the tiling parameters.
+//
+// The running minimum/maximum is calculated with the van Herk/Gil-Werman algorithm, so the costs per
+// pixel are independent of the size of the structuring element. Opening, closing and gradient are
+// calculated in a single pass per tile.
+//
+void morphology_gray_8bit(std::uint8_t * src, std::uint8_t * dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters, morphology_operation operation);
+
+} // namespace cvpg::imageproc::algorithms
+
+#endif // LIBCVPG_IMAGEPROC_ALGORITHMS_TILING_MORPHOLOGY_HPP
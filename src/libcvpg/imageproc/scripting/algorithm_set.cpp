@@ -8,14 +8,19 @@
 #include <libcvpg/imageproc/scripting/algorithms/and.hpp>
 #include <libcvpg/imageproc/scripting/algorithms/base.hpp>
 #include <libcvpg/imageproc/scripting/algorithms/binary_threshold.hpp>
+#include <libcvpg/imageproc/scripting/algorithms/canny.hpp>
+#include <libcvpg/imageproc/scripting/algorithms/connected_components.hpp>
 #include <libcvpg/imageproc/scripting/algorithms/convert_to_gray.hpp>
 #include <libcvpg/imageproc/scripting/algorithms/convert_to_rgb.hpp>
+#include <libcvpg/imageproc/scripting/algorithms/convolve.hpp>
 #include <libcvpg/imageproc/scripting/algorithms/diff.hpp>
+#include <libcvpg/imageproc/scripting/algorithms/gaussian.hpp>
 #include <libcvpg/imageproc/scripting/algorithms/histogram_equalization.hpp>
 #include <libcvpg/imageproc/scripting/algorithms/hog_image.hpp>
 #include <libcvpg/imageproc/scripting/algorithms/input.hpp>
 #include <libcvpg/imageproc/scripting/algorithms/k_means.hpp>
 #include <libcvpg/imageproc/scripting/algorithms/mean.hpp>
+#include <libcvpg/imageproc/scripting/algorithms/morphology.hpp>
 #include <libcvpg/imageproc/scripting/algorithms/multiply_add.hpp>
 #include <libcvpg/imageproc/scripting/algorithms/paint_meta.hpp>
 #include <libcvpg/imageproc/scripting/algorithms/or.hpp>
@@ -36,15 +41,24 @@ algorithm_set::algorithm_set()
 {
     register_algorithm(std::make_shared<algorithms::and_>());
     register_algorithm(std::make_shared<algorithms::binary_threshold>());
+    register_algorithm(std::make_shared<algorithms::canny>());
+    register_algorithm(std::make_shared<algorithms::close>());
+    register_algorithm(std::make_shared<algorithms::connected_components>());
     register_algorithm(std::make_shared<algorithms::convert_to_gray>());
     register_algorithm(std::make_shared<algorithms::convert_to_rgb>());
+    register_algorithm(std::make_shared<algorithms::convolve>());
     register_algorithm(std::make_shared<algorithms::diff>());
+    register_algorithm(std::make_shared<algorithms::dilate>());
+    register_algorithm(std::make_shared<algorithms::erode>());
+    register_algorithm(std::make_shared<algorithms::gaussian>());
+    register_algorithm(std::make_shared<algorithms::gradient>());
     register_algorithm(std::make_shared<algorithms::histogram_equalization>());
     register_algorithm(std::make_shared<algorithms::hog_image>());
     register_algorithm(std::make_shared<algorithms::input>());
     register_algorithm(std::make_shared<algorithms::k_means>());
     register_algorithm(std::make_shared<algorithms::mean>());
     register_algorithm(std::make_shared<algorithms::multiply_add>());
+    register_algorithm(std::make_shared<algorithms::open>());
     register_algorithm(std::make_shared<algorithms::or_>());
     register_algorithm(std::make_shared<algorithms::paint_meta>());
     register_algorithm(std::make_shared<algorithms::pooling>());
@@ -0,0 +1,227 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/imageproc/scripting/algorithms/canny.hpp>
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include <boost/asynchronous/continuation_task.hpp>
+
+#include <libcvpg/core/exception.hpp>
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/imageproc/algorithms/canny.hpp>
+#include <libcvpg/imageproc/scripting/item.hpp>
+#include <libcvpg/imageproc/scripting/processing_context.hpp>
+#include <libcvpg/imageproc/scripting/detail/compiler.hpp>
+#include <libcvpg/imageproc/scripting/detail/handler.hpp>
+#include <libcvpg/imageproc/scripting/detail/parser.hpp>
+
+namespace detail {
+
+struct canny_task :  public boost::asynchronous::continuation_task<std::shared_ptr<cvpg::imageproc::scripting::processing_context> >
+{
+    canny_task(std::shared_ptr<cvpg::imageproc::scripting::processing_context> context, std::uint32_t result_id, cvpg::imageproc::scripting::detail::parser::item item)
+        : boost::asynchronous::continuation_task<std::shared_ptr<cvpg::imageproc::scripting::processing_context> >("algorithms::canny_task")
+        , m_context(context)
+        , m_result_id(result_id)
+        , m_item(std::move(item))
+    {}
+
+    void operator()()
+    {
+        try
+        {
+            auto id = std::any_cast<std::uint32_t>(m_item.arguments.at(0).value());
+            auto low_threshold = std::any_cast<std::int32_t>(m_item.arguments.at(1).value());
+            auto high_threshold = std::any_cast<std::int32_t>(m_item.arguments.at(2).value());
+
+            auto input = m_context->load(id);
+            auto parameters = m_context->parameters();
+
+            std::uint32_t cutoff_x = 512;
+            std::uint32_t cutoff_y = 512;
+
+            {
+                auto it = parameters.find("cutoff_x");
+
+                if (it != parameters.end())
+                {
+                    cutoff_x = std::any_cast<std::uint32_t>(it->second);
+                }
+            }
+
+            {
+                auto it = parameters.find("cutoff_y");
+
+                if (it != parameters.end())
+                {
+                    cutoff_y = std::any_cast<std::uint32_t>(it->second);
+                }
+            }
+
+            auto start = std::chrono::system_clock::now();
+
+            auto store_result =
+                [result = this->this_task_result(), context = m_context, result_id = m_result_id, start](auto cont_res) mutable
+                {
+                    auto stop = std::chrono::system_clock::now();
+
+                    try
+                    {
+                        context->store(result_id, std::move(std::get<0>(cont_res).get()), std::chrono::duration_cast<std::chrono::microseconds>(stop - start));
+
+                        result.set_value(context);
+                    }
+                    catch (...)
+                    {
+                        result.set_exception(std::current_exception());
+                    }
+                };
+
+            if (input.type() == cvpg::imageproc::scripting::item::types::grayscale_8_bit_image)
+            {
+                auto image = std::any_cast<cvpg::image_gray_8bit>(input.value());
+
+                boost::asynchronous::create_callback_continuation(
+                    std::move(store_result),
+                    cvpg::imageproc::algorithms::canny(std::move(image), low_threshold, high_threshold, cutoff_x, cutoff_y)
+                );
+            }
+        }
+        catch (...)
+        {
+            this->this_task_result().set_exception(std::current_exception());
+        }
+    }
+
+private:
+    std::shared_ptr<cvpg::imageproc::scripting::processing_context> m_context;
+
+    std::uint32_t m_result_id;
+
+    cvpg::imageproc::scripting::detail::parser::item m_item;
+};
+
+auto canny(std::shared_ptr<cvpg::imageproc::scripting::processing_context> context, std::uint32_t result_id, cvpg::imageproc::scripting::detail::parser::item item)
+{
+    return boost::asynchronous::top_level_callback_continuation<std::shared_ptr<cvpg::imageproc::scripting::processing_context> >(
+               canny_task(context, result_id, std::move(item))
+           );
+}
+
+} // namespace detail
+
+namespace cvpg::imageproc::scripting::algorithms {
+
+std::string canny::name() const
+{
+    return "canny";
+}
+
+std::string canny::category() const
+{
+    return "filters/edge";
+}
+
+std::vector<scripting::item::types> canny::result() const
+{
+    return
+    {
+        scripting::item::types::grayscale_8_bit_image
+    };
+}
+
+parameter_set canny::parameters() const
+{
+    return parameter_set
+           ({
+               parameter("image", "input image", "", { scripting::item::types::grayscale_8_bit_image }),
+               parameter("low_threshold", "lower threshold of gradient magnitude", "", scripting::item::types::signed_integer, static_cast<std::int32_t>(0), static_cast<std::int32_t>(1500), static_cast<std::int32_t>(1)),
+               parameter("high_threshold", "upper threshold of gradient magnitude", "", scripting::item::types::signed_integer, static_cast<std::int32_t>(0), static_cast<std::int32_t>(1500), static_cast<std::int32_t>(1))
+           });
+}
+
+void canny::on_parse(std::shared_ptr<detail::parser> parser) const
+{
+    // all parameters
+    {
+        std::function<std::uint32_t(std::uint32_t, std::int32_t, std::int32_t)> fct =
+            [parser, parameters = this->parameters()](std::uint32_t image_id, std::int32_t low_threshold, std::int32_t high_threshold)
+            {
+                std::uint32_t result_id = 0;
+
+                // find image
+                if (!parser)
+                {
+                    throw cvpg::invalid_parameter_exception("invalid parser");
+                }
+
+                auto image = parser->find_item(image_id);
+
+                if (image.arguments.empty())
+                {
+                    throw cvpg::invalid_parameter_exception("invalid input ID");
+                }
+
+                auto input_type = image.arguments.front().type();
+
+                // check parameters
+                if (input_type != scripting::item::types::grayscale_8_bit_image)
+                {
+                    throw cvpg::invalid_parameter_exception("invalid input type");
+                }
+
+                if (!parameters.is_valid("low_threshold", low_threshold))
+                {
+                    throw cvpg::invalid_parameter_exception("invalid lower threshold");
+                }
+
+                if (!parameters.is_valid("high_threshold", high_threshold))
+                {
+                    throw cvpg::invalid_parameter_exception("invalid upper threshold");
+                }
+
+                if (low_threshold > high_threshold)
+                {
+                    throw cvpg::invalid_parameter_exception("lower threshold is greater than upper threshold");
+                }
+
+                detail::parser::item result_item
+                {
+                    "canny",
+                    {
+                        scripting::item(input_type, image_id),
+                        scripting::item(scripting::item::types::signed_integer, low_threshold),
+                        scripting::item(scripting::item::types::signed_integer, high_threshold)
+                    }
+                };
+
+                result_id = parser->register_item(std::move(result_item));
+
+                if (result_id != 0)
+                {
+                    parser->register_link(image_id, result_id);
+                }
+
+                return result_id;
+            };
+
+        parser->register_specification(name(), std::move(fct));
+    }
+}
+
+void canny::on_compile(std::uint32_t item_id, std::shared_ptr<detail::compiler> compiler) const
+{
+    auto handler =
+        detail::handler(
+            [result_id = item_id, item = compiler->get_item(item_id)](std::shared_ptr<processing_context> context)
+            {
+                return ::detail::canny(context, result_id, std::move(item));
+            });
+
+    compiler->register_handler(item_id, name(), std::move(handler));
+}
+
+} // namespace cvpg::imageproc::scripting::algorithms
@@ -0,0 +1,249 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/imageproc/scripting/algorithms/connected_components.hpp>
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include <boost/asynchronous/continuation_task.hpp>
+
+#include <libcvpg/core/exception.hpp>
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/imageproc/algorithms/connected_components.hpp>
+#include <libcvpg/imageproc/scripting/item.hpp>
+#include <libcvpg/imageproc/scripting/processing_context.hpp>
+#include <libcvpg/imageproc/scripting/detail/compiler.hpp>
+#include <libcvpg/imageproc/scripting/detail/handler.hpp>
+#include <libcvpg/imageproc/scripting/detail/parser.hpp>
+
+namespace detail {
+
+struct connected_components_task :  public boost::asynchronous::continuation_task<std::shared_ptr<cvpg::imageproc::scripting::processing_context> >
+{
+    connected_components_task(std::shared_ptr<cvpg::imageproc::scripting::processing_context> context, std::uint32_t result_id, cvpg::imageproc::scripting::detail::parser::item item)
+        : boost::asynchronous::continuation_task<std::shared_ptr<cvpg::imageproc::scripting::processing_context> >("algorithms::connected_components_task")
+        , m_context(context)
+        , m_result_id(result_id)
+        , m_item(std::move(item))
+    {}
+
+    void operator()()
+    {
+        try
+        {
+            auto id = std::any_cast<std::uint32_t>(m_item.arguments.at(0).value());
+            auto connectivity = std::any_cast<std::int32_t>(m_item.arguments.at(1).value());
+            auto min_area = std::any_cast<std::int32_t>(m_item.arguments.at(2).value());
+            auto key_str = std::any_cast<std::string>(m_item.arguments.at(3).value());
+
+            auto input = m_context->load(id);
+            auto parameters = m_context->parameters();
+
+            std::uint32_t cutoff_x = 512;
+            std::uint32_t cutoff_y = 512;
+
+            {
+                auto it = parameters.find("cutoff_x");
+
+                if (it != parameters.end())
+                {
+                    cutoff_x = std::any_cast<std::uint32_t>(it->second);
+                }
+            }
+
+            {
+                auto it = parameters.find("cutoff_y");
+
+                if (it != parameters.end())
+                {
+                    cutoff_y = std::any_cast<std::uint32_t>(it->second);
+                }
+            }
+
+            if (input.type() == cvpg::imageproc::scripting::item::types::grayscale_8_bit_image)
+            {
+                auto image = std::any_cast<cvpg::image_gray_8bit>(std::move(input.value()));
+
+                auto start = std::chrono::system_clock::now();
+
+                boost::asynchronous::create_callback_continuation(
+                    [result = this->this_task_result(), context = m_context, result_id = m_result_id, start](auto cont_res) mutable
+                    {
+                        auto stop = std::chrono::system_clock::now();
+
+                        try
+                        {
+                            context->store(result_id, std::move(std::get<0>(cont_res).get()), std::chrono::duration_cast<std::chrono::microseconds>(stop - start));
+
+                            result.set_value(context);
+                        }
+                        catch (...)
+                        {
+                            result.set_exception(std::current_exception());
+                        }
+                    },
+                    cvpg::imageproc::algorithms::connected_components(std::move(image), connectivity, min_area, std::move(key_str), cutoff_x, cutoff_y)
+                );
+            }
+        }
+        catch (...)
+        {
+            this->this_task_result().set_exception(std::current_exception());
+        }
+    }
+
+private:
+    std::shared_ptr<cvpg::imageproc::scripting::processing_context> m_context;
+
+    std::uint32_t m_result_id;
+
+    cvpg::imageproc::scripting::detail::parser::item m_item;
+};
+
+auto connected_components(std::shared_ptr<cvpg::imageproc::scripting::processing_context> context, std::uint32_t result_id, cvpg::imageproc::scripting::detail::parser::item item)
+{
+    return boost::asynchronous::top_level_callback_continuation<std::shared_ptr<cvpg::imageproc::scripting::processing_context> >(
+               connected_components_task(context, result_id, std::move(item))
+           );
+}
+
+} // namespace detail
+
+namespace cvpg::imageproc::scripting::algorithms {
+
+std::string connected_components::name() const
+{
+    return "connected_components";
+}
+
+std::string connected_components::category() const
+{
+    return "filters/segmentation";
+}
+
+std::vector<scripting::item::types> connected_components::result() const
+{
+    return
+    {
+        scripting::item::types::grayscale_8_bit_image
+    };
+}
+
+parameter_set connected_components::parameters() const
+{
+    return parameter_set
+           ({
+               parameter("image", "input mask", "", { scripting::item::types::grayscale_8_bit_image }),
+               parameter("connectivity", "pixel connectivity", "", scripting::item::types::signed_integer, { static_cast<std::int32_t>(4), static_cast<std::int32_t>(8) }),
+               parameter("min_area", "minimum area of a blob", "pixels", scripting::item::types::signed_integer, static_cast<std::int32_t>(1), static_cast<std::int32_t>(2147483647), static_cast<std::int32_t>(1)),
+               parameter("key", "key of metadata to store the blobs", "", scripting::item::types::characters)
+           });
+}
+
+void connected_components::on_parse(std::shared_ptr<detail::parser> parser) const
+{
+    auto create_item =
+        [parser, parameters = this->parameters()](std::uint32_t image_id, std::int32_t connectivity, std::int32_t min_area, std::string key)
+        {
+            // find image
+            if (!parser)
+            {
+                throw cvpg::invalid_parameter_exception("invalid parser");
+            }
+
+            auto image = parser->find_item(image_id);
+
+            if (image.arguments.empty())
+            {
+                throw cvpg::invalid_parameter_exception("invalid input ID");
+            }
+
+            auto input_type = image.arguments.front().type();
+
+            // check parameters
+            if (input_type != scripting::item::types::grayscale_8_bit_image)
+            {
+                throw cvpg::invalid_parameter_exception("invalid input type");
+            }
+
+            if (!parameters.is_valid("connectivity", connectivity))
+            {
+                throw cvpg::invalid_parameter_exception("invalid connectivity");
+            }
+
+            if (!parameters.is_valid("min_area", min_area))
+            {
+                throw cvpg::invalid_parameter_exception("invalid minimum area");
+            }
+
+            if (key.empty())
+            {
+                throw cvpg::invalid_parameter_exception("invalid metadata key");
+            }
+
+            detail::parser::item result_item
+            {
+                "connected_components",
+                {
+                    scripting::item(scripting::item::types::grayscale_8_bit_image, image_id),
+                    scripting::item(scripting::item::types::signed_integer, connectivity),
+                    scripting::item(scripting::item::types::signed_integer, min_area),
+                    scripting::item(scripting::item::types::characters, key)
+                }
+            };
+
+            std::uint32_t result_id = parser->register_item(std::move(result_item));
+
+            if (result_id != 0)
+            {
+                parser->register_link(image_id, result_id);
+            }
+
+            return result_id;
+        };
+
+    // all parameters
+    {
+        std::function<std::uint32_t(std::uint32_t, std::int32_t, std::int32_t, std::string)> fct = create_item;
+
+        parser->register_specification(name(), std::move(fct));
+    }
+
+    // default for metadata key
+    {
+        std::function<std::uint32_t(std::uint32_t, std::int32_t, std::int32_t)> fct =
+            [create_item](std::uint32_t image_id, std::int32_t connectivity, std::int32_t min_area)
+            {
+                return create_item(image_id, connectivity, min_area, "blobs");
+            };
+
+        parser->register_specification(name(), std::move(fct));
+    }
+
+    // default for all parameters except the input image
+    {
+        std::function<std::uint32_t(std::uint32_t)> fct =
+            [create_item](std::uint32_t image_id)
+            {
+                return create_item(image_id, 8, 1, "blobs");
+            };
+
+        parser->register_specification(name(), std::move(fct));
+    }
+}
+
+void connected_components::on_compile(std::uint32_t item_id, std::shared_ptr<detail::compiler> compiler) const
+{
+    auto handler =
+        detail::handler(
+            [result_id = item_id, item = compiler->get_item(item_id)](std::shared_ptr<processing_context> context)
+            {
+                return ::detail::connected_components(context, result_id, std::move(item));
+            });
+
+    compiler->register_handler(item_id, name(), std::move(handler));
+}
+
+} // namespace cvpg::imageproc::scripting::algorithms
@@ -0,0 +1,276 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/imageproc/scripting/algorithms/gaussian.hpp>
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include <boost/asynchronous/continuation_task.hpp>
+
+#include <libcvpg/core/exception.hpp>
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/imageproc/algorithms/border_mode.hpp>
+#include <libcvpg/imageproc/algorithms/gaussian.hpp>
+#include <libcvpg/imageproc/scripting/item.hpp>
+#include <libcvpg/imageproc/scripting/processing_context.hpp>
+#include <libcvpg/imageproc/scripting/detail/compiler.hpp>
+#include <libcvpg/imageproc/scripting/detail/handler.hpp>
+#include <libcvpg/imageproc/scripting/detail/parser.hpp>
+
+namespace detail {
+
+struct gaussian_task :  public boost::asynchronous::continuation_task<std::shared_ptr<cvpg::imageproc::scripting::processing_context> >
+{
+    gaussian_task(std::shared_ptr<cvpg::imageproc::scripting::processing_context> context, std::uint32_t result_id, cvpg::imageproc::scripting::detail::parser::item item)
+        : boost::asynchronous::continuation_task<std::shared_ptr<cvpg::imageproc::scripting::processing_context> >("algorithms::gaussian_task")
+        , m_context(context)
+        , m_result_id(result_id)
+        , m_item(std::move(item))
+    {}
+
+    void operator()()
+    {
+        try
+        {
+            auto id = std::any_cast<std::uint32_t>(m_item.arguments.at(0).value());
+            auto sigma = std::any_cast<double>(m_item.arguments.at(1).value());
+            auto border_mode_str = std::any_cast<std::string>(m_item.arguments.at(2).value());
+            auto mode_str = std::any_cast<std::string>(m_item.arguments.at(3).value());
+
+            auto input = m_context->load(id);
+            auto parameters = m_context->parameters();
+
+            std::uint32_t cutoff_x = 512;
+            std::uint32_t cutoff_y = 512;
+
+            {
+                auto it = parameters.find("cutoff_x");
+
+                if (it != parameters.end())
+                {
+                    cutoff_x = std::any_cast<std::uint32_t>(it->second);
+                }
+            }
+
+            {
+                auto it = parameters.find("cutoff_y");
+
+                if (it != parameters.end())
+                {
+                    cutoff_y = std::any_cast<std::uint32_t>(it->second);
+                }
+            }
+
+            auto border_mode = cvpg::imageproc::algorithms::to_border_mode(border_mode_str);
+            auto mode = cvpg::imageproc::algorithms::to_gaussian_mode(mode_str);
+
+            auto start = std::chrono::system_clock::now();
+
+            auto store_result =
+                [result = this->this_task_result(), context = m_context, result_id = m_result_id, start](auto cont_res) mutable
+                {
+                    auto stop = std::chrono::system_clock::now();
+
+                    try
+                    {
+                        context->store(result_id, std::move(std::get<0>(cont_res).get()), std::chrono::duration_cast<std::chrono::microseconds>(stop - start));
+
+                        result.set_value(context);
+                    }
+                    catch (...)
+                    {
+                        result.set_exception(std::current_exception());
+                    }
+                };
+
+            if (input.type() == cvpg::imageproc::scripting::item::types::grayscale_8_bit_image)
+            {
+                auto image = std::any_cast<cvpg::image_gray_8bit>(input.value());
+
+                boost::asynchronous::create_callback_continuation(
+                    std::move(store_result),
+                    cvpg::imageproc::algorithms::gaussian(std::move(image), sigma, border_mode, mode, cutoff_x, cutoff_y)
+                );
+            }
+            else if (input.type() == cvpg::imageproc::scripting::item::types::rgb_8_bit_image)
+            {
+                auto image = std::any_cast<cvpg::image_rgb_8bit>(input.value());
+
+                boost::asynchronous::create_callback_continuation(
+                    std::move(store_result),
+                    cvpg::imageproc::algorithms::gaussian(std::move(image), sigma, border_mode, mode, cutoff_x, cutoff_y)
+                );
+            }
+        }
+        catch (...)
+        {
+            this->this_task_result().set_exception(std::current_exception());
+        }
+    }
+
+private:
+    std::shared_ptr<cvpg::imageproc::scripting::processing_context> m_context;
+
+    std::uint32_t m_result_id;
+
+    cvpg::imageproc::scripting::detail::parser::item m_item;
+};
+
+auto gaussian(std::shared_ptr<cvpg::imageproc::scripting::processing_context> context, std::uint32_t result_id, cvpg::imageproc::scripting::detail::parser::item item)
+{
+    return boost::asynchronous::top_level_callback_continuation<std::shared_ptr<cvpg::imageproc::scripting::processing_context> >(
+               gaussian_task(context, result_id, std::move(item))
+           );
+}
+
+} // namespace detail
+
+namespace cvpg::imageproc::scripting::algorithms {
+
+std::string gaussian::name() const
+{
+    return "gaussian";
+}
+
+std::string gaussian::category() const
+{
+    return "filters/smoothing";
+}
+
+std::vector<scripting::item::types> gaussian::result() const
+{
+    return
+    {
+        scripting::item::types::grayscale_8_bit_image,
+        scripting::item::types::rgb_8_bit_image,
+    };
+}
+
+parameter_set gaussian::parameters() const
+{
+    using namespace std::string_literals;
+
+    return parameter_set
+           ({
+               parameter("image", "input image", "", { scripting::item::types::grayscale_8_bit_image, scripting::item::types::rgb_8_bit_image }),
+               parameter("sigma", "standard deviation", "pixels", scripting::item::types::real, {}, [](std::any value){ auto sigma = std::any_cast<double>(value); return sigma >= 0.1 && sigma <= 1000.0; }),
+               parameter("border_mode", "border mode", "", scripting::item::types::characters, { "ignore"s, "constant"s, "mirror"s }),
+               parameter("mode", "filter implementation", "", scripting::item::types::characters, { "auto"s, "kernel"s, "recursive"s })
+           });
+}
+
+void gaussian::on_parse(std::shared_ptr<detail::parser> parser) const
+{
+    auto create_item =
+        [parser, parameters = this->parameters()](std::uint32_t image_id, double sigma, std::string border_mode, std::string mode)
+        {
+            std::uint32_t result_id = 0;
+
+            // find image
+            if (!parser)
+            {
+                throw cvpg::invalid_parameter_exception("invalid parser");
+            }
+
+            auto image = parser->find_item(image_id);
+
+            if (image.arguments.empty())
+            {
+                throw cvpg::invalid_parameter_exception("invalid input ID");
+            }
+
+            auto input_type = image.arguments.front().type();
+
+            // check parameters
+            if (!(input_type == scripting::item::types::grayscale_8_bit_image || input_type == scripting::item::types::rgb_8_bit_image))
+            {
+                throw cvpg::invalid_parameter_exception("invalid input type");
+            }
+
+            if (!parameters.is_valid("sigma", sigma))
+            {
+                throw cvpg::invalid_parameter_exception("invalid standard deviation");
+            }
+
+            if (!parameters.is_valid("border_mode", border_mode))
+            {
+                throw cvpg::invalid_parameter_exception("invalid border mode");
+            }
+
+            if (!parameters.is_valid("mode", mode))
+            {
+                throw cvpg::invalid_parameter_exception("invalid mode");
+            }
+
+            // the approximation of the recursive filter is not valid for small standard deviations
+            if (mode == "recursive" && sigma < 0.5)
+            {
+                throw cvpg::invalid_parameter_exception("standard deviation too small for recursive mode");
+            }
+
+            detail::parser::item result_item
+            {
+                "gaussian",
+                {
+                    scripting::item(input_type, image_id),
+                    scripting::item(scripting::item::types::real, sigma),
+                    scripting::item(scripting::item::types::characters, border_mode),
+                    scripting::item(scripting::item::types::characters, mode)
+                }
+            };
+
+            result_id = parser->register_item(std::move(result_item));
+
+            if (result_id != 0)
+            {
+                parser->register_link(image_id, result_id);
+            }
+
+            return result_id;
+        };
+
+    // all parameters
+    {
+        std::function<std::uint32_t(std::uint32_t, double, std::string, std::string)> fct = create_item;
+
+        parser->register_specification(name(), std::move(fct));
+    }
+
+    // default for mode
+    {
+        std::function<std::uint32_t(std::uint32_t, double, std::string)> fct =
+            [create_item](std::uint32_t image_id, double sigma, std::string border_mode)
+            {
+                return create_item(image_id, sigma, std::move(border_mode), "auto");
+            };
+
+        parser->register_specification(name(), std::move(fct));
+    }
+
+    // default for border mode and mode
+    {
+        std::function<std::uint32_t(std::uint32_t, double)> fct =
+            [create_item](std::uint32_t image_id, double sigma)
+            {
+                return create_item(image_id, sigma, "constant", "auto");
+            };
+
+        parser->register_specification(name(), std::move(fct));
+    }
+}
+
+void gaussian::on_compile(std::uint32_t item_id, std::shared_ptr<detail::compiler> compiler) const
+{
+    auto handler =
+        detail::handler(
+            [result_id = item_id, item = compiler->get_item(item_id)](std::shared_ptr<processing_context> context)
+            {
+                return ::detail::gaussian(context, result_id, std::move(item));
+            });
+
+    compiler->register_handler(item_id, name(), std::move(handler));
+}
+
+} // namespace cvpg::imageproc::scripting::algorithms
@@ -11,6 +11,8 @@
 
 #include <libcvpg/core/exception.hpp>
 #include <libcvpg/core/image.hpp>
+#include <libcvpg/imageproc/algorithms/convert_to_gray.hpp>
+#include <libcvpg/imageproc/algorithms/convert_to_rgb.hpp>
 #include <libcvpg/imageproc/algorithms/tiling.hpp>
 #include <libcvpg/imageproc/scripting/item.hpp>
 #include <libcvpg/imageproc/scripting/processing_context.hpp>
@@ -37,14 +39,75 @@ struct input_task :  public boost::asynchronous::continuation_task<std::shared_p
 
             auto input = m_context->load(id);
 
+            if (input.type() == cvpg::imageproc::scripting::item::types::invalid)
+            {
+                throw cvpg::exception("no input image with requested ID available");
+            }
+
             if (input.type() == cvpg::imageproc::scripting::item::types::grayscale_8_bit_image)
             {
-                m_context->store(m_result_id, std::move(std::any_cast<cvpg::image_gray_8bit>(std::move(input.value()))));
+                auto image = std::move(std::any_cast<cvpg::image_gray_8bit>(std::move(input.value())));
+
+                if (image.range() == cvpg::color_range::limited)
+                {
+                    // a wrapped limited range luma plane is expanded on demand, the script gets full range values
+                    boost::asynchronous::create_callback_continuation(
+                        [task_result = this->this_task_result(), context = m_context, result_id = m_result_id](auto cont_res) mutable
+                        {
+                            try
+                            {
+                                context->store(result_id, std::move(std::get<0>(cont_res).get()));
+
+                                task_result.set_value(context);
+                            }
+                            catch (...)
+                            {
+                                task_result.set_exception(std::current_exception());
+                            }
+                        },
+                        cvpg::imageproc::algorithms::expand_to_full_range(std::move(image))
+                    );
+
+                    return;
+                }
+
+                m_context->store(m_result_id, std::move(image));
             }
             else if (input.type() == cvpg::imageproc::scripting::item::types::rgb_8_bit_image)
             {
                 m_context->store(m_result_id, std::move(std::any_cast<cvpg::image_rgb_8bit>(std::move(input.value()))));
             }
+            else if (input.type() == cvpg::imageproc::scripting::item::types::yuv420_8_bit_image)
+            {
+                // YUV images are converted on demand to the type requested by the script ; the grayscale image is the luma plane
+                auto image = std::move(std::any_cast<cvpg::image_yuv420_8bit>(std::move(input.value())));
+
+                auto store_result =
+                    [task_result = this->this_task_result(), context = m_context, result_id = m_result_id](auto cont_res) mutable
+                    {
+                        try
+                        {
+                            context->store(result_id, std::move(std::get<0>(cont_res).get()));
+
+                            task_result.set_value(context);
+                        }
+                        catch (...)
+                        {
+                            task_result.set_exception(std::current_exception());
+                        }
+                    };
+
+                if (m_item.arguments.at(0).type() == cvpg::imageproc::scripting::item::types::rgb_8_bit_image)
+                {
+                    boost::asynchronous::create_callback_continuation(std::move(store_result), cvpg::imageproc::algorithms::convert_to_rgb(std::move(image)));
+                }
+                else
+                {
+                    boost::asynchronous::create_callback_continuation(std::move(store_result), cvpg::imageproc::algorithms::convert_to_gray(std::move(image)));
+                }
+
+                return;
+            }
 
             this->this_task_result().set_value(m_context);
         }
@@ -100,7 +163,8 @@ parameter_set input::parameters() const
            ({
                parameter("mode", "type of input image", "", scripting::item::types::characters, { "gray"s, "rgb"s }),
                parameter("bits", "amount of bits", "", scripting::item::types::signed_integer, static_cast<std::int32_t>(8)),
-               parameter("source", "ID of input source", "", scripting::item::types::signed_integer)
+               parameter("source", "ID of input source", "", scripting::item::types::signed_integer),
+               parameter("index", "index of image in window of input images (0 is the newest image)", "", scripting::item::types::signed_integer)
            });
 }
 
@@ -213,6 +277,37 @@ void input::on_parse(std::shared_ptr<detail::parser> parser) const
         };
 
     parser->register_specification(name(), std::move(fct2));
+
+    // images of a window of input images, converted to grayscale if no mode is given
+    std::function<std::uint32_t(std::uint8_t, std::string)> fct3 =
+        [parser, parameters = this->parameters()](std::uint8_t index, std::string mode)
+        {
+            if (!parameters.is_valid("mode", mode))
+            {
+                throw cvpg::invalid_parameter_exception("invalid input mode");
+            }
+
+            detail::parser::item result_item
+            {
+                "input",
+                {
+                    scripting::item(mode == "rgb" ? scripting::item::types::rgb_8_bit_image : scripting::item::types::grayscale_8_bit_image,
+                                    processing_context::window_image_id(index)),
+                    scripting::item(scripting::item::types::signed_integer, static_cast<std::int32_t>(8))
+                }
+            };
+
+            return parser->register_item(std::move(result_item));
+        };
+
+    std::function<std::uint32_t(std::uint8_t)> fct4 =
+        [fct3](std::uint8_t index)
+        {
+            return fct3(index, "gray");
+        };
+
+    parser->register_specification(name(), std::move(fct3));
+    parser->register_specification(name(), std::move(fct4));
 }
 
 void input::on_compile(std::uint32_t item_id, std::shared_ptr<detail::compiler> compiler) const
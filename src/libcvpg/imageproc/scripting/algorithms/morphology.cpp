@@ -0,0 +1,485 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/imageproc/scripting/algorithms/morphology.hpp>
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include <boost/asynchronous/continuation_task.hpp>
+
+#include <libcvpg/core/exception.hpp>
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/imageproc/algorithms/tiling.hpp>
+#include <libcvpg/imageproc/algorithms/tiling/morphology.hpp>
+#include <libcvpg/imageproc/scripting/item.hpp>
+#include <libcvpg/imageproc/scripting/processing_context.hpp>
+#include <libcvpg/imageproc/scripting/detail/compiler.hpp>
+#include <libcvpg/imageproc/scripting/detail/handler.hpp>
+#include <libcvpg/imageproc/scripting/detail/parser.hpp>
+
+namespace detail {
+
+struct morphology_task :  public boost::asynchronous::continuation_task<std::shared_ptr<cvpg::imageproc::scripting::processing_context> >
+{
+    morphology_task(std::shared_ptr<cvpg::imageproc::scripting::processing_context> context, std::uint32_t result_id, cvpg::imageproc::scripting::detail::parser::item item, cvpg::imageproc::algorithms::morphology_operation operation)
+        : boost::asynchronous::continuation_task<std::shared_ptr<cvpg::imageproc::scripting::processing_context> >("algorithms::morphology_task")
+        , m_context(context)
+        , m_result_id(result_id)
+        , m_item(std::move(item))
+        , m_operation(operation)
+    {}
+
+    void operator()()
+    {
+        try
+        {
+            auto id = std::any_cast<std::uint32_t>(m_item.arguments.at(0).value());
+            auto width = std::any_cast<std::int32_t>(m_item.arguments.at(1).value());
+            auto height = std::any_cast<std::int32_t>(m_item.arguments.at(2).value());
+            auto border_mode_str = std::any_cast<std::string>(m_item.arguments.at(3).value());
+
+            auto input = m_context->load(id);
+            auto parameters = m_context->parameters();
+
+            std::uint32_t cutoff_x = 512;
+            std::uint32_t cutoff_y = 512;
+
+            {
+                auto it = parameters.find("cutoff_x");
+
+                if (it != parameters.end())
+                {
+                    cutoff_x = std::any_cast<std::uint32_t>(it->second);
+                }
+            }
+
+            {
+                auto it = parameters.find("cutoff_y");
+
+                if (it != parameters.end())
+                {
+                    cutoff_y = std::any_cast<std::uint32_t>(it->second);
+                }
+            }
+
+            auto border_mode = cvpg::imageproc::algorithms::to_border_mode(border_mode_str);
+
+            if (input.type() == cvpg::imageproc::scripting::item::types::grayscale_8_bit_image)
+            {
+                auto image = std::any_cast<cvpg::image_gray_8bit>(input.value());
+
+                const auto image_width = image.width();
+                const auto image_height = image.height();
+
+                auto start = std::chrono::system_clock::now();
+
+                auto tf = cvpg::imageproc::algorithms::tiling_functors::image<cvpg::image_gray_8bit>({{ std::move(image) }});
+                tf.parameters.image_width = image_width;
+                tf.parameters.image_height = image_height;
+                tf.parameters.cutoff_x = cutoff_x;
+                tf.parameters.cutoff_y = cutoff_y;
+                tf.parameters.signed_integer_numbers.push_back(width); // structuring element width
+                tf.parameters.signed_integer_numbers.push_back(height); // structuring element height
+                tf.parameters.border_mode = border_mode;
+
+                tf.tile_algorithm_task = [operation = m_operation](std::shared_ptr<cvpg::image_gray_8bit> src1, std::shared_ptr<cvpg::image_gray_8bit> /*src2*/, std::shared_ptr<cvpg::image_gray_8bit> dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+                {
+                    cvpg::imageproc::algorithms::morphology_gray_8bit(src1->data(0).get(), dst->data(0).get(), from_x, to_x, from_y, to_y, std::move(parameters), operation);
+                };
+
+                boost::asynchronous::create_callback_continuation(
+                    [result = this->this_task_result(), context = m_context, result_id = m_result_id, start](auto cont_res) mutable
+                    {
+                        auto stop = std::chrono::system_clock::now();
+
+                        try
+                        {
+                            context->store(result_id, std::move(std::get<0>(cont_res).get()), std::chrono::duration_cast<std::chrono::microseconds>(stop - start));
+
+                            result.set_value(context);
+                        }
+                        catch (...)
+                        {
+                            result.set_exception(std::current_exception());
+                        }
+                    },
+                    cvpg::imageproc::algorithms::tiling(std::move(tf))
+                );
+            }
+            else if (input.type() == cvpg::imageproc::scripting::item::types::rgb_8_bit_image)
+            {
+                auto image = std::any_cast<cvpg::image_rgb_8bit>(input.value());
+
+                const auto image_width = image.width();
+                const auto image_height = image.height();
+
+                auto start = std::chrono::system_clock::now();
+
+                auto tf = cvpg::imageproc::algorithms::tiling_functors::image<cvpg::image_rgb_8bit>({{ std::move(image) }});
+                tf.parameters.image_width = image_width;
+                tf.parameters.image_height = image_height;
+                tf.parameters.cutoff_x = cutoff_x;
+                tf.parameters.cutoff_y = cutoff_y;
+                tf.parameters.signed_integer_numbers.push_back(width); // structuring element width
+                tf.parameters.signed_integer_numbers.push_back(height); // structuring element height
+                tf.parameters.border_mode = border_mode;
+
+                tf.tile_algorithm_task = [operation = m_operation](std::shared_ptr<cvpg::image_rgb_8bit> src1, std::shared_ptr<cvpg::image_rgb_8bit> /*src2*/, std::shared_ptr<cvpg::image_rgb_8bit> dst, std::size_t from_x, std::size_t to_x, std::size_t from_y, std::size_t to_y, cvpg::imageproc::algorithms::tiling_parameters parameters)
+                {
+                    cvpg::imageproc::algorithms::morphology_gray_8bit(src1->data(0).get(), dst->data(0).get(), from_x, to_x, from_y, to_y, parameters, operation);
+                    cvpg::imageproc::algorithms::morphology_gray_8bit(src1->data(1).get(), dst->data(1).get(), from_x, to_x, from_y, to_y, parameters, operation);
+                    cvpg::imageproc::algorithms::morphology_gray_8bit(src1->data(2).get(), dst->data(2).get(), from_x, to_x, from_y, to_y, std::move(parameters), operation);
+                };
+
+                boost::asynchronous::create_callback_continuation(
+                    [result = this->this_task_result(), context = m_context, result_id = m_result_id, start](auto cont_res) mutable
+                    {
+                        auto stop = std::chrono::system_clock::now();
+
+                        try
+                        {
+                            context->store(result_id, std::move(std::get<0>(cont_res).get()), std::chrono::duration_cast<std::chrono::microseconds>(stop - start));
+
+                            result.set_value(context);
+                        }
+                        catch (...)
+                        {
+                            result.set_exception(std::current_exception());
+                        }
+                    },
+                    cvpg::imageproc::algorithms::tiling(std::move(tf))
+                );
+            }
+        }
+        catch (...)
+        {
+            this->this_task_result().set_exception(std::current_exception());
+        }
+    }
+
+private:
+    std::shared_ptr<cvpg::imageproc::scripting::processing_context> m_context;
+
+    std::uint32_t m_result_id;
+
+    cvpg::imageproc::scripting::detail::parser::item m_item;
+
+    cvpg::imageproc::algorithms::morphology_operation m_operation;
+};
+
+auto morphology(std::shared_ptr<cvpg::imageproc::scripting::processing_context> context, std::uint32_t result_id, cvpg::imageproc::scripting::detail::parser::item item, cvpg::imageproc::algorithms::morphology_operation operation)
+{
+    return boost::asynchronous::top_level_callback_continuation<std::shared_ptr<cvpg::imageproc::scripting::processing_context> >(
+               morphology_task(context, result_id, std::move(item), operation)
+           );
+}
+
+cvpg::imageproc::scripting::algorithms::parameter_set morphology_parameters()
+{
+    using namespace std::string_literals;
+
+    namespace scripting = cvpg::imageproc::scripting;
+
+    return scripting::algorithms::parameter_set
+           ({
+               scripting::algorithms::parameter("image", "input image", "", { scripting::item::types::grayscale_8_bit_image, scripting::item::types::rgb_8_bit_image }),
+               scripting::algorithms::parameter("element_width", "width of structuring element", "pixels", scripting::item::types::signed_integer, static_cast<std::int32_t>(1), static_cast<std::int32_t>(65535), static_cast<std::int32_t>(2)),
+               scripting::algorithms::parameter("element_height", "height of structuring element", "pixels", scripting::item::types::signed_integer, static_cast<std::int32_t>(1), static_cast<std::int32_t>(65535), static_cast<std::int32_t>(2)),
+               scripting::algorithms::parameter("border_mode", "border mode", "", scripting::item::types::characters, { "ignore"s, "constant"s, "mirror"s })
+           });
+}
+
+//
+// All morphological operations share the same parameters. So the script functions are registered here for all of them.
+//
+void register_morphology_specifications(std::string name, std::shared_ptr<cvpg::imageproc::scripting::detail::parser> parser)
+{
+    namespace scripting = cvpg::imageproc::scripting;
+
+    auto create_item =
+        [parser, name, parameters = morphology_parameters()](std::uint32_t image_id, std::int32_t width, std::int32_t height, std::string border_mode)
+        {
+            // find image
+            if (!parser)
+            {
+                throw cvpg::invalid_parameter_exception("invalid parser");
+            }
+
+            auto image = parser->find_item(image_id);
+
+            if (image.arguments.empty())
+            {
+                throw cvpg::invalid_parameter_exception("invalid input ID");
+            }
+
+            auto input_type = image.arguments.front().type();
+
+            // check parameters
+            if (!(input_type == scripting::item::types::grayscale_8_bit_image || input_type == scripting::item::types::rgb_8_bit_image))
+            {
+                throw cvpg::invalid_parameter_exception("invalid input type");
+            }
+
+            if (!parameters.is_valid("element_width", width))
+            {
+                throw cvpg::invalid_parameter_exception("invalid structuring element width");
+            }
+
+            if (!parameters.is_valid("element_height", height))
+            {
+                throw cvpg::invalid_parameter_exception("invalid structuring element height");
+            }
+
+            if (!parameters.is_valid("border_mode", border_mode))
+            {
+                throw cvpg::invalid_parameter_exception("invalid border mode");
+            }
+
+            scripting::detail::parser::item result_item
+            {
+                name,
+                {
+                    scripting::item(input_type, image_id),
+                    scripting::item(scripting::item::types::signed_integer, width),
+                    scripting::item(scripting::item::types::signed_integer, height),
+                    scripting::item(scripting::item::types::characters, border_mode)
+                }
+            };
+
+            std::uint32_t result_id = parser->register_item(std::move(result_item));
+
+            if (result_id != 0)
+            {
+                parser->register_link(image_id, result_id);
+            }
+
+            return result_id;
+        };
+
+    // all parameters
+    {
+        std::function<std::uint32_t(std::uint32_t, std::int32_t, std::int32_t, std::string)> fct = create_item;
+
+        parser->register_specification(name, std::move(fct));
+    }
+
+    // default for border mode
+    {
+        std::function<std::uint32_t(std::uint32_t, std::int32_t, std::int32_t)> fct =
+            [create_item](std::uint32_t image_id, std::int32_t width, std::int32_t height)
+            {
+                return create_item(image_id, width, height, "constant");
+            };
+
+        parser->register_specification(name, std::move(fct));
+    }
+
+    // square structuring element and default for border mode
+    {
+        std::function<std::uint32_t(std::uint32_t, std::int32_t)> fct =
+            [create_item](std::uint32_t image_id, std::int32_t size)
+            {
+                return create_item(image_id, size, size, "constant");
+            };
+
+        parser->register_specification(name, std::move(fct));
+    }
+}
+
+void register_morphology_handler(std::string name, std::uint32_t item_id, std::shared_ptr<cvpg::imageproc::scripting::detail::compiler> compiler, cvpg::imageproc::algorithms::morphology_operation operation)
+{
+    auto handler =
+        cvpg::imageproc::scripting::detail::handler(
+            [result_id = item_id, item = compiler->get_item(item_id), operation](std::shared_ptr<cvpg::imageproc::scripting::processing_context> context)
+            {
+                return ::detail::morphology(context, result_id, std::move(item), operation);
+            });
+
+    compiler->register_handler(item_id, std::move(name), std::move(handler));
+}
+
+} // namespace detail
+
+namespace cvpg::imageproc::scripting::algorithms {
+
+std::string erode::name() const
+{
+    return "erode";
+}
+
+std::string erode::category() const
+{
+    return "filters/morphology";
+}
+
+std::vector<scripting::item::types> erode::result() const
+{
+    return
+    {
+        scripting::item::types::grayscale_8_bit_image,
+        scripting::item::types::rgb_8_bit_image
+    };
+}
+
+parameter_set erode::parameters() const
+{
+    return ::detail::morphology_parameters();
+}
+
+void erode::on_parse(std::shared_ptr<detail::parser> parser) const
+{
+    ::detail::register_morphology_specifications(name(), std::move(parser));
+}
+
+void erode::on_compile(std::uint32_t item_id, std::shared_ptr<detail::compiler> compiler) const
+{
+    ::detail::register_morphology_handler(name(), item_id, std::move(compiler), cvpg::imageproc::algorithms::morphology_operation::erode);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+std::string dilate::name() const
+{
+    return "dilate";
+}
+
+std::string dilate::category() const
+{
+    return "filters/morphology";
+}
+
+std::vector<scripting::item::types> dilate::result() const
+{
+    return
+    {
+        scripting::item::types::grayscale_8_bit_image,
+        scripting::item::types::rgb_8_bit_image
+    };
+}
+
+parameter_set dilate::parameters() const
+{
+    return ::detail::morphology_parameters();
+}
+
+void dilate::on_parse(std::shared_ptr<detail::parser> parser) const
+{
+    ::detail::register_morphology_specifications(name(), std::move(parser));
+}
+
+void dilate::on_compile(std::uint32_t item_id, std::shared_ptr<detail::compiler> compiler) const
+{
+    ::detail::register_morphology_handler(name(), item_id, std::move(compiler), cvpg::imageproc::algorithms::morphology_operation::dilate);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+std::string open::name() const
+{
+    return "open";
+}
+
+std::string open::category() const
+{
+    return "filters/morphology";
+}
+
+std::vector<scripting::item::types> open::result() const
+{
+    return
+    {
+        scripting::item::types::grayscale_8_bit_image,
+        scripting::item::types::rgb_8_bit_image
+    };
+}
+
+parameter_set open::parameters() const
+{
+    return ::detail::morphology_parameters();
+}
+
+void open::on_parse(std::shared_ptr<detail::parser> parser) const
+{
+    ::detail::register_morphology_specifications(name(), std::move(parser));
+}
+
+void open::on_compile(std::uint32_t item_id, std::shared_ptr<detail::compiler> compiler) const
+{
+    ::detail::register_morphology_handler(name(), item_id, std::move(compiler), cvpg::imageproc::algorithms::morphology_operation::open);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+std::string close::name() const
+{
+    return "close";
+}
+
+std::string close::category() const
+{
+    return "filters/morphology";
+}
+
+std::vector<scripting::item::types> close::result() const
+{
+    return
+    {
+        scripting::item::types::grayscale_8_bit_image,
+        scripting::item::types::rgb_8_bit_image
+    };
+}
+
+parameter_set close::parameters() const
+{
+    return ::detail::morphology_parameters();
+}
+
+void close::on_parse(std::shared_ptr<detail::parser> parser) const
+{
+    ::detail::register_morphology_specifications(name(), std::move(parser));
+}
+
+void close::on_compile(std::uint32_t item_id, std::shared_ptr<detail::compiler> compiler) const
+{
+    ::detail::register_morphology_handler(name(), item_id, std::move(compiler), cvpg::imageproc::algorithms::morphology_operation::close);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+std::string gradient::name() const
+{
+    return "gradient";
+}
+
+std::string gradient::category() const
+{
+    return "filters/morphology";
+}
+
+std::vector<scripting::item::types> gradient::result() const
+{
+    return
+    {
+        scripting::item::types::grayscale_8_bit_image,
+        scripting::item::types::rgb_8_bit_image
+    };
+}
+
+parameter_set gradient::parameters() const
+{
+    return ::detail::morphology_parameters();
+}
+
+void gradient::on_parse(std::shared_ptr<detail::parser> parser) const
+{
+    ::detail::register_morphology_specifications(name(), std::move(parser));
+}
+
+void gradient::on_compile(std::uint32_t item_id, std::shared_ptr<detail::compiler> compiler) const
+{
+    ::detail::register_morphology_handler(name(), item_id, std::move(compiler), cvpg::imageproc::algorithms::morphology_operation::gradient);
+}
+
+} // namespace cvpg::imageproc::scripting::algorithms
@@ -4,12 +4,14 @@
 #include <libcvpg/imageproc/scripting/image_processor.hpp>
 
 #include <exception>
+#include <type_traits>
 #include <unordered_map>
 
 #include <boost/asynchronous/continuation_task.hpp>
 
 #include <libcvpg/imageproc/algorithms/convert_to_gray.hpp>
 #include <libcvpg/imageproc/algorithms/convert_to_rgb.hpp>
+#include <libcvpg/imageproc/algorithms/convert_to_yuv420.hpp>
 #include <libcvpg/imageproc/scripting/processing_context.hpp>
 #include <libcvpg/imageproc/scripting/detail/handler.hpp>
 #include <libcvpg/imageproc/scripting/detail/parallel_node.hpp>
@@ -142,6 +144,48 @@ auto executor(cvpg::imageproc::scripting::detail::compiler::result compiled,
            );
 }
 
+template<typename Image>
+constexpr cvpg::imageproc::scripting::item::types item_type()
+{
+    if constexpr (std::is_same_v<Image, cvpg::image_gray_8bit>)
+    {
+        return cvpg::imageproc::scripting::item::types::grayscale_8_bit_image;
+    }
+    else if constexpr (std::is_same_v<Image, cvpg::image_rgb_8bit>)
+    {
+        return cvpg::imageproc::scripting::item::types::rgb_8_bit_image;
+    }
+    else
+    {
+        return cvpg::imageproc::scripting::item::types::yuv420_8_bit_image;
+    }
+}
+
+// convert an image of another type to the type 'Image'
+template<typename Image, typename Input>
+auto convert_to(Input image)
+{
+    if constexpr (std::is_same_v<Image, cvpg::image_gray_8bit>)
+    {
+        if constexpr (std::is_same_v<Input, cvpg::image_rgb_8bit>)
+        {
+            return cvpg::imageproc::algorithms::convert_to_gray(std::move(image), cvpg::imageproc::algorithms::rgb_conversion_mode::calc_average);
+        }
+        else
+        {
+            return cvpg::imageproc::algorithms::convert_to_gray(std::move(image));
+        }
+    }
+    else if constexpr (std::is_same_v<Image, cvpg::image_rgb_8bit>)
+    {
+        return cvpg::imageproc::algorithms::convert_to_rgb(std::move(image));
+    }
+    else
+    {
+        return cvpg::imageproc::algorithms::convert_to_yuv420(std::move(image));
+    }
+}
+
 }
 
 namespace cvpg::imageproc::scripting {
@@ -304,6 +348,62 @@ void image_processor::evaluate(std::size_t compile_id, cvpg::image_rgb_8bit && i
     }
 }
 
+void image_processor::evaluate(std::size_t compile_id, cvpg::image_yuv420_8bit && image, std::function<void(item)> callback)
+{
+    auto it = m_compiled.find(compile_id);
+
+    if (it != m_compiled.end())
+    {
+        auto compiled = it->second;
+
+        const std::size_t context_id = m_context_counter++;
+
+        auto context = std::make_shared<processing_context>(context_id);
+        context->store(0, std::move(image));
+        context->set_parameters(m_params);
+
+        m_context.insert({ context_id, context });
+
+        post_callback(
+            [compiled = std::move(compiled)
+            ,context]() mutable
+            {
+                return executor(std::move(compiled), context);
+            },
+            [this, context_id, callback](auto cont_res)
+            {
+                try
+                {
+                    auto item = std::move(cont_res.get())->load();
+
+                    this->m_context.erase(context_id);
+
+                    callback(std::move(item));
+                }
+                catch (std::exception const & e)
+                {
+                    this->m_context.erase(context_id);
+
+                    callback(item(cvpg::imageproc::scripting::item::types::error, std::string(e.what())));
+                }
+                catch (...)
+                {
+                    this->m_context.erase(context_id);
+
+                    callback(item(cvpg::imageproc::scripting::item::types::error, std::string("unknown exception")));
+                }
+            },
+            "image_processor::evaluate::image_yuv420_8bit",
+            1,
+            1
+        );
+    }
+    else
+    {
+        callback(item(cvpg::imageproc::scripting::item::types::error, std::string("invalid context ID")));
+    }
+}
+
 void image_processor::evaluate_convert_if(std::size_t compile_id, cvpg::image_gray_8bit && image, std::function<void(cvpg::image_gray_8bit)> callback, std::function<void(std::size_t, std::string)> failed_callback)
 {
     evaluate(
@@ -396,6 +496,75 @@ void image_processor::evaluate_convert_if(std::size_t compile_id, cvpg::image_rg
     );
 }
 
+void image_processor::evaluate_convert_if(std::size_t compile_id, cvpg::image_yuv420_8bit && image, std::function<void(cvpg::image_yuv420_8bit)> callback, std::function<void(std::size_t, std::string)> failed_callback)
+{
+    evaluate(
+        compile_id,
+        std::move(image),
+        [this, compile_id, callback = std::move(callback), failed_callback = std::move(failed_callback)](auto item) mutable
+        {
+            if (item.type() == cvpg::imageproc::scripting::item::types::yuv420_8_bit_image)
+            {
+                callback(std::move(std::any_cast<cvpg::image_yuv420_8bit>(std::move(item.value()))));
+            }
+            else if (item.type() == cvpg::imageproc::scripting::item::types::grayscale_8_bit_image)
+            {
+                this->post_callback(
+                    [image = std::move(std::any_cast<cvpg::image_gray_8bit>(std::move(item.value())))]()
+                    {
+                        return imageproc::algorithms::convert_to_yuv420(std::move(image));
+                    },
+                    [compile_id, callback = std::move(callback), failed_callback = std::move(failed_callback)](auto cont_res) mutable
+                    {
+                        try
+                        {
+                            callback(std::move(cont_res.get()));
+                        }
+                        catch (std::exception const & e)
+                        {
+                            failed_callback(compile_id, e.what());
+                        }
+                    },
+                    "image_processor::evaluate_convert_if::image_yuv420_8bit::callback::image_gray_8bit",
+                    1,
+                    1
+                );
+            }
+            else if (item.type() == cvpg::imageproc::scripting::item::types::rgb_8_bit_image)
+            {
+                this->post_callback(
+                    [image = std::move(std::any_cast<cvpg::image_rgb_8bit>(std::move(item.value())))]()
+                    {
+                        return imageproc::algorithms::convert_to_yuv420(std::move(image));
+                    },
+                    [compile_id, callback = std::move(callback), failed_callback = std::move(failed_callback)](auto cont_res) mutable
+                    {
+                        try
+                        {
+                            callback(std::move(cont_res.get()));
+                        }
+                        catch (std::exception const & e)
+                        {
+                            failed_callback(compile_id, e.what());
+                        }
+                    },
+                    "image_processor::evaluate_convert_if::image_yuv420_8bit::callback::image_rgb_8bit",
+                    1,
+                    1
+                );
+            }
+            else if (item.type() == cvpg::imageproc::scripting::item::types::error)
+            {
+                failed_callback(compile_id, std::any_cast<std::string>(std::move(item.value())));
+            }
+            else
+            {
+                failed_callback(compile_id, "invalid result during evaluation of an image");
+            }
+        }
+    );
+}
+
 void image_processor::evaluate(std::size_t compile_id, cvpg::image_gray_8bit && image1, cvpg::image_gray_8bit && image2, std::function<void(item)> callback)
 {
     auto it = m_compiled.find(compile_id);
@@ -510,6 +679,63 @@ void image_processor::evaluate(std::size_t compile_id, cvpg::image_rgb_8bit && i
     }
 }
 
+void image_processor::evaluate(std::size_t compile_id, cvpg::image_yuv420_8bit && image1, cvpg::image_yuv420_8bit && image2, std::function<void(item)> callback)
+{
+    auto it = m_compiled.find(compile_id);
+
+    if (it != m_compiled.end())
+    {
+        auto compiled = it->second;
+
+        const std::size_t context_id = m_context_counter++;
+
+        auto context = std::make_shared<processing_context>(context_id);
+        context->store(0, std::move(image1));
+        context->store(2, std::move(image2));
+        context->set_parameters(m_params);
+
+        m_context.insert({ context_id, context });
+
+        post_callback(
+            [compiled = std::move(compiled)
+            ,context]() mutable
+            {
+                return executor(std::move(compiled), context);
+            },
+            [this, context_id, callback](auto cont_res)
+            {
+                try
+                {
+                    auto item = std::move(cont_res.get())->load();
+
+                    this->m_context.erase(context_id);
+
+                    callback(std::move(item));
+                }
+                catch (std::exception const & e)
+                {
+                    this->m_context.erase(context_id);
+
+                    callback(item(cvpg::imageproc::scripting::item::types::error, std::string(e.what())));
+                }
+                catch (...)
+                {
+                    this->m_context.erase(context_id);
+
+                    callback(item(cvpg::imageproc::scripting::item::types::error, std::string("unknown exception")));
+                }
+            },
+            "image_processor::evaluate::image_yuv420_8bit_2x",
+            1,
+            1
+        );
+    }
+    else
+    {
+        callback(item(cvpg::imageproc::scripting::item::types::error, std::string("invalid context ID")));
+    }
+}
+
 void image_processor::evaluate_convert_if(std::size_t compile_id, cvpg::image_gray_8bit && image1, cvpg::image_gray_8bit && image2, std::function<void(cvpg::image_gray_8bit)> callback, std::function<void(std::size_t, std::string)> failed_callback)
 {
     evaluate(
@@ -604,6 +830,127 @@ void image_processor::evaluate_convert_if(std::size_t compile_id, cvpg::image_rg
     );
 }
 
+void image_processor::evaluate_convert_if(std::size_t compile_id, cvpg::image_yuv420_8bit && image1, cvpg::image_yuv420_8bit && image2, std::function<void(cvpg::image_yuv420_8bit)> callback, std::function<void(std::size_t, std::string)> failed_callback)
+{
+    evaluate(
+        compile_id,
+        std::move(image1),
+        std::move(image2),
+        [this, compile_id, callback = std::move(callback), failed_callback = std::move(failed_callback)](auto item) mutable
+        {
+            if (item.type() == cvpg::imageproc::scripting::item::types::yuv420_8_bit_image)
+            {
+                callback(std::move(std::any_cast<cvpg::image_yuv420_8bit>(std::move(item.value()))));
+            }
+            else if (item.type() == cvpg::imageproc::scripting::item::types::grayscale_8_bit_image)
+            {
+                this->post_callback(
+                    [image = std::move(std::any_cast<cvpg::image_gray_8bit>(std::move(item.value())))]()
+                    {
+                        return imageproc::algorithms::convert_to_yuv420(std::move(image));
+                    },
+                    [compile_id, callback = std::move(callback), failed_callback = std::move(failed_callback)](auto cont_res) mutable
+                    {
+                        try
+                        {
+                            callback(std::move(cont_res.get()));
+                        }
+                        catch (std::exception const & e)
+                        {
+                            failed_callback(compile_id, e.what());
+                        }
+                    },
+                    "image_processor::evaluate_convert_if::image_yuv420_8bit_2x::callback::image_gray_8bit",
+                    1,
+                    1
+                );
+            }
+            else if (item.type() == cvpg::imageproc::scripting::item::types::rgb_8_bit_image)
+            {
+                this->post_callback(
+                    [image = std::move(std::any_cast<cvpg::image_rgb_8bit>(std::move(item.value())))]()
+                    {
+                        return imageproc::algorithms::convert_to_yuv420(std::move(image));
+                    },
+                    [compile_id, callback = std::move(callback), failed_callback = std::move(failed_callback)](auto cont_res) mutable
+                    {
+                        try
+                        {
+                            callback(std::move(cont_res.get()));
+                        }
+                        catch (std::exception const & e)
+                        {
+                            failed_callback(compile_id, e.what());
+                        }
+                    },
+                    "image_processor::evaluate_convert_if::image_yuv420_8bit_2x::callback::image_rgb_8bit",
+                    1,
+                    1
+                );
+            }
+            else if (item.type() == cvpg::imageproc::scripting::item::types::error)
+            {
+                failed_callback(compile_id, std::any_cast<std::string>(std::move(item.value())));
+            }
+            else
+            {
+                failed_callback(compile_id, "invalid result during evaluation of an image");
+            }
+        }
+    );
+}
+
+void image_processor::evaluate(std::size_t compile_id, std::vector<cvpg::image_gray_8bit> images, std::function<void(item)> callback)
+{
+    evaluate_window(compile_id, std::move(images), std::move(callback));
+}
+
+void image_processor::evaluate(std::size_t compile_id, std::vector<cvpg::image_rgb_8bit> images, std::function<void(item)> callback)
+{
+    evaluate_window(compile_id, std::move(images), std::move(callback));
+}
+
+void image_processor::evaluate(std::size_t compile_id, std::vector<cvpg::image_yuv420_8bit> images, std::function<void(item)> callback)
+{
+    evaluate_window(compile_id, std::move(images), std::move(callback));
+}
+
+void image_processor::evaluate_convert_if(std::size_t compile_id, std::vector<cvpg::image_gray_8bit> images, std::function<void(cvpg::image_gray_8bit)> callback, std::function<void(std::size_t, std::string)> failed_callback)
+{
+    evaluate_window(
+        compile_id,
+        std::move(images),
+        [this, compile_id, callback = std::move(callback), failed_callback = std::move(failed_callback)](auto item) mutable
+        {
+            convert_result(compile_id, std::move(item), std::move(callback), std::move(failed_callback));
+        }
+    );
+}
+
+void image_processor::evaluate_convert_if(std::size_t compile_id, std::vector<cvpg::image_rgb_8bit> images, std::function<void(cvpg::image_rgb_8bit)> callback, std::function<void(std::size_t, std::string)> failed_callback)
+{
+    evaluate_window(
+        compile_id,
+        std::move(images),
+        [this, compile_id, callback = std::move(callback), failed_callback = std::move(failed_callback)](auto item) mutable
+        {
+            convert_result(compile_id, std::move(item), std::move(callback), std::move(failed_callback));
+        }
+    );
+}
+
+void image_processor::evaluate_convert_if(std::size_t compile_id, std::vector<cvpg::image_yuv420_8bit> images, std::function<void(cvpg::image_yuv420_8bit)> callback, std::function<void(std::size_t, std::string)> failed_callback)
+{
+    evaluate_window(
+        compile_id,
+        std::move(images),
+        [this, compile_id, callback = std::move(callback), failed_callback = std::move(failed_callback)](auto item) mutable
+        {
+            convert_result(compile_id, std::move(item), std::move(callback), std::move(failed_callback));
+        }
+    );
+}
+
 void image_processor::add_param(std::string key, std::any value)
 {
     m_params.insert({ std::move(key), std::move(value) });
@@ -614,4 +961,160 @@ void image_processor::parameters(std::function<void(parameters_type)> callback)
     callback(m_params);
 }
 
+template<typename Image>
+void image_processor::evaluate_window(std::size_t compile_id, std::vector<Image> images, std::function<void(item)> callback)
+{
+    auto it = m_compiled.find(compile_id);
+
+    if (it == m_compiled.end())
+    {
+        callback(item(cvpg::imageproc::scripting::item::types::error, std::string("invalid context ID")));
+
+        return;
+    }
+
+    if (images.empty())
+    {
+        callback(item(cvpg::imageproc::scripting::item::types::error, std::string("no images to evaluate")));
+
+        return;
+    }
+
+    auto compiled = it->second;
+
+    const std::size_t context_id = m_context_counter++;
+
+    auto context = std::make_shared<processing_context>(context_id);
+
+    // copies of an image share the pixels, so storing an image under several IDs copies no pixel data
+    if (images.size() >= 2)
+    {
+        // scripts written for pairs of images get the previous image as source 1 and the newest one as source 3
+        context->store(0, Image(images[1]));
+        context->store(2, Image(images[0]));
+    }
+    else
+    {
+        context->store(0, Image(images[0]));
+    }
+
+    for (std::size_t k = 0; k < images.size(); ++k)
+    {
+        context->store(processing_context::window_image_id(static_cast<std::uint32_t>(k)), std::move(images[k]));
+    }
+
+    context->set_parameters(m_params);
+
+    m_context.insert({ context_id, context });
+
+    post_callback(
+        [compiled = std::move(compiled)
+        ,context]() mutable
+        {
+            return executor(std::move(compiled), context);
+        },
+        [this, context_id, callback](auto cont_res)
+        {
+            try
+            {
+                auto item = std::move(cont_res.get())->load();
+
+                this->m_context.erase(context_id);
+
+                callback(std::move(item));
+            }
+            catch (std::exception const & e)
+            {
+                this->m_context.erase(context_id);
+
+                callback(item(cvpg::imageproc::scripting::item::types::error, std::string(e.what())));
+            }
+            catch (...)
+            {
+                this->m_context.erase(context_id);
+
+                callback(item(cvpg::imageproc::scripting::item::types::error, std::string("unknown exception")));
+            }
+        },
+        "image_processor::evaluate::window",
+        1,
+        1
+    );
+}
+
+template<typename Image>
+void image_processor::convert_result(std::size_t compile_id, item result, std::function<void(Image)> callback, std::function<void(std::size_t, std::string)> failed_callback)
+{
+    if (result.type() == item_type<Image>())
+    {
+        callback(std::move(std::any_cast<Image>(std::move(result.value()))));
+
+        return;
+    }
+
+    if (result.type() == cvpg::imageproc::scripting::item::types::error)
+    {
+        failed_callback(compile_id, std::any_cast<std::string>(std::move(result.value())));
+
+        return;
+    }
+
+    auto convert =
+        [this, compile_id, &callback, &failed_callback](auto image)
+        {
+            this->post_callback(
+                [image = std::move(image)]() mutable
+                {
+                    return convert_to<Image>(std::move(image));
+                },
+                [compile_id, callback = std::move(callback), failed_callback = std::move(failed_callback)](auto cont_res) mutable
+                {
+                    try
+                    {
+                        callback(std::move(cont_res.get()));
+                    }
+                    catch (std::exception const & e)
+                    {
+                        failed_callback(compile_id, e.what());
+                    }
+                },
+                "image_processor::evaluate_convert_if::window::callback",
+                1,
+                1
+            );
+        };
+
+    if constexpr (!std::is_same_v<Image, cvpg::image_gray_8bit>)
+    {
+        if (result.type() == cvpg::imageproc::scripting::item::types::grayscale_8_bit_image)
+        {
+            convert(std::move(std::any_cast<cvpg::image_gray_8bit>(std::move(result.value()))));
+
+            return;
+        }
+    }
+
+    if constexpr (!std::is_same_v<Image, cvpg::image_rgb_8bit>)
+    {
+        if (result.type() == cvpg::imageproc::scripting::item::types::rgb_8_bit_image)
+        {
+            convert(std::move(std::any_cast<cvpg::image_rgb_8bit>(std::move(result.value()))));
+
+            return;
+        }
+    }
+
+    if constexpr (!std::is_same_v<Image, cvpg::image_yuv420_8bit>)
+    {
+        if (result.type() == cvpg::imageproc::scripting::item::types::yuv420_8_bit_image)
+        {
+            convert(std::move(std::any_cast<cvpg::image_yuv420_8bit>(std::move(result.value()))));
+
+            return;
+        }
+    }
+
+    failed_callback(compile_id, "invalid result during evaluation of an image");
+}
+
 } // namespace cvpg::imageproc::scripting
@@ -11,6 +11,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <boost/asynchronous/servant_proxy.hpp>
 #include <boost/asynchronous/trackable_servant.hpp>
@@ -47,18 +48,33 @@ public:
     // evaluate an input image
     void evaluate(std::size_t compile_id, cvpg::image_gray_8bit && image, std::function<void(item)> callback);
     void evaluate(std::size_t compile_id, cvpg::image_rgb_8bit && image, std::function<void(item)> callback);
+    void evaluate(std::size_t compile_id, cvpg::image_yuv420_8bit && image, std::function<void(item)> callback);
 
     // evaluate an input image and convert the result if it is not the same as the input type
     void evaluate_convert_if(std::size_t compile_id, cvpg::image_gray_8bit && image, std::function<void(cvpg::image_gray_8bit)> callback, std::function<void(std::size_t, std::string)> failed_callback);
     void evaluate_convert_if(std::size_t compile_id, cvpg::image_rgb_8bit && image, std::function<void(cvpg::image_rgb_8bit)> callback, std::function<void(std::size_t, std::string)> failed_callback);
+    void evaluate_convert_if(std::size_t compile_id, cvpg::image_yuv420_8bit && image, std::function<void(cvpg::image_yuv420_8bit)> callback, std::function<void(std::size_t, std::string)> failed_callback);
 
     // evaluate two input images
     void evaluate(std::size_t compile_id, cvpg::image_gray_8bit && image1, cvpg::image_gray_8bit && image2, std::function<void(item)> callback);
     void evaluate(std::size_t compile_id, cvpg::image_rgb_8bit && image1, cvpg::image_rgb_8bit && image2, std::function<void(item)> callback);
+    void evaluate(std::size_t compile_id, cvpg::image_yuv420_8bit && image1, cvpg::image_yuv420_8bit && image2, std::function<void(item)> callback);
 
     // evaluate two input images and convert the result if it is not the same as the input type
     void evaluate_convert_if(std::size_t compile_id, cvpg::image_gray_8bit && image1, cvpg::image_gray_8bit &&image2, std::function<void(cvpg::image_gray_8bit)> callback, std::function<void(std::size_t, std::string)> failed_callback);
     void evaluate_convert_if(std::size_t compile_id, cvpg::image_rgb_8bit && image1, cvpg::image_rgb_8bit && image2, std::function<void(cvpg::image_rgb_8bit)> callback, std::function<void(std::size_t, std::string)> failed_callback);
+    void evaluate_convert_if(std::size_t compile_id, cvpg::image_yuv420_8bit && image1, cvpg::image_yuv420_8bit && image2, std::function<void(cvpg::image_yuv420_8bit)> callback, std::function<void(std::size_t, std::string)> failed_callback);
+
+    // evaluate a window of input images ordered newest first ; the script gets image 'k' with 'input(k)', so
+    // 'input(0)' is the newest and 'input(images.size() - 1)' the oldest image
+    void evaluate(std::size_t compile_id, std::vector<cvpg::image_gray_8bit> images, std::function<void(item)> callback);
+    void evaluate(std::size_t compile_id, std::vector<cvpg::image_rgb_8bit> images, std::function<void(item)> callback);
+    void evaluate(std::size_t compile_id, std::vector<cvpg::image_yuv420_8bit> images, std::function<void(item)> callback);
+
+    // evaluate a window of input images and convert the result if it is not the same as the input type
+    void evaluate_convert_if(std::size_t compile_id, std::vector<cvpg::image_gray_8bit> images, std::function<void(cvpg::image_gray_8bit)> callback, std::function<void(std::size_t, std::string)> failed_callback);
+    void evaluate_convert_if(std::size_t compile_id, std::vector<cvpg::image_rgb_8bit> images, std::function<void(cvpg::image_rgb_8bit)> callback, std::function<void(std::size_t, std::string)> failed_callback);
+    void evaluate_convert_if(std::size_t compile_id, std::vector<cvpg::image_yuv420_8bit> images, std::function<void(cvpg::image_yuv420_8bit)> callback, std::function<void(std::size_t, std::string)> failed_callback);
 
     // add a parameter for filters
     void add_param(std::string key, std::any value);
@@ -67,6 +83,12 @@ public:
     void parameters(std::function<void(parameters_type)> callback) const;
 
 private:
+    template<typename Image>
+    void evaluate_window(std::size_t compile_id, std::vector<Image> images, std::function<void(item)> callback);
+
+    template<typename Image>
+    void convert_result(std::size_t compile_id, item result, std::function<void(Image)> callback, std::function<void(std::size_t, std::string)> failed_callback);
+
     algorithm_set m_algorithms;
 
     std::map<std::size_t, detail::compiler::result> m_compiled;
@@ -38,6 +38,10 @@ std::ostream & operator<<(std::ostream & out, item::types const & type)
             out << "RGB 8-bit image";
             break;
 
+        case item::types::yuv420_8_bit_image:
+            out << "YUV 4:2:0 8-bit image";
+            break;
+
         case item::types::binary_mask:
             out << "binary mask";
             break;
@@ -94,6 +98,12 @@ std::ostream & operator<<(std::ostream & out, item const & i)
                 break;
             }
 
+            case item::types::yuv420_8_bit_image:
+            {
+                out << "(" << std::any_cast<image_yuv420_8bit>(i.value()) << ")";
+                break;
+            }
+
             case item::types::binary_mask:
             {
                 // TODO implement me
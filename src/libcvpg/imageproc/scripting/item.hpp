@@ -29,6 +29,7 @@ public:
         invalid,
         grayscale_8_bit_image,
         rgb_8_bit_image,
+        yuv420_8_bit_image,
         binary_mask,
         signed_integer,
         real,
@@ -28,6 +28,13 @@ void processing_context::store(std::uint32_t image_id, cvpg::image_rgb_8bit && i
     m_last_stored = image_id;
 }
 
+void processing_context::store(std::uint32_t image_id, cvpg::image_yuv420_8bit && image, std::chrono::microseconds duration)
+{
+    m_items[image_id] = item(item::types::yuv420_8_bit_image, std::move(image));
+    m_durations[image_id] = std::move(duration);
+    m_last_stored = image_id;
+}
+
 item processing_context::load(std::uint32_t image_id) const
 {
     auto it = m_items.find(image_id);
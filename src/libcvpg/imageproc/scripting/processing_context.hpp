@@ -25,9 +25,16 @@ public:
 
     std::size_t id() const;
 
+    // ID of the image 'k' of a window of input images (0 is the newest image) ; far above the IDs of the items of a script
+    static constexpr std::uint32_t window_image_id(std::uint32_t k)
+    {
+        return 0xffff0000 + k;
+    }
+
     // store an image
     void store(std::uint32_t image_id, cvpg::image_gray_8bit && image, std::chrono::microseconds duration = std::chrono::microseconds());
     void store(std::uint32_t image_id, cvpg::image_rgb_8bit && image, std::chrono::microseconds duration = std::chrono::microseconds());
+    void store(std::uint32_t image_id, cvpg::image_yuv420_8bit && image, std::chrono::microseconds duration = std::chrono::microseconds());
 
     // load an item with a specific ID
     item load(std::uint32_t image_id) const;
@@ -0,0 +1,156 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/videoproc/fair_queue.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace cvpg::videoproc {
+
+fair_queue::fair_queue(std::size_t max_running)
+    : m_max_running(std::max<std::size_t>(max_running, 1))
+    , m_mutex()
+    , m_streams()
+{}
+
+std::size_t fair_queue::add_stream(std::string name, double weight)
+{
+    if (!(weight > 0.0))
+    {
+        throw std::invalid_argument("weight of a stream has to be greater than zero");
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    stream_info info;
+    info.statistics.name = std::move(name);
+    info.statistics.weight = weight;
+
+    m_streams.push_back(std::move(info));
+
+    return m_streams.size() - 1;
+}
+
+void fair_queue::submit(std::size_t stream, std::size_t cost, job_type job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto & s = m_streams.at(stream);
+
+        // a stream that was idle doesn't get credit for the time it was idle
+        entry e;
+        e.job = std::move(job);
+        e.start_tag = std::max(m_virtual_time, s.finish_tag);
+        e.submitted = clock_type::now();
+
+        s.finish_tag = e.start_tag + static_cast<double>(std::max<std::size_t>(cost, 1)) / s.statistics.weight;
+
+        s.jobs.push_back(std::move(e));
+
+        s.statistics.submitted++;
+        s.statistics.queued++;
+    }
+
+    dispatch();
+}
+
+std::vector<fair_queue::stream_statistics> fair_queue::statistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<stream_statistics> result;
+    result.reserve(m_streams.size());
+
+    for (auto const & s : m_streams)
+    {
+        result.push_back(s.statistics);
+    }
+
+    return result;
+}
+
+std::size_t fair_queue::max_running() const
+{
+    return m_max_running;
+}
+
+void fair_queue::complete(std::size_t stream, clock_type::time_point submitted)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto & statistics = m_streams[stream].statistics;
+
+        const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - submitted);
+
+        statistics.running--;
+        statistics.completed++;
+        statistics.sum_latency += latency;
+        statistics.max_latency = std::max(statistics.max_latency, latency);
+
+        --m_running;
+    }
+
+    dispatch();
+}
+
+void fair_queue::dispatch()
+{
+    std::vector<std::pair<job_type, std::function<void()> > > started;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        while (m_running < m_max_running)
+        {
+            // the waiting job with the lowest start tag is the next one
+            std::size_t next = m_streams.size();
+            double next_tag = std::numeric_limits<double>::max();
+
+            for (std::size_t i = 0; i < m_streams.size(); ++i)
+            {
+                if (!m_streams[i].jobs.empty() && m_streams[i].jobs.front().start_tag < next_tag)
+                {
+                    next = i;
+                    next_tag = m_streams[i].jobs.front().start_tag;
+                }
+            }
+
+            if (next == m_streams.size())
+            {
+                break;
+            }
+
+            auto & s = m_streams[next];
+
+            entry e = std::move(s.jobs.front());
+            s.jobs.pop_front();
+
+            s.statistics.queued--;
+            s.statistics.running++;
+            s.statistics.sum_wait += std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - e.submitted);
+
+            m_virtual_time = e.start_tag;
+            ++m_running;
+
+            started.emplace_back(
+                std::move(e.job),
+                [self = shared_from_this(), stream = next, submitted = e.submitted]()
+                {
+                    self->complete(stream, submitted);
+                }
+            );
+        }
+    }
+
+    // run the jobs without holding the lock, they could complete immediately
+    for (auto & [job, done] : started)
+    {
+        job(std::move(done));
+    }
+}
+
+} // namespace cvpg::videoproc
@@ -0,0 +1,119 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_FAIR_QUEUE_HPP
+#define LIBCVPG_VIDEOPROC_FAIR_QUEUE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cvpg::videoproc {
+
+//
+// A fair queue shares a limited amount of concurrently running jobs between multiple streams. Each
+// stream gets a share of the running jobs weighted by its cost (e.g. the bytes of a frame) and the
+// weight of the stream (start-time fair queuing). Jobs of the same stream are started in the order
+// they were submitted.
+//
+// Jobs are started at the thread that submits a job or completes a previous job. A job gets a function
+// that has to be called (at any thread) when the job is done. All functions can be called from
+// different threads. The queue has to be created by 'std::make_shared'.
+//
+class fair_queue : public std::enable_shared_from_this<fair_queue>
+{
+public:
+    using job_type = std::function<void(std::function<void()>)>;
+
+    struct stream_statistics
+    {
+        std::string name;
+        double weight = 1.0;
+
+        std::size_t submitted = 0;
+        std::size_t completed = 0;
+
+        // amount of jobs waiting and running at the moment
+        std::size_t queued = 0;
+        std::size_t running = 0;
+
+        // times between submitting and starting and between submitting and completing the jobs
+        std::chrono::nanoseconds sum_wait = std::chrono::nanoseconds(0);
+        std::chrono::nanoseconds sum_latency = std::chrono::nanoseconds(0);
+        std::chrono::nanoseconds max_latency = std::chrono::nanoseconds(0);
+    };
+
+    explicit fair_queue(std::size_t max_running);
+
+    fair_queue(fair_queue const &) = delete;
+    fair_queue(fair_queue &&) = delete;
+
+    fair_queue & operator=(fair_queue const &) = delete;
+    fair_queue & operator=(fair_queue &&) = delete;
+
+    ~fair_queue() = default;
+
+    // add a stream and return its ID
+    std::size_t add_stream(std::string name, double weight = 1.0);
+
+    void submit(std::size_t stream, std::size_t cost, job_type job);
+
+    std::vector<stream_statistics> statistics() const;
+
+    std::size_t max_running() const;
+
+private:
+    using clock_type = std::chrono::steady_clock;
+
+    struct entry
+    {
+        job_type job;
+
+        double start_tag = 0.0;
+
+        clock_type::time_point submitted;
+    };
+
+    struct stream_info
+    {
+        stream_statistics statistics;
+
+        std::deque<entry> jobs;
+
+        // finish tag of the last submitted job
+        double finish_tag = 0.0;
+    };
+
+    void complete(std::size_t stream, clock_type::time_point submitted);
+
+    // start waiting jobs as long as the maximum amount of running jobs isn't reached
+    void dispatch();
+
+    const std::size_t m_max_running;
+
+    mutable std::mutex m_mutex;
+
+    std::size_t m_running = 0;
+
+    // virtual time ; start tag of the last started job
+    double m_virtual_time = 0.0;
+
+    std::vector<stream_info> m_streams;
+};
+
+// a stream of a fair queue ; all stages of a pipeline use the same stream
+struct fair_share
+{
+    std::shared_ptr<fair_queue> queue;
+
+    std::size_t stream = 0;
+};
+
+} // namespace cvpg::videoproc
+
+#endif // LIBCVPG_VIDEOPROC_FAIR_QUEUE_HPP
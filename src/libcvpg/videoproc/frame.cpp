@@ -3,6 +3,9 @@
 
 #include <libcvpg/videoproc/frame.hpp>
 
+#include <cstring>
+#include <type_traits>
+
 namespace cvpg::videoproc {
 
 template<typename Image> frame<Image>::frame(std::size_t number)
@@ -32,14 +35,115 @@ template<typename Image> typename frame<Image>::image_type frame<Image>::move_im
     return std::move(m_image);
 }
 
+template<typename Image> typename frame<Image>::image_type frame<Image>::move_dense_image()
+{
+    if constexpr (std::is_same_v<image_type, image_yuv420_8bit>)
+    {
+        // YUV images are converted before they are used by the image processing algorithms
+        return std::move(m_image);
+    }
+    else
+    {
+        if (m_image.padding() == 0)
+        {
+            return std::move(m_image);
+        }
+
+        image_type image(m_image.width(), m_image.height(), 0);
+
+        const std::size_t stride = m_image.width() + m_image.padding();
+
+        for (std::uint8_t c = 0; c < std::tuple_size<typename image_type::channel_array_type>::value; ++c)
+        {
+            auto src = m_image.data(c).get();
+            auto dst = image.data(c).get();
+
+            for (std::size_t y = 0; y < m_image.height(); ++y)
+            {
+                std::memcpy(dst + y * m_image.width(), src + y * stride, m_image.width() * sizeof(typename image_type::pixel_type));
+            }
+        }
+
+        if (m_image.has_metadata())
+        {
+            image.set_metadata(m_image.get_metadata());
+        }
+
+        m_image = image_type();
+
+        return image;
+    }
+}
+
 template<typename Image> bool frame<Image>::flush() const
 {
     return m_flush;
 }
 
+template<typename Image> std::size_t frame<Image>::bytes() const
+{
+    if (m_flush)
+    {
+        return 0;
+    }
+
+    if constexpr (std::is_same_v<image_type, image_yuv420_8bit>)
+    {
+        std::size_t bytes = 0;
+
+        for (std::uint8_t p = 0; p < 3; ++p)
+        {
+            bytes += static_cast<std::size_t>(m_image.stride(p)) * m_image.plane_height(p);
+        }
+
+        return bytes;
+    }
+    else
+    {
+        return static_cast<std::size_t>(m_image.width() + m_image.padding()) * m_image.height() * std::tuple_size<typename image_type::channel_array_type>::value;
+    }
+}
+
+template<typename Image> std::int64_t frame<Image>::pts() const
+{
+    return m_timestamps.pts;
+}
+
+template<typename Image> frame_timestamps const & frame<Image>::timestamps() const
+{
+    return m_timestamps;
+}
+
+template<typename Image> void frame<Image>::set_timestamps(frame_timestamps timestamps)
+{
+    m_timestamps = std::move(timestamps);
+}
+
+template<typename Image> void frame<Image>::enter_stage(char const * stage)
+{
+    m_timestamps.stages.push_back({ stage, frame_timestamps::clock::now() });
+}
+
+template<typename Image> std::shared_ptr<source_packet const> const & frame<Image>::source() const
+{
+    return m_source;
+}
+
+template<typename Image> void frame<Image>::set_source(std::shared_ptr<source_packet const> source, bool modified)
+{
+    m_source = std::move(source);
+    m_modified = modified;
+}
+
+template<typename Image> bool frame<Image>::modified() const
+{
+    return m_modified;
+}
+
 // manual instantiation of frame<> for some types
 template class frame<image_gray_8bit>;
 template class frame<image_rgb_8bit>;
+template class frame<image_yuv420_8bit>;
 
 template<typename Image> std::ostream & operator<<(std::ostream & out, frame<Image> const & frame)
 {
@@ -51,6 +155,7 @@ template<typename Image> std::ostream & operator<<(std::ostream & out, frame<Ima
 // manual instantiation of operator<< for some types
 template std::ostream & operator<< <image_gray_8bit>(std::ostream &, frame<image_gray_8bit> const &);
 template std::ostream & operator<< <image_rgb_8bit>(std::ostream &, frame<image_rgb_8bit> const &);
+template std::ostream & operator<< <image_yuv420_8bit>(std::ostream &, frame<image_yuv420_8bit> const &);
 
 template<typename Image> bool operator<(frame<Image> const & a, frame<Image> const & b)
 {
@@ -60,6 +165,7 @@ template<typename Image> bool operator<(frame<Image> const & a, frame<Image> con
 // manual instantiation of operator< for some types
 template bool operator< <image_gray_8bit>(frame<image_gray_8bit> const &, frame<image_gray_8bit> const &);
 template bool operator< <image_rgb_8bit>(frame<image_rgb_8bit> const &, frame<image_rgb_8bit> const &);
+template bool operator< <image_yuv420_8bit>(frame<image_yuv420_8bit> const &, frame<image_yuv420_8bit> const &);
 
 template<typename Image> bool operator>(frame<Image> const & a, frame<Image> const & b)
 {
@@ -69,5 +175,6 @@ template<typename Image> bool operator>(frame<Image> const & a, frame<Image> con
 // manual instantiation of operator> for some types
 template bool operator> <image_gray_8bit>(frame<image_gray_8bit> const &, frame<image_gray_8bit> const &);
 template bool operator> <image_rgb_8bit>(frame<image_rgb_8bit> const &, frame<image_rgb_8bit> const &);
+template bool operator> <image_yuv420_8bit>(frame<image_yuv420_8bit> const &, frame<image_yuv420_8bit> const &);
 
 } // namespace cvpg::videoproc
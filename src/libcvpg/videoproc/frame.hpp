@@ -6,13 +6,71 @@
 
 #include <libcvpg/core/image.hpp>
 
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <ostream>
+#include <vector>
 
 namespace cvpg::videoproc {
 
 //
-// A frame represents a single image inside a video stream. Frames consists of the image data and
-// a number of the frame inside the video stream.
+// Timestamps of a frame. The presentation timestamp is given in the time base of the source stream.
+// Each stage records the time a frame entered it, so the latency of the stages could be measured for
+// each single frame.
+//
+struct frame_timestamps
+{
+    using clock = std::chrono::steady_clock;
+
+    // presentation timestamp of a frame without a known timestamp
+    static constexpr std::int64_t no_pts = std::numeric_limits<std::int64_t>::min();
+
+    std::int64_t pts = no_pts;
+
+    // time the frame was decoded by the source
+    clock::time_point decoded;
+
+    struct stage_entry
+    {
+        // name of the stage (a string literal)
+        char const * stage = nullptr;
+
+        clock::time_point entered;
+    };
+
+    // stages passed by the frame in order
+    std::vector<stage_entry> stages;
+};
+
+//
+// Compressed packet of the source stream a frame was decoded from. Packets are forwarded by a source
+// to allow a sink to write a GOP of the source stream again without encoding it. The packets of a GOP
+// are numbered in decode order, starting with the keyframe.
+//
+struct source_packet
+{
+    // codec of the source stream (an 'AVCodecID')
+    int codec_id = 0;
+
+    // number of the GOP at the source stream
+    std::size_t gop = 0;
+
+    // position of the packet inside its GOP in decode order
+    std::size_t index = 0;
+
+    // timestamps of the packet in the time base of the source stream
+    std::int64_t pts = 0;
+    std::int64_t dts = 0;
+
+    // packet data in a format that can be concatenated to an elementary stream (e.g. Annex B for H.264)
+    std::vector<std::uint8_t> data;
+};
+
+//
+// A frame represents a single image inside a video stream. Frames consists of the image data,
+// a number of the frame inside the video stream and the timestamps of the frame.
 //
 // If a video stream is finished a so called 'flush' frame indicates the end of video stream.
 //
@@ -39,20 +97,55 @@ public:
 
     image_type move_image();
 
+    // move the image out of the frame ; an image with padding (e.g. referring to the buffers of the
+    // decoder) is copied to an image without padding as expected by the image processing algorithms
+    image_type move_dense_image();
+
     // check if the frame is a flush frame
     bool flush() const;
 
+    // get the amount of bytes of the image data (including padding)
+    std::size_t bytes() const;
+
+    // get the presentation timestamp in the time base of the source stream
+    std::int64_t pts() const;
+
+    frame_timestamps const & timestamps() const;
+
+    // set the timestamps, e.g. of the frame a new frame was processed from
+    void set_timestamps(frame_timestamps timestamps);
+
+    // record that the frame entered the given stage now
+    void enter_stage(char const * stage);
+
+    // get the compressed packet of the source stream the frame was decoded from (if forwarded)
+    std::shared_ptr<source_packet const> const & source() const;
+
+    // set the source packet, e.g. of the frame a new frame was processed from ; 'modified' marks a
+    // frame whose image differs from the decoded image of the source packet
+    void set_source(std::shared_ptr<source_packet const> source, bool modified = false);
+
+    // check if the image of the frame differs from the decoded image of its source packet
+    bool modified() const;
+
 private:
     std::size_t m_number = 0;
 
     image_type m_image;
 
     bool m_flush = false;
+
+    frame_timestamps m_timestamps;
+
+    std::shared_ptr<source_packet const> m_source;
+
+    bool m_modified = false;
 };
 
 // suppress automatic instantiation of frame<> for some types
 extern template class frame<image_gray_8bit>;
 extern template class frame<image_rgb_8bit>;
+extern template class frame<image_yuv420_8bit>;
 
 template<typename Image>
 std::ostream & operator<<(std::ostream & out, frame<Image> const & frame);
@@ -60,6 +153,7 @@ std::ostream & operator<<(std::ostream & out, frame<Image> const & frame);
 // suppress automatic instantiation of operator<< for some types
 extern template std::ostream & operator<< <image_gray_8bit>(std::ostream &, frame<image_gray_8bit> const &);
 extern template std::ostream & operator<< <image_rgb_8bit>(std::ostream &, frame<image_rgb_8bit> const &);
+extern template std::ostream & operator<< <image_yuv420_8bit>(std::ostream &, frame<image_yuv420_8bit> const &);
 
 template<typename Image>
 bool operator<(frame<Image> const & a, frame<Image> const & b);
@@ -67,6 +161,7 @@ bool operator<(frame<Image> const & a, frame<Image> const & b);
 // suppress automatic instantiation of operator< for some types
 extern template bool operator< <image_gray_8bit>(frame<image_gray_8bit> const &, frame<image_gray_8bit> const &);
 extern template bool operator< <image_rgb_8bit>(frame<image_rgb_8bit> const &, frame<image_rgb_8bit> const &);
+extern template bool operator< <image_yuv420_8bit>(frame<image_yuv420_8bit> const &, frame<image_yuv420_8bit> const &);
 
 template<typename Image>
 bool operator>(frame<Image> const & a, frame<Image> const & b);
@@ -74,6 +169,7 @@ bool operator>(frame<Image> const & a, frame<Image> const & b);
 // suppress automatic instantiation of operator> for some types
 extern template bool operator> <image_gray_8bit>(frame<image_gray_8bit> const &, frame<image_gray_8bit> const &);
 extern template bool operator> <image_rgb_8bit>(frame<image_rgb_8bit> const &, frame<image_rgb_8bit> const &);
+extern template bool operator> <image_yuv420_8bit>(frame<image_yuv420_8bit> const &, frame<image_yuv420_8bit> const &);
 
 } // namespace cvpg::videoproc
 
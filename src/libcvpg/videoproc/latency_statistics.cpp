@@ -0,0 +1,178 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/videoproc/latency_statistics.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+std::size_t bucket_index(std::int64_t value, std::size_t sub_buckets)
+{
+    if (value <= 0)
+    {
+        return 0;
+    }
+
+    const auto v = static_cast<std::uint64_t>(value);
+
+    if (v < sub_buckets)
+    {
+        return static_cast<std::size_t>(v);
+    }
+
+    // position of the highest bit ; the next 4 bits select the sub bucket
+    const std::size_t exponent = 63 - static_cast<std::size_t>(__builtin_clzll(v));
+    const std::size_t sub = static_cast<std::size_t>(v >> (exponent - 4)) - sub_buckets;
+
+    return sub_buckets + (exponent - 4) * sub_buckets + sub;
+}
+
+// value in the middle of a bucket
+std::int64_t bucket_value(std::size_t index, std::size_t sub_buckets)
+{
+    if (index < sub_buckets)
+    {
+        return static_cast<std::int64_t>(index);
+    }
+
+    const std::size_t exponent = (index - sub_buckets) / sub_buckets + 4;
+    const std::size_t sub = (index - sub_buckets) % sub_buckets;
+
+    const std::uint64_t lower = static_cast<std::uint64_t>(sub_buckets + sub) << (exponent - 4);
+    const std::uint64_t width = std::uint64_t(1) << (exponent - 4);
+
+    return static_cast<std::int64_t>(lower + width / 2);
+}
+
+}
+
+namespace cvpg::videoproc {
+
+void latency_statistics::histogram::add(std::int64_t value)
+{
+    ++counts[bucket_index(value, sub_buckets)];
+    ++count;
+
+    max = std::max(max, value);
+}
+
+std::int64_t latency_statistics::histogram::percentile(double p) const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    // rank of the wanted latency (1-based)
+    const auto rank = std::max<std::uint64_t>(static_cast<std::uint64_t>(std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(count))), 1);
+
+    std::uint64_t counted = 0;
+
+    for (std::size_t i = 0; i < buckets; ++i)
+    {
+        counted += counts[i];
+
+        if (counted >= rank)
+        {
+            return std::min(bucket_value(i, sub_buckets), max);
+        }
+    }
+
+    return max;
+}
+
+void latency_statistics::add(frame_timestamps const & timestamps, frame_timestamps::clock::time_point left)
+{
+    const bool decoded = timestamps.decoded.time_since_epoch().count() != 0;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (decoded)
+    {
+        add_locked(source, std::chrono::duration_cast<duration>((timestamps.stages.empty() ? left : timestamps.stages.front().entered) - timestamps.decoded));
+    }
+
+    for (std::size_t i = 0; i < timestamps.stages.size(); ++i)
+    {
+        const auto until = i + 1 < timestamps.stages.size() ? timestamps.stages[i + 1].entered : left;
+
+        add_locked(timestamps.stages[i].stage, std::chrono::duration_cast<duration>(until - timestamps.stages[i].entered));
+    }
+
+    if (decoded)
+    {
+        add_locked(total, std::chrono::duration_cast<duration>(left - timestamps.decoded));
+    }
+}
+
+void latency_statistics::add(std::string const & stage, duration latency)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    add_locked(stage, latency);
+}
+
+std::vector<std::string> latency_statistics::stages() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<std::string> names;
+    names.reserve(m_stages.size());
+
+    for (auto const & stage : m_stages)
+    {
+        names.push_back(stage.first);
+    }
+
+    return names;
+}
+
+std::size_t latency_statistics::count(std::string const & stage) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto h = find(stage);
+
+    return h != nullptr ? static_cast<std::size_t>(h->count) : 0;
+}
+
+latency_statistics::duration latency_statistics::percentile(std::string const & stage, double p) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto h = find(stage);
+
+    return duration(h != nullptr ? h->percentile(p) : 0);
+}
+
+latency_statistics::duration latency_statistics::max(std::string const & stage) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto h = find(stage);
+
+    return duration(h != nullptr ? h->max : 0);
+}
+
+void latency_statistics::add_locked(std::string const & stage, duration latency)
+{
+    auto it = std::find_if(m_stages.begin(), m_stages.end(), [&stage](auto const & s){ return s.first == stage; });
+
+    if (it == m_stages.end())
+    {
+        it = m_stages.insert(m_stages.end(), { stage, histogram() });
+    }
+
+    it->second.add(latency.count());
+}
+
+latency_statistics::histogram const * latency_statistics::find(std::string const & stage) const
+{
+    auto it = std::find_if(m_stages.begin(), m_stages.end(), [&stage](auto const & s){ return s.first == stage; });
+
+    return it != m_stages.end() ? &(it->second) : nullptr;
+}
+
+} // namespace cvpg::videoproc
@@ -0,0 +1,95 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_LATENCY_STATISTICS_HPP
+#define LIBCVPG_VIDEOPROC_LATENCY_STATISTICS_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <libcvpg/videoproc/frame.hpp>
+
+namespace cvpg::videoproc {
+
+//
+// Latency statistics of the stages of a pipeline. The latency of a stage is the time between a frame
+// entering the stage and entering the next stage (or leaving the pipeline). The latency of the source
+// lasts from decoding a frame until it entered the first stage, the total latency from decoding until
+// leaving the pipeline.
+//
+// The latencies are counted at histograms with a relative resolution of about 6%, so the memory used
+// doesn't grow with the length of a stream. All functions can be called from different threads.
+//
+class latency_statistics
+{
+public:
+    using duration = std::chrono::microseconds;
+
+    // name of the latencies from decoding a frame until it entered the first stage
+    static constexpr char const * source = "source";
+
+    // name of the latencies from decoding a frame until it left the pipeline
+    static constexpr char const * total = "total";
+
+    latency_statistics() = default;
+
+    latency_statistics(latency_statistics const &) = delete;
+    latency_statistics(latency_statistics &&) = delete;
+
+    latency_statistics & operator=(latency_statistics const &) = delete;
+    latency_statistics & operator=(latency_statistics &&) = delete;
+
+    ~latency_statistics() = default;
+
+    // add the latencies of all stages passed by a frame that left the pipeline at the given time
+    void add(frame_timestamps const & timestamps, frame_timestamps::clock::time_point left);
+
+    // add a single latency of a stage
+    void add(std::string const & stage, duration latency);
+
+    // names of all stages in order of their first latency
+    std::vector<std::string> stages() const;
+
+    // amount of latencies of a stage
+    std::size_t count(std::string const & stage) const;
+
+    // latency of a stage at the given percentile (0-100) ; 0 if there are no latencies
+    duration percentile(std::string const & stage, double p) const;
+
+    duration max(std::string const & stage) const;
+
+private:
+    struct histogram
+    {
+        // 16 linear buckets for the first microseconds followed by 16 buckets per power of two
+        static constexpr std::size_t sub_buckets = 16;
+        static constexpr std::size_t buckets = sub_buckets + 60 * sub_buckets;
+
+        std::array<std::uint64_t, buckets> counts = {};
+
+        std::uint64_t count = 0;
+
+        std::int64_t max = 0;
+
+        void add(std::int64_t value);
+
+        std::int64_t percentile(double p) const;
+    };
+
+    void add_locked(std::string const & stage, duration latency);
+
+    histogram const * find(std::string const & stage) const;
+
+    mutable std::mutex m_mutex;
+
+    std::vector<std::pair<std::string, histogram> > m_stages;
+};
+
+} // namespace cvpg::videoproc
+
+#endif // LIBCVPG_VIDEOPROC_LATENCY_STATISTICS_HPP
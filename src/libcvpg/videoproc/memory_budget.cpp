@@ -0,0 +1,51 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/videoproc/memory_budget.hpp>
+
+namespace cvpg::videoproc {
+
+memory_budget::memory_budget(std::size_t limit)
+    : m_limit(limit)
+    , m_used(0)
+    , m_peak(0)
+{}
+
+void memory_budget::acquire(std::size_t bytes)
+{
+    const std::size_t used = m_used.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+    std::size_t peak = m_peak.load(std::memory_order_relaxed);
+
+    while (used > peak && !m_peak.compare_exchange_weak(peak, used, std::memory_order_relaxed))
+    {}
+}
+
+void memory_budget::release(std::size_t bytes)
+{
+    m_used.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+std::size_t memory_budget::limit() const
+{
+    return m_limit;
+}
+
+std::size_t memory_budget::used() const
+{
+    return m_used.load(std::memory_order_relaxed);
+}
+
+std::size_t memory_budget::available() const
+{
+    const std::size_t used = m_used.load(std::memory_order_relaxed);
+
+    return used < m_limit ? m_limit - used : 0;
+}
+
+std::size_t memory_budget::peak() const
+{
+    return m_peak.load(std::memory_order_relaxed);
+}
+
+} // namespace cvpg::videoproc
@@ -0,0 +1,57 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_MEMORY_BUDGET_HPP
+#define LIBCVPG_VIDEOPROC_MEMORY_BUDGET_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace cvpg::videoproc {
+
+//
+// A memory budget limits the bytes of the data buffered at all stages of a pipeline. The stages account
+// the bytes of their buffered data and accept new data only as long as the budget is not exhausted.
+//
+// Data that is already produced is always accepted, so the used bytes can exceed the limit for a short
+// time. All functions can be called from different threads.
+//
+class memory_budget
+{
+public:
+    explicit memory_budget(std::size_t limit);
+
+    memory_budget(memory_budget const &) = delete;
+    memory_budget(memory_budget &&) = delete;
+
+    memory_budget & operator=(memory_budget const &) = delete;
+    memory_budget & operator=(memory_budget &&) = delete;
+
+    ~memory_budget() = default;
+
+    void acquire(std::size_t bytes);
+
+    void release(std::size_t bytes);
+
+    // maximum amount of bytes
+    std::size_t limit() const;
+
+    // amount of currently used bytes
+    std::size_t used() const;
+
+    // amount of bytes that could be used until the limit is reached
+    std::size_t available() const;
+
+    // maximum amount of used bytes so far
+    std::size_t peak() const;
+
+private:
+    const std::size_t m_limit;
+
+    std::atomic<std::size_t> m_used;
+    std::atomic<std::size_t> m_peak;
+};
+
+} // namespace cvpg::videoproc
+
+#endif // LIBCVPG_VIDEOPROC_MEMORY_BUDGET_HPP
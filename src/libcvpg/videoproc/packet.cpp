@@ -51,6 +51,7 @@ template<typename Frame> bool packet<Frame>::failed() const
 // manual instantiation of packet<> for some types
 template class packet<frame<image_gray_8bit> >;
 template class packet<frame<image_rgb_8bit> >;
+template class packet<frame<image_yuv420_8bit> >;
 
 template<typename Frame> std::ostream & operator<<(std::ostream & out, packet<Frame> const & packet)
 {
@@ -62,5 +63,6 @@ template<typename Frame> std::ostream & operator<<(std::ostream & out, packet<Fr
 // manual instantiation of operator<< for some types
 template std::ostream & operator<< <frame<image_gray_8bit> >(std::ostream &, packet<frame<image_gray_8bit> > const &);
 template std::ostream & operator<< <frame<image_rgb_8bit> >(std::ostream &, packet<frame<image_rgb_8bit> > const &);
+template std::ostream & operator<< <frame<image_yuv420_8bit> >(std::ostream &, packet<frame<image_yuv420_8bit> > const &);
 
 } // namespace cvpg::videoproc
@@ -60,6 +60,7 @@ private:
 // suppress automatic instantiation of packet<> for some types
 extern template class packet<frame<image_gray_8bit> >;
 extern template class packet<frame<image_rgb_8bit> >;
+extern template class packet<frame<image_yuv420_8bit> >;
 
 template<typename Frame>
 std::ostream & operator<<(std::ostream & out, packet<Frame> const & packet);
@@ -67,6 +68,7 @@ std::ostream & operator<<(std::ostream & out, packet<Frame> const & packet);
 // suppress automatic instantiation of operator<< for some types
 extern template std::ostream & operator<< <frame<image_gray_8bit> >(std::ostream &, packet<frame<image_gray_8bit> > const &);
 extern template std::ostream & operator<< <frame<image_rgb_8bit> >(std::ostream &, packet<frame<image_rgb_8bit> > const &);
+extern template std::ostream & operator<< <frame<image_yuv420_8bit> >(std::ostream &, packet<frame<image_yuv420_8bit> > const &);
 
 } // namespace cvpg::videoproc
 
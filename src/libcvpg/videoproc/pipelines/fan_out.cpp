@@ -0,0 +1,171 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/videoproc/pipelines/fan_out.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace cvpg::videoproc::pipelines {
+
+template<typename Image> fan_out<Image>::fan_out(std::vector<branch_policy> policies,
+                                                 std::function<void(std::size_t, packet_type)> deliver_callback,
+                                                 std::function<void(std::size_t)> next_callback,
+                                                 std::function<void(std::size_t, std::size_t)> dropped_callback)
+    : m_branches()
+    , m_deliver_callback(std::move(deliver_callback))
+    , m_next_callback(std::move(next_callback))
+    , m_dropped_callback(std::move(dropped_callback))
+{
+    m_branches.reserve(policies.size());
+
+    for (auto policy : policies)
+    {
+        branch_info branch;
+        branch.policy = policy;
+
+        m_branches.push_back(std::move(branch));
+    }
+}
+
+template<typename Image> void fan_out<Image>::deliver(packet_type && packet)
+{
+    const std::size_t number = packet.number();
+    const bool failed = packet.failed();
+
+    auto frames = packet.move_frames();
+
+    const std::size_t data_frames = std::count_if(frames.begin(), frames.end(), [](auto const & f){ return !f.flush(); });
+
+    for (std::size_t b = 0; b < m_branches.size(); ++b)
+    {
+        auto & branch = m_branches[b];
+
+        packet_type p(number, failed);
+
+        if (branch.policy == branch_policy::block)
+        {
+            // the last branch gets the original frames, all others share the image data
+            if (b == m_branches.size() - 1)
+            {
+                for (auto & f : frames)
+                {
+                    p.add_frame(std::move(f));
+                }
+            }
+            else
+            {
+                for (auto const & f : frames)
+                {
+                    p.add_frame(videoproc::frame<Image>(f));
+                }
+            }
+
+            branch.requested -= std::min(branch.requested, data_frames);
+        }
+        else
+        {
+            // keep the newest frames that fit into the requested amount
+            const std::size_t keep = std::min(branch.requested, data_frames);
+            const std::size_t drop = data_frames - keep;
+
+            std::size_t skipped = 0;
+
+            for (auto const & f : frames)
+            {
+                if (f.flush())
+                {
+                    p.add_frame(videoproc::frame<Image>(branch.next_number));
+                }
+                else if (skipped < drop)
+                {
+                    ++skipped;
+                }
+                else
+                {
+                    // renumbered frames keep their timestamps and source packets
+                    videoproc::frame<Image> shared(branch.next_number++, f.image());
+                    shared.set_timestamps(f.timestamps());
+                    shared.set_source(f.source(), f.modified());
+
+                    p.add_frame(std::move(shared));
+                }
+            }
+
+            branch.requested -= keep;
+
+            if (drop > 0)
+            {
+                branch.dropped += drop;
+
+                m_dropped_callback(b, drop);
+            }
+
+            if (p.frames().empty())
+            {
+                continue;
+            }
+        }
+
+        m_deliver_callback(b, std::move(p));
+    }
+
+    // the upstream stage waits for a new request after each delivered packet
+    request_next();
+}
+
+template<typename Image> void fan_out<Image>::next(std::size_t branch, std::size_t max_new_data)
+{
+    if (branch < m_branches.size())
+    {
+        m_branches[branch].requested = max_new_data;
+
+        request_next();
+    }
+}
+
+template<typename Image> std::size_t fan_out<Image>::branches() const
+{
+    return m_branches.size();
+}
+
+template<typename Image> std::size_t fan_out<Image>::dropped(std::size_t branch) const
+{
+    return m_branches.at(branch).dropped;
+}
+
+template<typename Image> void fan_out<Image>::request_next()
+{
+    bool blocking = false;
+
+    std::size_t min_requested = std::numeric_limits<std::size_t>::max();
+    std::size_t max_requested = 0;
+
+    for (auto const & branch : m_branches)
+    {
+        if (branch.policy == branch_policy::block)
+        {
+            blocking = true;
+
+            min_requested = std::min(min_requested, branch.requested);
+        }
+        else
+        {
+            max_requested = std::max(max_requested, branch.requested);
+        }
+    }
+
+    const std::size_t requested = blocking ? min_requested : max_requested;
+
+    if (requested > 0)
+    {
+        m_next_callback(requested);
+    }
+}
+
+// manual instantiation of fan_out<> for some types
+template class fan_out<image_gray_8bit>;
+template class fan_out<image_rgb_8bit>;
+template class fan_out<image_yuv420_8bit>;
+
+} // namespace cvpg::videoproc::pipelines
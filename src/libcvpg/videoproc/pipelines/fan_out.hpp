@@ -0,0 +1,101 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_PIPELINES_FAN_OUT_HPP
+#define LIBCVPG_VIDEOPROC_PIPELINES_FAN_OUT_HPP
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/videoproc/frame.hpp>
+#include <libcvpg/videoproc/packet.hpp>
+
+namespace cvpg::videoproc::pipelines {
+
+// behaviour of a branch that can't receive as many frames as its upstream stage delivers
+enum class branch_policy
+{
+    // the upstream stage waits for the branch (and therefore for all other branches too)
+    block,
+
+    // frames the branch can't receive are dropped ; the upstream stage doesn't wait for the branch
+    drop
+};
+
+//
+// A fan out passes the packets of a stage to several branches (downstream stages). The frames of a
+// packet are shared by all branches, only the references to the image data are copied.
+//
+// Each branch requests new data on its own. The upstream stage is asked for the smallest amount of
+// frames requested by the blocking branches, so the slowest blocking branch determines the pace. If
+// all branches drop frames the largest requested amount is used.
+//
+// A dropping branch receives the newest frames of a packet that fit into its requested amount. The
+// frames of such a branch are renumbered without gaps, as expected by the downstream stages. Flush
+// frames are never dropped.
+//
+// A fan out is not thread-safe and has to be used from a single thread.
+//
+template<typename Image>
+class fan_out
+{
+public:
+    using packet_type = videoproc::packet<videoproc::frame<Image> >;
+
+    fan_out(std::vector<branch_policy> policies,
+            std::function<void(std::size_t, packet_type)> deliver_callback,
+            std::function<void(std::size_t)> next_callback,
+            std::function<void(std::size_t, std::size_t)> dropped_callback = [](std::size_t, std::size_t){});
+
+    fan_out(fan_out const &) = delete;
+    fan_out(fan_out &&) = default;
+
+    fan_out & operator=(fan_out const &) = delete;
+    fan_out & operator=(fan_out &&) = default;
+
+    ~fan_out() = default;
+
+    // pass a packet of the upstream stage to all branches
+    void deliver(packet_type && packet);
+
+    // a branch is ready to receive up to 'max_new_data' frames
+    void next(std::size_t branch, std::size_t max_new_data);
+
+    std::size_t branches() const;
+
+    // amount of frames dropped at a branch
+    std::size_t dropped(std::size_t branch) const;
+
+private:
+    void request_next();
+
+    struct branch_info
+    {
+        branch_policy policy = branch_policy::block;
+
+        // amount of frames the branch is able to receive
+        std::size_t requested = 0;
+
+        // number of the next frame delivered to the branch (only used by dropping branches)
+        std::size_t next_number = 0;
+
+        std::size_t dropped = 0;
+    };
+
+    std::vector<branch_info> m_branches;
+
+    std::function<void(std::size_t, packet_type)> m_deliver_callback;
+    std::function<void(std::size_t)> m_next_callback;
+    std::function<void(std::size_t, std::size_t)> m_dropped_callback;
+};
+
+// suppress automatic instantiation of fan_out<> for some types
+extern template class fan_out<image_gray_8bit>;
+extern template class fan_out<image_rgb_8bit>;
+extern template class fan_out<image_yuv420_8bit>;
+
+} // namespace cvpg::videoproc::pipelines
+
+#endif // LIBCVPG_VIDEOPROC_PIPELINES_FAN_OUT_HPP
@@ -63,6 +63,7 @@ private:
 // suppress automatic instantiation of file_to_file<> for some types
 extern template class file_to_file<any_stage<image_gray_8bit> >;
 extern template class file_to_file<any_stage<image_rgb_8bit> >;
+extern template class file_to_file<any_stage<image_yuv420_8bit> >;
 
 //
 // Hint: Boost.Asynchronous does not support templated proxies. Becaues the servant itself could
@@ -105,6 +106,24 @@ struct image_rgb_8bit_file_to_file_proxy : public boost::asynchronous::servant_p
    BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
 };
 
+struct image_yuv420_8bit_file_to_file_proxy : public boost::asynchronous::servant_proxy<
+                                                         image_yuv420_8bit_file_to_file_proxy,
+                                                         file_to_file<cvpg::videoproc::any_stage<cvpg::image_yuv420_8bit> >,
+                                                         imageproc::scripting::diagnostics::servant_job
+                                                     >
+{
+   template<typename... Args>
+   image_yuv420_8bit_file_to_file_proxy(Args... args)
+       : boost::asynchronous::servant_proxy<
+             image_yuv420_8bit_file_to_file_proxy,
+             file_to_file<cvpg::videoproc::any_stage<cvpg::image_yuv420_8bit> >,
+             imageproc::scripting::diagnostics::servant_job
+         >(std::forward<Args>(args)...)
+   {}
+
+   BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
+};
+
 } // namespace cvpg::videoproc::pipelines
 
 #endif // LIBCVPG_VIDEOPROC_PIPELINES_FILE_TO_FILE_HPP
@@ -0,0 +1,293 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/videoproc/pipelines/graph.hpp>
+
+#include <algorithm>
+
+#include <boost/range/adaptor/reversed.hpp>
+
+#include <libcvpg/videoproc/stage_parameters.hpp>
+#include <libcvpg/videoproc/update_indicator.hpp>
+
+namespace cvpg::videoproc::pipelines {
+
+template<typename Stage> struct graph<Stage>::processing_context
+{
+    parameters::callbacks callbacks;
+
+    std::size_t stages_initialized = 0;
+
+    std::size_t leaves_finished = 0;
+
+    // fan outs of all stages with several downstream stages
+    std::map<std::size_t, fan_out<typename Stage::image_type> > fan_outs;
+};
+
+template<typename Stage> graph<Stage>::graph(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler, topology<Stage> stages)
+    : boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>(scheduler)
+    , m_nodes(stages.nodes())
+    , m_leaves(std::count_if(m_nodes.begin(), m_nodes.end(), [](auto const & node){ return node.downstream.empty(); }))
+    , m_contexts()
+{}
+
+template<typename Stage> void graph<Stage>::start(std::vector<std::string> stage_parameters, parameters::callbacks callbacks)
+{
+    using image_type = typename Stage::image_type;
+    using packet_type = videoproc::packet<videoproc::frame<image_type> >;
+
+    auto context_id = ++m_context_counter;
+
+    if (stage_parameters.size() != m_nodes.size())
+    {
+        callbacks.failed(context_id, "expected " + std::to_string(m_nodes.size()) + " stage parameters but got " + std::to_string(stage_parameters.size()));
+
+        return;
+    }
+
+    auto context = std::make_shared<processing_context>();
+    context->callbacks = callbacks;
+
+    // create a fan out for each stage with several downstream stages
+    for (std::size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        auto const & node = m_nodes[i];
+
+        if (node.downstream.size() < 2)
+        {
+            continue;
+        }
+
+        std::vector<branch_policy> policies;
+        policies.reserve(node.downstream.size());
+
+        for (auto d : node.downstream)
+        {
+            policies.push_back(m_nodes[d].policy);
+        }
+
+        context->fan_outs.emplace(
+            i,
+            fan_out<image_type>(
+                std::move(policies),
+                [this, i, context_id](std::size_t branch, packet_type packet)
+                {
+                    (*(m_nodes[m_nodes[i].downstream[branch]].stage)).process(context_id, std::move(packet));
+                },
+                [this, i, context_id](std::size_t max_new_data)
+                {
+                    (*(m_nodes[i].stage)).next(context_id, max_new_data);
+                },
+                [callback = callbacks.update, context_id](std::size_t /*branch*/, std::size_t frames)
+                {
+                    callback(context_id, update_indicator("drop", frames, 0));
+                }
+            )
+        );
+    }
+
+    m_contexts.insert({ context_id, context });
+
+    for (std::size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        auto & node = m_nodes[i];
+
+        std::vector<Stage *> downstream_stages;
+        downstream_stages.reserve(node.downstream.size());
+
+        for (auto d : node.downstream)
+        {
+            downstream_stages.push_back(&(m_nodes[d].stage));
+        }
+
+        const bool has_fan_out = downstream_stages.size() > 1;
+
+        // packets and the end of the stream are passed to several downstream stages at the thread of the pipeline
+        std::function<void(std::size_t, packet_type)> deliver_callback;
+        std::function<void(std::size_t)> finished_callback;
+
+        if (has_fan_out)
+        {
+            deliver_callback = make_safe_callback(
+                [this, i](std::size_t context_id, packet_type packet)
+                {
+                    auto it = m_contexts.find(context_id);
+
+                    if (it != m_contexts.end())
+                    {
+                        it->second->fan_outs.at(i).deliver(std::move(packet));
+                    }
+                },
+                "graph::deliver_callback",
+                1
+            );
+        }
+        else
+        {
+            deliver_callback =
+                [next_stage = downstream_stages.empty() ? nullptr : downstream_stages.front()](std::size_t context_id, packet_type packet)
+                {
+                    if (!!next_stage)
+                    {
+                        (**next_stage).process(context_id, std::move(packet));
+                    }
+                };
+        }
+
+        if (downstream_stages.empty())
+        {
+            finished_callback = make_safe_callback(
+                [this](std::size_t context_id)
+                {
+                    stage_finished(context_id);
+                },
+                "graph::finished_callback",
+                1
+            );
+        }
+        else if (has_fan_out)
+        {
+            finished_callback = make_safe_callback(
+                [downstream_stages](std::size_t context_id)
+                {
+                    for (auto * stage : downstream_stages)
+                    {
+                        (**stage).finish(context_id);
+                    }
+                },
+                "graph::finished_callback",
+                1
+            );
+        }
+        else
+        {
+            finished_callback =
+                [next_stage = downstream_stages.front()](std::size_t context_id)
+                {
+                    (**next_stage).finish(context_id);
+                };
+        }
+
+        // requests of new data of a stage whose upstream stage has several downstream stages are combined by the fan out
+        std::function<void(std::size_t, std::size_t)> next_callback = [](std::size_t, std::size_t){};
+
+        if (node.upstream)
+        {
+            const std::size_t upstream = *(node.upstream);
+            auto const & siblings = m_nodes[upstream].downstream;
+
+            if (siblings.size() > 1)
+            {
+                const std::size_t branch = std::distance(siblings.begin(), std::find(siblings.begin(), siblings.end(), i));
+
+                next_callback = make_safe_callback(
+                    [this, upstream, branch](std::size_t context_id, std::size_t max_new_data)
+                    {
+                        auto it = m_contexts.find(context_id);
+
+                        if (it != m_contexts.end())
+                        {
+                            it->second->fan_outs.at(upstream).next(branch, max_new_data);
+                        }
+                    },
+                    "graph::next_callback",
+                    1
+                );
+            }
+            else
+            {
+                next_callback =
+                    [prev_stage = &(m_nodes[upstream].stage)](std::size_t context_id, std::size_t max_new_data)
+                    {
+                        (**prev_stage).next(context_id, max_new_data);
+                    };
+            }
+        }
+
+        (*(node.stage)).init(
+            context_id,
+            stage_parameters[i],
+            stage_callbacks<image_type>(
+            {
+                // init callback
+                make_safe_callback(
+                    [this, callback = (i == 0) ? callbacks.init : [](std::size_t, std::int64_t){}](std::size_t context_id, std::int64_t frames)
+                    {
+                        callback(context_id, frames);
+
+                        stage_initialized(context_id);
+                    },
+                    "graph::init_done_callback",
+                    1
+                ),
+                // parameters callback
+                [downstream_stages](std::size_t context_id, std::map<std::string, std::any> && params)
+                {
+                    for (auto * stage : downstream_stages)
+                    {
+                        (**stage).params(context_id, params);
+                    }
+                },
+                // deliver callback
+                std::move(deliver_callback),
+                // next callback
+                std::move(next_callback),
+                // finished callback
+                std::move(finished_callback),
+                // failed callback
+                [callback = callbacks.failed](std::size_t context_id, std::string error)
+                {
+                    callback(context_id, std::move(error));
+                },
+                // update callback
+                [callback = callbacks.update](std::size_t context_id, update_indicator update)
+                {
+                    callback(context_id, std::move(update));
+                }
+            })
+        );
+    }
+}
+
+template<typename Stage> void graph<Stage>::stage_initialized(std::size_t context_id)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it != m_contexts.end())
+    {
+        auto & context = it->second;
+
+        if (++(context->stages_initialized) == m_nodes.size())
+        {
+            // start all stages in reverse order, so downstream stages are ready before upstream stages deliver data
+            for (auto & node : boost::adaptors::reverse(m_nodes))
+            {
+                (*(node.stage)).start(context_id);
+            }
+        }
+    }
+}
+
+template<typename Stage> void graph<Stage>::stage_finished(std::size_t context_id)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it != m_contexts.end())
+    {
+        auto context = it->second;
+
+        if (++(context->leaves_finished) == m_leaves)
+        {
+            m_contexts.erase(it);
+
+            context->callbacks.finished();
+        }
+    }
+}
+
+// manual instantation of graph<> for some types
+template class graph<any_stage<image_gray_8bit> >;
+template class graph<any_stage<image_rgb_8bit> >;
+template class graph<any_stage<image_yuv420_8bit> >;
+
+} // cvpg::videoproc::pipelines
@@ -0,0 +1,201 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_PIPELINES_GRAPH_HPP
+#define LIBCVPG_VIDEOPROC_PIPELINES_GRAPH_HPP
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/asynchronous/servant_proxy.hpp>
+#include <boost/asynchronous/trackable_servant.hpp>
+#include <boost/asynchronous/queue/lockfree_queue.hpp>
+#include <boost/asynchronous/scheduler_shared_proxy.hpp>
+#include <boost/asynchronous/scheduler/single_thread_scheduler.hpp>
+
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/imageproc/scripting/diagnostics/typedefs.hpp>
+#include <libcvpg/videoproc/any_stage.hpp>
+#include <libcvpg/videoproc/frame.hpp>
+#include <libcvpg/videoproc/packet.hpp>
+#include <libcvpg/videoproc/update_indicator.hpp>
+#include <libcvpg/videoproc/pipelines/fan_out.hpp>
+#include <libcvpg/videoproc/pipelines/parameters.hpp>
+
+namespace cvpg::videoproc::pipelines {
+
+//
+// The topology of a graph pipeline. The first stage (usually a source) has no upstream stage, all
+// other stages receive the frames of exactly one upstream stage that was added before. A stage can
+// have several downstream stages, e.g. a recording sink and a branch of processors.
+//
+template<typename Stage>
+class topology
+{
+public:
+    struct node
+    {
+        Stage stage;
+
+        std::optional<std::size_t> upstream;
+
+        // behaviour of the branch starting at this stage if it is slower than its sibling branches
+        branch_policy policy = branch_policy::block;
+
+        std::vector<std::size_t> downstream;
+    };
+
+    // add the first stage ; returns the ID of the stage
+    std::size_t add(Stage stage)
+    {
+        if (!m_nodes.empty())
+        {
+            throw std::invalid_argument("topology has already a first stage");
+        }
+
+        m_nodes.push_back({ std::move(stage), std::nullopt, branch_policy::block, {} });
+
+        return 0;
+    }
+
+    // add a stage receiving the frames of the stage with the ID 'upstream' ; returns the ID of the stage
+    std::size_t add(Stage stage, std::size_t upstream, branch_policy policy = branch_policy::block)
+    {
+        if (upstream >= m_nodes.size())
+        {
+            throw std::invalid_argument("unknown upstream stage " + std::to_string(upstream));
+        }
+
+        const std::size_t id = m_nodes.size();
+
+        m_nodes[upstream].downstream.push_back(id);
+        m_nodes.push_back({ std::move(stage), upstream, policy, {} });
+
+        return id;
+    }
+
+    std::vector<node> const & nodes() const
+    {
+        return m_nodes;
+    }
+
+private:
+    std::vector<node> m_nodes;
+};
+
+//
+// A pipeline whose stages form a tree: the frames of a stage with several downstream stages are shared
+// by all of them without copying the image data (see 'fan_out'). So a stream is decoded only once for
+// e.g. a recording sink and an analytics branch.
+//
+// Backpressure is combined over the branches of a stage: the stage is asked for as many frames as the
+// slowest blocking branch is able to receive. Branches added with 'branch_policy::drop' drop frames
+// instead of stalling the other branches. The pipeline is finished if all stages without downstream
+// stages are finished.
+//
+// The parameters given at 'start()' are passed to the stages in order of their IDs.
+//
+template<typename Stage>
+class graph : public boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>
+{
+public:
+    graph(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler, topology<Stage> stages);
+
+    graph(graph const &) = delete;
+    graph(graph &&) = delete;
+
+    graph & operator=(graph const &) = delete;
+    graph & operator=(graph &&) = delete;
+
+    virtual ~graph() = default;
+
+    void start(std::vector<std::string> stage_parameters, parameters::callbacks callbacks);
+
+private:
+    void stage_initialized(std::size_t context_id);
+
+    void stage_finished(std::size_t context_id);
+
+    std::vector<typename topology<Stage>::node> m_nodes;
+
+    // amount of stages without downstream stages
+    std::size_t m_leaves;
+
+    std::size_t m_context_counter = 0;
+
+    struct processing_context;
+    std::map<std::size_t, std::shared_ptr<processing_context> > m_contexts;
+};
+
+// suppress automatic instantiation of graph<> for some types
+extern template class graph<any_stage<image_gray_8bit> >;
+extern template class graph<any_stage<image_rgb_8bit> >;
+extern template class graph<any_stage<image_yuv420_8bit> >;
+
+//
+// Hint: Boost.Asynchronous does not support templated proxies. Becaues the servant itself could
+// have template parameters we have to create a proxy for each wanted type.
+//
+
+struct image_gray_8bit_graph_proxy : public boost::asynchronous::servant_proxy<
+                                                image_gray_8bit_graph_proxy,
+                                                graph<cvpg::videoproc::any_stage<cvpg::image_gray_8bit> >,
+                                                imageproc::scripting::diagnostics::servant_job
+                                            >
+{
+   template<typename... Args>
+   image_gray_8bit_graph_proxy(Args... args)
+       : boost::asynchronous::servant_proxy<
+             image_gray_8bit_graph_proxy,
+             graph<cvpg::videoproc::any_stage<cvpg::image_gray_8bit> >,
+             imageproc::scripting::diagnostics::servant_job
+         >(std::forward<Args>(args)...)
+   {}
+
+   BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
+};
+
+struct image_rgb_8bit_graph_proxy : public boost::asynchronous::servant_proxy<
+                                               image_rgb_8bit_graph_proxy,
+                                               graph<cvpg::videoproc::any_stage<cvpg::image_rgb_8bit> >,
+                                               imageproc::scripting::diagnostics::servant_job
+                                           >
+{
+   template<typename... Args>
+   image_rgb_8bit_graph_proxy(Args... args)
+       : boost::asynchronous::servant_proxy<
+             image_rgb_8bit_graph_proxy,
+             graph<cvpg::videoproc::any_stage<cvpg::image_rgb_8bit> >,
+             imageproc::scripting::diagnostics::servant_job
+         >(std::forward<Args>(args)...)
+   {}
+
+   BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
+};
+
+struct image_yuv420_8bit_graph_proxy : public boost::asynchronous::servant_proxy<
+                                                  image_yuv420_8bit_graph_proxy,
+                                                  graph<cvpg::videoproc::any_stage<cvpg::image_yuv420_8bit> >,
+                                                  imageproc::scripting::diagnostics::servant_job
+                                              >
+{
+   template<typename... Args>
+   image_yuv420_8bit_graph_proxy(Args... args)
+       : boost::asynchronous::servant_proxy<
+             image_yuv420_8bit_graph_proxy,
+             graph<cvpg::videoproc::any_stage<cvpg::image_yuv420_8bit> >,
+             imageproc::scripting::diagnostics::servant_job
+         >(std::forward<Args>(args)...)
+   {}
+
+   BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
+};
+
+} // namespace cvpg::videoproc::pipelines
+
+#endif // LIBCVPG_VIDEOPROC_PIPELINES_GRAPH_HPP
@@ -0,0 +1,426 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/videoproc/pipelines/host.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include <boost/asynchronous/queue/lockfree_queue.hpp>
+#include <boost/asynchronous/scheduler/multiqueue_threadpool_scheduler.hpp>
+#include <boost/asynchronous/scheduler/single_thread_scheduler.hpp>
+
+#include <libcvpg/core/exception.hpp>
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/videoproc/any_stage.hpp>
+#include <libcvpg/videoproc/pipelines/file_to_file.hpp>
+#include <libcvpg/videoproc/pipelines/graph.hpp>
+#include <libcvpg/videoproc/pipelines/rtsp_to_file.hpp>
+#include <libcvpg/videoproc/processors/background.hpp>
+#include <libcvpg/videoproc/processors/frame.hpp>
+#include <libcvpg/videoproc/processors/interframe.hpp>
+#include <libcvpg/videoproc/sinks/file.hpp>
+#include <libcvpg/videoproc/sinks/null.hpp>
+#include <libcvpg/videoproc/sinks/raw.hpp>
+#include <libcvpg/videoproc/sources/file.hpp>
+#include <libcvpg/videoproc/sources/rtsp.hpp>
+#include <libcvpg/videoproc/sources/synthetic.hpp>
+
+namespace {
+
+// stages and pipelines processing frames of a format
+template<typename Image>
+struct frame_format_stages;
+
+template<>
+struct frame_format_stages<cvpg::image_gray_8bit>
+{
+    using file_source = cvpg::videoproc::sources::image_gray_8bit_file_proxy;
+    using rtsp_source = cvpg::videoproc::sources::image_gray_8bit_rtsp_proxy;
+    using synthetic_source = cvpg::videoproc::sources::image_gray_8bit_synthetic_proxy;
+    using frame_processor = cvpg::videoproc::processors::image_gray_8bit_frame_proxy;
+    using interframe_processor = cvpg::videoproc::processors::image_gray_8bit_interframe_proxy;
+    using background_processor = cvpg::videoproc::processors::image_gray_8bit_background_proxy;
+    using file_sink = cvpg::videoproc::sinks::image_gray_8bit_file_proxy;
+    using raw_sink = cvpg::videoproc::sinks::image_gray_8bit_raw_proxy;
+    using null_sink = cvpg::videoproc::sinks::image_gray_8bit_null_proxy;
+    using file_to_file = cvpg::videoproc::pipelines::image_gray_8bit_file_to_file_proxy;
+    using rtsp_to_file = cvpg::videoproc::pipelines::image_gray_8bit_rtsp_to_file_proxy;
+    using graph = cvpg::videoproc::pipelines::image_gray_8bit_graph_proxy;
+};
+
+template<>
+struct frame_format_stages<cvpg::image_rgb_8bit>
+{
+    using file_source = cvpg::videoproc::sources::image_rgb_8bit_file_proxy;
+    using rtsp_source = cvpg::videoproc::sources::image_rgb_8bit_rtsp_proxy;
+    using synthetic_source = cvpg::videoproc::sources::image_rgb_8bit_synthetic_proxy;
+    using frame_processor = cvpg::videoproc::processors::image_rgb_8bit_frame_proxy;
+    using interframe_processor = cvpg::videoproc::processors::image_rgb_8bit_interframe_proxy;
+    using background_processor = cvpg::videoproc::processors::image_rgb_8bit_background_proxy;
+    using file_sink = cvpg::videoproc::sinks::image_rgb_8bit_file_proxy;
+    using raw_sink = cvpg::videoproc::sinks::image_rgb_8bit_raw_proxy;
+    using null_sink = cvpg::videoproc::sinks::image_rgb_8bit_null_proxy;
+    using file_to_file = cvpg::videoproc::pipelines::image_rgb_8bit_file_to_file_proxy;
+    using rtsp_to_file = cvpg::videoproc::pipelines::image_rgb_8bit_rtsp_to_file_proxy;
+    using graph = cvpg::videoproc::pipelines::image_rgb_8bit_graph_proxy;
+};
+
+template<>
+struct frame_format_stages<cvpg::image_yuv420_8bit>
+{
+    using file_source = cvpg::videoproc::sources::image_yuv420_8bit_file_proxy;
+    using rtsp_source = cvpg::videoproc::sources::image_yuv420_8bit_rtsp_proxy;
+    using synthetic_source = cvpg::videoproc::sources::image_yuv420_8bit_synthetic_proxy;
+    using frame_processor = cvpg::videoproc::processors::image_yuv420_8bit_frame_proxy;
+    using interframe_processor = cvpg::videoproc::processors::image_yuv420_8bit_interframe_proxy;
+    using background_processor = cvpg::videoproc::processors::image_yuv420_8bit_background_proxy;
+    using file_sink = cvpg::videoproc::sinks::image_yuv420_8bit_file_proxy;
+    using raw_sink = cvpg::videoproc::sinks::image_yuv420_8bit_raw_proxy;
+    using null_sink = cvpg::videoproc::sinks::image_yuv420_8bit_null_proxy;
+    using file_to_file = cvpg::videoproc::pipelines::image_yuv420_8bit_file_to_file_proxy;
+    using rtsp_to_file = cvpg::videoproc::pipelines::image_yuv420_8bit_rtsp_to_file_proxy;
+    using graph = cvpg::videoproc::pipelines::image_yuv420_8bit_graph_proxy;
+};
+
+// a scheduler with a single thread ; unnamed schedulers get the default name of Boost.Asynchronous
+cvpg::videoproc::pipelines::host::scheduler_type make_scheduler(std::string name = std::string())
+{
+    using queue_type = boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job>;
+
+    if (name.empty())
+    {
+        return boost::asynchronous::make_shared_scheduler_proxy<boost::asynchronous::single_thread_scheduler<queue_type> >();
+    }
+
+    return boost::asynchronous::make_shared_scheduler_proxy<boost::asynchronous::single_thread_scheduler<queue_type> >(std::move(name));
+}
+
+}
+
+namespace cvpg::videoproc::pipelines {
+
+host::host(host_parameters parameters)
+    : m_parameters(std::move(parameters))
+    , m_thread_pool(boost::asynchronous::make_shared_scheduler_proxy<
+                        boost::asynchronous::multiqueue_threadpool_scheduler<
+                            boost::asynchronous::lockfree_queue<imageproc::scripting::diagnostics::servant_job> > >(std::max<std::size_t>(m_parameters.threads, 1), std::string("threadpool")))
+    , m_memory_budget()
+    , m_fair_queue()
+    , m_groups()
+    , m_streams()
+{
+    if (m_parameters.stream_groups == 0)
+    {
+        throw cvpg::exception("at least one stream group is needed");
+    }
+
+    if (m_parameters.memory_budget > 0)
+    {
+        m_memory_budget = std::make_shared<videoproc::memory_budget>(m_parameters.memory_budget);
+    }
+
+    if (m_parameters.fair_queue_depth == 0)
+    {
+        m_parameters.fair_queue_depth = std::max<std::size_t>(m_parameters.threads, 1) * 2;
+    }
+
+    m_fair_queue = std::make_shared<fair_queue>(m_parameters.fair_queue_depth);
+}
+
+host::scheduler_type host::thread_pool() const
+{
+    return m_thread_pool;
+}
+
+std::size_t host::add_stream(stream_parameters parameters,
+                             imageproc::scripting::image_processor_proxy image_processor,
+                             parameters::callbacks callbacks)
+{
+    const std::size_t id = m_streams.size();
+
+    // distribute the streams to the groups in a round-robin manner ; the groups are created on demand,
+    // so there are never more groups than streams
+    if (m_groups.size() < m_parameters.stream_groups)
+    {
+        group g;
+
+        g.source_stage_scheduler = make_scheduler();
+        g.processors_scheduler = make_scheduler("processors");
+        g.file_out_scheduler = make_scheduler();
+        g.pipeline_scheduler = make_scheduler();
+
+        m_groups.push_back(std::move(g));
+    }
+
+    auto const & stream_group = m_groups[id % m_groups.size()];
+
+    fair_share fair;
+
+    if (m_parameters.fair_sharing)
+    {
+        fair.queue = m_fair_queue;
+        fair.stream = m_fair_queue->add_stream(parameters.name, parameters.weight);
+    }
+
+    stream s;
+    s.callbacks = std::move(callbacks);
+    s.promise = std::make_shared<std::promise<std::string> >();
+    s.future = s.promise->get_future().share();
+    s.frames_saved = std::make_shared<std::atomic<std::size_t> >(0);
+    s.latencies = std::make_shared<latency_statistics>();
+
+    switch (parameters.format)
+    {
+        case frame_format::rgb:
+            s.pipeline = create_pipeline<image_rgb_8bit>(parameters, stream_group, image_processor, fair, s.latencies);
+            break;
+
+        case frame_format::yuv420:
+            s.pipeline = create_pipeline<image_yuv420_8bit>(parameters, stream_group, image_processor, fair, s.latencies);
+            break;
+
+        case frame_format::gray:
+            s.pipeline = create_pipeline<image_gray_8bit>(parameters, stream_group, image_processor, fair, s.latencies);
+            break;
+    }
+
+    if (parameters.record.empty())
+    {
+        s.stage_parameters =
+        {
+            parameters.uri,                 // source stage
+            parameters.frame_script,        // frame stage
+            parameters.interframe_script,   // interframe stage
+            parameters.output               // sink stage
+        };
+    }
+    else
+    {
+        s.stage_parameters =
+        {
+            parameters.uri,                 // source stage
+            parameters.record,              // recording sink stage
+            parameters.frame_script,        // frame stage
+            parameters.interframe_script,   // interframe stage
+            parameters.output               // sink stage
+        };
+    }
+
+    m_streams.push_back(std::move(s));
+
+    return id;
+}
+
+void host::start()
+{
+    for (auto & s : m_streams)
+    {
+        if (s.started)
+        {
+            continue;
+        }
+
+        s.started = true;
+
+        auto promise = s.promise;
+        auto frames_saved = s.frames_saved;
+        auto callbacks = s.callbacks;
+
+        (*(s.pipeline)).start(
+            // stage parameters
+            s.stage_parameters,
+            // callbacks
+            {
+                [promise, callbacks]()
+                {
+                    if (callbacks.finished)
+                    {
+                        callbacks.finished();
+                    }
+
+                    promise->set_value("");
+                },
+                [callbacks](std::size_t context_id, std::int64_t frames)
+                {
+                    if (callbacks.init)
+                    {
+                        callbacks.init(context_id, frames);
+                    }
+                },
+                [promise, callbacks](std::size_t context_id, std::string error)
+                {
+                    if (callbacks.failed)
+                    {
+                        callbacks.failed(context_id, error);
+                    }
+
+                    promise->set_value(std::move(error));
+                },
+                [frames_saved, callbacks](std::size_t context_id, update_indicator update)
+                {
+                    if (update.context() == "save")
+                    {
+                        frames_saved->fetch_add(update.processed(), std::memory_order_relaxed);
+                    }
+
+                    if (callbacks.update)
+                    {
+                        callbacks.update(context_id, std::move(update));
+                    }
+                }
+            }
+        );
+    }
+}
+
+std::vector<host::stream_result> host::wait_until(std::chrono::steady_clock::time_point deadline)
+{
+    std::vector<stream_result> results;
+    results.reserve(m_streams.size());
+
+    for (auto & s : m_streams)
+    {
+        stream_result result;
+
+        const auto status = s.future.wait_until(deadline);
+
+        if (status == std::future_status::deferred)
+        {
+            result.state = stream_state::deferred;
+        }
+        else if (status == std::future_status::timeout)
+        {
+            result.state = stream_state::timed_out;
+        }
+        else
+        {
+            result.error = s.future.get();
+            result.state = result.error.empty() ? stream_state::finished : stream_state::failed;
+        }
+
+        results.push_back(std::move(result));
+    }
+
+    return results;
+}
+
+std::size_t host::streams() const
+{
+    return m_streams.size();
+}
+
+std::size_t host::groups() const
+{
+    return m_groups.size();
+}
+
+std::size_t host::fair_queue_depth() const
+{
+    return m_parameters.fair_queue_depth;
+}
+
+std::size_t host::frames_saved(std::size_t stream) const
+{
+    return m_streams.at(stream).frames_saved->load(std::memory_order_relaxed);
+}
+
+std::shared_ptr<latency_statistics> host::latencies(std::size_t stream) const
+{
+    return m_streams.at(stream).latencies;
+}
+
+std::vector<fair_queue::stream_statistics> host::statistics() const
+{
+    return m_fair_queue->statistics();
+}
+
+std::shared_ptr<videoproc::memory_budget> host::memory_budget() const
+{
+    return m_memory_budget;
+}
+
+template<typename Image>
+any_pipeline host::create_pipeline(stream_parameters const & parameters,
+                                   group const & stream_group,
+                                   imageproc::scripting::image_processor_proxy image_processor,
+                                   fair_share fair,
+                                   std::shared_ptr<latency_statistics> latencies) const
+{
+    using stages = frame_format_stages<Image>;
+
+    any_stage<Image> frame_processor = std::make_shared<typename stages::frame_processor>(stream_group.processors_scheduler, m_parameters.buffered_processing_frames, image_processor, m_memory_budget, fair, parameters.gating);
+    any_stage<Image> interframe_processor;
+
+    if (parameters.subtract_background)
+    {
+        interframe_processor = std::make_shared<typename stages::background_processor>(stream_group.processors_scheduler, m_thread_pool, m_parameters.buffered_processing_frames, parameters.background, m_memory_budget);
+    }
+    else
+    {
+        interframe_processor = std::make_shared<typename stages::interframe_processor>(stream_group.processors_scheduler, m_parameters.buffered_processing_frames, image_processor, m_memory_budget, fair, parameters.interframe_window);
+    }
+
+    any_stage<Image> file_producer;
+
+    switch (parameters.sink)
+    {
+        case sink_type::file:
+            file_producer = std::make_shared<typename stages::file_sink>(stream_group.file_out_scheduler, m_parameters.buffered_output_frames, parameters.encoder, m_memory_budget, latencies);
+            break;
+
+        case sink_type::raw:
+            file_producer = std::make_shared<typename stages::raw_sink>(stream_group.file_out_scheduler, m_parameters.buffered_output_frames, parameters.raw_format, m_memory_budget, latencies);
+            break;
+
+        case sink_type::null:
+            file_producer = std::make_shared<typename stages::null_sink>(stream_group.file_out_scheduler, m_parameters.buffered_output_frames, m_memory_budget, latencies);
+            break;
+    }
+
+    any_stage<Image> source_stage;
+
+    switch (parameters.input)
+    {
+        case input_type::video:
+            source_stage = std::make_shared<typename stages::file_source>(stream_group.source_stage_scheduler, m_parameters.buffered_input_frames, parameters.decoder, m_memory_budget);
+            break;
+
+        case input_type::stream:
+            source_stage = std::make_shared<typename stages::rtsp_source>(stream_group.source_stage_scheduler, m_parameters.buffered_input_frames, parameters.stream, parameters.live, m_memory_budget);
+            break;
+
+        case input_type::synthetic:
+            source_stage = std::make_shared<typename stages::synthetic_source>(stream_group.source_stage_scheduler, m_parameters.buffered_input_frames, parameters.synthetic, m_memory_budget);
+            break;
+    }
+
+    if (parameters.record.empty())
+    {
+        if (parameters.input == input_type::stream)
+        {
+            return std::make_shared<typename stages::rtsp_to_file>(stream_group.pipeline_scheduler, source_stage, frame_processor, interframe_processor, file_producer);
+        }
+
+        return std::make_shared<typename stages::file_to_file>(stream_group.pipeline_scheduler, source_stage, frame_processor, interframe_processor, file_producer);
+    }
+
+    // the decoded frames are recorded and processed at the same time ; the recording always ends with
+    // a sequence end code
+    auto record_encoder = parameters.encoder;
+    record_encoder.end_code = true;
+
+    any_stage<Image> record_producer = std::make_shared<typename stages::file_sink>(stream_group.file_out_scheduler, m_parameters.buffered_output_frames, record_encoder, m_memory_budget);
+
+    topology<any_stage<Image> > stages_topology;
+
+    const auto source_id = stages_topology.add(source_stage);
+    stages_topology.add(record_producer, source_id);
+    const auto frame_id = stages_topology.add(frame_processor, source_id, parameters.analytics_policy);
+    const auto interframe_id = stages_topology.add(interframe_processor, frame_id);
+    stages_topology.add(file_producer, interframe_id);
+
+    return std::make_shared<typename stages::graph>(stream_group.pipeline_scheduler, std::move(stages_topology));
+}
+
+} // namespace cvpg::videoproc::pipelines
@@ -0,0 +1,148 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_PIPELINES_HOST_HPP
+#define LIBCVPG_VIDEOPROC_PIPELINES_HOST_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/asynchronous/scheduler_shared_proxy.hpp>
+
+#include <libcvpg/imageproc/scripting/image_processor.hpp>
+#include <libcvpg/imageproc/scripting/diagnostics/typedefs.hpp>
+#include <libcvpg/videoproc/fair_queue.hpp>
+#include <libcvpg/videoproc/latency_statistics.hpp>
+#include <libcvpg/videoproc/memory_budget.hpp>
+#include <libcvpg/videoproc/pipelines/any_pipeline.hpp>
+#include <libcvpg/videoproc/pipelines/host_parameters.hpp>
+#include <libcvpg/videoproc/pipelines/parameters.hpp>
+
+namespace cvpg::videoproc::pipelines {
+
+//
+// A host runs the pipelines of several streams at once. All streams share a thread pool, a memory
+// budget and a fair queue that distributes the frame evaluations of the streams by their weights. The
+// streams are assigned round-robin to the stream groups ; each group has own threads for the sources,
+// processors, sinks and pipelines of its streams.
+//
+// Usage: create an image processor at the thread pool of the host and compile the scripts, add the
+// streams, start them and wait until they are done. A host is not thread-safe and has to be used from
+// a single thread ; the callbacks of the streams are called at the threads of the pipelines.
+//
+class host
+{
+public:
+    using scheduler_type = boost::asynchronous::any_shared_scheduler_proxy<imageproc::scripting::diagnostics::servant_job>;
+
+    // state of a stream after waiting for it
+    enum class stream_state
+    {
+        finished,
+        failed,
+        timed_out,
+        deferred
+    };
+
+    struct stream_result
+    {
+        stream_state state = stream_state::timed_out;
+
+        // error of a failed stream
+        std::string error;
+    };
+
+    explicit host(host_parameters parameters);
+
+    host(host const &) = delete;
+    host(host &&) = delete;
+
+    host & operator=(host const &) = delete;
+    host & operator=(host &&) = delete;
+
+    ~host() = default;
+
+    scheduler_type thread_pool() const;
+
+    // add a stream and return its ID ; the callbacks are called in addition to the own ones of the host
+    std::size_t add_stream(stream_parameters parameters,
+                           imageproc::scripting::image_processor_proxy image_processor,
+                           parameters::callbacks callbacks = parameters::callbacks());
+
+    // start all streams not started yet
+    void start();
+
+    // wait until all streams are done or the deadline is reached ; could be called multiple times
+    std::vector<stream_result> wait_until(std::chrono::steady_clock::time_point deadline);
+
+    std::size_t streams() const;
+
+    std::size_t groups() const;
+
+    std::size_t fair_queue_depth() const;
+
+    // amount of frames written by the sink of a stream
+    std::size_t frames_saved(std::size_t stream) const;
+
+    // latencies of the frames written by the sink of a stream
+    std::shared_ptr<latency_statistics> latencies(std::size_t stream) const;
+
+    // statistics of the fair queue ; empty if the thread pool isn't shared fairly
+    std::vector<fair_queue::stream_statistics> statistics() const;
+
+    // empty if the memory is unlimited
+    std::shared_ptr<videoproc::memory_budget> memory_budget() const;
+
+private:
+    struct group
+    {
+        scheduler_type source_stage_scheduler;
+        scheduler_type processors_scheduler;
+        scheduler_type file_out_scheduler;
+        scheduler_type pipeline_scheduler;
+    };
+
+    struct stream
+    {
+        any_pipeline pipeline;
+        std::vector<std::string> stage_parameters;
+        parameters::callbacks callbacks;
+
+        bool started = false;
+
+        std::shared_ptr<std::promise<std::string> > promise;
+        std::shared_future<std::string> future;
+
+        std::shared_ptr<std::atomic<std::size_t> > frames_saved;
+        std::shared_ptr<latency_statistics> latencies;
+    };
+
+    template<typename Image>
+    any_pipeline create_pipeline(stream_parameters const & parameters,
+                                 group const & stream_group,
+                                 imageproc::scripting::image_processor_proxy image_processor,
+                                 fair_share fair,
+                                 std::shared_ptr<latency_statistics> latencies) const;
+
+    host_parameters m_parameters;
+
+    scheduler_type m_thread_pool;
+
+    std::shared_ptr<videoproc::memory_budget> m_memory_budget;
+
+    std::shared_ptr<fair_queue> m_fair_queue;
+
+    std::vector<group> m_groups;
+
+    // declared last, so the pipelines are destroyed before the schedulers of the groups
+    std::vector<stream> m_streams;
+};
+
+} // namespace cvpg::videoproc::pipelines
+
+#endif // LIBCVPG_VIDEOPROC_PIPELINES_HOST_HPP
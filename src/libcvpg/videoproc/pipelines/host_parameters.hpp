@@ -0,0 +1,129 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_PIPELINES_HOST_PARAMETERS_HPP
+#define LIBCVPG_VIDEOPROC_PIPELINES_HOST_PARAMETERS_HPP
+
+#include <cstdint>
+#include <string>
+
+#include <libcvpg/videoproc/pipelines/fan_out.hpp>
+#include <libcvpg/videoproc/processors/background_parameters.hpp>
+#include <libcvpg/videoproc/processors/gating_parameters.hpp>
+#include <libcvpg/videoproc/sinks/encoder_parameters.hpp>
+#include <libcvpg/videoproc/sinks/raw.hpp>
+#include <libcvpg/videoproc/sources/decoder_parameters.hpp>
+#include <libcvpg/videoproc/sources/live_parameters.hpp>
+#include <libcvpg/videoproc/sources/rtsp_parameters.hpp>
+#include <libcvpg/videoproc/sources/synthetic_parameters.hpp>
+
+namespace cvpg::videoproc::pipelines {
+
+// format of the frames passed between the stages of a stream
+enum class frame_format
+{
+    rgb,
+    yuv420,
+    gray
+};
+
+// source of a stream
+enum class input_type
+{
+    // video file
+    video,
+
+    // RTSP stream
+    stream,
+
+    // generated video
+    synthetic
+};
+
+// sink of a stream
+enum class sink_type
+{
+    // encoded video file
+    file,
+
+    // uncompressed planes of the frames
+    raw,
+
+    // frames are discarded
+    null
+};
+
+//
+// Parameters shared by all streams of a host.
+//
+struct host_parameters
+{
+    // amount of worker threads of the thread pool
+    std::size_t threads = 1;
+
+    // amount of stream groups ; each group has own threads for the sources, processors, sinks and
+    // pipelines of its streams
+    std::size_t stream_groups = 1;
+
+    // share the thread pool fairly between the streams by a fair queue
+    bool fair_sharing = true;
+
+    // maximum amount of frame evaluations of all streams running at the thread pool at once
+    // (0 = twice the amount of threads)
+    std::size_t fair_queue_depth = 0;
+
+    // maximum amount of bytes of buffered frames at all stages of all streams (0 = unlimited)
+    std::size_t memory_budget = 0;
+
+    std::size_t buffered_input_frames = 20;
+    std::size_t buffered_processing_frames = 50;
+    std::size_t buffered_output_frames = 20;
+};
+
+//
+// Parameters of a stream of a host.
+//
+struct stream_parameters
+{
+    // name of the stream used at statistics
+    std::string name;
+
+    // share of the thread pool relative to the other streams
+    double weight = 1.0;
+
+    frame_format format = frame_format::rgb;
+
+    // source stage
+    input_type input = input_type::video;
+    std::string uri;
+    sources::decoder_parameters decoder;
+    sources::rtsp_parameters stream;
+    sources::live_parameters live;
+    sources::synthetic_parameters synthetic;
+
+    // frame stage
+    std::string frame_script;
+    processors::gating_parameters gating;
+
+    // inter-frame stage ; the background subtraction replaces the inter-frame script
+    std::string interframe_script;
+    std::size_t interframe_window = 2;
+    bool subtract_background = false;
+    processors::background_parameters background;
+
+    // sink stage
+    sink_type sink = sink_type::file;
+    sinks::raw_format raw_format = sinks::raw_format::y4m;
+    sinks::encoder_parameters encoder;
+    std::string output;
+
+    // the decoded frames are recorded to this file in parallel to the processing (empty = no recording)
+    std::string record;
+
+    // behaviour of the processing branch if it can't keep up with the recording
+    branch_policy analytics_policy = branch_policy::block;
+};
+
+} // namespace cvpg::videoproc::pipelines
+
+#endif // LIBCVPG_VIDEOPROC_PIPELINES_HOST_PARAMETERS_HPP
@@ -108,5 +108,6 @@ void rtsp_to_file<Stage>::stage_initialized(std::size_t context_id, std::size_t
 // manual instantation of rtsp_to_file<> for some types
 template class rtsp_to_file<any_stage<image_gray_8bit> >;
 template class rtsp_to_file<any_stage<image_rgb_8bit> >;
+template class rtsp_to_file<any_stage<image_yuv420_8bit> >;
 
 } // cvpg::videoproc::pipelines
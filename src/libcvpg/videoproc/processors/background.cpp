@@ -0,0 +1,441 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/videoproc/processors/background.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <utility>
+
+#include <libcvpg/core/exception.hpp>
+#include <libcvpg/core/meta_data.hpp>
+#include <libcvpg/videoproc/stage_data_handler.hpp>
+#include <libcvpg/videoproc/processors/background_model.hpp>
+
+namespace {
+
+// intensity plane of an image and the distance of its lines
+struct intensity_plane
+{
+    std::uint8_t const * data = nullptr;
+    std::size_t stride = 0;
+};
+
+intensity_plane intensity(cvpg::image_gray_8bit const & image, std::uint8_t *, std::uint32_t, std::uint32_t)
+{
+    return { image.data(0).get(), static_cast<std::size_t>(image.width()) + image.padding() };
+}
+
+// the intensity of the lines ['from_y', 'to_y') is calculated at the mask, the mask is updated in place afterwards
+intensity_plane intensity(cvpg::image_rgb_8bit const & image, std::uint8_t * mask, std::uint32_t from_y, std::uint32_t to_y)
+{
+    const std::uint32_t width = image.width();
+    const std::size_t stride = static_cast<std::size_t>(width) + image.padding();
+
+    std::uint8_t const * r = image.data(0).get();
+    std::uint8_t const * g = image.data(1).get();
+    std::uint8_t const * b = image.data(2).get();
+
+    for (std::uint32_t y = from_y; y < to_y; ++y)
+    {
+        const std::size_t offset = y * stride;
+
+        std::uint8_t * line = mask + static_cast<std::size_t>(y) * width;
+
+        // luma weights of BT.601 in fixed point (sum is 256)
+        for (std::uint32_t x = 0; x < width; ++x)
+        {
+            line[x] = static_cast<std::uint8_t>((77 * r[offset + x] + 150 * g[offset + x] + 29 * b[offset + x]) >> 8);
+        }
+    }
+
+    return { mask, width };
+}
+
+intensity_plane intensity(cvpg::image_yuv420_8bit const & image, std::uint8_t *, std::uint32_t, std::uint32_t)
+{
+    return { image.data(0).get(), image.stride(0) };
+}
+
+// the mask as image of a frame
+cvpg::image_gray_8bit mask_image(cvpg::image_gray_8bit const &, cvpg::image_gray_8bit mask)
+{
+    return mask;
+}
+
+cvpg::image_rgb_8bit mask_image(cvpg::image_rgb_8bit const &, cvpg::image_gray_8bit mask)
+{
+    return cvpg::image_rgb_8bit(mask.width(), mask.height(), 0, {{ mask.data(0), mask.data(0), mask.data(0) }});
+}
+
+cvpg::image_yuv420_8bit mask_image(cvpg::image_yuv420_8bit const &, cvpg::image_gray_8bit mask)
+{
+    cvpg::image_yuv420_8bit image(mask.width(), mask.height());
+
+    // the chroma planes are neutral (gray)
+    for (std::uint8_t p = 1; p < 3; ++p)
+    {
+        memset(image.data(p).get(), 128, static_cast<std::size_t>(image.stride(p)) * image.plane_height(p));
+    }
+
+    // the mask (0 or 255) is used as full range luma
+    return cvpg::image_yuv420_8bit(image.width(), image.height(), {{ mask.data(0), image.data(1), image.data(2) }}, {{ mask.width(), image.stride(1), image.stride(2) }}, cvpg::color_range::full);
+}
+
+} // anonymous namespace
+
+namespace cvpg::videoproc::processors {
+
+template<typename Image> struct background<Image>::processing_context
+{
+    bool prev_stage_finished = false;
+
+    struct status_info
+    {
+        std::size_t next_waiting = 0;
+
+        std::size_t packet_counter = 0;
+
+        std::size_t frames_created = 0;
+
+        // a frame is updating the model at the moment
+        bool busy = false;
+
+        // tiles of the current frame that are not updated yet
+        std::size_t tiles_left = 0;
+
+        bool failed = false;
+    };
+
+    status_info status;
+
+    struct callback_info
+    {
+        std::function<void(std::size_t, std::map<std::string, std::any>)> params;
+        std::function<void(std::size_t, videoproc::packet<videoproc::frame<Image> >)> deliver_packet;
+        std::function<void(std::size_t, std::size_t)> next;
+        std::function<void(std::size_t)> finished;
+        std::function<void(std::size_t, std::string)> failed;
+        std::function<void(std::size_t, videoproc::update_indicator)> update_indicator;
+    };
+
+    callback_info callbacks;
+
+    struct buffer_in_info
+    {
+        std::size_t next_frame = 0;
+
+        // frames received out of order, waiting for the frames before them
+        std::map<std::size_t, videoproc::frame<Image> > pending;
+    };
+
+    buffer_in_info buffer_in;
+
+    std::shared_ptr<background_model> model;
+
+    std::shared_ptr<stage_data_handler<videoproc::frame<Image> > > sdh_out;
+};
+
+template<typename Image> background<Image>::background(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler,
+                                                       boost::asynchronous::any_shared_scheduler_proxy<imageproc::scripting::diagnostics::servant_job> pool,
+                                                       std::size_t max_frames_output_buffer,
+                                                       background_parameters parameters,
+                                                       std::shared_ptr<memory_budget> memory_budget)
+    : boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>(scheduler, pool)
+    , m_max_frames_output_buffer(max_frames_output_buffer)
+    , m_parameters(std::move(parameters))
+    , m_memory_budget(std::move(memory_budget))
+    , m_contexts()
+{}
+
+template<typename Image> void background<Image>::init(std::size_t context_id, std::string, stage_callbacks<Image> callbacks)
+{
+    if (m_parameters.tile_lines == 0)
+    {
+        throw cvpg::exception("tiles of background processor must contain at least one line");
+    }
+
+    // create new processing context
+    auto context = std::make_shared<processing_context>();
+    context->callbacks.params = std::move(callbacks.parameters);
+    context->callbacks.deliver_packet = std::move(callbacks.deliver);
+    context->callbacks.next = std::move(callbacks.next);
+    context->callbacks.finished = std::move(callbacks.finished);
+    context->callbacks.failed = std::move(callbacks.failed);
+    context->callbacks.update_indicator = std::move(callbacks.update);
+    context->model = std::make_shared<background_model>(m_parameters);
+
+    context->sdh_out = std::make_shared<stage_data_handler<videoproc::frame<Image> > >(
+        "background",
+        m_max_frames_output_buffer,
+        [context_id, context]()
+        {
+            const auto free = context->sdh_out->free();
+
+            if (free != 0)
+            {
+                // inform previous stage that this stage is ready to receive new data
+                context->callbacks.next(context_id, free);
+            }
+        },
+        [context]()
+        {
+            return context->status.next_waiting;
+        },
+        [this, context_id, context](std::vector<videoproc::frame<Image> > frames, std::function<void()> deliver_done_callback)
+        {
+            if (!frames.empty())
+            {
+                context->status.next_waiting = 0;
+
+                auto packet_number = context->status.packet_counter;
+
+                videoproc::packet<videoproc::frame<Image> > packet(packet_number);
+
+                for (auto & f : frames)
+                {
+                    packet.add_frame(std::move(f));
+                }
+
+                context->callbacks.deliver_packet(context_id, std::move(packet));
+            }
+
+            deliver_done_callback();
+        },
+        m_memory_budget
+    );
+
+    m_contexts.insert({ context_id, context });
+
+    callbacks.initialized(context_id, 0);
+
+    context->sdh_out->try_flush();
+}
+
+template<typename Image> void background<Image>::params(std::size_t context_id, std::map<std::string, std::any> p)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it != m_contexts.end())
+    {
+        auto & context = it->second;
+
+        context->callbacks.params(context_id, std::move(p));
+    }
+}
+
+template<typename Image> void background<Image>::start(std::size_t context_id)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it != m_contexts.end())
+    {
+        auto & context = it->second;
+
+        if (!(context->prev_stage_finished))
+        {
+            context->callbacks.next(context_id, context->sdh_out->free());
+        }
+    }
+}
+
+template<typename Image> void background<Image>::finish(std::size_t context_id)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it != m_contexts.end())
+    {
+        auto & context = it->second;
+
+        context->prev_stage_finished = true;
+    }
+}
+
+template<typename Image> void background<Image>::process(std::size_t context_id, videoproc::packet<videoproc::frame<Image> > && packet)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it != m_contexts.end())
+    {
+        auto & context = it->second;
+
+        auto frames = packet.move_frames();
+
+        for (auto & frame : frames)
+        {
+            frame.enter_stage("processors::background");
+
+            const auto number = frame.number();
+
+            context->buffer_in.pending.insert({ number, std::move(frame) });
+        }
+
+        try_process_input(context_id);
+    }
+}
+
+template<typename Image> void background<Image>::next(std::size_t context_id, std::size_t max_new_data)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it != m_contexts.end())
+    {
+        auto & context = it->second;
+
+        context->status.next_waiting = max_new_data;
+
+        context->sdh_out->try_flush();
+    }
+}
+
+template<typename Image> void background<Image>::try_process_input(std::size_t context_id)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it == m_contexts.end())
+    {
+        return;
+    }
+
+    auto context = it->second;
+
+    // the model is updated by one frame after another
+    if (context->status.busy || context->status.failed)
+    {
+        return;
+    }
+
+    auto & pending = context->buffer_in.pending;
+
+    auto frame_it = pending.find(context->buffer_in.next_frame);
+
+    if (frame_it == pending.end())
+    {
+        // try flush output and trigger new input in case we have not enough frames
+        context->sdh_out->try_flush();
+
+        return;
+    }
+
+    auto frame = std::move(frame_it->second);
+    pending.erase(frame_it);
+
+    ++(context->buffer_in.next_frame);
+
+    if (frame.flush())
+    {
+        context->sdh_out->add(typename videoproc::frame<Image>(context->status.frames_created));
+
+        return;
+    }
+
+    const auto image = frame.move_image();
+
+    // luma planes keep the range of the decoder, the model adapts to it
+    auto model = context->model;
+    model->resize(image.width(), image.height(), image.range());
+
+    // the mask is written by the tiles ; frames without a luma plane store their intensity at the mask before
+    cvpg::image_gray_8bit mask(image.width(), image.height());
+
+    const std::uint32_t tile_lines = m_parameters.tile_lines;
+    const std::size_t tiles = (image.height() + tile_lines - 1) / tile_lines;
+
+    context->status.busy = true;
+    context->status.tiles_left = tiles;
+
+    const auto current_frame_number = context->status.frames_created++;
+
+    // called after all tiles of the frame are updated
+    auto frame_done = [this, context_id, context, model, image, mask, current_frame_number, current_timestamps = frame.timestamps(), current_source = frame.source(), current_modified = frame.modified()]()
+    {
+        model->finish_frame();
+
+        context->callbacks.update_indicator(context_id, videoproc::update_indicator("background", 1, 0));
+
+        videoproc::frame<Image> result;
+
+        if (m_parameters.output == background_output::frame)
+        {
+            // the mask is added to a copy of the meta data, because the meta data may be shared with other images
+            auto metadata = (image.has_metadata() && !!image.get_metadata()) ? std::make_shared<cvpg::meta_data>(*image.get_metadata()) : std::make_shared<cvpg::meta_data>();
+            metadata->push("foreground_mask", mask);
+
+            auto annotated = image;
+            annotated.set_metadata(std::move(metadata));
+
+            result = videoproc::frame<Image>(current_frame_number, std::move(annotated));
+        }
+        else
+        {
+            result = videoproc::frame<Image>(current_frame_number, mask_image(image, mask));
+        }
+
+        result.set_timestamps(current_timestamps);
+
+        // the pixels of the frame are only kept if the mask is added as meta data
+        result.set_source(current_source, current_modified || m_parameters.output != background_output::frame);
+
+        context->sdh_out->add(std::move(result));
+
+        context->status.busy = false;
+
+        this->try_process_input(context_id);
+    };
+
+    for (std::size_t tile = 0; tile < tiles; ++tile)
+    {
+        const std::uint32_t from_y = static_cast<std::uint32_t>(tile * tile_lines);
+        const std::uint32_t to_y = std::min(from_y + tile_lines, image.height());
+
+        post_callback(
+            [model, image, mask, from_y, to_y]()
+            {
+                std::uint8_t * mask_data = mask.data(0).get();
+
+                const auto plane = intensity(image, mask_data, from_y, to_y);
+
+                model->update(plane.data, plane.stride, mask_data, mask.width(), from_y, to_y);
+
+                return to_y - from_y;
+            },
+            [context_id, context, frame_done](auto cont_res)
+            {
+                try
+                {
+                    cont_res.get();
+
+                    if (--(context->status.tiles_left) == 0 && !(context->status.failed))
+                    {
+                        frame_done();
+                    }
+                }
+                catch (std::exception const & e)
+                {
+                    context->status.failed = true;
+
+                    context->callbacks.update_indicator(context_id, videoproc::update_indicator("background", 0, 1));
+                    context->callbacks.failed(context_id, e.what());
+                }
+                catch (...)
+                {
+                    context->status.failed = true;
+
+                    context->callbacks.update_indicator(context_id, videoproc::update_indicator("background", 0, 1));
+                    context->callbacks.failed(context_id, "unknown error when updating background model");
+                }
+            },
+            "processors::background::try_process_input",
+            1,
+            1
+        );
+    }
+}
+
+// manual instantiation of background<> for some types
+template class background<cvpg::image_gray_8bit>;
+template class background<cvpg::image_rgb_8bit>;
+template class background<cvpg::image_yuv420_8bit>;
+
+} // namespace cvpg::videoproc::processors
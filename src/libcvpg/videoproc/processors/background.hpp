@@ -0,0 +1,139 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_PROCESSORS_BACKGROUND_HPP
+#define LIBCVPG_VIDEOPROC_PROCESSORS_BACKGROUND_HPP
+
+#include <any>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <boost/asynchronous/servant_proxy.hpp>
+#include <boost/asynchronous/trackable_servant.hpp>
+
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/imageproc/scripting/diagnostics/typedefs.hpp>
+#include <libcvpg/videoproc/frame.hpp>
+#include <libcvpg/videoproc/memory_budget.hpp>
+#include <libcvpg/videoproc/packet.hpp>
+#include <libcvpg/videoproc/stage_parameters.hpp>
+#include <libcvpg/videoproc/update_indicator.hpp>
+#include <libcvpg/videoproc/processors/background_parameters.hpp>
+
+namespace cvpg::videoproc::processors {
+
+//
+// A background processor separates moving objects from the static background of a video stream. A
+// background model is updated with the intensity of each frame and the foreground mask (255 =
+// foreground, 0 = background) replaces the image of the frame or is added to the meta data of the
+// image as 'foreground_mask' (see 'background_output').
+//
+// The frames are processed in order, because each frame updates the model. The lines of a frame are
+// split into tiles of 'tile_lines' lines that are updated in parallel at the thread pool. Unlike the
+// inter-frame processor no script is evaluated, so the stage parameter passed at 'init' is ignored.
+//
+template<typename Image>
+class background : public boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>
+{
+public:
+    background(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler,
+               boost::asynchronous::any_shared_scheduler_proxy<imageproc::scripting::diagnostics::servant_job> pool,
+               std::size_t max_frames_output_buffer,
+               background_parameters parameters = background_parameters(),
+               std::shared_ptr<memory_budget> memory_budget = nullptr);
+
+    background(background const &) = delete;
+    background(background &&) = delete;
+
+    background & operator=(background const &) = delete;
+    background & operator=(background &&) = delete;
+
+    virtual ~background() = default;
+
+    void init(std::size_t context_id, std::string parameter, stage_callbacks<Image> callbacks);
+
+    void params(std::size_t context_id, std::map<std::string, std::any> p);
+
+    void start(std::size_t context_id);
+
+    void finish(std::size_t context_id);
+
+    void process(std::size_t context_id, videoproc::packet<videoproc::frame<Image> > && packet);
+
+    void next(std::size_t context_id, std::size_t max_new_data);
+
+private:
+    void try_process_input(std::size_t context_id);
+
+    // maximum amount of frames at output buffer
+    std::size_t m_max_frames_output_buffer;
+
+    background_parameters m_parameters;
+
+    // memory budget shared with the other stages of the pipeline (optional)
+    std::shared_ptr<memory_budget> m_memory_budget;
+
+    struct processing_context;
+    std::map<std::size_t, std::shared_ptr<processing_context> > m_contexts;
+};
+
+// suppress automatic instantiation of background<> for some types
+extern template class background<cvpg::image_gray_8bit>;
+extern template class background<cvpg::image_rgb_8bit>;
+extern template class background<cvpg::image_yuv420_8bit>;
+
+//
+// Hint: Boost.Asynchronous does not support templated proxies. Becaues the servant itself could
+// have template parameters we have to create a proxy for each wanted type.
+//
+
+struct image_gray_8bit_background_proxy : public boost::asynchronous::servant_proxy<image_gray_8bit_background_proxy, background<cvpg::image_gray_8bit>, imageproc::scripting::diagnostics::servant_job>
+{
+    template<typename... Args>
+    image_gray_8bit_background_proxy(Args... args)
+        : boost::asynchronous::servant_proxy<image_gray_8bit_background_proxy, background<cvpg::image_gray_8bit>, imageproc::scripting::diagnostics::servant_job>(std::forward<Args>(args)...)
+    {}
+
+    BOOST_ASYNC_POST_MEMBER_LOG(init, "init", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(params, "params", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(finish, "finish", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(process, "process", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
+};
+
+struct image_rgb_8bit_background_proxy : public boost::asynchronous::servant_proxy<image_rgb_8bit_background_proxy, background<cvpg::image_rgb_8bit>, imageproc::scripting::diagnostics::servant_job>
+{
+    template<typename... Args>
+    image_rgb_8bit_background_proxy(Args... args)
+        : boost::asynchronous::servant_proxy<image_rgb_8bit_background_proxy, background<cvpg::image_rgb_8bit>, imageproc::scripting::diagnostics::servant_job>(std::forward<Args>(args)...)
+    {}
+
+    BOOST_ASYNC_POST_MEMBER_LOG(init, "init", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(params, "params", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(finish, "finish", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(process, "process", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
+};
+
+struct image_yuv420_8bit_background_proxy : public boost::asynchronous::servant_proxy<image_yuv420_8bit_background_proxy, background<cvpg::image_yuv420_8bit>, imageproc::scripting::diagnostics::servant_job>
+{
+    template<typename... Args>
+    image_yuv420_8bit_background_proxy(Args... args)
+        : boost::asynchronous::servant_proxy<image_yuv420_8bit_background_proxy, background<cvpg::image_yuv420_8bit>, imageproc::scripting::diagnostics::servant_job>(std::forward<Args>(args)...)
+    {}
+
+    BOOST_ASYNC_POST_MEMBER_LOG(init, "init", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(params, "params", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(finish, "finish", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(process, "process", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
+};
+
+} // namespace cvpg::videoproc::processors
+
+#endif // LIBCVPG_VIDEOPROC_PROCESSORS_BACKGROUND_HPP
@@ -0,0 +1,294 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/videoproc/processors/background_model.hpp>
+
+#include <algorithm>
+
+namespace cvpg::videoproc::processors {
+
+background_model::background_model(background_parameters parameters)
+    : m_parameters(std::move(parameters))
+{
+    m_parameters.gaussians = std::max<std::uint32_t>(m_parameters.gaussians, 1);
+}
+
+void background_model::resize(std::uint32_t width, std::uint32_t height, color_range range)
+{
+    if (width == m_width && height == m_height && range == m_range && !m_mean.empty())
+    {
+        return;
+    }
+
+    m_width = width;
+    m_height = height;
+    m_range = range;
+    m_frames = 0;
+
+    // limited range intensities cover 219 instead of 255 values, so their differences are smaller
+    const float scale = range == color_range::limited ? 219.0f / 255.0f : 1.0f;
+
+    m_threshold = m_parameters.threshold * scale;
+    m_initial_variance = m_parameters.initial_variance * scale * scale;
+    m_minimum_variance = m_parameters.minimum_variance * scale * scale;
+
+    const std::size_t pixels = static_cast<std::size_t>(width) * height;
+
+    if (m_parameters.method == background_method::gaussian_mixture)
+    {
+        m_mean.assign(pixels * m_parameters.gaussians, 0.0f);
+        m_variance.assign(pixels * m_parameters.gaussians, m_initial_variance);
+        m_weight.assign(pixels * m_parameters.gaussians, 0.0f);
+    }
+    else
+    {
+        m_mean.assign(pixels, 0.0f);
+        m_variance.clear();
+        m_weight.clear();
+    }
+}
+
+void background_model::update(std::uint8_t const * intensity, std::size_t intensity_stride, std::uint8_t * mask, std::size_t mask_stride, std::uint32_t from_y, std::uint32_t to_y)
+{
+    to_y = std::min(to_y, m_height);
+
+    for (std::uint32_t y = from_y; y < to_y; ++y)
+    {
+        const std::size_t offset = static_cast<std::size_t>(y) * m_width;
+
+        if (m_parameters.method == background_method::gaussian_mixture)
+        {
+            update_gaussian_mixture(intensity + y * intensity_stride, mask + y * mask_stride, offset);
+        }
+        else
+        {
+            update_running_average(intensity + y * intensity_stride, mask + y * mask_stride, offset);
+        }
+    }
+}
+
+void background_model::finish_frame()
+{
+    ++m_frames;
+}
+
+void background_model::update(std::uint8_t const * intensity, std::size_t intensity_stride, std::uint8_t * mask, std::size_t mask_stride)
+{
+    update(intensity, intensity_stride, mask, mask_stride, 0, m_height);
+    finish_frame();
+}
+
+std::uint32_t background_model::width() const
+{
+    return m_width;
+}
+
+std::uint32_t background_model::height() const
+{
+    return m_height;
+}
+
+color_range background_model::range() const
+{
+    return m_range;
+}
+
+std::size_t background_model::frames() const
+{
+    return m_frames;
+}
+
+background_parameters const & background_model::parameters() const
+{
+    return m_parameters;
+}
+
+void background_model::update_running_average(std::uint8_t const * intensity, std::uint8_t * mask, std::size_t offset)
+{
+    const std::uint32_t width = m_width;
+
+    float * mean = m_mean.data() + offset;
+
+    if (m_frames == 0)
+    {
+        for (std::uint32_t x = 0; x < width; ++x)
+        {
+            mean[x] = static_cast<float>(intensity[x]);
+            mask[x] = 0;
+        }
+
+        return;
+    }
+
+    const float rate = m_parameters.learning_rate;
+    const float threshold = m_threshold * m_threshold;
+
+    // no branches inside the loop, so the compiler is able to vectorize it
+    for (std::uint32_t x = 0; x < width; ++x)
+    {
+        const float difference = static_cast<float>(intensity[x]) - mean[x];
+
+        mask[x] = difference * difference > threshold ? 255 : 0;
+        mean[x] += rate * difference;
+    }
+}
+
+void background_model::update_gaussian_mixture(std::uint8_t const * intensity, std::uint8_t * mask, std::size_t offset)
+{
+    const std::uint32_t gaussians = m_parameters.gaussians;
+    const std::size_t width = m_width;
+
+    // distance between the planes of two distributions
+    const std::size_t plane = width * m_height;
+
+    if (m_frames == 0)
+    {
+        for (std::size_t x = 0; x < width; ++x)
+        {
+            m_mean[offset + x] = static_cast<float>(intensity[x]);
+            m_variance[offset + x] = m_initial_variance;
+            m_weight[offset + x] = 1.0f;
+            mask[x] = 0;
+        }
+
+        for (std::uint32_t k = 1; k < gaussians; ++k)
+        {
+            std::fill(m_weight.begin() + k * plane + offset, m_weight.begin() + k * plane + offset + width, 0.0f);
+        }
+
+        return;
+    }
+
+    const float rate = m_parameters.learning_rate;
+    const float deviations = m_parameters.deviations * m_parameters.deviations;
+    const float initial_variance = m_initial_variance;
+    const float minimum_variance = m_minimum_variance;
+    const float background_ratio = m_parameters.background_ratio;
+
+    // The distributions are processed one after another for blocks of pixels of the line, so all loops
+    // are without branches and could be vectorized. The intermediate values are stored at local arrays
+    // that can't alias the model. The indices of distributions are stored as floats to get vectors of
+    // the same width.
+    constexpr std::size_t block = 256;
+
+    float value[block];
+    float matched[block];
+    float matched_weight[block];
+    float lowest[block];
+    float lowest_weight[block];
+    float sum[block];
+
+    for (std::size_t from = 0; from < width; from += block)
+    {
+        const std::size_t n = std::min(block, width - from);
+
+        for (std::size_t x = 0; x < n; ++x)
+        {
+            value[x] = static_cast<float>(intensity[from + x]);
+            matched[x] = -1.0f;
+            matched_weight[x] = -1.0f;
+            lowest[x] = 0.0f;
+            lowest_weight[x] = 2.0f;
+            sum[x] = 0.0f;
+        }
+
+        // find the matching distribution with the highest weight and the distribution with the lowest weight
+        for (std::uint32_t k = 0; k < gaussians; ++k)
+        {
+            float const * mean = m_mean.data() + k * plane + offset + from;
+            float const * variance = m_variance.data() + k * plane + offset + from;
+            float const * weight = m_weight.data() + k * plane + offset + from;
+
+            const float index = static_cast<float>(k);
+
+            for (std::size_t x = 0; x < n; ++x)
+            {
+                const float difference = value[x] - mean[x];
+                const float w = weight[x];
+
+                const bool match = (difference * difference <= deviations * variance[x]) & (w > matched_weight[x]);
+                const bool low = w < lowest_weight[x];
+
+                matched[x] = match ? index : matched[x];
+                matched_weight[x] = match ? w : matched_weight[x];
+                lowest[x] = low ? index : lowest[x];
+                lowest_weight[x] = low ? w : lowest_weight[x];
+            }
+        }
+
+        // update the matching distribution or replace the distribution with the lowest weight if no distribution matches
+        for (std::uint32_t k = 0; k < gaussians; ++k)
+        {
+            float * mean = m_mean.data() + k * plane + offset + from;
+            float * variance = m_variance.data() + k * plane + offset + from;
+            float * weight = m_weight.data() + k * plane + offset + from;
+
+            const float index = static_cast<float>(k);
+
+            for (std::size_t x = 0; x < n; ++x)
+            {
+                const bool is_matched = matched[x] == index;
+                const bool is_replaced = (matched[x] < 0.0f) & (lowest[x] == index);
+
+                const float difference = value[x] - mean[x];
+                const float v = variance[x];
+
+                const float w = is_replaced ? rate : weight[x] * (1.0f - rate) + (is_matched ? rate : 0.0f);
+
+                // the weight of a matched distribution is at least the learning rate, so the update rate is at most 1
+                const float quotient = rate / w;
+                const float update_rate = is_matched ? quotient : 0.0f;
+
+                const float updated_variance = v + update_rate * (difference * difference - v);
+
+                // a replaced distribution gets the current value as mean
+                mean[x] += (is_replaced ? 1.0f : update_rate) * difference;
+                variance[x] = is_replaced ? initial_variance : (updated_variance > minimum_variance ? updated_variance : minimum_variance);
+                weight[x] = w;
+
+                sum[x] += w;
+            }
+        }
+
+        // normalize the weights ; 'matched_weight' gets the normalized weight of the matched distribution
+        for (std::size_t x = 0; x < n; ++x)
+        {
+            sum[x] = 1.0f / sum[x];
+            lowest_weight[x] = 0.0f;
+        }
+
+        for (std::uint32_t k = 0; k < gaussians; ++k)
+        {
+            float * weight = m_weight.data() + k * plane + offset + from;
+
+            const float index = static_cast<float>(k);
+
+            for (std::size_t x = 0; x < n; ++x)
+            {
+                const float w = weight[x] * sum[x];
+
+                weight[x] = w;
+                matched_weight[x] = matched[x] == index ? w : matched_weight[x];
+            }
+        }
+
+        // the matched distribution is part of the background if the distributions with higher weights
+        // don't describe the background already ; 'lowest_weight' gets the sum of these weights
+        for (std::uint32_t k = 0; k < gaussians; ++k)
+        {
+            float const * weight = m_weight.data() + k * plane + offset + from;
+
+            for (std::size_t x = 0; x < n; ++x)
+            {
+                lowest_weight[x] += weight[x] > matched_weight[x] ? weight[x] : 0.0f;
+            }
+        }
+
+        for (std::size_t x = 0; x < n; ++x)
+        {
+            mask[from + x] = ((matched[x] < 0.0f) | (lowest_weight[x] >= background_ratio)) ? 255 : 0;
+        }
+    }
+}
+
+} // namespace cvpg::videoproc::processors
@@ -0,0 +1,87 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_PROCESSORS_BACKGROUND_MODEL_HPP
+#define LIBCVPG_VIDEOPROC_PROCESSORS_BACKGROUND_MODEL_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/videoproc/processors/background_parameters.hpp>
+
+namespace cvpg::videoproc::processors {
+
+//
+// A background model stores statistics of the intensity of each pixel of a video and separates the
+// foreground from the background of each frame. The first frame initializes the model and has no
+// foreground.
+//
+// The thresholds and variances of the parameters are given for full range intensities. Limited range
+// intensities (e.g. the luma plane of a video decoder) are used as they are ; the thresholds and
+// variances are scaled to their range instead of expanding each frame.
+//
+// The model is updated in place. The statistics are stored plane by plane (a plane of each value of
+// all pixels), so the lines of a frame are processed by simple loops that could be vectorized by the
+// compiler. Disjoint ranges of lines of the same frame can be updated at the same time by different
+// threads ; 'finish_frame' has to be called after all lines of a frame are updated.
+//
+class background_model
+{
+public:
+    explicit background_model(background_parameters parameters = background_parameters());
+
+    // set the size and the range of the intensities of the frames ; the model is dropped if one of them differs
+    void resize(std::uint32_t width, std::uint32_t height, color_range range = color_range::full);
+
+    // update the lines ['from_y', 'to_y') of the model with a frame and write the foreground mask
+    // (255 = foreground, 0 = background) of these lines ; 'intensity' and 'mask' can point to the
+    // same buffer
+    void update(std::uint8_t const * intensity, std::size_t intensity_stride, std::uint8_t * mask, std::size_t mask_stride, std::uint32_t from_y, std::uint32_t to_y);
+
+    // all lines of the current frame are updated
+    void finish_frame();
+
+    // update all lines of the model with a frame
+    void update(std::uint8_t const * intensity, std::size_t intensity_stride, std::uint8_t * mask, std::size_t mask_stride);
+
+    std::uint32_t width() const;
+    std::uint32_t height() const;
+
+    color_range range() const;
+
+    // amount of frames the model was updated with
+    std::size_t frames() const;
+
+    background_parameters const & parameters() const;
+
+private:
+    void update_running_average(std::uint8_t const * intensity, std::uint8_t * mask, std::size_t offset);
+
+    void update_gaussian_mixture(std::uint8_t const * intensity, std::uint8_t * mask, std::size_t offset);
+
+    background_parameters m_parameters;
+
+    std::uint32_t m_width = 0;
+    std::uint32_t m_height = 0;
+
+    std::size_t m_frames = 0;
+
+    color_range m_range = color_range::full;
+
+    // threshold and variances of the parameters scaled to the range of the intensities
+    float m_threshold = 0.0f;
+    float m_initial_variance = 0.0f;
+    float m_minimum_variance = 0.0f;
+
+    // mean of the intensity of each pixel ; one plane per distribution for method 'gaussian_mixture'
+    std::vector<float> m_mean;
+
+    // variance and weight of the distributions of each pixel (method 'gaussian_mixture')
+    std::vector<float> m_variance;
+    std::vector<float> m_weight;
+};
+
+} // namespace cvpg::videoproc::processors
+
+#endif // LIBCVPG_VIDEOPROC_PROCESSORS_BACKGROUND_MODEL_HPP
@@ -0,0 +1,68 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_PROCESSORS_BACKGROUND_PARAMETERS_HPP
+#define LIBCVPG_VIDEOPROC_PROCESSORS_BACKGROUND_PARAMETERS_HPP
+
+#include <cstdint>
+
+namespace cvpg::videoproc::processors {
+
+// model of the background of a video
+enum class background_method
+{
+    // running average of the intensity of each pixel
+    running_average,
+
+    // mixture of gaussian distributions of the intensity of each pixel
+    gaussian_mixture
+};
+
+// output of the background subtraction stage
+enum class background_output
+{
+    // the foreground mask replaces the image of a frame
+    mask,
+
+    // the image of a frame is passed and the foreground mask is added to the meta data of the image
+    frame
+};
+
+//
+// Parameters of a background model. The model works on the intensity (luma) of the pixels and is
+// updated with each frame. A pixel is foreground if it doesn't fit to the background model.
+//
+struct background_parameters
+{
+    background_method method = background_method::running_average;
+
+    background_output output = background_output::mask;
+
+    // weight of the current frame when updating the model ; a higher rate adapts faster to changes
+    float learning_rate = 0.01f;
+
+    // minimum difference of the intensity to the running average of a foreground pixel (method 'running_average')
+    float threshold = 25.0f;
+
+    // amount of gaussian distributions per pixel (method 'gaussian_mixture')
+    std::uint32_t gaussians = 3;
+
+    // maximum distance in standard deviations of an intensity matching a distribution (method 'gaussian_mixture')
+    float deviations = 2.5f;
+
+    // minimum share of all observations of the distributions describing the background (method 'gaussian_mixture')
+    float background_ratio = 0.7f;
+
+    // variance of new distributions (method 'gaussian_mixture')
+    float initial_variance = 225.0f;
+
+    // lower limit of the variance of the distributions (method 'gaussian_mixture')
+    float minimum_variance = 16.0f;
+
+    // amount of lines updated by one task ; the tiles of a frame are updated in parallel
+    std::uint32_t tile_lines = 64;
+};
+
+} // namespace cvpg::videoproc::processors
+
+#endif // LIBCVPG_VIDEOPROC_PROCESSORS_BACKGROUND_PARAMETERS_HPP
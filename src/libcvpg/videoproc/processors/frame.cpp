@@ -3,14 +3,45 @@
 
 #include <libcvpg/videoproc/processors/frame.hpp>
 
+#include <cstdint>
 #include <exception>
 #include <future>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include <boost/asynchronous/continuation_task.hpp>
 
 #include <libcvpg/core/exception.hpp>
 #include <libcvpg/videoproc/stage_data_handler.hpp>
+#include <libcvpg/videoproc/processors/motion_gate.hpp>
+
+namespace {
+
+// intensity plane of an image compared by the motion gate and the distance of its lines
+struct intensity_plane
+{
+    std::uint8_t const * data = nullptr;
+    std::size_t stride = 0;
+};
+
+intensity_plane intensity(cvpg::image_gray_8bit const & image)
+{
+    return { image.data(0).get(), static_cast<std::size_t>(image.width()) + image.padding() };
+}
+
+// the green channel contributes most to the luma of RGB images
+intensity_plane intensity(cvpg::image_rgb_8bit const & image)
+{
+    return { image.data(1).get(), static_cast<std::size_t>(image.width()) + image.padding() };
+}
+
+intensity_plane intensity(cvpg::image_yuv420_8bit const & image)
+{
+    return { image.data(0).get(), image.stride(0) };
+}
+
+} // anonymous namespace
 
 namespace cvpg::videoproc::processors {
 
@@ -41,15 +72,37 @@ template<typename Image> struct frame<Image>::processing_context
 
     callback_info callbacks;
 
+    // decides which frames are evaluated (optional)
+    std::unique_ptr<motion_gate> gate;
+
+    struct gated_result
+    {
+        bool done = false;
+
+        typename videoproc::frame<Image>::image_type image;
+
+        // numbers, timestamps and source packets of skipped frames waiting for the result
+        std::vector<std::tuple<std::size_t, frame_timestamps, std::shared_ptr<source_packet const> > > waiting;
+    };
+
+    // result of the last evaluated frame (gating mode 'previous_result')
+    std::shared_ptr<gated_result> last_result;
+
     std::shared_ptr<stage_data_handler<videoproc::frame<Image> > > sdh_out;
 };
 
 template<typename Image> frame<Image>::frame(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler,
                                              std::size_t max_frames_output_buffer,
-                                             imageproc::scripting::image_processor_proxy image_processor)
+                                             imageproc::scripting::image_processor_proxy image_processor,
+                                             std::shared_ptr<memory_budget> memory_budget,
+                                             fair_share fair,
+                                             gating_parameters gating)
     : boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>(scheduler)
     , m_max_frames_output_buffer(max_frames_output_buffer)
     , m_image_processor(std::make_shared<imageproc::scripting::image_processor_proxy>(image_processor))
+    , m_memory_budget(std::move(memory_budget))
+    , m_fair(std::move(fair))
+    , m_gating(std::move(gating))
     , m_contexts()
 {}
 
@@ -64,6 +117,11 @@ template<typename Image> void frame<Image>::init(std::size_t context_id, std::st
     context->callbacks.failed = std::move(callbacks.failed);
     context->callbacks.update_indicator = std::move(callbacks.update);
 
+    if (m_gating.mode != gating_mode::off)
+    {
+        context->gate = std::make_unique<motion_gate>(m_gating);
+    }
+
     context->sdh_out = std::make_shared<stage_data_handler<videoproc::frame<Image> > >(
         "frame",
         m_max_frames_output_buffer,
@@ -100,7 +158,8 @@ template<typename Image> void frame<Image>::init(std::size_t context_id, std::st
             }
 
             deliver_done_callback();
-        }
+        },
+        m_memory_budget
     );
 
     m_contexts.insert({ context_id, context });
@@ -255,31 +314,133 @@ template<typename Image> void frame<Image>::process_next_frames(std::size_t cont
                 continue;
             }
 
-            auto image = frame.move_image();
+            frame.enter_stage("processors::frame");
+
+            if (context->gate)
+            {
+                const auto image = frame.image();
+                const auto plane = intensity(image);
+
+                if (!context->gate->process(plane.data, plane.stride, image.width(), image.height()))
+                {
+                    context->callbacks.update_indicator(context_id, videoproc::update_indicator("skip", 1, 0));
+
+                    if (m_gating.mode == gating_mode::raw_frame || !(context->last_result))
+                    {
+                        context->sdh_out->add(std::move(frame));
+                    }
+                    else if (context->last_result->done)
+                    {
+                        auto result_image = context->last_result->image;
+
+                        videoproc::frame<Image> result(frame_number, std::move(result_image));
+                        result.set_timestamps(frame.timestamps());
+                        result.set_source(frame.source(), true);
 
-            m_image_processor->evaluate_convert_if(
-                context->frames_id,
-                std::move(image),
-                make_safe_callback(
-                    [context, context_id, frame_number](typename videoproc::frame<Image>::image_type image)
+                        context->sdh_out->add(std::move(result));
+                    }
+                    else
                     {
-                        context->callbacks.update_indicator(context_id, videoproc::update_indicator("frame", 1, 0));
-
-                        context->sdh_out->add(typename videoproc::frame<Image>(frame_number, std::move(image)));
-                    },
-                    "processors::frame::process_next_frames::callback::success",
-                    1
-                ),
-                make_safe_callback(
-                    [context](std::size_t context_id, std::string error)
+                        // the evaluation of the last processed frame is still running
+                        context->last_result->waiting.push_back({ frame_number, frame.timestamps(), frame.source() });
+                    }
+
+                    continue;
+                }
+
+                if (m_gating.mode == gating_mode::previous_result)
+                {
+                    context->last_result = std::make_shared<typename processing_context::gated_result>();
+                }
+            }
+
+            const std::size_t cost = frame.bytes();
+
+            // a script returning the decoded pixels leaves the frame unmodified ; the pixels of the frame
+            // and of its dense copy are compared by address only
+            std::uint8_t const * decoded_pixels = frame.source() ? frame.image().data(0).get() : nullptr;
+
+            auto image = frame.move_dense_image();
+
+            std::uint8_t const * dense_pixels = decoded_pixels != nullptr ? image.data(0).get() : nullptr;
+
+            std::function<void(typename videoproc::frame<Image>::image_type)> success_callback = make_safe_callback(
+                [context, context_id, frame_number, timestamps = frame.timestamps(), source = frame.source(), decoded_pixels, dense_pixels, last_result = context->last_result](typename videoproc::frame<Image>::image_type image)
+                {
+                    context->callbacks.update_indicator(context_id, videoproc::update_indicator("frame", 1, 0));
+
+                    if (last_result)
                     {
-                        context->callbacks.update_indicator(context_id, videoproc::update_indicator("frame", 0, 1));
+                        // the skipped frames share the pixels of the result
+                        last_result->image = image;
+                        last_result->done = true;
+
+                        for (auto & [number, skipped_timestamps, skipped_source] : last_result->waiting)
+                        {
+                            auto result_image = last_result->image;
+
+                            videoproc::frame<Image> skipped(number, std::move(result_image));
+                            skipped.set_timestamps(std::move(skipped_timestamps));
+                            skipped.set_source(std::move(skipped_source), true);
+
+                            context->sdh_out->add(std::move(skipped));
+                        }
 
-                        context->callbacks.failed(context_id, std::move(error));
-                    },
-                    "processors::frame::process_next_frames::callback::failed",
-                    1
-                )
+                        last_result->waiting.clear();
+                    }
+
+                    std::uint8_t const * result_pixels = image.data(0).get();
+
+                    // the processed frame keeps the timestamps and the source packet of its source frame
+                    videoproc::frame<Image> result(frame_number, std::move(image));
+                    result.set_timestamps(timestamps);
+                    result.set_source(source, result_pixels != decoded_pixels && result_pixels != dense_pixels);
+
+                    context->sdh_out->add(std::move(result));
+                },
+                "processors::frame::process_next_frames::callback::success",
+                1
+            );
+
+            std::function<void(std::size_t, std::string)> failed_callback = make_safe_callback(
+                [context](std::size_t context_id, std::string error)
+                {
+                    context->callbacks.update_indicator(context_id, videoproc::update_indicator("frame", 0, 1));
+
+                    context->callbacks.failed(context_id, std::move(error));
+                },
+                "processors::frame::process_next_frames::callback::failed",
+                1
+            );
+
+            if (!m_fair.queue)
+            {
+                m_image_processor->evaluate_convert_if(context->frames_id, std::move(image), std::move(success_callback), std::move(failed_callback));
+
+                continue;
+            }
+
+            // the evaluation is started by the fair queue as soon as it is the turn of this pipeline
+            m_fair.queue->submit(
+                m_fair.stream,
+                cost,
+                [image_processor = m_image_processor, frames_id = context->frames_id, image = std::move(image), success_callback, failed_callback](std::function<void()> done) mutable
+                {
+                    image_processor->evaluate_convert_if(
+                        frames_id,
+                        std::move(image),
+                        [done, success_callback](typename videoproc::frame<Image>::image_type image)
+                        {
+                            done();
+                            success_callback(std::move(image));
+                        },
+                        [done, failed_callback](std::size_t context_id, std::string error)
+                        {
+                            done();
+                            failed_callback(context_id, std::move(error));
+                        }
+                    );
+                }
             );
         }
 
@@ -293,5 +454,6 @@ template<typename Image> void frame<Image>::process_next_frames(std::size_t cont
 // manual instantiation of frame<> for some types
 template class frame<cvpg::image_gray_8bit>;
 template class frame<cvpg::image_rgb_8bit>;
+template class frame<cvpg::image_yuv420_8bit>;
 
 } // namespace cvpg::videoproc::processors
@@ -16,23 +16,34 @@
 #include <libcvpg/core/image.hpp>
 #include <libcvpg/imageproc/scripting/image_processor.hpp>
 #include <libcvpg/imageproc/scripting/diagnostics/typedefs.hpp>
+#include <libcvpg/videoproc/fair_queue.hpp>
 #include <libcvpg/videoproc/frame.hpp>
+#include <libcvpg/videoproc/memory_budget.hpp>
 #include <libcvpg/videoproc/packet.hpp>
 #include <libcvpg/videoproc/stage_parameters.hpp>
 #include <libcvpg/videoproc/update_indicator.hpp>
+#include <libcvpg/videoproc/processors/gating_parameters.hpp>
 
 namespace cvpg::videoproc::processors {
 
 //
 // A frame processor handles image processing on single frames inside a video stream.
 //
+// A motion gate (optional, see 'gating_parameters') skips the evaluation of the script for frames that
+// barely differ from the last processed frame. A skipped frame gets the result of the last processed
+// frame or is passed unprocessed. The intensity of frames is taken from the luma plane, or from the
+// green channel of RGB frames.
+//
 template<typename Image>
 class frame : public boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>
 {
 public:
     frame(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler,
           std::size_t max_frames_output_buffer,
-          imageproc::scripting::image_processor_proxy image_processor);
+          imageproc::scripting::image_processor_proxy image_processor,
+          std::shared_ptr<memory_budget> memory_budget = nullptr,
+          fair_share fair = fair_share(),
+          gating_parameters gating = gating_parameters());
 
     frame(frame const &) = delete;
     frame(frame &&) = delete;
@@ -62,6 +73,14 @@ private:
 
     std::shared_ptr<imageproc::scripting::image_processor_proxy> m_image_processor;
 
+    // memory budget shared with the other stages of the pipeline (optional)
+    std::shared_ptr<memory_budget> m_memory_budget;
+
+    // share of the evaluations of the image processor, if the image processor is shared with other pipelines (optional)
+    fair_share m_fair;
+
+    gating_parameters m_gating;
+
     struct processing_context;
     std::map<std::size_t, std::shared_ptr<processing_context> > m_contexts;
 };
@@ -69,6 +88,7 @@ private:
 // suppress automatic instantiation of frame<> for some types
 extern template class frame<cvpg::image_gray_8bit>;
 extern template class frame<cvpg::image_rgb_8bit>;
+extern template class frame<cvpg::image_yuv420_8bit>;
 
 //
 // Hint: Boost.Asynchronous does not support templated proxies. Becaues the servant itself could
@@ -105,6 +125,21 @@ struct image_rgb_8bit_frame_proxy : public boost::asynchronous::servant_proxy<im
     BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
 };
 
+struct image_yuv420_8bit_frame_proxy : public boost::asynchronous::servant_proxy<image_yuv420_8bit_frame_proxy, frame<cvpg::image_yuv420_8bit>, imageproc::scripting::diagnostics::servant_job>
+{
+    template<typename... Args>
+    image_yuv420_8bit_frame_proxy(Args... args)
+        : boost::asynchronous::servant_proxy<image_yuv420_8bit_frame_proxy, frame<cvpg::image_yuv420_8bit>, imageproc::scripting::diagnostics::servant_job>(std::forward<Args>(args)...)
+    {}
+
+    BOOST_ASYNC_POST_MEMBER_LOG(init, "init", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(params, "params", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(finish, "finish", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(process, "process", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
+};
+
 } // namespace cvpg::videoproc::processors
 
 #endif // LIBCVPG_VIDEOPROC_PROCESSORS_FRAME_HPP
@@ -0,0 +1,56 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_PROCESSORS_GATING_PARAMETERS_HPP
+#define LIBCVPG_VIDEOPROC_PROCESSORS_GATING_PARAMETERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cvpg::videoproc::processors {
+
+// handling of frames without motion by a frame processor
+enum class gating_mode
+{
+    // all frames are processed
+    off,
+
+    // frames without motion get the result of the last processed frame
+    previous_result,
+
+    // frames without motion are passed unprocessed
+    raw_frame
+};
+
+//
+// Parameters of the motion gate of a frame processor. Each frame is compared with the last processed
+// frame at a reduced resolution. The change of a frame is the mean absolute difference of the
+// intensity of the block that changed most, so small moving objects are detected even if most of the
+// frame is static.
+//
+// The thresholds form a hysteresis: a moving scene becomes static if the change is at most
+// 'static_threshold' and a static scene moves again if the change exceeds 'motion_threshold'.
+//
+struct gating_parameters
+{
+    gating_mode mode = gating_mode::off;
+
+    // factor the frames are downscaled with before they are compared
+    std::uint32_t scale = 4;
+
+    // width and height of the compared blocks at the downscaled frames
+    std::uint32_t block_size = 8;
+
+    // maximum change of a frame of a static scene
+    float static_threshold = 2.0f;
+
+    // minimum change of a frame that starts motion in a static scene
+    float motion_threshold = 4.0f;
+
+    // maximum amount of subsequently skipped frames ; the next frame is processed anyway
+    std::size_t max_skipped = 25;
+};
+
+} // namespace cvpg::videoproc::processors
+
+#endif // LIBCVPG_VIDEOPROC_PROCESSORS_GATING_PARAMETERS_HPP
@@ -3,14 +3,15 @@
 
 #include <libcvpg/videoproc/processors/interframe.hpp>
 
-#include <algorithm>
-#include <deque>
+#include <cstdint>
 #include <exception>
 #include <future>
+#include <vector>
 
 #include <boost/asynchronous/continuation_task.hpp>
 
 #include <libcvpg/core/exception.hpp>
+#include <libcvpg/videoproc/sliding_window.hpp>
 #include <libcvpg/videoproc/stage_data_handler.hpp>
 
 namespace cvpg::videoproc::processors {
@@ -48,25 +49,52 @@ template<typename Image> struct interframe<Image>::processing_context
     struct buffer_in_info
     {
         std::size_t next_frame = 0;
-        std::shared_ptr<std::deque<videoproc::frame<Image> > > data;
+
+        // frames received out of order, waiting for the frames before them
+        std::map<std::size_t, videoproc::frame<Image> > pending;
     };
 
     buffer_in_info buffer_in;
 
+    struct window_entry
+    {
+        typename videoproc::frame<Image>::image_type image;
+        frame_timestamps timestamps;
+        std::size_t bytes = 0;
+        std::shared_ptr<source_packet const> source;
+
+        // the image differs from the decoded image of the source packet
+        bool modified = false;
+    };
+
+    // the last frames of the video
+    std::unique_ptr<sliding_window<window_entry> > window;
+
     std::shared_ptr<stage_data_handler<videoproc::frame<Image> > > sdh_out;
 };
 
 template<typename Image> interframe<Image>::interframe(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler,
                                                        std::size_t max_frames_output_buffer,
-                                                       imageproc::scripting::image_processor_proxy image_processor)
+                                                       imageproc::scripting::image_processor_proxy image_processor,
+                                                       std::shared_ptr<memory_budget> memory_budget,
+                                                       fair_share fair,
+                                                       std::size_t window_size)
     : boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>(scheduler)
     , m_max_frames_output_buffer(max_frames_output_buffer)
     , m_image_processor(std::make_shared<imageproc::scripting::image_processor_proxy>(image_processor))
+    , m_memory_budget(std::move(memory_budget))
+    , m_fair(std::move(fair))
+    , m_window_size(window_size)
     , m_contexts()
 {}
 
 template<typename Image> void interframe<Image>::init(std::size_t context_id, std::string script, stage_callbacks<Image> callbacks)
 {
+    if (m_window_size == 0)
+    {
+        throw cvpg::exception("window of inter-frame processor must contain at least one frame");
+    }
+
     // create new processing context
     auto context = std::make_shared<processing_context>();
     context->callbacks.params = std::move(callbacks.parameters);
@@ -75,7 +103,7 @@ template<typename Image> void interframe<Image>::init(std::size_t context_id, st
     context->callbacks.finished = std::move(callbacks.finished);
     context->callbacks.failed = std::move(callbacks.failed);
     context->callbacks.update_indicator = std::move(callbacks.update);
-    context->buffer_in.data = std::make_shared<std::deque<videoproc::frame<Image> > >();
+    context->window = std::make_unique<sliding_window<typename processing_context::window_entry> >(m_window_size);
 
     context->sdh_out = std::make_shared<stage_data_handler<videoproc::frame<Image> > >(
         "interframe",
@@ -113,7 +141,8 @@ template<typename Image> void interframe<Image>::init(std::size_t context_id, st
             }
 
             deliver_done_callback();
-        }
+        },
+        m_memory_budget
     );
 
     m_contexts.insert({ context_id, context });
@@ -223,8 +252,19 @@ template<typename Image> void interframe<Image>::process(std::size_t context_id,
     {
         auto & context = it->second;
 
-        // add new frames at the end of the input buffer
-        context->buffer_in.data->insert(context->buffer_in.data->end(), packet.frames().begin(), packet.frames().end());
+        auto frames = packet.move_frames();
+
+        for (auto & frame : frames)
+        {
+            frame.enter_stage("processors::interframe");
+        }
+
+        for (auto & frame : frames)
+        {
+            const auto number = frame.number();
+
+            context->buffer_in.pending.insert({ number, std::move(frame) });
+        }
 
         try_process_input(context_id);
     }
@@ -252,171 +292,142 @@ template<typename Image> void interframe<Image>::try_process_input(std::size_t c
     {
         auto & context = it->second;
 
-        if (context->buffer_in.data->empty())
-        {
-            return;
-        }
+        auto & pending = context->buffer_in.pending;
+        auto & window = *(context->window);
 
-        std::vector<std::size_t> numbers;
-        numbers.reserve(context->buffer_in.data->size());
+        bool flush_frame = false;
+        std::size_t evaluations = 0;
 
-        for (auto & frame : *context->buffer_in.data)
+        // take the frames in order of their numbers ; every frame that completes a window starts an evaluation
+        for (auto it = pending.find(context->buffer_in.next_frame); it != pending.end(); it = pending.find(context->buffer_in.next_frame))
         {
-            numbers.push_back(frame.number());
-        }
+            auto frame = std::move(it->second);
+            pending.erase(it);
 
-        std::sort(numbers.begin(), numbers.end());
+            ++(context->buffer_in.next_frame);
 
-        std::size_t frame_number = context->buffer_in.next_frame;
-
-        bool found = true;
+            if (frame.flush())
+            {
+                flush_frame = true;
+                break;
+            }
 
-        // TODO speed up this code!
-        while (found)
-        {
-            found = false;
+            // the oldest frame is evicted from a full window
+            const bool modified = frame.modified();
 
-            auto it = std::find_if(numbers.begin(),
-                                   numbers.end(),
-                                   [frame_number](std::size_t number)
-                                   {
-                                       return number == frame_number;
-                                   });
+            window.push({ std::any_cast<typename videoproc::frame<Image>::image_type>(std::move(frame.move_dense_image())), frame.timestamps(), frame.bytes(), frame.source(), modified });
 
-            if (it != numbers.end())
+            if (!window.full())
             {
-                found = true;
-                ++frame_number;
-            }
-            else
-            {
-                if (numbers.size() > 1)
-                {
-                    --frame_number;
-                }
-                else
-                {
-                    break;
-                }
+                continue;
             }
-        }
 
-        std::vector<videoproc::frame<Image> > frames;
-        frames.reserve(context->buffer_in.data->size());
-
-        // TODO use partition instead of copy_if here?!?!
-        std::copy_if(context->buffer_in.data->begin(),
-                     context->buffer_in.data->end(),
-                     std::back_inserter(frames),
-                     [frame_number](auto const & frame)
-                     {
-                         return frame.number() <= frame_number;
-                     });
-
-        std:sort(frames.begin(),
-                 frames.end(),
-                 [](auto const & a, auto const & b)
-                 {
-                     return a.number() < b.number();
-                 });
-
-        if (frames.size() < 2)
-        {
-            // try flush output and trigger new input in case we have not enough images
-            context->sdh_out->try_flush();
-            return;
-        }
+            // the images share their pixels with the images in the window ; ordered newest first, so the script
+            // gets the newest frame with 'input(0)'
+            std::vector<typename videoproc::frame<Image>::image_type> images;
+            images.reserve(window.size());
 
-        // except the frame, delete all older ones
-        for (auto it = context->buffer_in.data->begin(); it != context->buffer_in.data->end(); /* increment inside loop */)
-        {
-            if (it->number() <= (frame_number - 1))
-            {
-                it = context->buffer_in.data->erase(it);
-            }
-            else
+            // size of the images, used as costs of the evaluations by the fair queue
+            std::size_t cost = 0;
+
+            for (std::size_t k = 0; k < window.size(); ++k)
             {
-                ++it;
+                images.push_back(window.at(k).image);
+                cost += window.at(k).bytes;
             }
-        }
 
-        context->buffer_in.next_frame = frame_number;
+            const auto current_frame_number = context->status.frames_created++;
 
-        auto frames_amount = frames.size();
+            // a script returning the newest frame of the window (e.g. 'input(0)') leaves it unmodified ; the
+            // pixels are compared by address only
+            std::uint8_t const * current_pixels = window.at(0).modified ? nullptr : window.at(0).image.data(0).get();
 
-        auto packets_created = context->status.packets_created;
-        auto frames_created = context->status.frames_created;
+            std::function<void(typename videoproc::frame<Image>::image_type)> success_callback = make_safe_callback(
+                [context, context_id, current_frame_number, current_timestamps = window.at(0).timestamps, current_source = window.at(0).source, current_pixels](typename videoproc::frame<Image>::image_type image)
+                {
+                    context->callbacks.update_indicator(context_id, videoproc::update_indicator("interframe", 1, 0));
 
-        // create a vector of images for the image processor
-        auto images = std::make_shared<std::vector<typename videoproc::frame<Image>::image_type> >();
-        images->reserve(frames.size());
+                    const bool modified = current_pixels == nullptr || image.data(0).get() != current_pixels;
 
-        bool flush_frame = false;
-        std::size_t flush_number = 0;
+                    // the result gets the timestamps and the source packet of the newest frame of the window
+                    videoproc::frame<Image> result(current_frame_number, std::move(image));
+                    result.set_timestamps(current_timestamps);
+                    result.set_source(current_source, modified);
 
-        // extract/get raw images from items
-        for (auto & frame : frames)
-        {
-            // abort if frame is a flush frame
-            if (frame.flush())
+                    context->sdh_out->add(std::move(result));
+                },
+                "processors::interframe::try_process_input::callback::success",
+                1
+            );
+
+            std::function<void(std::size_t, std::string)> failed_callback = make_safe_callback(
+                [context](std::size_t context_id, std::string error)
+                {
+                    context->callbacks.update_indicator(context_id, videoproc::update_indicator("interframe", 0, 1));
+
+                    context->callbacks.failed(context_id, std::move(error));
+                },
+                "processors::interframe::try_process_input::callback::failed",
+                1
+            );
+
+            ++evaluations;
+
+            if (!m_fair.queue)
             {
-                flush_frame = true;
-                flush_number = frame.number();
+                m_image_processor->evaluate_convert_if(context->frames_id, std::move(images), std::move(success_callback), std::move(failed_callback));
+
                 continue;
             }
 
-            images->push_back(std::any_cast<typename videoproc::frame<Image>::image_type>(std::move(frame.move_image())));
+            // the evaluation is started by the fair queue as soon as it is the turn of this pipeline ; all images of the window are counted as costs
+            m_fair.queue->submit(
+                m_fair.stream,
+                cost,
+                [image_processor = m_image_processor, frames_id = context->frames_id, images = std::move(images), success_callback, failed_callback](std::function<void()> done)
+                {
+                    image_processor->evaluate_convert_if(
+                        frames_id,
+                        images,
+                        [done, success_callback](typename videoproc::frame<Image>::image_type image)
+                        {
+                            done();
+                            success_callback(std::move(image));
+                        },
+                        [done, failed_callback](std::size_t context_id, std::string error)
+                        {
+                            done();
+                            failed_callback(context_id, std::move(error));
+                        }
+                    );
+                }
+            );
         }
 
-        if (flush_frame)
+        if (evaluations > 0)
         {
-            // assume that we've 'lost' a single frame at interframe stage, so flush frame is one minus the last frame number
-            --flush_number;
+            context->status.packets_created++;
         }
 
-        for (std::size_t i = 0; i < images->size() - 1; ++i)
+        if (flush_frame)
         {
-            const auto current_frame_number = frames_created + i;
-
-            m_image_processor->evaluate_convert_if(
-                context->frames_id,
-                (*images)[i],
-                (*images)[i + 1],
-                make_safe_callback(
-                    [context, context_id, current_frame_number, images](typename videoproc::frame<Image>::image_type image)
-                    {
-                        context->callbacks.update_indicator(context_id, videoproc::update_indicator("interframe", 1, 0));
-
-                        context->sdh_out->add(typename videoproc::frame<Image>(current_frame_number, std::move(image)));
-                    },
-                    "processors::interframe::try_process_input::callback::success",
-                    1
-                ),
-                make_safe_callback(
-                    [context](std::size_t context_id, std::string error)
-                    {
-                        context->callbacks.update_indicator(context_id, videoproc::update_indicator("interframe", 0, 1));
-
-                        context->callbacks.failed(context_id, std::move(error));
-                    },
-                    "processors::interframe::try_process_input::callback::failed",
-                    1
-                )
-            );
-        }
+            // all results are numbered already, so the flush frame follows the last result
+            context->sdh_out->add(typename videoproc::frame<Image>(context->status.frames_created));
 
-        if (flush_frame)
+            // release the images of the last window
+            window.clear();
+        }
+        else if (evaluations == 0)
         {
-            context->sdh_out->add(typename videoproc::frame<Image>(flush_number));
+            // try flush output and trigger new input in case we have not enough images
+            context->sdh_out->try_flush();
         }
-
-        context->status.frames_created += images->size()/*frames_amount*/ - 1 - (flush_frame ? 1 : 0);
-        context->status.packets_created++;
     }
 }
 
 // manual instantiation of interframe<> for some types
 template class interframe<cvpg::image_gray_8bit>;
 template class interframe<cvpg::image_rgb_8bit>;
+template class interframe<cvpg::image_yuv420_8bit>;
 
 } // namespace cvpg::videoproc::processors
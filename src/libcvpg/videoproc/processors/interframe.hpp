@@ -16,7 +16,9 @@
 #include <libcvpg/core/image.hpp>
 #include <libcvpg/imageproc/scripting/image_processor.hpp>
 #include <libcvpg/imageproc/scripting/diagnostics/typedefs.hpp>
+#include <libcvpg/videoproc/fair_queue.hpp>
 #include <libcvpg/videoproc/frame.hpp>
+#include <libcvpg/videoproc/memory_budget.hpp>
 #include <libcvpg/videoproc/packet.hpp>
 #include <libcvpg/videoproc/stage_parameters.hpp>
 #include <libcvpg/videoproc/update_indicator.hpp>
@@ -27,13 +29,25 @@ namespace cvpg::videoproc::processors {
 // An inter-frame processor handles subsequent images inside a video stream that was previously
 // processed by a frame processor.
 //
+// The script is evaluated for each sliding window of the last 'window_size' frames ; the script gets
+// image 'k' of the window with 'input(k)'. The window is ordered newest first: 'input(0)' is the
+// newest (current) frame and 'input(window_size - 1)' the oldest one. This is the reverse order of
+// the sources of two input images, where 'input(mode, bits, 1)' is the older image. The frames of a
+// window are shared with the image processor, not copied. The result of an evaluation gets the
+// timestamps of the newest frame, so a video of 'n' frames results in 'n - window_size + 1' frames.
+// It keeps the source packet of the newest frame and stays unmodified if the script returns the
+// unmodified newest frame (e.g. 'input(0)'), so such frames could be passed through by a file sink.
+//
 template<typename Image>
 class interframe : public boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>
 {
 public:
     interframe(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler,
                std::size_t max_frames_output_buffer,
-               imageproc::scripting::image_processor_proxy image_processor);
+               imageproc::scripting::image_processor_proxy image_processor,
+               std::shared_ptr<memory_budget> memory_budget = nullptr,
+               fair_share fair = fair_share(),
+               std::size_t window_size = 2);
 
     interframe(interframe const &) = delete;
     interframe(interframe &&) = delete;
@@ -63,6 +77,15 @@ private:
 
     std::shared_ptr<imageproc::scripting::image_processor_proxy> m_image_processor;
 
+    // memory budget shared with the other stages of the pipeline (optional)
+    std::shared_ptr<memory_budget> m_memory_budget;
+
+    // share of the evaluations of the image processor, if the image processor is shared with other pipelines (optional)
+    fair_share m_fair;
+
+    // amount of frames the script is evaluated with
+    std::size_t m_window_size;
+
     struct processing_context;
     std::map<std::size_t, std::shared_ptr<processing_context> > m_contexts;
 };
@@ -70,6 +93,7 @@ private:
 // suppress automatic instantiation of interframe<> for some types
 extern template class interframe<cvpg::image_gray_8bit>;
 extern template class interframe<cvpg::image_rgb_8bit>;
+extern template class interframe<cvpg::image_yuv420_8bit>;
 
 //
 // Hint: Boost.Asynchronous does not support templated proxies. Becaues the servant itself could
@@ -106,6 +130,21 @@ struct image_rgb_8bit_interframe_proxy : public boost::asynchronous::servant_pro
     BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
 };
 
+struct image_yuv420_8bit_interframe_proxy : public boost::asynchronous::servant_proxy<image_yuv420_8bit_interframe_proxy, interframe<cvpg::image_yuv420_8bit>, imageproc::scripting::diagnostics::servant_job>
+{
+    template<typename... Args>
+    image_yuv420_8bit_interframe_proxy(Args... args)
+        : boost::asynchronous::servant_proxy<image_yuv420_8bit_interframe_proxy, interframe<cvpg::image_yuv420_8bit>, imageproc::scripting::diagnostics::servant_job>(std::forward<Args>(args)...)
+    {}
+
+    BOOST_ASYNC_POST_MEMBER_LOG(init, "init", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(params, "params", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(finish, "finish", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(process, "process", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
+};
+
 } // namespace cvpg::videoproc::processors
 
 #endif // LIBCVPG_VIDEOPROC_PROCESSORS_INTERFRAME_HPP
@@ -0,0 +1,178 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/videoproc/processors/motion_gate.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace cvpg::videoproc::processors {
+
+motion_gate::motion_gate(gating_parameters parameters)
+    : m_parameters(std::move(parameters))
+{
+    // the sums of a downscaled pixel have to fit into 16 bits
+    m_parameters.scale = std::clamp<std::uint32_t>(m_parameters.scale, 1, 16);
+    m_parameters.block_size = std::max<std::uint32_t>(m_parameters.block_size, 1);
+}
+
+bool motion_gate::process(std::uint8_t const * intensity, std::size_t stride, std::uint32_t width, std::uint32_t height)
+{
+    if (width != m_width || height != m_height)
+    {
+        m_width = width;
+        m_height = height;
+
+        m_scaled_width = width / m_parameters.scale;
+        m_scaled_height = height / m_parameters.scale;
+
+        m_current.assign(static_cast<std::size_t>(m_scaled_width) * m_scaled_height, 0);
+        m_sums.assign(m_scaled_width * m_parameters.scale, 0);
+
+        reset();
+    }
+
+    // frames smaller than a downscaled pixel are always processed
+    if (m_scaled_width == 0 || m_scaled_height == 0)
+    {
+        return true;
+    }
+
+    downscale(intensity, stride);
+
+    if (m_reference.empty())
+    {
+        m_reference.swap(m_current);
+        m_current.resize(m_reference.size());
+
+        m_change = 0.0f;
+        m_moving = true;
+
+        return true;
+    }
+
+    m_change = compare();
+
+    // hysteresis between the moving and the static scene
+    m_moving = m_change > (m_moving ? m_parameters.static_threshold : m_parameters.motion_threshold);
+
+    if (m_moving || m_skipped >= m_parameters.max_skipped)
+    {
+        // the processed frame is the new reference
+        m_reference.swap(m_current);
+        m_skipped = 0;
+
+        return true;
+    }
+
+    ++m_skipped;
+
+    return false;
+}
+
+void motion_gate::reset()
+{
+    m_reference.clear();
+    m_change = 0.0f;
+    m_skipped = 0;
+    m_moving = true;
+}
+
+float motion_gate::change() const
+{
+    return m_change;
+}
+
+std::size_t motion_gate::skipped() const
+{
+    return m_skipped;
+}
+
+bool motion_gate::moving() const
+{
+    return m_moving;
+}
+
+gating_parameters const & motion_gate::parameters() const
+{
+    return m_parameters;
+}
+
+void motion_gate::downscale(std::uint8_t const * intensity, std::size_t stride)
+{
+    const std::uint32_t scale = m_parameters.scale;
+    const std::uint32_t width = m_scaled_width * scale;
+
+    // the pixels of the last incomplete block of each line and column are ignored
+    const std::uint32_t area = scale * scale;
+
+    for (std::uint32_t y = 0; y < m_scaled_height; ++y)
+    {
+        std::uint16_t * sums = m_sums.data();
+
+        std::fill(sums, sums + width, 0);
+
+        // add the lines first, so all loops work on subsequent pixels
+        for (std::uint32_t l = 0; l < scale; ++l)
+        {
+            std::uint8_t const * line = intensity + static_cast<std::size_t>(y * scale + l) * stride;
+
+            for (std::uint32_t x = 0; x < width; ++x)
+            {
+                sums[x] += line[x];
+            }
+        }
+
+        std::uint8_t * scaled = m_current.data() + static_cast<std::size_t>(y) * m_scaled_width;
+
+        for (std::uint32_t x = 0; x < m_scaled_width; ++x)
+        {
+            std::uint32_t sum = 0;
+
+            for (std::uint32_t s = 0; s < scale; ++s)
+            {
+                sum += sums[x * scale + s];
+            }
+
+            scaled[x] = static_cast<std::uint8_t>(sum / area);
+        }
+    }
+}
+
+float motion_gate::compare() const
+{
+    const std::uint32_t block_size = m_parameters.block_size;
+
+    float change = 0.0f;
+
+    for (std::uint32_t by = 0; by < m_scaled_height; by += block_size)
+    {
+        const std::uint32_t to_y = std::min(by + block_size, m_scaled_height);
+
+        for (std::uint32_t bx = 0; bx < m_scaled_width; bx += block_size)
+        {
+            const std::uint32_t to_x = std::min(bx + block_size, m_scaled_width);
+
+            // sum of absolute differences of the block
+            std::uint32_t sad = 0;
+
+            for (std::uint32_t y = by; y < to_y; ++y)
+            {
+                const std::size_t offset = static_cast<std::size_t>(y) * m_scaled_width;
+
+                for (std::uint32_t x = bx; x < to_x; ++x)
+                {
+                    const int difference = static_cast<int>(m_current[offset + x]) - static_cast<int>(m_reference[offset + x]);
+
+                    sad += static_cast<std::uint32_t>(difference < 0 ? -difference : difference);
+                }
+            }
+
+            change = std::max(change, static_cast<float>(sad) / static_cast<float>((to_y - by) * (to_x - bx)));
+        }
+    }
+
+    return change;
+}
+
+} // namespace cvpg::videoproc::processors
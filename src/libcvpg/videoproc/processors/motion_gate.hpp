@@ -0,0 +1,76 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_PROCESSORS_MOTION_GATE_HPP
+#define LIBCVPG_VIDEOPROC_PROCESSORS_MOTION_GATE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <libcvpg/videoproc/processors/gating_parameters.hpp>
+
+namespace cvpg::videoproc::processors {
+
+//
+// A motion gate decides which frames of a video have to be processed. A processed frame becomes the
+// reference the following frames are compared with, so slow changes accumulate until a frame is
+// processed again. The first frame and the first frame after a change of the frame size are always
+// processed.
+//
+// Frames have to be passed in order of the video.
+//
+class motion_gate
+{
+public:
+    explicit motion_gate(gating_parameters parameters = gating_parameters());
+
+    // check if a frame has to be processed ; 'intensity' is a plane of 'width' x 'height' pixels whose
+    // lines are 'stride' pixels apart
+    bool process(std::uint8_t const * intensity, std::size_t stride, std::uint32_t width, std::uint32_t height);
+
+    // forget the reference frame
+    void reset();
+
+    // change of the last frame compared to the reference frame
+    float change() const;
+
+    // amount of frames skipped since the last processed frame
+    std::size_t skipped() const;
+
+    // check if the scene was moving at the last frame
+    bool moving() const;
+
+    gating_parameters const & parameters() const;
+
+private:
+    void downscale(std::uint8_t const * intensity, std::size_t stride);
+
+    float compare() const;
+
+    gating_parameters m_parameters;
+
+    std::uint32_t m_width = 0;
+    std::uint32_t m_height = 0;
+
+    // size of the downscaled frames
+    std::uint32_t m_scaled_width = 0;
+    std::uint32_t m_scaled_height = 0;
+
+    // downscaled intensity of the current and the reference frame
+    std::vector<std::uint8_t> m_current;
+    std::vector<std::uint8_t> m_reference;
+
+    // sums of the lines of a downscaled line
+    std::vector<std::uint16_t> m_sums;
+
+    float m_change = 0.0f;
+
+    std::size_t m_skipped = 0;
+
+    bool m_moving = true;
+};
+
+} // namespace cvpg::videoproc::processors
+
+#endif // LIBCVPG_VIDEOPROC_PROCESSORS_MOTION_GATE_HPP
@@ -0,0 +1,218 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_REORDER_BUFFER_HPP
+#define LIBCVPG_VIDEOPROC_REORDER_BUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+
+namespace cvpg::videoproc {
+
+// statistics about the order of the entries inserted into a reorder buffer
+struct reorder_statistics
+{
+    // amount of inserted entries
+    std::size_t inserted = 0;
+
+    // amount of entries inserted while at least one entry with a lower number was missing
+    std::size_t out_of_order = 0;
+
+    // maximum and sum of the distances between the number of an inserted entry and the next expected number
+    std::size_t max_depth = 0;
+    std::size_t sum_depth = 0;
+};
+
+//
+// A reorder buffer stores entries that arrive in any order and returns them in order of their numbers.
+//
+// The entries are stored at a ring of fixed capacity that is addressed by the distance between the
+// number of an entry and the next expected number. So inserting an entry and draining the next entry
+// is O(1) and entries are only moved, never copied. Entries whose numbers don't fit into the ring are
+// rejected and have to be inserted again later.
+//
+// The buffer can be used by a single producer (inserting entries) and a single consumer (draining
+// entries) at different threads without any further synchronization.
+//
+// The template type 'T' has to provide a 'number()' function.
+//
+template<typename T>
+class reorder_buffer
+{
+public:
+    explicit reorder_buffer(std::size_t capacity, std::size_t first = 0)
+        : m_capacity(round_capacity(capacity))
+        , m_mask(m_capacity - 1)
+        , m_slots(std::make_unique<slot[]>(m_capacity))
+        , m_next(first)
+    {}
+
+    reorder_buffer(reorder_buffer const &) = delete;
+    reorder_buffer(reorder_buffer &&) = delete;
+
+    reorder_buffer & operator=(reorder_buffer const &) = delete;
+    reorder_buffer & operator=(reorder_buffer &&) = delete;
+
+    ~reorder_buffer() = default;
+
+    // check if an entry with the given number fits into the ring (producer side)
+    bool fits(std::size_t number) const
+    {
+        const std::size_t next = m_next.load(std::memory_order_acquire);
+
+        return number >= next && (number - next) < m_capacity;
+    }
+
+    // insert an entry ; returns false (and leaves 't' untouched) if the number doesn't fit into the ring or is already stored (producer side)
+    bool insert(T && t)
+    {
+        const std::size_t number = t.number();
+        const std::size_t next = m_next.load(std::memory_order_acquire);
+
+        if (number < next || (number - next) >= m_capacity)
+        {
+            return false;
+        }
+
+        slot & s = m_slots[number & m_mask];
+
+        if (s.occupied.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        s.value.emplace(std::move(t));
+        s.occupied.store(true, std::memory_order_release);
+
+        m_size.fetch_add(1, std::memory_order_relaxed);
+
+        // statistics are only written by the producer
+        const std::size_t depth = number - next;
+
+        m_statistics.inserted.store(m_statistics.inserted.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        m_statistics.sum_depth.store(m_statistics.sum_depth.load(std::memory_order_relaxed) + depth, std::memory_order_relaxed);
+
+        if (depth > 0)
+        {
+            m_statistics.out_of_order.store(m_statistics.out_of_order.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        if (depth > m_statistics.max_depth.load(std::memory_order_relaxed))
+        {
+            m_statistics.max_depth.store(depth, std::memory_order_relaxed);
+        }
+
+        return true;
+    }
+
+    // pass up to 'max_entries' consecutive entries starting at the next expected number to 'f' ; returns the amount of passed entries (consumer side)
+    template<typename F>
+    std::size_t drain(F && f, std::size_t max_entries = std::numeric_limits<std::size_t>::max())
+    {
+        std::size_t drained = 0;
+        std::size_t next = m_next.load(std::memory_order_relaxed);
+
+        while (drained < max_entries)
+        {
+            slot & s = m_slots[next & m_mask];
+
+            if (!s.occupied.load(std::memory_order_acquire))
+            {
+                break;
+            }
+
+            T t = std::move(*(s.value));
+            s.value.reset();
+
+            // release the slot before the producer is allowed to use it for the next round
+            s.occupied.store(false, std::memory_order_release);
+            m_next.store(++next, std::memory_order_release);
+
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+
+            f(std::move(t));
+
+            ++drained;
+        }
+
+        return drained;
+    }
+
+    // number of the next expected entry
+    std::size_t next() const
+    {
+        return m_next.load(std::memory_order_acquire);
+    }
+
+    // amount of stored entries
+    std::size_t size() const
+    {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    std::size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    reorder_statistics statistics() const
+    {
+        reorder_statistics result;
+        result.inserted = m_statistics.inserted.load(std::memory_order_relaxed);
+        result.out_of_order = m_statistics.out_of_order.load(std::memory_order_relaxed);
+        result.max_depth = m_statistics.max_depth.load(std::memory_order_relaxed);
+        result.sum_depth = m_statistics.sum_depth.load(std::memory_order_relaxed);
+
+        return result;
+    }
+
+private:
+    // round up to a power of two, so slots can be addressed by a mask
+    static std::size_t round_capacity(std::size_t capacity)
+    {
+        std::size_t rounded = 1;
+
+        while (rounded < capacity)
+        {
+            rounded <<= 1;
+        }
+
+        return rounded;
+    }
+
+    struct slot
+    {
+        std::atomic<bool> occupied = false;
+        std::optional<T> value;
+    };
+
+    struct atomic_statistics
+    {
+        std::atomic<std::size_t> inserted = 0;
+        std::atomic<std::size_t> out_of_order = 0;
+        std::atomic<std::size_t> max_depth = 0;
+        std::atomic<std::size_t> sum_depth = 0;
+    };
+
+    const std::size_t m_capacity;
+    const std::size_t m_mask;
+
+    std::unique_ptr<slot[]> m_slots;
+
+    std::atomic<std::size_t> m_next;
+    std::atomic<std::size_t> m_size = 0;
+
+    atomic_statistics m_statistics;
+};
+
+} // namespace cvpg::videoproc
+
+#endif // LIBCVPG_VIDEOPROC_REORDER_BUFFER_HPP
@@ -0,0 +1,64 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_SINKS_ENCODER_PARAMETERS_HPP
+#define LIBCVPG_VIDEOPROC_SINKS_ENCODER_PARAMETERS_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace cvpg::videoproc::sinks {
+
+//
+// Parameters of the video encoder used at a sink stage. Empty or negative values keep the defaults of
+// the encoder.
+//
+// Fast presets (e.g. 'veryfast') with tune 'zerolatency' suit live outputs, slow presets (e.g. 'slow')
+// with a constant rate factor suit archival outputs.
+//
+struct encoder_parameters
+{
+    // name of the encoder (empty = default H.264 encoder)
+    std::string codec;
+
+    // encoder specific preset and tuning (e.g. 'ultrafast' ... 'veryslow' and 'film' or 'zerolatency' for 'libx264')
+    std::string preset;
+    std::string tune;
+
+    // constant rate factor ; has precedence over the bit rate
+    int crf = -1;
+
+    // average bit rate in bits per second (0 = encoder default)
+    std::int64_t bit_rate = 0;
+
+    // maximum distance of keyframes in frames
+    int gop_size = -1;
+
+    // amount of threads used by the encoder (0 = chosen by the encoder)
+    std::size_t threads = 0;
+
+    // encode multiple frames at once ; adds a delay of one frame per thread
+    bool frame_threading = true;
+
+    // encode multiple slices of a frame at once
+    bool slice_threading = true;
+
+    // amount of segments that are encoded in parallel with independent encoders ; 0 or 1 encodes the
+    // video sequentially
+    std::size_t parallel_segments = 0;
+
+    // amount of frames of a segment ; each segment starts with a keyframe and contains closed GOPs only
+    std::size_t segment_frames = 250;
+
+    // write GOPs of unmodified frames with the forwarded packets of the source stream and encode only
+    // GOPs containing modified frames ; segments follow the GOPs of the source stream then
+    bool passthrough = false;
+
+    // finish the file with a sequence end code ; disabled for parts of a video that are concatenated
+    // afterwards and not used at containers
+    bool end_code = true;
+};
+
+} // namespace cvpg::videoproc::sinks
+
+#endif // LIBCVPG_VIDEOPROC_SINKS_ENCODER_PARAMETERS_HPP
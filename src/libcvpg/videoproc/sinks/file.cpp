@@ -3,18 +3,25 @@
 
 #include <libcvpg/videoproc/sinks/file.hpp>
 
+#include <algorithm>
 #include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 #include <boost/asynchronous/continuation_task.hpp>
 #include <boost/asynchronous/queue/lockfree_queue.hpp>
 #include <boost/asynchronous/scheduler_shared_proxy.hpp>
+#include <boost/asynchronous/scheduler/multiqueue_threadpool_scheduler.hpp>
 #include <boost/asynchronous/scheduler/single_thread_scheduler.hpp>
 
 extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
 #include <libavformat/avio.h>
+#include <libavutil/dict.h>
 #include <libavutil/imgutils.h>
+#include <libavutil/mathematics.h>
 #include <libavutil/opt.h>
 #include <libavutil/pixfmt.h>
 #include <libswscale/swscale.h>
@@ -22,9 +29,399 @@ extern "C" {
 
 #include <libcvpg/core/exception.hpp>
 #include <libcvpg/videoproc/stage_data_handler.hpp>
+#include <libcvpg/videoproc/sinks/passthrough.hpp>
+#include <libcvpg/videoproc/sources/decoded_planes.hpp>
+
+namespace {
+
+//
+// Apply the encoder parameters, which are independent of the video, to a not yet opened encoder.
+//
+void configure_encoder(AVCodecContext * codec_context, cvpg::videoproc::sinks::encoder_parameters const & encoder)
+{
+    codec_context->thread_type = (encoder.frame_threading ? FF_THREAD_FRAME : 0) | (encoder.slice_threading ? FF_THREAD_SLICE : 0);
+    codec_context->thread_count = codec_context->thread_type != 0 ? static_cast<int>(encoder.threads) : 1;
+
+    if (encoder.gop_size >= 0)
+    {
+        codec_context->gop_size = encoder.gop_size;
+    }
+
+    if (encoder.crf < 0 && encoder.bit_rate > 0)
+    {
+        codec_context->bit_rate = encoder.bit_rate;
+    }
+}
+
+//
+// Open an encoder with the options specific to the encoder (preset, tune and crf). Returns the name of
+// the first option not supported by the encoder or an empty string. Throws if the encoder could not
+// be opened.
+//
+std::string open_encoder(AVCodecContext * codec_context, cvpg::videoproc::sinks::encoder_parameters const & encoder)
+{
+    AVDictionary * options = nullptr;
+
+    if (!encoder.preset.empty())
+    {
+        av_dict_set(&options, "preset", encoder.preset.c_str(), 0);
+    }
+
+    if (!encoder.tune.empty())
+    {
+        av_dict_set(&options, "tune", encoder.tune.c_str(), 0);
+    }
+
+    if (encoder.crf >= 0)
+    {
+        av_dict_set_int(&options, "crf", encoder.crf, 0);
+    }
+
+    const int res = avcodec_open2(codec_context, codec_context->codec, &options);
+
+    // options not consumed by the encoder remain at the dictionary
+    AVDictionaryEntry * unused_option = av_dict_get(options, "", nullptr, AV_DICT_IGNORE_SUFFIX);
+    const std::string unused_option_name = unused_option != nullptr ? unused_option->key : "";
+
+    av_dict_free(&options);
+
+    if (res < 0)
+    {
+        throw cvpg::io_exception("could not open video codec");
+    }
+
+    return unused_option_name;
+}
+
+//
+// Convert an image to the pixel format of a (writable) frame. The buffer is used for interleaving the
+// channels of grayscale and RGB images and can be reused for all images.
+//
+template<typename Image>
+void convert_image(Image const & image, AVFrame * frame, std::vector<std::uint8_t> & buffer)
+{
+    const AVPixelFormat frame_pixel_format = static_cast<AVPixelFormat>(frame->format);
+
+    std::uint8_t const * src_data[4] = { nullptr, nullptr, nullptr, nullptr };
+    int src_linesize[4] = { 0, 0, 0, 0 };
+
+    AVPixelFormat pixel_format = AVPixelFormat::AV_PIX_FMT_NONE;
+
+    if constexpr (std::is_same_v<Image, cvpg::image_yuv420_8bit>)
+    {
+        // planes of YUV images are used directly ; full range planes are converted by SWS if the encoder uses the limited range
+        pixel_format = image.range() == cvpg::color_range::full ? AVPixelFormat::AV_PIX_FMT_YUVJ420P : AVPixelFormat::AV_PIX_FMT_YUV420P;
+
+        for (std::uint8_t p = 0; p < 3; ++p)
+        {
+            src_data[p] = image.data(p).get();
+            src_linesize[p] = static_cast<int>(image.stride(p));
+        }
+
+        if (frame_pixel_format == pixel_format && static_cast<int>(image.width()) == frame->width && static_cast<int>(image.height()) == frame->height)
+        {
+            // encoder uses the same format, so the planes are copied without any conversion
+            av_image_copy(frame->data, frame->linesize, src_data, src_linesize, pixel_format, frame->width, frame->height);
+
+            return;
+        }
+    }
+    else
+    {
+        constexpr std::size_t channels = std::tuple_size<typename Image::channel_array_type>::value;
+
+        pixel_format = channels == 1 ? AVPixelFormat::AV_PIX_FMT_GRAY8 : AVPixelFormat::AV_PIX_FMT_RGB24;
+
+        buffer.resize(static_cast<std::size_t>(image.width()) * image.height() * channels);
+
+        std::size_t pos = 0;
+
+        // lines of the image are 'width + padding' pixels apart
+        const std::size_t stride = image.width() + image.padding();
+
+        // convert image to byte array of suitable pixel format
+        for (std::size_t y = 0; y < image.height(); ++y)
+        {
+            for (std::size_t x = 0; x < image.width(); ++x, pos += channels)
+            {
+                if constexpr (channels == 1)
+                {
+                    buffer[pos] = image.data(0).get()[y * stride + x];
+                }
+                else if constexpr (channels == 3)
+                {
+                    buffer[pos] = image.data(0).get()[y * stride + x];
+                    buffer[pos + 1] = image.data(1).get()[y * stride + x];
+                    buffer[pos + 2] = image.data(2).get()[y * stride + x];
+                }
+            }
+        }
+
+        src_data[0] = buffer.data();
+        src_linesize[0] = static_cast<int>(image.width() * channels);
+    }
+
+    // create a SWS context to convert image to the pixel format of the encoder
+    auto sws_ctx = sws_getContext(image.width(),
+                                  image.height(),
+                                  pixel_format,
+                                  frame->width,
+                                  frame->height,
+                                  frame_pixel_format,
+                                  0,
+                                  0,
+                                  0,
+                                  0);
+
+    if constexpr (std::is_same_v<Image, cvpg::image_gray_8bit>)
+    {
+        // a wrapped luma plane of a decoder could still be in the limited range
+        if (image.range() == cvpg::color_range::limited)
+        {
+            cvpg::videoproc::sources::set_source_color_range(sws_ctx, AVColorRange::AVCOL_RANGE_MPEG);
+        }
+    }
+
+    sws_scale(sws_ctx,
+              src_data,
+              src_linesize,
+              0,
+              image.height(),
+              frame->data,
+              frame->linesize);
+
+    sws_freeContext(sws_ctx);
+}
+
+//
+// Timestamps of the frames sent to an encoder. Encoders need strictly increasing timestamps, so frames
+// without a presentation timestamp or with a timestamp not after the previous one (e.g. after a
+// reconnect of a stream) continue one frame duration after the previous frame.
+//
+struct pts_sequence
+{
+    std::int64_t last = AV_NOPTS_VALUE;
+
+    // added to the presentation timestamps after they went backwards
+    std::int64_t offset = 0;
+
+    std::int64_t next(std::int64_t pts, std::int64_t frame_number, AVRational framerate, AVRational time_base)
+    {
+        const std::int64_t duration = std::max<std::int64_t>(av_rescale_q(1, av_inv_q(framerate), time_base), 1);
+
+        std::int64_t result = 0;
+
+        if (pts == AV_NOPTS_VALUE)
+        {
+            result = last == AV_NOPTS_VALUE ? av_rescale_q(frame_number, av_inv_q(framerate), time_base) : last + duration;
+        }
+        else
+        {
+            result = pts + offset;
+
+            if (last != AV_NOPTS_VALUE && result <= last)
+            {
+                offset = last + duration - pts;
+                result = last + duration;
+            }
+        }
+
+        last = result;
+
+        return result;
+    }
+};
+
+//
+// Receive all available packets of an encoder and copy them to separate memory. Returns 0 if all
+// available packets were received or a negative error code of the encoder.
+//
+template<typename Entry>
+int receive_packets(AVCodecContext * codec_context, AVPacket * packet, std::vector<Entry> & entries, std::int64_t & packet_counter)
+{
+    while (true)
+    {
+        const int ret = avcodec_receive_packet(codec_context, packet);
+
+        if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF)
+        {
+            return 0;
+        }
+        else if (ret < 0)
+        {
+            return ret;
+        }
+
+        Entry entry;
+        entry.id = packet_counter++;
+        entry.size = static_cast<std::size_t>(packet->size * sizeof(std::uint8_t));
+        entry.pts = packet->pts;
+        entry.dts = packet->dts;
+        entry.keyframe = (packet->flags & AV_PKT_FLAG_KEY) != 0;
+
+        // create memory from 'AVPacket' to separate memory
+        entry.frame = std::shared_ptr<std::uint8_t>(static_cast<std::uint8_t *>(malloc(entry.size)), [](std::uint8_t * ptr){ free(ptr); });
+        memcpy(entry.frame.get(), packet->data, entry.size);
+
+        av_packet_unref(packet);
+
+        entries.push_back(std::move(entry));
+    }
+}
+
+//
+// Copy the forwarded packets of the frames of a segment in decode order.
+//
+template<typename Image, typename Entry>
+std::vector<Entry> passthrough_packets(std::vector<cvpg::videoproc::frame<Image> > const & frames)
+{
+    std::vector<Entry> entries(frames.size());
+
+    for (auto const & f : frames)
+    {
+        auto const & source = f.source();
+
+        Entry & entry = entries[source->index];
+        entry.id = source->index;
+        entry.size = source->data.size();
+        entry.pts = source->pts;
+        entry.dts = source->dts;
+        entry.keyframe = source->index == 0;
+
+        entry.frame = std::shared_ptr<std::uint8_t>(static_cast<std::uint8_t *>(malloc(entry.size)), [](std::uint8_t * ptr){ free(ptr); });
+        memcpy(entry.frame.get(), source->data.data(), entry.size);
+    }
+
+    return entries;
+}
+
+//
+// Check if an output format writes the timestamps of the packets, i.e. if it is a container and not
+// an elementary stream.
+//
+bool is_container(AVOutputFormat const * format)
+{
+    return format != nullptr && (format->flags & AVFMT_NOTIMESTAMPS) == 0;
+}
+
+//
+// Write the header of a container. The codec parameters of the stream are taken from the encoder, the
+// time base of the stream could be changed by the muxer.
+//
+template<typename Video>
+void write_header(Video & video)
+{
+    if (!video.mux)
+    {
+        return;
+    }
+
+    if (avcodec_parameters_from_context(video.stream->codecpar, video.codec_context) < 0)
+    {
+        throw cvpg::exception("failed to set codec parameters of output stream");
+    }
+
+    video.stream->time_base = video.time_base;
+
+    if (avformat_write_header(video.format_context, nullptr) < 0)
+    {
+        throw cvpg::io_exception("failed to write header of output file");
+    }
+}
+
+//
+// Write an encoded packet to the output. A container gets the packet with its timestamps rescaled
+// from the time base of the encoder to the time base of the stream ; an elementary stream gets the
+// packet data only.
+//
+template<typename Video, typename Entry>
+void write_entry(Video & video, Entry const & entry)
+{
+    if (!video.mux)
+    {
+        fwrite(entry.frame.get(), 1, entry.size, video.file);
+
+        return;
+    }
+
+    AVPacket * packet = av_packet_alloc();
+
+    if (!packet)
+    {
+        throw cvpg::exception("failed to allocate memory for packet");
+    }
+
+    // the data isn't reference counted, so the muxer copies it if the packet has to be buffered
+    packet->data = entry.frame.get();
+    packet->size = static_cast<int>(entry.size);
+    packet->pts = entry.pts;
+    packet->dts = entry.dts;
+    packet->flags = entry.keyframe ? AV_PKT_FLAG_KEY : 0;
+    packet->stream_index = video.stream->index;
+
+    av_packet_rescale_ts(packet, video.time_base, video.stream->time_base);
+
+    // containers need strictly increasing decoding timestamps, also at the borders of segments
+    // encoded by different encoders or passed through from the source stream
+    if (packet->dts != AV_NOPTS_VALUE && video.last_dts != AV_NOPTS_VALUE && packet->dts <= video.last_dts)
+    {
+        packet->dts = video.last_dts + 1;
+    }
+
+    if (packet->dts != AV_NOPTS_VALUE)
+    {
+        video.last_dts = packet->dts;
+    }
+
+    const int ret = av_interleaved_write_frame(video.format_context, packet);
+
+    av_packet_free(&packet);
+
+    if (ret < 0)
+    {
+        throw cvpg::io_exception("failed to write packet to output file");
+    }
+}
+
+//
+// Finish the output. A container gets its trailer, an elementary stream optionally a sequence end code.
+//
+template<typename Video>
+void close_output(Video & video, bool end_code)
+{
+    if (video.mux)
+    {
+        const int ret = av_write_trailer(video.format_context);
+
+        avio_closep(&(video.format_context->pb));
+
+        if (ret < 0)
+        {
+            throw cvpg::io_exception("failed to write trailer of output file");
+        }
+
+        return;
+    }
+
+    // add sequence end code to have a real MPEG file
+    if (end_code)
+    {
+        std::uint8_t endcode[] = { 0, 0, 1, 0xb7 };
+        fwrite(endcode, 1, sizeof(endcode), video.file);
+    }
+
+    fclose(video.file);
+}
+
+}
 
 namespace cvpg::videoproc::sinks {
 
+bool writes_container(std::string const & filename)
+{
+    return is_container(av_guess_format(nullptr, filename.c_str(), nullptr));
+}
+
 template<typename Image> struct file<Image>::processing_context
 {
     bool prev_stage_finished = false;
@@ -33,8 +430,14 @@ template<typename Image> struct file<Image>::processing_context
     {
         std::string uri;
 
+        // elementary streams are written to a file directly, containers by the format context
         FILE * file = nullptr;
 
+        bool mux = false;
+
+        // decoding timestamp of the last packet written to a container (in the time base of the stream)
+        std::int64_t last_dts = AV_NOPTS_VALUE;
+
         AVFormatContext * format_context = nullptr;
         AVCodecContext * codec_context = nullptr;
 
@@ -44,6 +447,13 @@ template<typename Image> struct file<Image>::processing_context
 
         std::int64_t frames_sent = 0;
         std::int64_t frames_received = 0;
+
+        // frame rate and time base of the source stream
+        AVRational framerate = AVRational{25, 1};
+        AVRational time_base = AVRational{1, 25};
+
+        // timestamps of the frames sent to the encoder
+        pts_sequence pts;
     };
 
     video_info video;
@@ -70,6 +480,12 @@ template<typename Image> struct file<Image>::processing_context
             std::size_t id = 0;
             std::shared_ptr<std::uint8_t> frame;
             std::size_t size = 0;
+
+            // timestamps in the time base of the source stream
+            std::int64_t pts = AV_NOPTS_VALUE;
+            std::int64_t dts = AV_NOPTS_VALUE;
+
+            bool keyframe = false;
         };
 
         std::vector<entry> data;
@@ -77,9 +493,39 @@ template<typename Image> struct file<Image>::processing_context
 
     buffer_info buffer;
 
+    struct segments_info
+    {
+        // frames of the segment currently collected and their bytes charged to the memory budget
+        std::vector<videoproc::frame<Image> > frames;
+        std::size_t frames_bytes = 0;
+
+        // number of the next segment to start and to write
+        std::size_t next_start = 0;
+        std::size_t next_write = 0;
+
+        std::size_t running = 0;
+
+        bool flushed = false;
+
+        // encoded segments waiting to be written in order
+        std::map<std::size_t, std::vector<typename buffer_info::entry> > encoded;
+
+        // delivery of further frames is held back while all segment encoders are busy
+        std::function<void()> deliver_done_callback;
+
+        // GOP of the source stream of the last collected frame with a forwarded packet
+        std::size_t gop = 0;
+        bool gop_known = false;
+    };
+
+    // segments of the video if encoded in parallel or if GOPs of the source stream are passed through
+    segments_info segments;
+
     std::shared_ptr<stage_data_handler<videoproc::frame<Image> > > sdh;
 
     bool finished = false;
+
+    std::shared_ptr<latency_statistics> latencies;
 };
 
 template<typename Image>
@@ -98,23 +544,7 @@ struct write_frames_task : public boost::asynchronous::continuation_task<std::ve
     {
         try
         {
-            std::size_t channels = 0;
-            AVPixelFormat pixel_format = AVPixelFormat::AV_PIX_FMT_NONE;
-
-            if constexpr (std::tuple_size<typename Image::channel_array_type>::value == 1)
-            {
-                channels = 1;
-                pixel_format = AVPixelFormat::AV_PIX_FMT_GRAY8;
-            }
-            else if constexpr (std::tuple_size<typename Image::channel_array_type>::value == 3)
-            {
-                channels = 3;
-                pixel_format = AVPixelFormat::AV_PIX_FMT_RGB24;
-            }
-            else
-            {
-                // TODO handle error
-            }
+            auto codec_context = m_context->video.codec_context;
 
             AVFrame * frame = av_frame_alloc();
 
@@ -123,9 +553,9 @@ struct write_frames_task : public boost::asynchronous::continuation_task<std::ve
                 throw cvpg::exception("failed to allocate memory for frame");
             }
 
-            frame->format = m_context->video.codec_context->pix_fmt;
-            frame->width = m_context->video.codec_context->width;
-            frame->height = m_context->video.codec_context->height;
+            frame->format = codec_context->pix_fmt;
+            frame->width = codec_context->width;
+            frame->height = codec_context->height;
 
             int ret = av_frame_get_buffer(frame, 0);
 
@@ -144,11 +574,8 @@ struct write_frames_task : public boost::asynchronous::continuation_task<std::ve
             std::vector<typename cvpg::videoproc::sinks::file<Image>::processing_context::buffer_info::entry> buffer;
             buffer.reserve(m_frames.size());
 
-            // pre-reserve output data as the size of the first image
-            auto image_data = m_frames.empty() ? nullptr : new std::uint8_t[m_frames.front().image().width() * m_frames.front().image().height() * channels];
-            int image_linesize[1] = { m_frames.empty() ? 0 : (static_cast<int>(m_frames.front().image().width() * channels)) };
-
-            ret = av_image_alloc(frame->data, frame->linesize, m_frames.empty() ? 0 : m_frames.front().image().width(), m_frames.empty() ? 0 : m_frames.front().image().height(), m_context->video.codec_context->pix_fmt, 32);
+            // used for the conversion of all images
+            std::vector<std::uint8_t> image_data;
 
             for (auto & inter_frame : m_frames)
             {
@@ -165,52 +592,11 @@ struct write_frames_task : public boost::asynchronous::continuation_task<std::ve
                     throw cvpg::exception("failed to allocate memory for video frame");
                 }
 
-                frame->pts = m_context->video.frames_sent++;
-
-                auto image = inter_frame.move_image();
+                frame->pts = m_context->video.pts.next(inter_frame.pts(), m_context->video.frames_sent++, m_context->video.framerate, m_context->video.time_base);
 
-                std::size_t pos = 0;
-
-                // convert image to byte array of suitable pixel format
-                for (std::size_t y = 0; y < image.height(); ++y)
-                {
-                    for (std::size_t x = 0; x < image.width(); ++x, pos += channels)
-                    {
-                        if constexpr (std::tuple_size<typename Image::channel_array_type>::value == 1)
-                        {
-                            image_data[pos] = image.data(0).get()[y * image.width() + x];
-                        }
-                        else if constexpr (std::tuple_size<typename Image::channel_array_type>::value == 3)
-                        {
-                            image_data[pos] = image.data(0).get()[y * image.width() + x];
-                            image_data[pos + 1] = image.data(1).get()[y * image.width() + x];
-                            image_data[pos + 2] = image.data(2).get()[y * image.width() + x];
-                        }
-                    }
-                }
+                convert_image(inter_frame.move_image(), frame, image_data);
 
-                // create a SWC context to convert image from RGB to source pixel format
-                auto sws_ctx = sws_getContext(image.width(),
-                                              image.height(),
-                                              pixel_format,
-                                              image.width(),
-                                              image.height(),
-                                              m_context->video.codec_context->pix_fmt,
-                                              0,
-                                              0,
-                                              0,
-                                              0);
-
-                // perform conversion to raw data
-                sws_scale(sws_ctx,
-                          &image_data,
-                          image_linesize,
-                          0,
-                          image.height(),
-                          frame->data,
-                          frame->linesize);
-
-                ret = avcodec_send_frame(m_context->video.codec_context, frame);
+                ret = avcodec_send_frame(codec_context, frame);
 
                 if (ret < 0)
                 {
@@ -238,46 +624,24 @@ struct write_frames_task : public boost::asynchronous::continuation_task<std::ve
                     // TODO error handling
                 }
 
-                while (ret >= 0)
+                if (receive_packets(codec_context, packet, buffer, m_context->video.frames_received) < 0)
                 {
-                    ret = avcodec_receive_packet(m_context->video.codec_context, packet);
+                    av_packet_free(&packet);
+                    av_frame_free(&frame);
 
-                    if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF)
-                    {
-                        break;
-                    }
-                    else if (ret < 0)
-                    {
-                        // TODO error handling
-
-                        break;
-                    }
-
-                    typename cvpg::videoproc::sinks::file<Image>::processing_context::buffer_info::entry entry;
-                    entry.id = m_context->video.frames_received++;
-                    entry.size = static_cast<std::size_t>(packet->size * sizeof(std::uint8_t));
-
-                    // create memory from 'AVPacket' to separate memory
-                    entry.frame = std::shared_ptr<std::uint8_t>(static_cast<std::uint8_t *>(malloc(entry.size)), [](std::uint8_t * ptr){ free(ptr); });
-                    memcpy(entry.frame.get(), packet->data, entry.size);
-
-                    av_packet_unref(packet);
+                    throw cvpg::io_exception("failed to receive packets from encoder");
+                }
 
-                    buffer.push_back(std::move(entry));
+                if (m_context->latencies)
+                {
+                    m_context->latencies->add(inter_frame.timestamps(), videoproc::frame_timestamps::clock::now());
                 }
 
                 // TODO indicate frame written
             }
 
-            if (!m_frames.empty())
-            {
-                delete[] image_data;
-            }
-
             av_packet_free(&packet);
-
             av_frame_free(&frame);
-            av_frame_unref(frame);
 
             this->this_task_result().set_value(std::move(buffer));
         }
@@ -337,32 +701,13 @@ struct write_last_frames_task : public boost::asynchronous::continuation_task<st
             std::vector<typename cvpg::videoproc::sinks::file<Image>::processing_context::buffer_info::entry> buffer;
             buffer.reserve(100);
 
-            while (ret >= 0)
-            {
-                ret = avcodec_receive_packet(m_context->video.codec_context, packet);
-
-                if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF)
-                {
-                    break;
-                }
-                else if (ret < 0)
-                {
-                    // TODO error handling
-
-                    break;
-                }
-
-                typename cvpg::videoproc::sinks::file<Image>::processing_context::buffer_info::entry entry;
-                entry.id = m_context->video.frames_received++;
-                entry.size = static_cast<std::size_t>(packet->size * sizeof(std::uint8_t));
-
-                // create memory from 'AVPacket' to separate memory
-                entry.frame = std::shared_ptr<std::uint8_t>(static_cast<std::uint8_t *>(malloc(entry.size)), [](std::uint8_t * ptr){ free(ptr); });
-                memcpy(entry.frame.get(), packet->data, entry.size);
+            ret = receive_packets(m_context->video.codec_context, packet, buffer, m_context->video.frames_received);
 
-                av_packet_unref(packet);
+            av_packet_free(&packet);
 
-                buffer.push_back(std::move(entry));
+            if (ret < 0)
+            {
+                throw cvpg::io_exception("failed to receive packets from encoder");
             }
 
             this->this_task_result().set_value(std::move(buffer));
@@ -389,16 +734,160 @@ write_last_frames(std::size_t context_id,
            );
 }
 
+//
+// Encode the frames of a segment with an own encoder. The segment starts with a keyframe and contains
+// closed GOPs only, so segments can be encoded in parallel and their packets be concatenated afterwards.
+//
+template<typename Image>
+std::vector<typename cvpg::videoproc::sinks::file<Image>::processing_context::buffer_info::entry>
+encode_segment_frames(std::shared_ptr<typename cvpg::videoproc::sinks::file<Image>::processing_context> context,
+                      encoder_parameters const & encoder,
+                      std::vector<videoproc::frame<Image> > frames)
+{
+    AVCodecContext * codec_context = avcodec_alloc_context3(context->video.codec_context->codec);
+
+    if (codec_context == nullptr)
+    {
+        throw cvpg::exception("could not allocate an encoding context for segment");
+    }
+
+    codec_context->width = context->video.codec_context->width;
+    codec_context->height = context->video.codec_context->height;
+    codec_context->framerate = context->video.framerate;
+    codec_context->time_base = context->video.time_base;
+    codec_context->pix_fmt = context->video.codec_context->pix_fmt;
+
+    configure_encoder(codec_context, encoder);
+
+    codec_context->flags |= AV_CODEC_FLAG_CLOSED_GOP;
+
+    if (encoder.gop_size < 0)
+    {
+        codec_context->gop_size = static_cast<int>(frames.size());
+    }
+
+    std::vector<typename cvpg::videoproc::sinks::file<Image>::processing_context::buffer_info::entry> entries;
+    entries.reserve(frames.size());
+
+    std::string error;
+
+    try
+    {
+        const std::string unused_option = open_encoder(codec_context, encoder);
+
+        if (!unused_option.empty())
+        {
+            error = std::string("encoder option '").append(unused_option).append("' not supported by encoder '").append(codec_context->codec->name).append("'");
+        }
+    }
+    catch (std::exception const & e)
+    {
+        error = e.what();
+    }
+
+    AVFrame * frame = av_frame_alloc();
+    AVPacket * packet = av_packet_alloc();
+
+    if (error.empty() && (frame == nullptr || packet == nullptr))
+    {
+        error = "failed to allocate memory for segment encoding";
+    }
+
+    if (error.empty())
+    {
+        frame->format = codec_context->pix_fmt;
+        frame->width = codec_context->width;
+        frame->height = codec_context->height;
+
+        if (av_frame_get_buffer(frame, 0) < 0)
+        {
+            error = "failed to allocate memory for video frame data";
+        }
+    }
+
+    std::int64_t packet_counter = 0;
+
+    pts_sequence pts;
+
+    // used for the conversion of all images
+    std::vector<std::uint8_t> image_data;
+
+    for (auto & f : frames)
+    {
+        if (!error.empty())
+        {
+            break;
+        }
+
+        if (av_frame_make_writable(frame) < 0)
+        {
+            error = "failed to allocate memory for video frame";
+
+            break;
+        }
+
+        frame->pts = pts.next(f.pts(), static_cast<std::int64_t>(f.number()), context->video.framerate, context->video.time_base);
+
+        convert_image(f.move_image(), frame, image_data);
+
+        if (avcodec_send_frame(codec_context, frame) < 0)
+        {
+            error = "failed to encode frame of segment";
+
+            break;
+        }
+
+        if (receive_packets(codec_context, packet, entries, packet_counter) < 0)
+        {
+            error = "failed to receive packets of segment from encoder";
+
+            break;
+        }
+
+        if (context->latencies)
+        {
+            context->latencies->add(f.timestamps(), videoproc::frame_timestamps::clock::now());
+        }
+    }
+
+    // drain the encoder
+    if (error.empty())
+    {
+        if (avcodec_send_frame(codec_context, nullptr) < 0 || receive_packets(codec_context, packet, entries, packet_counter) < 0)
+        {
+            error = "failed to drain encoder of segment";
+        }
+    }
+
+    av_packet_free(&packet);
+    av_frame_free(&frame);
+    avcodec_free_context(&codec_context);
+
+    if (!error.empty())
+    {
+        throw cvpg::exception(error);
+    }
+
+    return entries;
+}
+
 } // namespace cvpg::videoproc::sinks
 
 namespace cvpg::videoproc::sinks {
 
-template<typename Image> file<Image>::file(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler, std::size_t max_frames_write_buffer)
+template<typename Image> file<Image>::file(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler, std::size_t max_frames_write_buffer, encoder_parameters encoder, std::shared_ptr<memory_budget> memory_budget, std::shared_ptr<latency_statistics> latencies)
     : boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>(scheduler,
-                                                                                                                                             boost::asynchronous::create_shared_scheduler_proxy(
-                                                                                                                                                 new boost::asynchronous::single_thread_scheduler<boost::asynchronous::lockfree_queue<imageproc::scripting::diagnostics::servant_job> >()
-                                                                                                                                             ))
+                                                                                                                                             encoder.parallel_segments > 1
+                                                                                                                                                 ? boost::asynchronous::make_shared_scheduler_proxy<
+                                                                                                                                                       boost::asynchronous::multiqueue_threadpool_scheduler<
+                                                                                                                                                           boost::asynchronous::lockfree_queue<imageproc::scripting::diagnostics::servant_job> > >(encoder.parallel_segments, std::string("sinks::file"))
+                                                                                                                                                 : boost::asynchronous::create_shared_scheduler_proxy(
+                                                                                                                                                       new boost::asynchronous::single_thread_scheduler<boost::asynchronous::lockfree_queue<imageproc::scripting::diagnostics::servant_job> >()
+                                                                                                                                                   ))
     , m_max_frames_write_buffer(max_frames_write_buffer)
+    , m_encoder(std::move(encoder))
+    , m_memory_budget(std::move(memory_budget))
+    , m_latencies(std::move(latencies))
     , m_contexts()
 {}
 
@@ -412,6 +901,7 @@ template<typename Image> void file<Image>::init(std::size_t context_id, std::str
     context->callbacks.failed = std::move(callbacks.failed);
     context->callbacks.update_indicator = std::move(callbacks.update);
     context->buffer.data.reserve(m_max_frames_write_buffer);
+    context->latencies = m_latencies;
 
     context->sdh = std::make_shared<stage_data_handler<videoproc::frame<Image> > >(
         "sinks::file",
@@ -427,6 +917,13 @@ template<typename Image> void file<Image>::init(std::size_t context_id, std::str
         },
         [this, context_id, context](std::vector<videoproc::frame<Image> > frames, std::function<void()> deliver_done_callback)
         {
+            if (m_encoder.parallel_segments > 1 || m_encoder.passthrough)
+            {
+                collect_segments(context_id, std::move(frames), std::move(deliver_done_callback));
+
+                return;
+            }
+
             // check if a flush frame is contained at 'frames'
             bool has_flush = false;
 
@@ -461,12 +958,7 @@ template<typename Image> void file<Image>::init(std::size_t context_id, std::str
 
                             this->try_flush_buffer(context_id);
 
-                            // add sequence end code to have a real MPEG file
-                            std::uint8_t endcode[] = { 0, 0, 1, 0xb7 };
-                            fwrite(endcode, 1, sizeof(endcode), context->video.file);
-
-                            // close file
-                            fclose(context->video.file);
+                            close_output(context->video, m_encoder.end_code);
 
                             context->finished = true;
                             context->callbacks.finished(context_id);
@@ -523,18 +1015,12 @@ template<typename Image> void file<Image>::init(std::size_t context_id, std::str
                     1
                 );
             }
-        }
+        },
+        m_memory_budget
     );
 
     m_contexts.insert({ context_id, context });
 
-    context->video.file = fopen(context->video.uri.c_str(), "wb");
-
-    if (!context->video.file)
-    {
-        throw cvpg::io_exception("failed to open output file");
-    }
-
     context->video.format_context = avformat_alloc_context();
 
     if (context->video.format_context == nullptr)
@@ -542,28 +1028,41 @@ template<typename Image> void file<Image>::init(std::size_t context_id, std::str
         throw cvpg::exception("failed to create output context");
     }
 
-    // associate the output file (pointer) with the container format context
-    AVIOContext * io_context = nullptr;
-    context->video.format_context->pb = io_context;
+    // guess the desired container format based on the file extension ; unknown extensions get an
+    // elementary stream
+    context->video.format_context->oformat = av_guess_format(nullptr, context->video.uri.c_str(), nullptr);
+    context->video.mux = is_container(context->video.format_context->oformat);
 
-    // guess the desired container format based on the file extension
-    if (!(context->video.format_context->oformat = av_guess_format(nullptr, context->video.uri.c_str(), nullptr)))
+    if (context->video.mux)
     {
-        avio_closep(&(context->video.format_context->pb));
-        avformat_free_context(context->video.format_context);
+        if (avio_open(&(context->video.format_context->pb), context->video.uri.c_str(), AVIO_FLAG_WRITE) < 0)
+        {
+            avformat_free_context(context->video.format_context);
 
-        throw cvpg::exception("could not find output file format");
+            throw cvpg::io_exception("failed to open output file");
+        }
     }
+    else
+    {
+        context->video.file = fopen(context->video.uri.c_str(), "wb");
+
+        if (!context->video.file)
+        {
+            avformat_free_context(context->video.format_context);
 
-    AVCodec * codec = avcodec_find_encoder(AVCodecID::AV_CODEC_ID_H264);
+            throw cvpg::io_exception("failed to open output file");
+        }
+    }
 
     // find the encoder to be used by its name
+    AVCodec * codec = m_encoder.codec.empty() ? avcodec_find_encoder(AVCodecID::AV_CODEC_ID_H264) : avcodec_find_encoder_by_name(m_encoder.codec.c_str());
+
     if (codec == nullptr)
     {
         avio_closep(&(context->video.format_context->pb));
         avformat_free_context(context->video.format_context);
 
-        throw cvpg::exception("could not find video decoder 'H264'");
+        throw cvpg::exception(std::string("could not find video encoder '").append(m_encoder.codec.empty() ? "H264" : m_encoder.codec).append("'"));
     }
 
     // create a new audio stream in the output file container
@@ -633,16 +1132,74 @@ template<typename Image> void file<Image>::params(std::size_t context_id, std::m
         throw cvpg::exception("invalid video dimensions");
     }
 
-    context->video.codec_context->time_base = AVRational{1, 25}; // vinfo.codec_context->time_base;
-    context->video.codec_context->pix_fmt = AVPixelFormat::AV_PIX_FMT_YUV420P;
+    // check frame rate
+    {
+        auto it = p.find("frames.framerate");
+
+        if (it != p.end())
+        {
+            context->video.framerate = std::any_cast<AVRational>(it->second);
+        }
+    }
+
+    // check time base
+    {
+        auto it = p.find("frames.time_base");
+
+        if (it != p.end())
+        {
+            context->video.time_base = std::any_cast<AVRational>(it->second);
+        }
+    }
+
+    if (context->video.framerate.num <= 0 || context->video.framerate.den <= 0 || context->video.time_base.num <= 0 || context->video.time_base.den <= 0)
+    {
+        throw cvpg::exception("invalid video frame rate or time base");
+    }
+
+    auto codec_context = context->video.codec_context;
+
+    codec_context->framerate = context->video.framerate;
+    codec_context->time_base = context->video.time_base;
+    codec_context->pix_fmt = AVPixelFormat::AV_PIX_FMT_YUV420P;
+
+    // segments are encoded by own encoders ; their packets carry the parameter sets of the codec, so
+    // the container takes them from the first packet
+    if (m_encoder.parallel_segments > 1 || m_encoder.passthrough)
+    {
+        write_header(context->video);
+
+        return;
+    }
+
+    configure_encoder(codec_context, m_encoder);
+
+    // containers expecting the parameter sets at the header get them from the encoder
+    if (context->video.mux && (context->video.format_context->oformat->flags & AVFMT_GLOBALHEADER) != 0)
+    {
+        codec_context->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+    }
+
+    std::string unused_option;
 
-    if (avcodec_open2(context->video.codec_context, context->video.codec_context->codec, nullptr) < 0)
+    try
+    {
+        unused_option = open_encoder(codec_context, m_encoder);
+    }
+    catch (...)
     {
         avio_closep(&(context->video.format_context->pb));
         avformat_free_context(context->video.format_context);
 
-        throw cvpg::io_exception("could not open video codec");
+        throw;
     }
+
+    if (!unused_option.empty())
+    {
+        throw cvpg::exception(std::string("encoder option '").append(unused_option).append("' not supported by encoder '").append(codec_context->codec->name).append("'"));
+    }
+
+    write_header(context->video);
 }
 
 template<typename Image> void file<Image>::start(std::size_t context_id)
@@ -680,7 +1237,14 @@ template<typename Image> void file<Image>::process(std::size_t context_id, video
     {
         auto & context = it->second;
 
-        context->sdh->add(packet.move_frames());
+        auto frames = packet.move_frames();
+
+        for (auto & frame : frames)
+        {
+            frame.enter_stage("sinks::file");
+        }
+
+        context->sdh->add(std::move(frames));
     }
 }
 
@@ -715,7 +1279,7 @@ template<typename Image> void file<Image>::try_flush_buffer(std::size_t context_
 
                 if (entry.id == context->buffer.next_frame)
                 {
-                    fwrite(entry.frame.get(), 1, entry.size, context->video.file);
+                    write_entry(context->video, entry);
 
                     context->buffer.data.erase(it);
                     context->buffer.next_frame++;
@@ -729,8 +1293,235 @@ template<typename Image> void file<Image>::try_flush_buffer(std::size_t context_
     }
 }
 
+template<typename Image> void file<Image>::collect_segments(std::size_t context_id, std::vector<videoproc::frame<Image> > frames, std::function<void()> deliver_done_callback)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it == m_contexts.end())
+    {
+        return;
+    }
+
+    auto & segments = it->second->segments;
+
+    for (auto & frame : frames)
+    {
+        if (frame.flush())
+        {
+            segments.flushed = true;
+
+            continue;
+        }
+
+        // frames with forwarded packets are cut into segments at the GOPs of the source stream
+        const bool follow_gops = m_encoder.passthrough && frame.source();
+
+        if (follow_gops)
+        {
+            const std::size_t gop = frame.source()->gop;
+
+            if (!segments.frames.empty() && (!segments.gop_known || gop != segments.gop))
+            {
+                start_segment(context_id);
+            }
+
+            segments.gop = gop;
+            segments.gop_known = true;
+        }
+
+        // collected frames are charged to the memory budget until their segment is encoded
+        const std::size_t bytes = frame.bytes();
+
+        if (m_memory_budget)
+        {
+            m_memory_budget->acquire(bytes);
+        }
+
+        segments.frames_bytes += bytes;
+
+        segments.frames.push_back(std::move(frame));
+
+        if (!follow_gops && segments.frames.size() >= std::max<std::size_t>(m_encoder.segment_frames, 1))
+        {
+            start_segment(context_id);
+        }
+    }
+
+    if (segments.flushed)
+    {
+        // the last segment could be shorter
+        if (!segments.frames.empty())
+        {
+            start_segment(context_id);
+        }
+
+        // finishes if no segment is running anymore
+        write_segments(context_id);
+    }
+    else if (segments.running < std::max<std::size_t>(m_encoder.parallel_segments, 1))
+    {
+        deliver_done_callback();
+    }
+    else
+    {
+        segments.deliver_done_callback = std::move(deliver_done_callback);
+    }
+}
+
+template<typename Image> void file<Image>::start_segment(std::size_t context_id)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it == m_contexts.end())
+    {
+        return;
+    }
+
+    auto context = it->second;
+    auto & segments = context->segments;
+
+    const std::size_t segment_number = segments.next_start++;
+
+    std::vector<videoproc::frame<Image> > frames;
+    frames.swap(segments.frames);
+
+    const std::size_t bytes = segments.frames_bytes;
+    segments.frames_bytes = 0;
+
+    if (m_encoder.passthrough && is_passthrough_segment(frames, context->video.codec_context->codec_id))
+    {
+        // the packets of the source stream are written as they are
+        auto entries = passthrough_packets<Image, typename processing_context::buffer_info::entry>(frames);
+
+        if (m_memory_budget)
+        {
+            m_memory_budget->release(bytes);
+        }
+
+        if (context->latencies)
+        {
+            const auto now = videoproc::frame_timestamps::clock::now();
+
+            for (auto const & f : frames)
+            {
+                context->latencies->add(f.timestamps(), now);
+            }
+        }
+
+        context->callbacks.update_indicator(context_id, videoproc::update_indicator("save", entries.size(), 0));
+
+        segments.encoded.insert({ segment_number, std::move(entries) });
+
+        write_segments(context_id);
+
+        return;
+    }
+
+    ++segments.running;
+
+    post_callback(
+        [context, encoder = m_encoder, frames = std::move(frames)]() mutable
+        {
+            return encode_segment_frames<Image>(context, encoder, std::move(frames));
+        },
+        [this, context_id, context, segment_number, bytes](auto cont_res)
+        {
+            // the frames of the segment are released by the encoder
+            if (m_memory_budget)
+            {
+                m_memory_budget->release(bytes);
+            }
+
+            try
+            {
+                auto entries = std::move(cont_res.get());
+
+                --context->segments.running;
+
+                context->callbacks.update_indicator(context_id, videoproc::update_indicator("save", entries.size(), 0));
+
+                context->segments.encoded.insert({ segment_number, std::move(entries) });
+
+                this->write_segments(context_id);
+            }
+            catch (std::exception const & e)
+            {
+                context->callbacks.failed(context_id, e.what());
+            }
+            catch (...)
+            {
+                context->callbacks.failed(context_id, "unknown error when encoding segment");
+            }
+        },
+        "sinks::file::encode_segment",
+        1,
+        1
+    );
+}
+
+template<typename Image> void file<Image>::write_segments(std::size_t context_id)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it == m_contexts.end())
+    {
+        return;
+    }
+
+    auto & context = it->second;
+    auto & segments = context->segments;
+
+    try
+    {
+        // write all encoded segments that follow the last written one
+        auto encoded = segments.encoded.begin();
+
+        while (encoded != segments.encoded.end() && encoded->first == segments.next_write)
+        {
+            for (auto const & entry : encoded->second)
+            {
+                write_entry(context->video, entry);
+            }
+
+            encoded = segments.encoded.erase(encoded);
+
+            ++segments.next_write;
+        }
+
+        if (segments.flushed && segments.running == 0 && !context->finished)
+        {
+            close_output(context->video, m_encoder.end_code);
+        }
+    }
+    catch (std::exception const & e)
+    {
+        context->finished = true;
+        context->callbacks.failed(context_id, e.what());
+
+        return;
+    }
+
+    if (segments.flushed)
+    {
+        if (segments.running == 0 && !context->finished)
+        {
+            context->finished = true;
+            context->callbacks.finished(context_id);
+        }
+    }
+    else if (segments.deliver_done_callback && segments.running < std::max<std::size_t>(m_encoder.parallel_segments, 1))
+    {
+        // continue delivery of frames held back while all segment encoders were busy
+        auto deliver_done_callback = std::move(segments.deliver_done_callback);
+        segments.deliver_done_callback = nullptr;
+
+        deliver_done_callback();
+    }
+}
+
 // manual instantiation of file<> for some types
 template class file<cvpg::image_gray_8bit>;
 template class file<cvpg::image_rgb_8bit>;
+template class file<cvpg::image_yuv420_8bit>;
 
 } // namespace cvpg::videoproc::sinks
@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <boost/asynchronous/servant_proxy.hpp>
 #include <boost/asynchronous/trackable_servant.hpp>
@@ -16,20 +17,49 @@
 #include <libcvpg/core/image.hpp>
 #include <libcvpg/imageproc/scripting/diagnostics/typedefs.hpp>
 #include <libcvpg/videoproc/frame.hpp>
+#include <libcvpg/videoproc/latency_statistics.hpp>
+#include <libcvpg/videoproc/memory_budget.hpp>
 #include <libcvpg/videoproc/packet.hpp>
 #include <libcvpg/videoproc/stage_parameters.hpp>
 #include <libcvpg/videoproc/update_indicator.hpp>
+#include <libcvpg/videoproc/sinks/encoder_parameters.hpp>
 
 namespace cvpg::videoproc::sinks {
 
+// check if a file sink muxes the video into a container for the given file name (see 'file')
+bool writes_container(std::string const & filename);
+
 //
 // A file sink writes frames of a video stream to a file.
 //
+// The encoder is configured by the given encoder parameters and opened as soon as the parameters of
+// the video (size, frame rate and time base of the source stream) are received.
+//
+// If more than one parallel segment is set at the encoder parameters, the ordered frames are cut into
+// segments of a fixed length. Each segment is encoded by an own encoder at a thread pool and starts
+// with a keyframe without references to other segments. The encoded segments are written in order
+// to a single file. Frames of segments are charged to the memory budget until they are encoded, and a
+// segment that fails to encode fails the whole video.
+//
+// If passthrough is set at the encoder parameters, the frames are cut into segments at the GOPs of
+// the source stream instead. A GOP whose frames are unmodified and carry all packets of the GOP (see
+// 'decoder_parameters') is written with these packets without encoding it again ; only GOPs with
+// modified frames are encoded. The GOPs of the source stream are expected to be closed.
+//
+// Frames are encoded with the presentation timestamps of the source stream, so streams with a variable
+// frame rate keep their timing. If latency statistics are given, the latencies of all stages passed by
+// a frame are added as soon as the frame is encoded.
+//
+// The container is chosen by the extension of the file name (e.g. '.mp4' or '.mkv') ; the packets are
+// muxed with their timestamps rescaled to the time base of the container. File names with an extension
+// of an elementary stream (e.g. '.h264') or an unknown extension get the plain packets without any
+// timestamps, so such files could be concatenated.
+//
 template<typename Image>
 class file : public boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>
 {
 public:
-    file(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler, std::size_t max_frames_write_buffer);
+    file(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler, std::size_t max_frames_write_buffer, encoder_parameters encoder = encoder_parameters(), std::shared_ptr<memory_budget> memory_budget = nullptr, std::shared_ptr<latency_statistics> latencies = nullptr);
 
     file(file const &) = delete;
     file(file &&) = delete;
@@ -56,15 +86,30 @@ public:
 private:
     void try_flush_buffer(std::size_t context_id);
 
+    void collect_segments(std::size_t context_id, std::vector<videoproc::frame<Image> > frames, std::function<void()> deliver_done_callback);
+
+    void start_segment(std::size_t context_id);
+
+    void write_segments(std::size_t context_id);
+
     // maximum size of frames at output buffer when writing the video stream to file
     std::size_t m_max_frames_write_buffer;
 
+    encoder_parameters m_encoder;
+
+    // memory budget shared with the other stages of the pipeline (optional)
+    std::shared_ptr<memory_budget> m_memory_budget;
+
+    // latencies of the frames written by this stage (optional)
+    std::shared_ptr<latency_statistics> m_latencies;
+
     std::map<std::size_t, std::shared_ptr<processing_context> > m_contexts;
 };
 
 // suppress automatic instantiation of file<> for some types
 extern template class file<cvpg::image_gray_8bit>;
 extern template class file<cvpg::image_rgb_8bit>;
+extern template class file<cvpg::image_yuv420_8bit>;
 
 //
 // Hint: Boost.Asynchronous does not support templated proxies. Becaues the servant itself could
@@ -101,6 +146,21 @@ struct image_rgb_8bit_file_proxy : public boost::asynchronous::servant_proxy<ima
     BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
 };
 
+struct image_yuv420_8bit_file_proxy : public boost::asynchronous::servant_proxy<image_yuv420_8bit_file_proxy, file<cvpg::image_yuv420_8bit>, imageproc::scripting::diagnostics::servant_job>
+{
+    template<typename... Args>
+    image_yuv420_8bit_file_proxy(Args... args)
+        : boost::asynchronous::servant_proxy<image_yuv420_8bit_file_proxy, file<cvpg::image_yuv420_8bit>, imageproc::scripting::diagnostics::servant_job>(std::forward<Args>(args)...)
+    {}
+
+    BOOST_ASYNC_POST_MEMBER_LOG(init, "init", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(params, "params", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(finish, "finish", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(process, "process", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
+};
+
 } // namespace cvpg::videoproc::sinks
 
 #endif // LIBCVPG_VIDEOPROC_SINKS_FILE_HPP
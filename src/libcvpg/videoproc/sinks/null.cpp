@@ -0,0 +1,174 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/videoproc/sinks/null.hpp>
+
+#include <vector>
+
+#include <libcvpg/core/exception.hpp>
+#include <libcvpg/videoproc/stage_data_handler.hpp>
+
+namespace cvpg::videoproc::sinks {
+
+template<typename Image> struct null<Image>::processing_context
+{
+    bool prev_stage_finished = false;
+
+    bool finished = false;
+
+    struct callback_info
+    {
+        std::function<void(std::size_t, std::size_t)> next;
+        std::function<void(std::size_t)> finished;
+        std::function<void(std::size_t, std::string)> failed;
+        std::function<void(std::size_t, videoproc::update_indicator)> update_indicator;
+    };
+
+    callback_info callbacks;
+
+    std::shared_ptr<stage_data_handler<videoproc::frame<Image> > > sdh;
+};
+
+template<typename Image> null<Image>::null(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler, std::size_t max_frames_write_buffer, std::shared_ptr<memory_budget> memory_budget, std::shared_ptr<latency_statistics> latencies)
+    : boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>(scheduler)
+    , m_max_frames_write_buffer(max_frames_write_buffer)
+    , m_memory_budget(std::move(memory_budget))
+    , m_latencies(std::move(latencies))
+    , m_contexts()
+{}
+
+template<typename Image> void null<Image>::init(std::size_t context_id, std::string /*uri*/, stage_callbacks<Image> callbacks)
+{
+    // create new processing context
+    auto context = std::make_shared<processing_context>();
+    context->callbacks.next = std::move(callbacks.next);
+    context->callbacks.finished = std::move(callbacks.finished);
+    context->callbacks.failed = std::move(callbacks.failed);
+    context->callbacks.update_indicator = std::move(callbacks.update);
+
+    context->sdh = std::make_shared<stage_data_handler<videoproc::frame<Image> > >(
+        "sinks::null",
+        m_max_frames_write_buffer,
+        [context_id, context]()
+        {
+            // inform previous stage that this stage is ready to receive new data
+            context->callbacks.next(context_id, context->sdh->free());
+        },
+        [context]()
+        {
+            return context->sdh->free();
+        },
+        [this, context_id, context](std::vector<videoproc::frame<Image> > frames, std::function<void()> deliver_done_callback)
+        {
+            const auto dropped = frame_timestamps::clock::now();
+
+            std::size_t counted = 0;
+            bool has_flush = false;
+
+            for (auto const & frame : frames)
+            {
+                if (frame.flush())
+                {
+                    has_flush = true;
+
+                    continue;
+                }
+
+                if (m_latencies)
+                {
+                    m_latencies->add(frame.timestamps(), dropped);
+                }
+
+                ++counted;
+            }
+
+            if (counted > 0)
+            {
+                context->callbacks.update_indicator(context_id, videoproc::update_indicator("save", counted, 0));
+            }
+
+            if (has_flush)
+            {
+                context->finished = true;
+                context->callbacks.finished(context_id);
+            }
+            else
+            {
+                deliver_done_callback();
+            }
+        },
+        m_memory_budget
+    );
+
+    m_contexts.insert({ context_id, context });
+
+    callbacks.initialized(context_id, 0);
+
+    context->sdh->try_flush();
+}
+
+template<typename Image> void null<Image>::params(std::size_t context_id, std::map<std::string, std::any> /*p*/)
+{
+    if (m_contexts.find(context_id) == m_contexts.end())
+    {
+        throw cvpg::exception("no context with given ID found");
+    }
+}
+
+template<typename Image> void null<Image>::start(std::size_t context_id)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it != m_contexts.end())
+    {
+        auto & context = it->second;
+
+        if (!(context->prev_stage_finished))
+        {
+            context->callbacks.next(context_id, context->sdh->free());
+        }
+    }
+}
+
+template<typename Image> void null<Image>::finish(std::size_t context_id)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it != m_contexts.end())
+    {
+        auto & context = it->second;
+
+        context->prev_stage_finished = true;
+    }
+}
+
+template<typename Image> void null<Image>::process(std::size_t context_id, videoproc::packet<videoproc::frame<Image> > && packet)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it != m_contexts.end())
+    {
+        auto & context = it->second;
+
+        auto frames = packet.move_frames();
+
+        for (auto & frame : frames)
+        {
+            frame.enter_stage("sinks::null");
+        }
+
+        context->sdh->add(std::move(frames));
+    }
+}
+
+template<typename Image> void null<Image>::next(std::size_t /*context_id*/, std::size_t /*max_new_data*/)
+{
+    // no next at sink
+}
+
+// manual instantiation of null<> for some types
+template class null<cvpg::image_gray_8bit>;
+template class null<cvpg::image_rgb_8bit>;
+template class null<cvpg::image_yuv420_8bit>;
+
+} // namespace cvpg::videoproc::sinks
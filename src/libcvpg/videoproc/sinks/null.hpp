@@ -0,0 +1,132 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_SINKS_NULL_HPP
+#define LIBCVPG_VIDEOPROC_SINKS_NULL_HPP
+
+#include <any>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <boost/asynchronous/servant_proxy.hpp>
+#include <boost/asynchronous/trackable_servant.hpp>
+
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/imageproc/scripting/diagnostics/typedefs.hpp>
+#include <libcvpg/videoproc/frame.hpp>
+#include <libcvpg/videoproc/latency_statistics.hpp>
+#include <libcvpg/videoproc/memory_budget.hpp>
+#include <libcvpg/videoproc/packet.hpp>
+#include <libcvpg/videoproc/stage_parameters.hpp>
+#include <libcvpg/videoproc/update_indicator.hpp>
+
+namespace cvpg::videoproc::sinks {
+
+//
+// A null sink drops all frames of a video stream. The frames are only counted (as saved frames of the
+// update indicators), so the throughput of the previous stages could be measured without the costs of
+// an encoder. The URI given at 'init' is not used.
+//
+// If latency statistics are given, the latencies of all stages passed by a frame are added as soon as
+// the frame is dropped.
+//
+template<typename Image>
+class null : public boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>
+{
+public:
+    null(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler, std::size_t max_frames_write_buffer, std::shared_ptr<memory_budget> memory_budget = nullptr, std::shared_ptr<latency_statistics> latencies = nullptr);
+
+    null(null const &) = delete;
+    null(null &&) = delete;
+
+    null & operator=(null const &) = delete;
+    null & operator=(null &&) = delete;
+
+    virtual ~null() = default;
+
+    void init(std::size_t context_id, std::string uri, stage_callbacks<Image> callbacks);
+
+    void params(std::size_t context_id, std::map<std::string, std::any> p);
+
+    void start(std::size_t context_id);
+
+    void finish(std::size_t context_id);
+
+    void process(std::size_t context_id, videoproc::packet<videoproc::frame<Image> > && packet);
+
+    void next(std::size_t context_id, std::size_t max_new_data);
+
+private:
+    // maximum size of frames at the input buffer
+    std::size_t m_max_frames_write_buffer;
+
+    // memory budget shared with the other stages of the pipeline (optional)
+    std::shared_ptr<memory_budget> m_memory_budget;
+
+    // latencies of the frames dropped by this stage (optional)
+    std::shared_ptr<latency_statistics> m_latencies;
+
+    struct processing_context;
+    std::map<std::size_t, std::shared_ptr<processing_context> > m_contexts;
+};
+
+// suppress automatic instantiation of null<> for some types
+extern template class null<cvpg::image_gray_8bit>;
+extern template class null<cvpg::image_rgb_8bit>;
+extern template class null<cvpg::image_yuv420_8bit>;
+
+//
+// Hint: Boost.Asynchronous does not support templated proxies. Becaues the servant itself could
+// have template parameters we have to create a proxy for each wanted type.
+//
+
+struct image_gray_8bit_null_proxy : public boost::asynchronous::servant_proxy<image_gray_8bit_null_proxy, null<cvpg::image_gray_8bit>, imageproc::scripting::diagnostics::servant_job>
+{
+    template<typename... Args>
+    image_gray_8bit_null_proxy(Args... args)
+        : boost::asynchronous::servant_proxy<image_gray_8bit_null_proxy, null<cvpg::image_gray_8bit>, imageproc::scripting::diagnostics::servant_job>(std::forward<Args>(args)...)
+    {}
+
+    BOOST_ASYNC_POST_MEMBER_LOG(init, "init", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(params, "params", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(finish, "finish", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(process, "process", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
+};
+
+struct image_rgb_8bit_null_proxy : public boost::asynchronous::servant_proxy<image_rgb_8bit_null_proxy, null<cvpg::image_rgb_8bit>, imageproc::scripting::diagnostics::servant_job>
+{
+    template<typename... Args>
+    image_rgb_8bit_null_proxy(Args... args)
+        : boost::asynchronous::servant_proxy<image_rgb_8bit_null_proxy, null<cvpg::image_rgb_8bit>, imageproc::scripting::diagnostics::servant_job>(std::forward<Args>(args)...)
+    {}
+
+    BOOST_ASYNC_POST_MEMBER_LOG(init, "init", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(params, "params", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(finish, "finish", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(process, "process", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
+};
+
+struct image_yuv420_8bit_null_proxy : public boost::asynchronous::servant_proxy<image_yuv420_8bit_null_proxy, null<cvpg::image_yuv420_8bit>, imageproc::scripting::diagnostics::servant_job>
+{
+    template<typename... Args>
+    image_yuv420_8bit_null_proxy(Args... args)
+        : boost::asynchronous::servant_proxy<image_yuv420_8bit_null_proxy, null<cvpg::image_yuv420_8bit>, imageproc::scripting::diagnostics::servant_job>(std::forward<Args>(args)...)
+    {}
+
+    BOOST_ASYNC_POST_MEMBER_LOG(init, "init", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(params, "params", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(finish, "finish", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(process, "process", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
+};
+
+} // namespace cvpg::videoproc::sinks
+
+#endif // LIBCVPG_VIDEOPROC_SINKS_NULL_HPP
@@ -0,0 +1,48 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/videoproc/sinks/passthrough.hpp>
+
+#include <libcvpg/core/image.hpp>
+
+namespace cvpg::videoproc::sinks {
+
+template<typename Image>
+bool is_passthrough_segment(std::vector<videoproc::frame<Image> > const & frames, int codec_id)
+{
+    if (frames.empty() || !frames.front().source())
+    {
+        return false;
+    }
+
+    const std::size_t gop = frames.front().source()->gop;
+
+    std::vector<bool> indices(frames.size(), false);
+
+    for (auto const & f : frames)
+    {
+        auto const & source = f.source();
+
+        if (!source || f.modified() || source->gop != gop || source->codec_id != codec_id)
+        {
+            return false;
+        }
+
+        // each packet of the GOP has to be there exactly once
+        if (source->index >= indices.size() || indices[source->index])
+        {
+            return false;
+        }
+
+        indices[source->index] = true;
+    }
+
+    return true;
+}
+
+// manual instantiation of is_passthrough_segment<> for some types
+template bool is_passthrough_segment<image_gray_8bit>(std::vector<videoproc::frame<image_gray_8bit> > const &, int);
+template bool is_passthrough_segment<image_rgb_8bit>(std::vector<videoproc::frame<image_rgb_8bit> > const &, int);
+template bool is_passthrough_segment<image_yuv420_8bit>(std::vector<videoproc::frame<image_yuv420_8bit> > const &, int);
+
+} // namespace cvpg::videoproc::sinks
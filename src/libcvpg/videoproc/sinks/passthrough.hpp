@@ -0,0 +1,23 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_SINKS_PASSTHROUGH_HPP
+#define LIBCVPG_VIDEOPROC_SINKS_PASSTHROUGH_HPP
+
+#include <vector>
+
+#include <libcvpg/videoproc/frame.hpp>
+
+namespace cvpg::videoproc::sinks {
+
+//
+// Check if the frames of a segment could be written with the forwarded packets of the source stream.
+// This is the case if all frames are unmodified and their packets form a complete GOP of a stream
+// with the given codec (an 'AVCodecID').
+//
+template<typename Image>
+bool is_passthrough_segment(std::vector<videoproc::frame<Image> > const & frames, int codec_id);
+
+} // namespace cvpg::videoproc::sinks
+
+#endif // LIBCVPG_VIDEOPROC_SINKS_PASSTHROUGH_HPP
@@ -0,0 +1,335 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/videoproc/sinks/raw.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+extern "C" {
+#include <libavutil/rational.h>
+}
+
+#include <libcvpg/core/exception.hpp>
+#include <libcvpg/videoproc/stage_data_handler.hpp>
+
+namespace {
+
+//
+// Write the planes of an image line by line without padding. Returns false if writing failed.
+//
+template<typename Image>
+bool write_planes(Image const & image, FILE * file)
+{
+    if constexpr (std::is_same_v<Image, cvpg::image_yuv420_8bit>)
+    {
+        for (std::uint8_t p = 0; p < 3; ++p)
+        {
+            std::uint8_t const * data = image.data(p).get();
+
+            for (std::uint32_t y = 0; y < image.plane_height(p); ++y)
+            {
+                if (fwrite(data + static_cast<std::size_t>(y) * image.stride(p), 1, image.plane_width(p), file) != image.plane_width(p))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    else
+    {
+        constexpr std::size_t channels = std::tuple_size<typename Image::channel_array_type>::value;
+
+        // lines of the image are 'width + padding' pixels apart
+        const std::size_t stride = image.width() + image.padding();
+
+        for (std::uint8_t c = 0; c < channels; ++c)
+        {
+            std::uint8_t const * data = image.data(c).get();
+
+            for (std::uint32_t y = 0; y < image.height(); ++y)
+            {
+                if (fwrite(data + y * stride, 1, image.width(), file) != image.width())
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+}
+
+namespace cvpg::videoproc::sinks {
+
+template<typename Image> struct raw<Image>::processing_context
+{
+    bool prev_stage_finished = false;
+
+    bool finished = false;
+
+    struct video_info
+    {
+        std::string uri;
+
+        FILE * file = nullptr;
+
+        // size of the first frame ; all frames must have this size
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+
+        AVRational framerate = AVRational{25, 1};
+
+        bool header_written = false;
+    };
+
+    video_info video;
+
+    struct callback_info
+    {
+        std::function<void(std::size_t, std::size_t)> next;
+        std::function<void(std::size_t)> finished;
+        std::function<void(std::size_t, std::string)> failed;
+        std::function<void(std::size_t, videoproc::update_indicator)> update_indicator;
+    };
+
+    callback_info callbacks;
+
+    std::shared_ptr<stage_data_handler<videoproc::frame<Image> > > sdh;
+};
+
+template<typename Image> raw<Image>::raw(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler, std::size_t max_frames_write_buffer, raw_format format, std::shared_ptr<memory_budget> memory_budget, std::shared_ptr<latency_statistics> latencies)
+    : boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>(scheduler)
+    , m_max_frames_write_buffer(max_frames_write_buffer)
+    , m_format(format)
+    , m_memory_budget(std::move(memory_budget))
+    , m_latencies(std::move(latencies))
+    , m_contexts()
+{}
+
+template<typename Image> void raw<Image>::init(std::size_t context_id, std::string uri, stage_callbacks<Image> callbacks)
+{
+    if constexpr (std::is_same_v<Image, cvpg::image_rgb_8bit>)
+    {
+        if (m_format == raw_format::y4m)
+        {
+            throw cvpg::exception("Y4M format supports YUV and grayscale images only");
+        }
+    }
+
+    // create new processing context
+    auto context = std::make_shared<processing_context>();
+    context->video.uri = std::move(uri);
+    context->callbacks.next = std::move(callbacks.next);
+    context->callbacks.finished = std::move(callbacks.finished);
+    context->callbacks.failed = std::move(callbacks.failed);
+    context->callbacks.update_indicator = std::move(callbacks.update);
+
+    context->sdh = std::make_shared<stage_data_handler<videoproc::frame<Image> > >(
+        "sinks::raw",
+        m_max_frames_write_buffer,
+        [context_id, context]()
+        {
+            // inform previous stage that this stage is ready to receive new data
+            context->callbacks.next(context_id, context->sdh->free());
+        },
+        [context]()
+        {
+            return context->sdh->free();
+        },
+        [this, context_id, context](std::vector<videoproc::frame<Image> > frames, std::function<void()> deliver_done_callback)
+        {
+            auto & video = context->video;
+
+            std::size_t written = 0;
+            bool has_flush = false;
+
+            for (auto const & frame : frames)
+            {
+                if (frame.flush())
+                {
+                    has_flush = true;
+
+                    continue;
+                }
+
+                auto const & image = frame.image();
+
+                if (video.width == 0 && video.height == 0)
+                {
+                    video.width = image.width();
+                    video.height = image.height();
+                }
+                else if (image.width() != video.width || image.height() != video.height)
+                {
+                    context->callbacks.failed(context_id, "size of frame differs from first frame");
+
+                    return;
+                }
+
+                bool ok = true;
+
+                if (m_format == raw_format::y4m)
+                {
+                    if (!video.header_written)
+                    {
+                        const char * colorspace = std::is_same_v<Image, cvpg::image_yuv420_8bit> ? "420jpeg" : "mono";
+
+                        // the color range of the first frame is stated for the whole stream
+                        const char * range = "";
+
+                        if constexpr (!std::is_same_v<Image, cvpg::image_rgb_8bit>)
+                        {
+                            range = image.range() == cvpg::color_range::full ? " XCOLORRANGE=FULL" : " XCOLORRANGE=LIMITED";
+                        }
+
+                        ok &= fprintf(video.file, "YUV4MPEG2 W%u H%u F%d:%d Ip A1:1 C%s%s\n", video.width, video.height, video.framerate.num, video.framerate.den, colorspace, range) > 0;
+
+                        video.header_written = true;
+                    }
+
+                    ok &= fputs("FRAME\n", video.file) >= 0;
+                }
+
+                ok &= write_planes(image, video.file);
+
+                if (!ok)
+                {
+                    context->callbacks.failed(context_id, "failed to write frame to output file");
+
+                    return;
+                }
+
+                if (m_latencies)
+                {
+                    m_latencies->add(frame.timestamps(), frame_timestamps::clock::now());
+                }
+
+                ++written;
+            }
+
+            if (written > 0)
+            {
+                context->callbacks.update_indicator(context_id, videoproc::update_indicator("save", written, 0));
+            }
+
+            if (has_flush)
+            {
+                fclose(video.file);
+                video.file = nullptr;
+
+                context->finished = true;
+                context->callbacks.finished(context_id);
+            }
+            else
+            {
+                deliver_done_callback();
+            }
+        },
+        m_memory_budget
+    );
+
+    m_contexts.insert({ context_id, context });
+
+    context->video.file = fopen(context->video.uri.c_str(), "wb");
+
+    if (!context->video.file)
+    {
+        throw cvpg::io_exception("failed to open output file");
+    }
+
+    callbacks.initialized(context_id, 0);
+
+    context->sdh->try_flush();
+}
+
+template<typename Image> void raw<Image>::params(std::size_t context_id, std::map<std::string, std::any> p)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it == m_contexts.end())
+    {
+        throw cvpg::exception("no context with given ID found");
+    }
+
+    auto & context = it->second;
+
+    // check frame rate
+    {
+        auto it = p.find("frames.framerate");
+
+        if (it != p.end())
+        {
+            context->video.framerate = std::any_cast<AVRational>(it->second);
+        }
+    }
+
+    if (context->video.framerate.num <= 0 || context->video.framerate.den <= 0)
+    {
+        throw cvpg::exception("invalid video frame rate");
+    }
+}
+
+template<typename Image> void raw<Image>::start(std::size_t context_id)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it != m_contexts.end())
+    {
+        auto & context = it->second;
+
+        if (!(context->prev_stage_finished))
+        {
+            context->callbacks.next(context_id, context->sdh->free());
+        }
+    }
+}
+
+template<typename Image> void raw<Image>::finish(std::size_t context_id)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it != m_contexts.end())
+    {
+        auto & context = it->second;
+
+        context->prev_stage_finished = true;
+    }
+}
+
+template<typename Image> void raw<Image>::process(std::size_t context_id, videoproc::packet<videoproc::frame<Image> > && packet)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it != m_contexts.end())
+    {
+        auto & context = it->second;
+
+        auto frames = packet.move_frames();
+
+        for (auto & frame : frames)
+        {
+            frame.enter_stage("sinks::raw");
+        }
+
+        context->sdh->add(std::move(frames));
+    }
+}
+
+template<typename Image> void raw<Image>::next(std::size_t /*context_id*/, std::size_t /*max_new_data*/)
+{
+    // no next at sink
+}
+
+// manual instantiation of raw<> for some types
+template class raw<cvpg::image_gray_8bit>;
+template class raw<cvpg::image_rgb_8bit>;
+template class raw<cvpg::image_yuv420_8bit>;
+
+} // namespace cvpg::videoproc::sinks
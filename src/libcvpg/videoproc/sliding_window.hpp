@@ -0,0 +1,81 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_SLIDING_WINDOW_HPP
+#define LIBCVPG_VIDEOPROC_SLIDING_WINDOW_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace cvpg::videoproc {
+
+//
+// A sliding window keeps the last 'size' entries pushed into it. The entries are stored at a ring,
+// so pushing an entry into a full window overwrites (evicts) the oldest entry without moving any
+// other entry.
+//
+// Entries are addressed by their age: entry 0 is the newest one, entry 'size() - 1' the oldest one.
+//
+template<typename T>
+class sliding_window
+{
+public:
+    explicit sliding_window(std::size_t size)
+        : m_entries(size > 0 ? size : 1)
+    {}
+
+    // add an entry ; evicts the oldest entry if the window is full
+    void push(T t)
+    {
+        m_entries[m_head] = std::move(t);
+
+        m_head = (m_head + 1) % m_entries.size();
+
+        if (m_size < m_entries.size())
+        {
+            ++m_size;
+        }
+    }
+
+    // get the entry with the given age (0 is the newest entry)
+    T const & at(std::size_t age) const
+    {
+        return m_entries[(m_head + m_entries.size() - 1 - age) % m_entries.size()];
+    }
+
+    // amount of stored entries
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    std::size_t capacity() const
+    {
+        return m_entries.size();
+    }
+
+    bool full() const
+    {
+        return m_size == m_entries.size();
+    }
+
+    void clear()
+    {
+        m_entries.assign(m_entries.size(), T());
+        m_head = 0;
+        m_size = 0;
+    }
+
+private:
+    std::vector<T> m_entries;
+
+    // index of the slot that is written next
+    std::size_t m_head = 0;
+
+    std::size_t m_size = 0;
+};
+
+} // namespace cvpg::videoproc
+
+#endif // LIBCVPG_VIDEOPROC_SLIDING_WINDOW_HPP
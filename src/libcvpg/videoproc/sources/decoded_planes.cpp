@@ -0,0 +1,142 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/videoproc/sources/decoded_planes.hpp>
+
+#include <cstdint>
+#include <memory>
+
+extern "C" {
+#include <libavutil/frame.h>
+#include <libavutil/pixfmt.h>
+#include <libswscale/swscale.h>
+}
+
+namespace cvpg::videoproc::sources {
+
+bool has_luma_plane(int pixel_format)
+{
+    switch (pixel_format)
+    {
+        case AVPixelFormat::AV_PIX_FMT_GRAY8:
+        case AVPixelFormat::AV_PIX_FMT_NV12:
+        case AVPixelFormat::AV_PIX_FMT_NV16:
+        case AVPixelFormat::AV_PIX_FMT_NV21:
+        case AVPixelFormat::AV_PIX_FMT_YUV410P:
+        case AVPixelFormat::AV_PIX_FMT_YUV411P:
+        case AVPixelFormat::AV_PIX_FMT_YUV420P:
+        case AVPixelFormat::AV_PIX_FMT_YUV422P:
+        case AVPixelFormat::AV_PIX_FMT_YUV440P:
+        case AVPixelFormat::AV_PIX_FMT_YUV444P:
+        case AVPixelFormat::AV_PIX_FMT_YUVJ420P:
+        case AVPixelFormat::AV_PIX_FMT_YUVJ422P:
+        case AVPixelFormat::AV_PIX_FMT_YUVJ440P:
+        case AVPixelFormat::AV_PIX_FMT_YUVJ444P:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool has_full_range_luma(int pixel_format, int color_range)
+{
+    switch (pixel_format)
+    {
+        // always full range
+        case AVPixelFormat::AV_PIX_FMT_GRAY8:
+        case AVPixelFormat::AV_PIX_FMT_YUVJ420P:
+        case AVPixelFormat::AV_PIX_FMT_YUVJ422P:
+        case AVPixelFormat::AV_PIX_FMT_YUVJ440P:
+        case AVPixelFormat::AV_PIX_FMT_YUVJ444P:
+            return true;
+
+        // full range only if signaled by the stream ; an unspecified range is limited
+        case AVPixelFormat::AV_PIX_FMT_NV12:
+        case AVPixelFormat::AV_PIX_FMT_NV16:
+        case AVPixelFormat::AV_PIX_FMT_NV21:
+        case AVPixelFormat::AV_PIX_FMT_YUV410P:
+        case AVPixelFormat::AV_PIX_FMT_YUV411P:
+        case AVPixelFormat::AV_PIX_FMT_YUV420P:
+        case AVPixelFormat::AV_PIX_FMT_YUV422P:
+        case AVPixelFormat::AV_PIX_FMT_YUV440P:
+        case AVPixelFormat::AV_PIX_FMT_YUV444P:
+            return color_range == AVColorRange::AVCOL_RANGE_JPEG;
+
+        default:
+            return false;
+    }
+}
+
+void set_source_color_range(SwsContext * sws_context, int color_range)
+{
+    if (sws_context == nullptr || (color_range != AVColorRange::AVCOL_RANGE_JPEG && color_range != AVColorRange::AVCOL_RANGE_MPEG))
+    {
+        return;
+    }
+
+    int * inv_table = nullptr;
+    int * table = nullptr;
+
+    int src_range = 0;
+    int dst_range = 0;
+
+    int brightness = 0;
+    int contrast = 0;
+    int saturation = 0;
+
+    if (sws_getColorspaceDetails(sws_context, &inv_table, &src_range, &table, &dst_range, &brightness, &contrast, &saturation) < 0)
+    {
+        return;
+    }
+
+    const int range = color_range == AVColorRange::AVCOL_RANGE_JPEG ? 1 : 0;
+
+    if (range != src_range)
+    {
+        sws_setColorspaceDetails(sws_context, inv_table, range, table, dst_range, brightness, contrast, saturation);
+    }
+}
+
+bool wrap_luma_plane(AVFrame const * frame, std::vector<cvpg::image_gray_8bit> & images)
+{
+    AVFrame * reference = av_frame_clone(frame);
+
+    if (reference == nullptr)
+    {
+        return false;
+    }
+
+    auto data = std::shared_ptr<std::uint8_t>(reference->data[0], [reference](std::uint8_t * /*ptr*/){ AVFrame * f = reference; av_frame_free(&f); });
+
+    images.emplace_back(frame->width, frame->height, frame->linesize[0] - frame->width, cvpg::image_gray_8bit::channel_array_type({ data }));
+    images.back().set_range(has_full_range_luma(frame->format, frame->color_range) ? cvpg::color_range::full : cvpg::color_range::limited);
+
+    return true;
+}
+
+bool wrap_yuv420_planes(AVFrame const * frame, std::vector<cvpg::image_yuv420_8bit> & images)
+{
+    AVFrame * reference = av_frame_clone(frame);
+
+    if (reference == nullptr)
+    {
+        return false;
+    }
+
+    auto holder = std::shared_ptr<AVFrame>(reference, [](AVFrame * f){ av_frame_free(&f); });
+
+    images.emplace_back(frame->width,
+                        frame->height,
+                        cvpg::image_yuv420_8bit::plane_array_type {{ std::shared_ptr<std::uint8_t>(holder, reference->data[0]),
+                                                                     std::shared_ptr<std::uint8_t>(holder, reference->data[1]),
+                                                                     std::shared_ptr<std::uint8_t>(holder, reference->data[2]) }},
+                        cvpg::image_yuv420_8bit::stride_array_type {{ static_cast<std::uint32_t>(frame->linesize[0]),
+                                                                      static_cast<std::uint32_t>(frame->linesize[1]),
+                                                                      static_cast<std::uint32_t>(frame->linesize[2]) }},
+                        has_full_range_luma(frame->format, frame->color_range) ? cvpg::color_range::full : cvpg::color_range::limited);
+
+    return true;
+}
+
+} // namespace cvpg::videoproc::sources
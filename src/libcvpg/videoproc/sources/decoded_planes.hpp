@@ -0,0 +1,56 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_SOURCES_DECODED_PLANES_HPP
+#define LIBCVPG_VIDEOPROC_SOURCES_DECODED_PLANES_HPP
+
+#include <vector>
+
+#include <libcvpg/core/image.hpp>
+
+struct AVFrame;
+struct SwsContext;
+
+namespace cvpg::videoproc::sources {
+
+//
+// Check if the first plane of a decoded frame of the given pixel format contains the 8-bit luma values
+// of the frame at full resolution, so it could be wrapped as grayscale image.
+//
+bool has_luma_plane(int pixel_format);
+
+//
+// Check if the first plane of a decoded frame of the given pixel format and color range (an
+// 'AVColorRange') contains full range 8-bit luma values at full resolution. Only such a plane matches
+// the conversion to 'AV_PIX_FMT_GRAY8', which is full range. Limited range luma (16 ... 235) has to be
+// expanded before it is used as intensity.
+//
+bool has_full_range_luma(int pixel_format, int color_range);
+
+//
+// Set the color range of the source frames of a conversion context to the given color range (an
+// 'AVColorRange'). Conversion contexts take the range from the pixel format only, so frames of a
+// pixel format without an own full range variant (e.g. NV12) would be expanded twice otherwise. An
+// unspecified color range keeps the range of the pixel format.
+//
+void set_source_color_range(SwsContext * sws_context, int color_range);
+
+//
+// Wrap the luma plane of a decoded frame into a grayscale image without copying any pixel. The image
+// holds a reference of the frame buffers as long as the image data is used. The difference between
+// the line size of the frame and the width is stored as padding of the image. The color range of the
+// image is taken from the frame ; limited range luma is expanded by the consumers of the image, never
+// in place, because the decoder could still use the frame as reference.
+//
+bool wrap_luma_plane(AVFrame const * frame, std::vector<cvpg::image_gray_8bit> & images);
+
+//
+// Wrap the planes of a decoded YUV 4:2:0 frame into an image without copying any pixel. All planes
+// share a reference of the frame buffers, which is released with the last plane. The color range of the
+// image is taken from the frame.
+//
+bool wrap_yuv420_planes(AVFrame const * frame, std::vector<cvpg::image_yuv420_8bit> & images);
+
+} // namespace cvpg::videoproc::sources
+
+#endif // LIBCVPG_VIDEOPROC_SOURCES_DECODED_PLANES_HPP
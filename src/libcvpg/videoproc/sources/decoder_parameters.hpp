@@ -0,0 +1,45 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_SOURCES_DECODER_PARAMETERS_HPP
+#define LIBCVPG_VIDEOPROC_SOURCES_DECODER_PARAMETERS_HPP
+
+#include <cstdint>
+
+#include <libcvpg/videoproc/sources/range_parameters.hpp>
+#include <libcvpg/videoproc/sources/sampling_parameters.hpp>
+
+namespace cvpg::videoproc::sources {
+
+//
+// Parameters of the video decoder used at a source stage.
+//
+struct decoder_parameters
+{
+    // amount of threads used by the decoder (0 = chosen by the decoder)
+    std::size_t threads = 0;
+
+    // decode multiple frames at once ; adds a delay of one frame per thread
+    bool frame_threading = true;
+
+    // decode multiple slices of a frame at once
+    bool slice_threading = true;
+
+    // amount of segments (each starting at a keyframe) that are decoded in parallel with independent
+    // decoders ; 0 or 1 decodes the video sequentially
+    std::size_t parallel_segments = 0;
+
+    // frames passed to the next stage ; parallel segments are not used if frames are skipped
+    sampling_parameters sampling;
+
+    // part of the video that is read ; parallel segments are not used for a part of a video
+    range_parameters range;
+
+    // attach the compressed packets of the source stream to the decoded frames, so unmodified GOPs
+    // could be written without encoding them again ; not used with parallel segments
+    bool forward_packets = false;
+};
+
+} // namespace cvpg::videoproc::sources
+
+#endif // LIBCVPG_VIDEOPROC_SOURCES_DECODER_PARAMETERS_HPP
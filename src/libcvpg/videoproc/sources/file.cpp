@@ -3,7 +3,19 @@
 
 #include <libcvpg/videoproc/sources/file.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <boost/asynchronous/queue/lockfree_queue.hpp>
+#include <boost/asynchronous/scheduler_shared_proxy.hpp>
+#include <boost/asynchronous/scheduler/multiqueue_threadpool_scheduler.hpp>
 
 extern "C" {
 #include <libavcodec/avcodec.h>
@@ -16,14 +28,25 @@ extern "C" {
 }
 
 #include <libcvpg/videoproc/stage_data_handler.hpp>
+#include <libcvpg/videoproc/sources/decoded_planes.hpp>
+#include <libcvpg/videoproc/sources/frame_range.hpp>
+#include <libcvpg/videoproc/sources/frame_sampler.hpp>
+#include <libcvpg/videoproc/sources/packet_forwarder.hpp>
+
+static_assert(AV_NOPTS_VALUE == cvpg::videoproc::frame_timestamps::no_pts, "unknown timestamps of FFmpeg and of frames differ");
 
 namespace {
 
 #undef av_err2str
 #define av_err2str(errnum) av_make_error_string((char*)__builtin_alloca(AV_ERROR_MAX_STRING_SIZE), AV_ERROR_MAX_STRING_SIZE, errnum)
 
+//
+// Decode a packet and append the decoded frames to the given images and their presentation timestamps
+// to the given timestamps. Frames outside of the given range are dropped. If a sampler is given, frames
+// that are not sampled are dropped before they are converted.
+//
 template<typename Image>
-int decode_packet(AVPacket * packet, AVCodecContext * codec_context, AVFrame * frame, std::vector<Image> & images)
+int decode_packet(AVPacket * packet, AVCodecContext * codec_context, AVFrame * frame, SwsContext *& sws_context, std::vector<Image> & images, std::vector<std::int64_t> & timestamps, cvpg::videoproc::sources::frame_sampler * sampler = nullptr, AVRational time_base = AVRational{ 0, 1 }, cvpg::videoproc::sources::frame_range * range = nullptr)
 {
     int res = avcodec_send_packet(codec_context, packet);
 
@@ -53,88 +76,487 @@ int decode_packet(AVPacket * packet, AVCodecContext * codec_context, AVFrame * f
             break;
         }
 
-        std::size_t channels = 0;
-        AVPixelFormat pixel_format = AVPixelFormat::AV_PIX_FMT_NONE;
+        if (range != nullptr && !range->accept(frame->best_effort_timestamp))
+        {
+            av_frame_unref(frame);
+
+            continue;
+        }
 
-        if constexpr (std::tuple_size<typename Image::channel_array_type>::value == 1)
+        if (sampler != nullptr && sampler->enabled())
         {
-            channels = 1;
-            pixel_format = AVPixelFormat::AV_PIX_FMT_GRAY8;
+            const bool sampled = (frame->best_effort_timestamp != AV_NOPTS_VALUE && time_base.num != 0)
+                               ? sampler->accept(static_cast<double>(frame->best_effort_timestamp) * av_q2d(time_base))
+                               : sampler->accept();
+
+            if (!sampled)
+            {
+                av_frame_unref(frame);
+
+                continue;
+            }
         }
-        else if constexpr (std::tuple_size<typename Image::channel_array_type>::value == 3)
+
+        // unknown timestamps of the decoder and of the frames are the same value
+        timestamps.push_back(frame->best_effort_timestamp);
+
+        if constexpr (std::is_same_v<Image, cvpg::image_yuv420_8bit>)
         {
-            channels = 3;
-            pixel_format = AVPixelFormat::AV_PIX_FMT_RGB24;
+            // YUV 4:2:0 images use the planes of the decoder directly if possible
+            const bool is_yuv420 = frame->format == AVPixelFormat::AV_PIX_FMT_YUV420P || frame->format == AVPixelFormat::AV_PIX_FMT_YUVJ420P;
+
+            if (is_yuv420 && frame->linesize[0] >= frame->width && frame->linesize[1] > 0 && frame->linesize[2] > 0 && cvpg::videoproc::sources::wrap_yuv420_planes(frame, images))
+            {
+                av_frame_unref(frame);
+
+                continue;
+            }
+        }
+        else if constexpr (std::tuple_size<typename Image::channel_array_type>::value == 1)
+        {
+            // grayscale images use the luma plane of the decoder directly ; limited range luma keeps its
+            // range and is expanded by the consumers of the image
+            if (cvpg::videoproc::sources::has_luma_plane(frame->format) && frame->linesize[0] >= frame->width && cvpg::videoproc::sources::wrap_luma_plane(frame, images))
+            {
+                av_frame_unref(frame);
+
+                continue;
+            }
+        }
+
+        Image image(frame->width, frame->height);
+
+        AVPixelFormat pixel_format = AVPixelFormat::AV_PIX_FMT_NONE;
+
+        // the converted frame is written directly to the channel planes of the image
+        std::uint8_t * dst_data[4] = { nullptr, nullptr, nullptr, nullptr };
+        int dst_linesize[4] = { 0, 0, 0, 0 };
+
+        if constexpr (std::is_same_v<Image, cvpg::image_yuv420_8bit>)
+        {
+            pixel_format = AVPixelFormat::AV_PIX_FMT_YUV420P;
+
+            for (std::uint8_t p = 0; p < 3; ++p)
+            {
+                dst_data[p] = image.data(p).get();
+                dst_linesize[p] = static_cast<int>(image.stride(p));
+            }
         }
         else
         {
-            // TODO handle error
+            const int linesize = static_cast<int>(image.width() + image.padding());
+
+            if constexpr (std::tuple_size<typename Image::channel_array_type>::value == 1)
+            {
+                pixel_format = AVPixelFormat::AV_PIX_FMT_GRAY8;
+
+                dst_data[0] = image.data(0).get();
+                dst_linesize[0] = linesize;
+            }
+            else if constexpr (std::tuple_size<typename Image::channel_array_type>::value == 3)
+            {
+                // planes of GBRP are ordered green, blue, red
+                pixel_format = AVPixelFormat::AV_PIX_FMT_GBRP;
+
+                dst_data[0] = image.data(1).get();
+                dst_data[1] = image.data(2).get();
+                dst_data[2] = image.data(0).get();
+                dst_linesize[0] = linesize;
+                dst_linesize[1] = linesize;
+                dst_linesize[2] = linesize;
+            }
+            else
+            {
+                // TODO handle error
+            }
         }
 
-        Image image(frame->width, frame->height, 0);
+        // the context of the previous frame is reused as long as the frame format doesn't change
+        sws_context = sws_getCachedContext(sws_context,
+                                           frame->width,
+                                           frame->height,
+                                           static_cast<AVPixelFormat>(frame->format),
+                                           image.width(),
+                                           image.height(),
+                                           pixel_format,
+                                           0,
+                                           nullptr,
+                                           nullptr,
+                                           nullptr);
+
+        if (sws_context == nullptr)
+        {
+            av_frame_unref(frame);
+
+            timestamps.pop_back();
 
-        // create a SWC context to convert image from source to RGB pixel format
-        auto sws_ctx = sws_getContext(codec_context->width,
-                                      codec_context->height,
-                                      codec_context->pix_fmt,
-                                      image.width(),
-                                      image.height(),
-                                      pixel_format,
-                                      0,
-                                      0,
-                                      0,
-                                      0);
+            res = AVERROR(EINVAL);
 
-        auto raw_data = std::shared_ptr<std::uint8_t>(static_cast<std::uint8_t *>(malloc(image.width() * image.height() * channels)), [](std::uint8_t * ptr){ free(ptr); });
+            break;
+        }
 
-        AVFrame * dst = av_frame_alloc();
-        dst->data[0] = raw_data.get();
-        dst->data[1] = nullptr;
-        dst->linesize[0] = image.width() * channels;
-        dst->linesize[1] = 0;
+        // the range of the decoded frame has precedence over the range of its pixel format
+        cvpg::videoproc::sources::set_source_color_range(sws_context, frame->color_range);
 
-        // perform conversion to RGB raw data
-        sws_scale(sws_ctx,
+        sws_scale(sws_context,
                   frame->data,
                   frame->linesize,
                   0,
-                  image.height(),
-                  dst->data,
-                  dst->linesize);
+                  frame->height,
+                  dst_data,
+                  dst_linesize);
 
-        // convert into cvpg::image format
-        for (std::size_t y = 0; y < image.height(); ++y)
-        {
-            std::size_t dst_pos = y * image.width();
-            std::size_t src_pos = dst_pos * channels;
+        av_frame_unref(frame);
 
-            for (std::size_t x = 0; x < image.width(); ++x, ++dst_pos, src_pos += channels)
+        images.push_back(std::move(image));
+    }
+
+    return res;
+}
+
+//
+// Set the threading of a decoder. Has to be called before the decoder is opened.
+//
+void set_threading(AVCodecContext * codec_context, cvpg::videoproc::sources::decoder_parameters const & decoder)
+{
+    codec_context->thread_type = (decoder.frame_threading ? FF_THREAD_FRAME : 0) | (decoder.slice_threading ? FF_THREAD_SLICE : 0);
+    codec_context->thread_count = codec_context->thread_type != 0 ? static_cast<int>(decoder.threads) : 1;
+}
+
+// a part of a video starting at a keyframe that can be decoded independent of all other segments
+struct segment
+{
+    // position at file and decoding timestamp of the keyframe
+    std::int64_t position = -1;
+    std::int64_t dts = AV_NOPTS_VALUE;
+
+    // number of the first frame and amount of frames (one frame per packet) of this segment
+    std::size_t first_frame = 0;
+    std::size_t frames = 0;
+
+    // presentation timestamps of all frames of this segment in ascending order
+    std::vector<std::int64_t> timestamps;
+
+    // position at file and decoding timestamp of the keyframe decoding starts at ; frames of an open GOP
+    // reference the previous segment, so decoding starts at the keyframe of the previous segment
+    std::int64_t decode_position = -1;
+    std::int64_t decode_dts = AV_NOPTS_VALUE;
+};
+
+//
+// Open the input and return the index of the best video stream or a negative error code.
+//
+int open_input(std::string const & uri, AVFormatContext ** format_context)
+{
+    int res = avformat_open_input(format_context, uri.c_str(), nullptr, nullptr);
+
+    if (res < 0)
+    {
+        return res;
+    }
+
+    res = avformat_find_stream_info(*format_context, nullptr);
+
+    if (res < 0)
+    {
+        return res;
+    }
+
+    return av_find_best_stream(*format_context, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+}
+
+//
+// Split the video stream of the given input at its keyframes into segments of at least 'min_frames'
+// frames. Only the packets are read, nothing will be decoded.
+//
+// Frames of segments are numbered by their presentation timestamps. If a timestamp is missing, occurs
+// twice or the timestamps of segments overlap, no segments are returned and the video has to be decoded
+// sequentially.
+//
+std::vector<segment> scan_segments(std::string const & uri, std::size_t min_frames)
+{
+    std::vector<segment> segments;
+
+    // presentation timestamps of the keyframes of the segments
+    std::vector<std::int64_t> keyframes;
+
+    AVFormatContext * format_context = nullptr;
+
+    const int stream_index = open_input(uri, &format_context);
+
+    AVPacket * packet = av_packet_alloc();
+
+    bool numbered = stream_index >= 0 && packet != nullptr;
+
+    if (numbered)
+    {
+        std::size_t frames = 0;
+
+        while (numbered && av_read_frame(format_context, packet) >= 0)
+        {
+            if (packet->stream_index == stream_index)
             {
-                if constexpr (std::tuple_size<typename Image::channel_array_type>::value == 1)
+                const bool is_keyframe = (packet->flags & AV_PKT_FLAG_KEY) != 0;
+
+                // start a new segment at a keyframe if the current one is large enough
+                if (segments.empty() || (is_keyframe && segments.back().frames >= min_frames))
                 {
-                    image.data(0).get()[dst_pos] = dst->data[0][src_pos];
+                    if (is_keyframe)
+                    {
+                        segments.push_back({ packet->pos, packet->dts, frames, 0, {}, packet->pos, packet->dts });
+                        keyframes.push_back(packet->pts);
+                    }
                 }
-                else if constexpr (std::tuple_size<typename Image::channel_array_type>::value == 3)
+
+                if (!segments.empty())
                 {
-                    image.data(0).get()[dst_pos] = dst->data[0][src_pos];
-                    image.data(1).get()[dst_pos] = dst->data[0][src_pos + 1];
-                    image.data(2).get()[dst_pos] = dst->data[0][src_pos + 2];
+                    segments.back().frames++;
+                    segments.back().timestamps.push_back(packet->pts);
+
+                    numbered = packet->pts != AV_NOPTS_VALUE;
+
+                    ++frames;
                 }
             }
+
+            av_packet_unref(packet);
         }
+    }
+
+    av_packet_free(&packet);
+    avformat_close_input(&format_context);
 
-        sws_freeContext(sws_ctx);
+    for (std::size_t i = 0; numbered && i < segments.size(); ++i)
+    {
+        auto & timestamps = segments[i].timestamps;
 
-        av_frame_free(&dst);
+        std::sort(timestamps.begin(), timestamps.end());
 
-        av_frame_unref(frame);
+        numbered = std::adjacent_find(timestamps.begin(), timestamps.end()) == timestamps.end() &&
+                   (i == 0 || segments[i - 1].timestamps.back() < timestamps.front());
 
-        images.push_back(std::move(image));
+        // frames before the keyframe belong to an open GOP ; the first segment has no GOP to reference
+        if (numbered && timestamps.front() < keyframes[i])
+        {
+            numbered = i > 0;
+
+            if (numbered)
+            {
+                segments[i].decode_position = segments[i - 1].position;
+                segments[i].decode_dts = segments[i - 1].dts;
+            }
+        }
     }
 
-    return res;
+    if (!numbered)
+    {
+        segments.clear();
+    }
+
+    return segments;
 }
 
+//
+// Decoder of a single segment with an own input and decoder. A segment is decoded in chunks, so the
+// frames of a segment are passed on (and charged to the memory budget of the buffer) while the rest of
+// the segment is still decoded.
+//
+// Frames are numbered by the position of their presentation timestamp at the segment, so frames are
+// numbered the same way as by sequential decoding. Frames decoded before the segment (when starting at
+// the keyframe of the previous segment) are dropped.
+//
+template<typename Image>
+struct segment_decoder
+{
+    // decoded frames with their numbers and presentation timestamps
+    struct chunk
+    {
+        std::vector<Image> images;
+        std::vector<std::size_t> numbers;
+        std::vector<std::int64_t> timestamps;
+
+        // set after the last frame of the segment
+        bool finished = false;
+    };
+
+    segment_decoder(std::string uri, cvpg::videoproc::sources::decoder_parameters const & decoder, segment s)
+        : uri(std::move(uri))
+        , decoder(decoder)
+        , s(std::move(s))
+        , decoded(this->s.timestamps.size(), false)
+    {}
+
+    segment_decoder(segment_decoder const &) = delete;
+    segment_decoder & operator=(segment_decoder const &) = delete;
+
+    ~segment_decoder()
+    {
+        sws_freeContext(sws_context);
+        avcodec_free_context(&codec_context);
+        avformat_close_input(&format_context);
+        av_frame_free(&frame);
+        av_packet_free(&packet);
+    }
+
+    // decode until at least 'max_frames' frames of the segment are decoded or the segment ends ; throws on errors
+    chunk decode(std::size_t max_frames)
+    {
+        if (format_context == nullptr)
+        {
+            open();
+        }
+
+        chunk result;
+
+        std::vector<Image> images;
+        std::vector<std::int64_t> timestamps;
+
+        while (result.images.size() < max_frames && !drained)
+        {
+            images.clear();
+            timestamps.clear();
+
+            if (packets < s.frames && av_read_frame(format_context, packet) >= 0)
+            {
+                if (packet->stream_index == stream_index)
+                {
+                    // the seek could end before the keyframe decoding starts at, so skip all packets before it
+                    started = started || is_keyframe(s.decode_position, s.decode_dts);
+
+                    // packets are counted from the keyframe of the segment on
+                    inside = inside || (started && is_keyframe(s.position, s.dts));
+
+                    if (started && decode_packet<Image>(packet, codec_context, frame, sws_context, images, timestamps) < 0)
+                    {
+                        av_packet_unref(packet);
+
+                        throw std::runtime_error("failed to decode segment");
+                    }
+
+                    packets += inside ? 1 : 0;
+                }
+
+                av_packet_unref(packet);
+            }
+            else
+            {
+                // drain frames still buffered at the decoder
+                if (decode_packet<Image>(nullptr, codec_context, frame, sws_context, images, timestamps) < 0)
+                {
+                    throw std::runtime_error("failed to flush decoder of segment");
+                }
+
+                drained = true;
+            }
+
+            for (std::size_t i = 0; i < images.size(); ++i)
+            {
+                auto it = std::lower_bound(s.timestamps.begin(), s.timestamps.end(), timestamps[i]);
+
+                // drop frames of other segments and frames decoded twice
+                if (it == s.timestamps.end() || *it != timestamps[i] || decoded[it - s.timestamps.begin()])
+                {
+                    continue;
+                }
+
+                const std::size_t index = static_cast<std::size_t>(it - s.timestamps.begin());
+
+                decoded[index] = true;
+                ++frames;
+
+                result.images.push_back(std::move(images[i]));
+                result.numbers.push_back(s.first_frame + index);
+                result.timestamps.push_back(timestamps[i]);
+            }
+        }
+
+        if (drained && frames < s.frames)
+        {
+            // frames are never invented, so a segment that misses frames fails
+            throw std::runtime_error(std::string("decoded ").append(std::to_string(frames)).append(" of ").append(std::to_string(s.frames)).append(" frames of segment"));
+        }
+
+        result.finished = drained;
+
+        return result;
+    }
+
+    void open()
+    {
+        frame = av_frame_alloc();
+        packet = av_packet_alloc();
+
+        if (frame == nullptr || packet == nullptr)
+        {
+            throw std::runtime_error("failed to allocate memory for segment decoding");
+        }
+
+        stream_index = open_input(uri, &format_context);
+
+        if (stream_index < 0)
+        {
+            throw std::runtime_error(std::string("failed to open input '").append(uri).append("'"));
+        }
+
+        AVCodecParameters * codec_parameters = format_context->streams[stream_index]->codecpar;
+        AVCodec * codec = avcodec_find_decoder(codec_parameters->codec_id);
+
+        codec_context = avcodec_alloc_context3(codec);
+
+        if (codec == nullptr || codec_context == nullptr || avcodec_parameters_to_context(codec_context, codec_parameters) < 0)
+        {
+            throw std::runtime_error("failed to create decoder for segment");
+        }
+
+        set_threading(codec_context, decoder);
+
+        if (avcodec_open2(codec_context, codec, nullptr) < 0)
+        {
+            throw std::runtime_error("failed to open decoder for segment");
+        }
+
+        if (av_seek_frame(format_context, stream_index, s.decode_dts, AVSEEK_FLAG_BACKWARD) < 0)
+        {
+            throw std::runtime_error("failed to seek to segment");
+        }
+    }
+
+    // check if the current packet is the keyframe at the given position (or decoding timestamp if unknown)
+    bool is_keyframe(std::int64_t position, std::int64_t dts) const
+    {
+        return (packet->flags & AV_PKT_FLAG_KEY) != 0 && (position >= 0 ? packet->pos == position : packet->dts >= dts);
+    }
+
+    std::string uri;
+
+    cvpg::videoproc::sources::decoder_parameters decoder;
+
+    segment s;
+
+    AVFormatContext * format_context = nullptr;
+    AVCodecContext * codec_context = nullptr;
+    SwsContext * sws_context = nullptr;
+
+    AVFrame * frame = nullptr;
+    AVPacket * packet = nullptr;
+
+    int stream_index = -1;
+
+    // set at the keyframe decoding starts at and at the keyframe of the segment
+    bool started = false;
+    bool inside = false;
+
+    // set after the decoder was flushed at the end of the segment
+    bool drained = false;
+
+    // packets read from the segment and frames of the segment decoded so far
+    std::size_t packets = 0;
+    std::size_t frames = 0;
+
+    // frames of the segment (in order of their timestamps) that are already decoded
+    std::vector<bool> decoded;
+};
+
 }
 
 namespace cvpg::videoproc::sources {
@@ -167,6 +589,9 @@ template<typename Image> struct file<Image>::processing_context
         AVFormatContext * format_context = nullptr;
         AVCodecContext * codec_context = nullptr;
 
+        // context to convert decoded frames to the pixel format of 'Image'
+        SwsContext * sws_context = nullptr;
+
         std::size_t stream_index = 0;
     };
 
@@ -199,13 +624,54 @@ template<typename Image> struct file<Image>::processing_context
 
     callback_info callbacks;
 
+    struct segments_info
+    {
+        std::vector<segment> entries;
+
+        // index of the next segment to decode
+        std::size_t next = 0;
+
+        // amount of chunks being decoded and of completely decoded segments
+        std::size_t running = 0;
+        std::size_t done = 0;
+
+        // started segments waiting to decode their next chunk by index of segment
+        std::map<std::size_t, std::shared_ptr<segment_decoder<Image> > > waiting;
+    };
+
+    // segments of the video if decoded in parallel
+    segments_info segments;
+
+    // selects the decoded frames passed to the next stage
+    frame_sampler sampler;
+
+    // part of the video that is read
+    frame_range range;
+
+    // compressed packets attached to the decoded frames (optional)
+    std::unique_ptr<packet_forwarder> forwarder;
+
     std::shared_ptr<stage_data_handler<videoproc::frame<Image> > > sdh;
+
+    ~processing_context()
+    {
+        sws_freeContext(video.sws_context);
+    }
 };
 
 template<typename Image> file<Image>::file(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler,
-                                           std::size_t max_frames_read_buffer)
-    : boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>(scheduler)
+                                           std::size_t max_frames_read_buffer,
+                                           decoder_parameters decoder,
+                                           std::shared_ptr<memory_budget> memory_budget)
+    : boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>(scheduler,
+                                                                                                                                             decoder.parallel_segments > 1
+                                                                                                                                                 ? boost::asynchronous::make_shared_scheduler_proxy<
+                                                                                                                                                       boost::asynchronous::multiqueue_threadpool_scheduler<
+                                                                                                                                                           boost::asynchronous::lockfree_queue<imageproc::scripting::diagnostics::servant_job> > >(decoder.parallel_segments, std::string("sources::file"))
+                                                                                                                                                 : boost::asynchronous::any_shared_scheduler_proxy<imageproc::scripting::diagnostics::servant_job>())
     , m_max_frames_read_buffer(max_frames_read_buffer)
+    , m_decoder(std::move(decoder))
+    , m_memory_budget(std::move(memory_budget))
     , m_contexts()
 {}
 
@@ -273,7 +739,8 @@ template<typename Image> void file<Image>::init(std::size_t context_id, std::str
             {
                 deliver_done_callback();
             }
-        }
+        },
+        m_memory_budget
     );
 
     m_contexts.insert({ context_id, context });
@@ -359,6 +826,8 @@ template<typename Image> void file<Image>::init(std::size_t context_id, std::str
 
     context->frames.pixel_format = context->video.codec_context->pix_fmt;
 
+    set_threading(context->video.codec_context, m_decoder);
+
     // get amount of frames
     if (context->video.format_context->nb_streams > 0)
     {
@@ -369,6 +838,49 @@ template<typename Image> void file<Image>::init(std::size_t context_id, std::str
         const std::int64_t frames = static_cast<std::int64_t>(static_cast<double>(context->video.format_context->duration) * fps / 1000000.0);
 
         context->video.frames = frames;
+
+        // the frame rate and time base of the source stream are used by later stages (e.g. for encoding)
+        AVStream * stream = context->video.format_context->streams[context->video.stream_index];
+
+        const AVRational framerate = av_guess_frame_rate(context->video.format_context, stream, nullptr);
+
+        if (framerate.num > 0 && framerate.den > 0)
+        {
+            context->video.framerate = framerate;
+        }
+
+        context->video.time_base = stream->time_base;
+    }
+
+    context->sampler = frame_sampler(m_decoder.sampling, av_q2d(context->video.framerate));
+
+    // frames that are not sampled anyway are skipped by the decoder if possible
+    if (context->sampler.keyframes_only())
+    {
+        context->video.codec_context->skip_frame = AVDISCARD_NONKEY;
+    }
+    else if (context->sampler.discard_non_reference())
+    {
+        context->video.codec_context->skip_frame = AVDISCARD_NONREF;
+    }
+
+    context->video.codec_context->pkt_timebase = context->video.time_base;
+
+    // segments are decoded with independent decoders, so sampled frames couldn't be numbered in order
+    if (m_decoder.parallel_segments > 1 && !context->sampler.enabled() && !m_decoder.range.enabled())
+    {
+        // segments are decoded in chunks, but small segments keep more decoders busy at short videos
+        context->segments.entries = scan_segments(context->video.uri, std::max<std::size_t>(m_max_frames_read_buffer / m_decoder.parallel_segments, 1));
+
+        if (context->segments.entries.size() > 1)
+        {
+            context->video.frames = static_cast<std::int64_t>(context->segments.entries.back().first_frame + context->segments.entries.back().frames);
+        }
+        else
+        {
+            // nothing to parallelize
+            context->segments.entries.clear();
+        }
     }
 
     if (avcodec_open2(context->video.codec_context, codec, nullptr) < 0)
@@ -382,14 +894,71 @@ template<typename Image> void file<Image>::init(std::size_t context_id, std::str
         return;
     }
 
+    // packets are forwarded by the sequential decoder only
+    if (m_decoder.forward_packets && context->segments.entries.empty())
+    {
+        context->forwarder = std::make_unique<packet_forwarder>();
+
+        if (!context->forwarder->open(codec_parameters, context->video.time_base))
+        {
+            context->callbacks.failed(context_id, "failed to initialize forwarding of packets");
+
+            return;
+        }
+    }
+
+    if (m_decoder.range.enabled())
+    {
+        const auto & range = m_decoder.range;
+
+        if (range.start < 0.0 || (range.end >= 0.0 && range.end <= range.start))
+        {
+            context->callbacks.failed(context_id, "invalid range of video");
+
+            return;
+        }
+
+        AVStream * stream = context->video.format_context->streams[context->video.stream_index];
+
+        const double fps = av_q2d(context->video.framerate);
+
+        // positions of the range in seconds
+        const double start = range.unit == range_unit::frames ? range.start / fps : range.start;
+        const double end = range.unit == range_unit::frames ? range.end / fps : range.end;
+
+        const std::int64_t first = stream->start_time != AV_NOPTS_VALUE ? stream->start_time : 0;
+
+        context->range = frame_range::create(range, fps, av_q2d(context->video.time_base), first);
+
+        if (range.start > 0.0)
+        {
+            // the seek ends at the keyframe before the start, all frames before the start are decoded and dropped
+            if (av_seek_frame(context->video.format_context, static_cast<int>(context->video.stream_index), context->range.start, AVSEEK_FLAG_BACKWARD) < 0)
+            {
+                context->callbacks.failed(context_id, "failed to seek to start of range");
+
+                return;
+            }
+
+            avcodec_flush_buffers(context->video.codec_context);
+        }
+
+        // estimate the amount of frames of the range
+        const double duration = static_cast<double>(context->video.frames) / fps;
+
+        context->video.frames = static_cast<std::int64_t>(std::max(((range.end >= 0.0 ? std::min(end, duration) : duration) - start) * fps, 0.0));
+    }
+
     std::map<std::string, std::any> params =
     {
         { "frames.width", context->frames.width },
-        { "frames.height", context->frames.height }
+        { "frames.height", context->frames.height },
+        { "frames.framerate", context->video.framerate },
+        { "frames.time_base", context->video.time_base }
     };
 
     context->callbacks.params(context_id, std::move(params));
-    callbacks.initialized(context_id, context->video.frames);
+    callbacks.initialized(context_id, context->sampler.sampled_frames(context->video.frames));
 }
 
 template<typename Image> void file<Image>::params(std::size_t /*context_id*/, std::map<std::string, std::any> /*p*/)
@@ -411,6 +980,14 @@ template<typename Image> void file<Image>::start(std::size_t context_id)
             return;
         }
 
+        // segments decide on their own if the buffer could take more frames
+        if (!context->segments.entries.empty())
+        {
+            decode_segments(context_id);
+
+            return;
+        }
+
         // check if input buffer is full
         if (context->sdh->full())
         {
@@ -420,6 +997,9 @@ template<typename Image> void file<Image>::start(std::size_t context_id)
         std::vector<Image> images;
         images.reserve(m_max_frames_read_buffer);
 
+        std::vector<std::int64_t> timestamps;
+        timestamps.reserve(m_max_frames_read_buffer);
+
         AVFrame * frame = av_frame_alloc();
 
         if (!frame)
@@ -438,6 +1018,9 @@ template<typename Image> void file<Image>::start(std::size_t context_id)
             return;
         }
 
+        // decoded frames could be dropped without being delivered
+        const bool skipping = context->sampler.enabled() || context->range.start != AV_NOPTS_VALUE;
+
         // try to read files to fill a quarter of the input buffer
         for (auto i = 0; i < context->sdh->free(); /* increment only when really encode */)
         {
@@ -448,6 +1031,16 @@ template<typename Image> void file<Image>::start(std::size_t context_id)
                 if (res == AVERROR_EOF)
                 {
                     context->status.eof_reached = true;
+
+                    // drain frames still buffered at the decoder (e.g. when using frame threading)
+                    std::vector<Image> packet_images;
+                    std::vector<std::int64_t> packet_timestamps;
+
+                    if (decode_packet<Image>(nullptr, context->video.codec_context, frame, context->video.sws_context, packet_images, packet_timestamps, &(context->sampler), context->video.time_base, &(context->range)) >= 0)
+                    {
+                        images.insert(images.end(), packet_images.begin(), packet_images.end());
+                        timestamps.insert(timestamps.end(), packet_timestamps.begin(), packet_timestamps.end());
+                    }
                 }
                 else
                 {
@@ -461,32 +1054,67 @@ template<typename Image> void file<Image>::start(std::size_t context_id)
 
             if (packet->stream_index == context->video.stream_index)
             {
-                ++i;
+                // all packets are counted, so GOPs with dropped packets are not written without encoding
+                if (context->forwarder)
+                {
+                    context->forwarder->add(packet);
+                }
+
+                // packets of frames that are not decoded at all are not passed to the decoder
+                if (context->sampler.keyframes_only() && (packet->flags & AV_PKT_FLAG_KEY) == 0)
+                {
+                    av_packet_unref(packet);
+
+                    continue;
+                }
 
                 context->status.frames_loaded++;
 
                 std::vector<Image> packet_images;
+                std::vector<std::int64_t> packet_timestamps;
+
+                const int decode_result = decode_packet<Image>(packet, context->video.codec_context, frame, context->video.sws_context, packet_images, packet_timestamps, &(context->sampler), context->video.time_base, &(context->range));
+
+                // too many non-reference frames in a row for the sampling interval, so all frames are decoded again
+                if (context->video.codec_context->skip_frame == AVDISCARD_NONREF && !context->sampler.discard_non_reference())
+                {
+                    context->video.codec_context->skip_frame = AVDISCARD_DEFAULT;
+                }
 
-                if (decode_packet<Image>(packet, context->video.codec_context, frame, packet_images) < 0)
+                if (decode_result < 0)
                 {
+                    ++i;
+
                     context->status.frames_failed++;
 
                     context->callbacks.update_indicator(context_id, videoproc::update_indicator("load", 0, 1));
                 }
                 else
                 {
+                    // if frames are sampled or dropped before the start of the range, packets are read until the delivered frames fill the buffer
+                    i += skipping ? static_cast<int>(packet_images.size()) : 1;
+
                     images.insert(images.end(), packet_images.begin(), packet_images.end());
+                    timestamps.insert(timestamps.end(), packet_timestamps.begin(), packet_timestamps.end());
 
-                    if (packet_images.empty())
+                    if (!packet_images.empty())
                     {
-                        // TODO indicate an empty packet in a separate way !?!?
-                        context->callbacks.update_indicator(context_id, videoproc::update_indicator("load", 0, 1));
+                        context->callbacks.update_indicator(context_id, videoproc::update_indicator("load", 1, 0));
                     }
-                    else
+                    else if (!skipping)
                     {
-                        context->callbacks.update_indicator(context_id, videoproc::update_indicator("load", 1, 0));
+                        // TODO indicate an empty packet in a separate way !?!?
+                        context->callbacks.update_indicator(context_id, videoproc::update_indicator("load", 0, 1));
                     }
                 }
+
+                if (context->range.end_reached)
+                {
+                    // all further frames are after the end of the range
+                    context->status.eof_reached = true;
+
+                    break;
+                }
             }
         }
 
@@ -496,24 +1124,150 @@ template<typename Image> void file<Image>::start(std::size_t context_id)
         av_frame_free(&frame);
         av_packet_free(&packet);
 
-        if (!images.empty())
+        std::vector<videoproc::frame<Image> > frames;
+        frames.reserve(images.size() + 1);
+
+        const auto decoded = frame_timestamps::clock::now();
+
+        for (std::size_t i = 0; i < images.size(); ++i)
         {
-            std::vector<videoproc::frame<Image> > frames;
-            frames.reserve(images.size());
+            frames.emplace_back(context->status.frames_processed++, std::move(images[i]));
+            frames.back().set_timestamps({ timestamps[i], decoded, {} });
 
-            for (auto & image : images)
+            if (context->forwarder)
             {
-                frames.emplace_back(context->status.frames_processed++, std::move(image));
+                frames.back().set_source(context->forwarder->take(timestamps[i]));
             }
+        }
 
+        if (context->status.eof_reached && !(context->status.eof_flushed))
+        {
+            // add flush frame when end-of-file reached
+            frames.emplace_back(context->status.frames_processed++);
+        }
+
+        if (!frames.empty())
+        {
             context->sdh->add(std::move(frames));
+        }
+    }
+}
 
-            if (context->status.eof_reached && !(context->status.eof_flushed))
-            {
-                // add flush frame when end-of-file reached
-                context->sdh->add(videoproc::frame<Image>(context->status.frames_processed++));
-            }
+template<typename Image> void file<Image>::decode_segments(std::size_t context_id)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it == m_contexts.end())
+    {
+        return;
+    }
+
+    auto context = it->second;
+    auto & segments = context->segments;
+
+    while (segments.running < m_decoder.parallel_segments)
+    {
+        // a full buffer could hold frames of later segments only while the next stage waits for frames of
+        // an earlier segment, so in this case the earliest segment continues to guarantee progress
+        if (context->sdh->full() && (segments.running > 0 || context->status.next_waiting == 0))
+        {
+            break;
+        }
+
+        // started segments continue in order before new segments are started
+        std::size_t index = segments.next;
+        std::shared_ptr<segment_decoder<Image> > decoder;
+
+        if (!segments.waiting.empty())
+        {
+            index = segments.waiting.begin()->first;
+            decoder = std::move(segments.waiting.begin()->second);
+
+            segments.waiting.erase(segments.waiting.begin());
+        }
+        else if (segments.next < segments.entries.size())
+        {
+            decoder = std::make_shared<segment_decoder<Image> >(context->video.uri, m_decoder, segments.entries[segments.next]);
+
+            ++segments.next;
         }
+        else
+        {
+            break;
+        }
+
+        ++segments.running;
+
+        // running segments share the free space of the buffer
+        const std::size_t chunk_frames = std::max<std::size_t>(context->sdh->free() / m_decoder.parallel_segments, 1);
+
+        post_callback(
+            [decoder, chunk_frames]()
+            {
+                return decoder->decode(chunk_frames);
+            },
+            [this, context_id, context, decoder, index](auto cont_res)
+            {
+                try
+                {
+                    auto decoded = std::move(cont_res.get());
+
+                    auto & images = decoded.images;
+
+                    auto & segments = context->segments;
+
+                    --segments.running;
+
+                    if (decoded.finished)
+                    {
+                        ++segments.done;
+                    }
+                    else
+                    {
+                        segments.waiting.insert({ index, decoder });
+                    }
+
+                    context->status.frames_loaded += images.size();
+                    context->status.frames_processed += images.size();
+
+                    std::vector<videoproc::frame<Image> > frames;
+                    frames.reserve(images.size() + 1);
+
+                    const auto now = frame_timestamps::clock::now();
+
+                    for (std::size_t i = 0; i < images.size(); ++i)
+                    {
+                        frames.emplace_back(decoded.numbers[i], std::move(images[i]));
+                        frames.back().set_timestamps({ decoded.timestamps[i], now, {} });
+                    }
+
+                    if (segments.done == segments.entries.size())
+                    {
+                        context->status.eof_reached = true;
+
+                        // add flush frame after the last frame of the last segment
+                        frames.emplace_back(segments.entries.back().first_frame + segments.entries.back().frames);
+                    }
+
+                    context->callbacks.update_indicator(context_id, videoproc::update_indicator("load", images.size(), 0));
+
+                    context->sdh->add(std::move(frames));
+
+                    this->decode_segments(context_id);
+                }
+                catch (std::exception const & e)
+                {
+                    context->callbacks.failed(context_id, e.what());
+                }
+                catch (...)
+                {
+                    context->callbacks.failed(context_id, "unknown error when decoding segment");
+                }
+            },
+            "sources::file::decode_segment",
+            1,
+            1
+        );
     }
 }
 
@@ -544,5 +1298,29 @@ template<typename Image> void file<Image>::next(std::size_t context_id, std::siz
 // manual instantiation of file<> for some types
 template class file<cvpg::image_gray_8bit>;
 template class file<cvpg::image_rgb_8bit>;
+template class file<cvpg::image_yuv420_8bit>;
+
+std::vector<range_parameters> split_into_ranges(std::string const & uri, std::size_t chunks)
+{
+    AVFormatContext * format_context = nullptr;
+
+    const int stream_index = open_input(uri, &format_context);
+
+    const std::int64_t duration = (stream_index >= 0 && format_context != nullptr) ? format_context->duration : AV_NOPTS_VALUE;
+
+    avformat_close_input(&format_context);
+
+    if (stream_index < 0)
+    {
+        throw std::runtime_error(std::string("failed to open input '").append(uri).append("'"));
+    }
+
+    if (duration == AV_NOPTS_VALUE || duration <= 0)
+    {
+        throw std::runtime_error(std::string("unknown duration of input '").append(uri).append("'"));
+    }
+
+    return split_range(static_cast<double>(duration) / AV_TIME_BASE, chunks);
+}
 
 } // namespace cvpg::videoproc::sources
@@ -10,6 +10,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <boost/asynchronous/servant_proxy.hpp>
 #include <boost/asynchronous/trackable_servant.hpp>
@@ -17,8 +18,11 @@
 #include <libcvpg/core/image.hpp>
 #include <libcvpg/imageproc/scripting/diagnostics/typedefs.hpp>
 #include <libcvpg/videoproc/frame.hpp>
+#include <libcvpg/videoproc/memory_budget.hpp>
 #include <libcvpg/videoproc/packet.hpp>
 #include <libcvpg/videoproc/stage_parameters.hpp>
+#include <libcvpg/videoproc/sources/decoder_parameters.hpp>
+#include <libcvpg/videoproc/sources/range_parameters.hpp>
 #include <libcvpg/videoproc/update_indicator.hpp>
 
 namespace cvpg::videoproc::sources {
@@ -30,11 +34,26 @@ namespace cvpg::videoproc::sources {
 // packet. These packets will be stored inside an output buffer. Each packet at the output buffer
 // will be delivered to the next stage if this stage is ready to receive new data.
 //
+// If more than one parallel segment is set at the decoder parameters, the video is split at its
+// keyframes into segments. These segments are decoded concurrently at an own thread pool, each with an
+// independent decoder, and merged back in order of their frame numbers. Segments are decoded in chunks
+// that share the free space of the buffer, so segments could be larger than the buffer. Frames are
+// numbered by their presentation timestamps ; videos without unique timestamps are decoded sequentially.
+//
+// If frames are sampled (see 'sampling_parameters'), only the sampled frames are converted and
+// delivered. They are numbered without gaps. Segments are not decoded in parallel in this case.
+//
+// If a range is set at the decoder parameters, the source seeks to the start of the range and finishes
+// at its end. The first frame of the range gets the number 0.
+//
+// If packets are forwarded (see 'decoder_parameters'), each frame decoded sequentially gets the
+// compressed packet it was decoded from, so a sink could write unmodified GOPs without encoding them.
+//
 template<typename Image>
 class file : public boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>
 {
 public:
-    file(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler, std::size_t max_frames_read_buffer);
+    file(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler, std::size_t max_frames_read_buffer, decoder_parameters decoder = decoder_parameters(), std::shared_ptr<memory_budget> memory_budget = nullptr);
 
     file(file const &) = delete;
     file(file &&) = delete;
@@ -56,10 +75,17 @@ public:
 
     void next(std::size_t context_id, std::size_t max_new_data);
 
-private:    
+private:
+    void decode_segments(std::size_t context_id);
+
     // amount of frames that will be (tried to) read from video file at once
     std::size_t m_max_frames_read_buffer;
 
+    decoder_parameters m_decoder;
+
+    // memory budget shared with the other stages of the pipeline (optional)
+    std::shared_ptr<memory_budget> m_memory_budget;
+
     struct processing_context;
     std::map<std::size_t, std::shared_ptr<processing_context> > m_contexts;
 };
@@ -67,6 +93,14 @@ private:
 // suppress automatic instantiation of file<> for some types
 extern template class file<cvpg::image_gray_8bit>;
 extern template class file<cvpg::image_rgb_8bit>;
+extern template class file<cvpg::image_yuv420_8bit>;
+
+//
+// Split the video of the given input into 'chunks' consecutive ranges of the same duration. Each frame
+// is part of exactly one range, so the ranges could be processed independently and their results be
+// concatenated in order. Throws if the input could not be opened or its duration is unknown.
+//
+std::vector<range_parameters> split_into_ranges(std::string const & uri, std::size_t chunks);
 
 //
 // Hint: Boost.Asynchronous does not support templated proxies. Becaues the servant itself could
@@ -107,6 +141,23 @@ struct image_rgb_8bit_file_proxy : public boost::asynchronous::servant_proxy<ima
     BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
 };
 
+struct image_yuv420_8bit_file_proxy : public boost::asynchronous::servant_proxy<image_yuv420_8bit_file_proxy, file<cvpg::image_yuv420_8bit>, imageproc::scripting::diagnostics::servant_job>
+{
+    using image_type = cvpg::image_yuv420_8bit;
+
+    template<typename... Args>
+    image_yuv420_8bit_file_proxy(Args... args)
+        : boost::asynchronous::servant_proxy<image_yuv420_8bit_file_proxy, file<cvpg::image_yuv420_8bit>, imageproc::scripting::diagnostics::servant_job>(std::forward<Args>(args)...)
+    {}
+
+    BOOST_ASYNC_POST_MEMBER_LOG(init, "init", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(params, "params", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(finish, "finish", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(process, "process", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
+};
+
 } // namespace cvpg::videoproc::sources
 
 #endif // LIBCVPG_VIDEOPROC_SOURCES_FILE_HPP
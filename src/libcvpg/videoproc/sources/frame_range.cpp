@@ -0,0 +1,65 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/videoproc/sources/frame_range.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace cvpg::videoproc::sources {
+
+bool frame_range::accept(std::int64_t pts)
+{
+    if (pts == frame_timestamps::no_pts)
+    {
+        return true;
+    }
+
+    const bool before_start = start != frame_timestamps::no_pts && pts < start;
+    const bool after_end = end != frame_timestamps::no_pts && pts >= end;
+
+    end_reached |= after_end;
+
+    return !before_start && !after_end;
+}
+
+frame_range frame_range::create(range_parameters const & range, double framerate, double time_base, std::int64_t first)
+{
+    frame_range result;
+
+    // positions of the range in seconds
+    const double start = range.unit == range_unit::frames ? range.start / framerate : range.start;
+    const double end = range.unit == range_unit::frames ? range.end / framerate : range.end;
+
+    if (range.start > 0.0)
+    {
+        result.start = first + static_cast<std::int64_t>(std::llround(start / time_base));
+    }
+
+    if (range.end >= 0.0)
+    {
+        result.end = first + static_cast<std::int64_t>(std::llround(end / time_base));
+    }
+
+    return result;
+}
+
+std::vector<range_parameters> split_range(double duration, std::size_t chunks)
+{
+    chunks = std::max<std::size_t>(chunks, 1);
+
+    std::vector<range_parameters> ranges(chunks);
+
+    for (std::size_t i = 0; i < chunks; ++i)
+    {
+        ranges[i].unit = range_unit::seconds;
+        ranges[i].start = duration * static_cast<double>(i) / static_cast<double>(chunks);
+
+        // the last range is read until the end, so no frame is lost by an inexact duration
+        ranges[i].end = (i + 1 < chunks) ? duration * static_cast<double>(i + 1) / static_cast<double>(chunks) : -1.0;
+    }
+
+    return ranges;
+}
+
+} // namespace cvpg::videoproc::sources
@@ -0,0 +1,42 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_SOURCES_FRAME_RANGE_HPP
+#define LIBCVPG_VIDEOPROC_SOURCES_FRAME_RANGE_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <libcvpg/videoproc/frame.hpp>
+#include <libcvpg/videoproc/sources/range_parameters.hpp>
+
+namespace cvpg::videoproc::sources {
+
+//
+// Presentation timestamps of the first frame and after the last frame read from a video, i.e. the
+// frames of the range [start, end). An unknown start or end doesn't limit the range.
+//
+struct frame_range
+{
+    std::int64_t start = frame_timestamps::no_pts;
+    std::int64_t end = frame_timestamps::no_pts;
+
+    // set as soon as a frame at or after the end is checked
+    bool end_reached = false;
+
+    // check if a frame with the given presentation timestamp is part of the range ; frames without a
+    // timestamp are always part of it
+    bool accept(std::int64_t pts);
+
+    // create the range of a part of a stream with the given frame rate and time base (in seconds) ;
+    // 'first' is the presentation timestamp of the start of the stream
+    static frame_range create(range_parameters const & range, double framerate, double time_base, std::int64_t first = 0);
+};
+
+// split a video of the given duration (in seconds) into consecutive ranges ; each range ends where the
+// next one starts and the last range is read until the end of the video
+std::vector<range_parameters> split_range(double duration, std::size_t chunks);
+
+} // namespace cvpg::videoproc::sources
+
+#endif // LIBCVPG_VIDEOPROC_SOURCES_FRAME_RANGE_HPP
@@ -0,0 +1,129 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/videoproc/sources/frame_sampler.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace cvpg::videoproc::sources {
+
+frame_sampler::frame_sampler(sampling_parameters parameters, double framerate)
+    : m_parameters(std::move(parameters))
+    , m_framerate(framerate > 0.0 ? framerate : 25.0)
+    , m_interval(0.0)
+{
+    switch (m_parameters.mode)
+    {
+        case sampling_mode::every_nth:
+            m_interval = m_parameters.every_nth > 1 ? static_cast<double>(m_parameters.every_nth) / m_framerate : 0.0;
+            break;
+
+        case sampling_mode::fps:
+            m_interval = (m_parameters.fps > 0.0 && m_parameters.fps < m_framerate) ? 1.0 / m_parameters.fps : 0.0;
+            break;
+
+        case sampling_mode::all:
+        case sampling_mode::keyframes:
+            break;
+    }
+}
+
+bool frame_sampler::enabled() const
+{
+    return m_interval > 0.0 || keyframes_only();
+}
+
+bool frame_sampler::keyframes_only() const
+{
+    return m_parameters.mode == sampling_mode::keyframes;
+}
+
+bool frame_sampler::discard_non_reference() const
+{
+    // skipping non-reference frames only shifts the sampling as long as the decoded frames are not further
+    // apart than the interval ; e.g. an IBBP stream sampled at every 2nd frame would end at every 3rd frame
+    const double tolerance = 0.5 / m_framerate;
+
+    return m_interval * m_framerate >= 2.0 && m_max_gap <= m_interval + tolerance;
+}
+
+std::int64_t frame_sampler::sampled_frames(std::int64_t frames) const
+{
+    if (keyframes_only())
+    {
+        return 0;
+    }
+
+    if (m_interval <= 0.0 || frames <= 0)
+    {
+        return frames;
+    }
+
+    return static_cast<std::int64_t>(std::ceil(static_cast<double>(frames) / (m_interval * m_framerate)));
+}
+
+bool frame_sampler::accept(double seconds)
+{
+    ++m_frames;
+
+    if (m_interval <= 0.0)
+    {
+        ++m_accepted;
+
+        return true;
+    }
+
+    // timestamps are jittering by less than half a frame
+    const double tolerance = 0.5 / m_framerate;
+
+    if (m_started && seconds + tolerance < m_last)
+    {
+        reset();
+    }
+    else if (m_started)
+    {
+        m_max_gap = std::max(m_max_gap, seconds - m_last);
+    }
+
+    m_last = seconds;
+
+    if (!m_started || seconds + tolerance >= m_next_due)
+    {
+        // don't catch up after a gap in the stream
+        m_next_due = (m_started && m_next_due + m_interval > seconds) ? m_next_due + m_interval : seconds + m_interval;
+        m_started = true;
+
+        ++m_accepted;
+
+        return true;
+    }
+
+    ++m_skipped;
+
+    return false;
+}
+
+bool frame_sampler::accept()
+{
+    return accept(static_cast<double>(m_frames) / m_framerate);
+}
+
+void frame_sampler::reset()
+{
+    m_started = false;
+    m_next_due = 0.0;
+    m_last = 0.0;
+}
+
+std::size_t frame_sampler::accepted() const
+{
+    return m_accepted;
+}
+
+std::size_t frame_sampler::skipped() const
+{
+    return m_skipped;
+}
+
+} // namespace cvpg::videoproc::sources
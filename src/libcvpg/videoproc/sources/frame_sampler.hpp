@@ -0,0 +1,74 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_SOURCES_FRAME_SAMPLER_HPP
+#define LIBCVPG_VIDEOPROC_SOURCES_FRAME_SAMPLER_HPP
+
+#include <cstdint>
+
+#include <libcvpg/videoproc/sources/sampling_parameters.hpp>
+
+namespace cvpg::videoproc::sources {
+
+//
+// A frame sampler decides which decoded frames of a stream are passed to the next stage. Frames are
+// sampled by their presentation time, so frames discarded by the decoder (e.g. non-reference frames)
+// only shift the sampling to the next decoded frame. If the presentation time goes backwards (e.g.
+// after a reconnect) the sampling starts again.
+//
+// Frames have to be passed in presentation order.
+//
+class frame_sampler
+{
+public:
+    explicit frame_sampler(sampling_parameters parameters = sampling_parameters(), double framerate = 25.0);
+
+    // check if frames are skipped at all
+    bool enabled() const;
+
+    // check if only keyframes have to be decoded
+    bool keyframes_only() const;
+
+    // check if non-reference frames could be discarded by the decoder ; turns false as soon as decoded frames
+    // are further apart than the interval (e.g. more non-reference frames in a row than the interval)
+    bool discard_non_reference() const;
+
+    // estimated amount of sampled frames of a stream with the given amount of frames ; 0 if unknown
+    std::int64_t sampled_frames(std::int64_t frames) const;
+
+    // check if the frame with the given presentation time (in seconds) is sampled
+    bool accept(double seconds);
+
+    // check if the next frame is sampled if its presentation time is unknown
+    bool accept();
+
+    // start the sampling again
+    void reset();
+
+    std::size_t accepted() const;
+    std::size_t skipped() const;
+
+private:
+    sampling_parameters m_parameters;
+
+    double m_framerate;
+
+    // time between sampled frames in seconds ; 0 if all decoded frames are sampled
+    double m_interval;
+
+    bool m_started = false;
+
+    double m_next_due = 0.0;
+    double m_last = 0.0;
+
+    // longest time between two consecutive decoded frames in seconds
+    double m_max_gap = 0.0;
+
+    std::size_t m_frames = 0;
+    std::size_t m_accepted = 0;
+    std::size_t m_skipped = 0;
+};
+
+} // namespace cvpg::videoproc::sources
+
+#endif // LIBCVPG_VIDEOPROC_SOURCES_FRAME_SAMPLER_HPP
@@ -0,0 +1,44 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_SOURCES_LIVE_PARAMETERS_HPP
+#define LIBCVPG_VIDEOPROC_SOURCES_LIVE_PARAMETERS_HPP
+
+#include <chrono>
+#include <cstdint>
+
+namespace cvpg::videoproc::sources {
+
+// frames that could be dropped by a live source if the pipeline falls behind
+enum class drop_policy : std::uint8_t
+{
+    // all packets are decoded, stale decoded frames are dropped
+    frames,
+
+    // like 'frames', but non-reference frames are skipped by the decoder while falling behind ; packets
+    // marked as disposable by the demuxer are not even passed to the decoder
+    non_reference,
+
+    // while falling behind all packets are skipped until the next keyframe
+    keyframes
+};
+
+//
+// Parameters of the live mode of a source stage. In live mode the input is read at the pace of the
+// stream, independent of the later stages. Frames that can't be passed to the next stage within the
+// maximum latency are dropped, so the output stays real-time if the pipeline is overloaded.
+//
+struct live_parameters
+{
+    // enable the live mode ; if disabled, every frame is passed to the next stage
+    bool enabled = false;
+
+    // maximum time between the capture of a frame (estimated from its timestamp) and passing it to the next stage
+    std::chrono::milliseconds max_latency = std::chrono::milliseconds(500);
+
+    drop_policy policy = drop_policy::frames;
+};
+
+} // namespace cvpg::videoproc::sources
+
+#endif // LIBCVPG_VIDEOPROC_SOURCES_LIVE_PARAMETERS_HPP
@@ -0,0 +1,146 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/videoproc/sources/packet_forwarder.hpp>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+namespace cvpg::videoproc::sources {
+
+packet_forwarder::~packet_forwarder()
+{
+    av_bsf_free(&m_bsf);
+    av_packet_free(&m_filtered);
+}
+
+bool packet_forwarder::open(AVCodecParameters const * codec_parameters, AVRational time_base)
+{
+    m_codec_id = codec_parameters->codec_id;
+
+    m_filtered = av_packet_alloc();
+
+    if (m_filtered == nullptr)
+    {
+        return false;
+    }
+
+    // a first byte 1 of the extra data is the configuration record of length prefixed packets
+    const bool length_prefixed = codec_parameters->extradata != nullptr && codec_parameters->extradata_size > 0 && codec_parameters->extradata[0] == 1;
+
+    char const * filter_name = nullptr;
+
+    if (length_prefixed && m_codec_id == AVCodecID::AV_CODEC_ID_H264)
+    {
+        filter_name = "h264_mp4toannexb";
+    }
+    else if (length_prefixed && m_codec_id == AVCodecID::AV_CODEC_ID_HEVC)
+    {
+        filter_name = "hevc_mp4toannexb";
+    }
+
+    if (filter_name == nullptr)
+    {
+        // packets are used as they are
+        return true;
+    }
+
+    AVBitStreamFilter const * filter = av_bsf_get_by_name(filter_name);
+
+    if (filter == nullptr || av_bsf_alloc(filter, &m_bsf) < 0)
+    {
+        return false;
+    }
+
+    if (avcodec_parameters_copy(m_bsf->par_in, codec_parameters) < 0)
+    {
+        return false;
+    }
+
+    m_bsf->time_base_in = time_base;
+
+    return av_bsf_init(m_bsf) >= 0;
+}
+
+void packet_forwarder::add(AVPacket const * packet)
+{
+    if (m_bsf == nullptr)
+    {
+        keep(packet);
+
+        return;
+    }
+
+    if (av_packet_ref(m_filtered, packet) < 0 || av_bsf_send_packet(m_bsf, m_filtered) < 0)
+    {
+        av_packet_unref(m_filtered);
+
+        return;
+    }
+
+    while (av_bsf_receive_packet(m_bsf, m_filtered) >= 0)
+    {
+        keep(m_filtered);
+
+        av_packet_unref(m_filtered);
+    }
+}
+
+std::shared_ptr<source_packet const> packet_forwarder::take(std::int64_t pts)
+{
+    if (pts == AV_NOPTS_VALUE)
+    {
+        return nullptr;
+    }
+
+    auto it = m_packets.find(pts);
+
+    if (it == m_packets.end())
+    {
+        return nullptr;
+    }
+
+    auto packet = std::move(it->second);
+
+    m_packets.erase(m_packets.begin(), ++it);
+
+    return packet;
+}
+
+std::size_t packet_forwarder::pending() const
+{
+    return m_packets.size();
+}
+
+void packet_forwarder::keep(AVPacket const * packet)
+{
+    if ((packet->flags & AV_PKT_FLAG_KEY) != 0)
+    {
+        // a keyframe starts a new GOP
+        m_gop += m_started ? 1 : 0;
+        m_index = 0;
+
+        m_started = true;
+    }
+
+    // packets before the first keyframe or without a timestamp could not be used
+    if (!m_started || packet->pts == AV_NOPTS_VALUE)
+    {
+        ++m_index;
+
+        return;
+    }
+
+    auto source = std::make_shared<source_packet>();
+    source->codec_id = m_codec_id;
+    source->gop = m_gop;
+    source->index = m_index++;
+    source->pts = packet->pts;
+    source->dts = packet->dts == AV_NOPTS_VALUE ? packet->pts : packet->dts;
+    source->data.assign(packet->data, packet->data + packet->size);
+
+    m_packets[packet->pts] = std::move(source);
+}
+
+} // namespace cvpg::videoproc::sources
@@ -0,0 +1,71 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_SOURCES_PACKET_FORWARDER_HPP
+#define LIBCVPG_VIDEOPROC_SOURCES_PACKET_FORWARDER_HPP
+
+#include <cstdint>
+#include <map>
+#include <memory>
+
+#include <libcvpg/videoproc/frame.hpp>
+
+struct AVBSFContext;
+struct AVCodecParameters;
+struct AVPacket;
+struct AVRational;
+
+namespace cvpg::videoproc::sources {
+
+//
+// Forwards the compressed packets of a video stream to the frames decoded from them. Packets are kept
+// by their presentation timestamp until the decoder outputs the frame of a packet. H.264 and H.265
+// packets of MP4 like containers are converted to Annex B, so the packets of a GOP could be written
+// one after another to an elementary stream.
+//
+class packet_forwarder
+{
+public:
+    packet_forwarder() = default;
+
+    packet_forwarder(packet_forwarder const &) = delete;
+    packet_forwarder(packet_forwarder &&) = delete;
+
+    packet_forwarder & operator=(packet_forwarder const &) = delete;
+    packet_forwarder & operator=(packet_forwarder &&) = delete;
+
+    ~packet_forwarder();
+
+    // prepare the forwarding of the packets of a stream with the given codec parameters and time base
+    bool open(AVCodecParameters const * codec_parameters, AVRational time_base);
+
+    // add a packet read from the video stream in decode order
+    void add(AVPacket const * packet);
+
+    // take the packet of the frame with the given presentation timestamp ; packets of frames before
+    // this one were dropped (e.g. by sampling) and are released
+    std::shared_ptr<source_packet const> take(std::int64_t pts);
+
+    // amount of packets not taken yet
+    std::size_t pending() const;
+
+private:
+    void keep(AVPacket const * packet);
+
+    int m_codec_id = 0;
+
+    AVBSFContext * m_bsf = nullptr;
+    AVPacket * m_filtered = nullptr;
+
+    // number of the current GOP and position of the next packet inside of it
+    std::size_t m_gop = 0;
+    std::size_t m_index = 0;
+
+    bool m_started = false;
+
+    std::map<std::int64_t, std::shared_ptr<source_packet const> > m_packets;
+};
+
+} // namespace cvpg::videoproc::sources
+
+#endif // LIBCVPG_VIDEOPROC_SOURCES_PACKET_FORWARDER_HPP
@@ -0,0 +1,226 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/videoproc/sources/pattern_generator.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+namespace {
+
+struct rgb
+{
+    std::uint8_t r = 0;
+    std::uint8_t g = 0;
+    std::uint8_t b = 0;
+};
+
+// full range BT.601 coefficients scaled by 256 ; the offset keeps the sums of the chroma values positive
+std::uint8_t luma(rgb c)
+{
+    return static_cast<std::uint8_t>((77 * c.r + 150 * c.g + 29 * c.b) >> 8);
+}
+
+std::uint8_t chroma_u(rgb c)
+{
+    return static_cast<std::uint8_t>((-43 * c.r - 85 * c.g + 128 * c.b + 32768) >> 8);
+}
+
+std::uint8_t chroma_v(rgb c)
+{
+    return static_cast<std::uint8_t>((128 * c.r - 107 * c.g - 21 * c.b + 32768) >> 8);
+}
+
+std::uint64_t splitmix64(std::uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+
+    return x ^ (x >> 31);
+}
+
+// position moving back and forth between 0 and 'range'
+std::int64_t bounce(std::int64_t position, std::int64_t range)
+{
+    if (range <= 0)
+    {
+        return 0;
+    }
+
+    const std::int64_t p = position % (2 * range);
+
+    return p <= range ? p : 2 * range - p;
+}
+
+//
+// Set all pixels of an image to the colors returned by 'color(x, y)'.
+//
+template<typename Image, typename Color>
+void fill(Image & image, Color && color)
+{
+    if constexpr (std::is_same_v<Image, cvpg::image_yuv420_8bit>)
+    {
+        std::uint8_t * y_plane = image.data(0).get();
+
+        for (std::uint32_t y = 0; y < image.height(); ++y)
+        {
+            std::uint8_t * line = y_plane + static_cast<std::size_t>(y) * image.stride(0);
+
+            for (std::uint32_t x = 0; x < image.width(); ++x)
+            {
+                line[x] = luma(color(x, y));
+            }
+        }
+
+        std::uint8_t * u_plane = image.data(1).get();
+        std::uint8_t * v_plane = image.data(2).get();
+
+        for (std::uint32_t y = 0; y < image.plane_height(1); ++y)
+        {
+            std::uint8_t * u_line = u_plane + static_cast<std::size_t>(y) * image.stride(1);
+            std::uint8_t * v_line = v_plane + static_cast<std::size_t>(y) * image.stride(2);
+
+            for (std::uint32_t x = 0; x < image.plane_width(1); ++x)
+            {
+                const rgb c = color(2 * x, 2 * y);
+
+                u_line[x] = chroma_u(c);
+                v_line[x] = chroma_v(c);
+            }
+        }
+    }
+    else
+    {
+        constexpr std::size_t channels = std::tuple_size<typename Image::channel_array_type>::value;
+
+        // lines of the image are 'width + padding' pixels apart
+        const std::size_t stride = image.width() + image.padding();
+
+        for (std::uint32_t y = 0; y < image.height(); ++y)
+        {
+            for (std::uint32_t x = 0; x < image.width(); ++x)
+            {
+                const rgb c = color(x, y);
+                const std::size_t pos = y * stride + x;
+
+                if constexpr (channels == 1)
+                {
+                    image.data(0).get()[pos] = luma(c);
+                }
+                else if constexpr (channels == 3)
+                {
+                    image.data(0).get()[pos] = c.r;
+                    image.data(1).get()[pos] = c.g;
+                    image.data(2).get()[pos] = c.b;
+                }
+            }
+        }
+    }
+}
+
+}
+
+namespace cvpg::videoproc::sources {
+
+template<typename Image>
+pattern_generator<Image>::pattern_generator(synthetic_parameters parameters)
+    : m_parameters(std::move(parameters))
+{}
+
+template<typename Image>
+Image pattern_generator<Image>::generate(std::int64_t frame_number) const
+{
+    const std::uint32_t width = m_parameters.width;
+    const std::uint32_t height = m_parameters.height;
+
+    Image image(width, height);
+
+    switch (m_parameters.pattern)
+    {
+        case synthetic_pattern::bars:
+        {
+            static constexpr rgb bars[8] =
+            {
+                { 255, 255, 255 }, { 255, 255, 0 }, { 0, 255, 255 }, { 0, 255, 0 },
+                { 255, 0, 255 }, { 255, 0, 0 }, { 0, 0, 255 }, { 0, 0, 0 }
+            };
+
+            fill(image, [width](std::uint32_t x, std::uint32_t /*y*/){ return bars[static_cast<std::size_t>(x) * 8 / width]; });
+
+            break;
+        }
+
+        case synthetic_pattern::gradient:
+        {
+            const auto n = static_cast<std::uint32_t>(frame_number);
+
+            fill(image,
+                 [n](std::uint32_t x, std::uint32_t y)
+                 {
+                     return rgb{ static_cast<std::uint8_t>(x + n), static_cast<std::uint8_t>(y + n), static_cast<std::uint8_t>((x + y) / 2 + n) };
+                 });
+
+            break;
+        }
+
+        case synthetic_pattern::moving_shapes:
+        {
+            // a box moving horizontally and a circle moving vertically, both bouncing at the borders
+            const std::int64_t box = std::max<std::int64_t>(std::min(width, height) / 8, 1);
+            const std::int64_t box_x = bounce(frame_number * 4, static_cast<std::int64_t>(width) - box);
+            const std::int64_t box_y = height / 4;
+
+            const std::int64_t radius = std::max<std::int64_t>(std::min(width, height) / 12, 1);
+            const std::int64_t circle_x = static_cast<std::int64_t>(width) * 3 / 4;
+            const std::int64_t circle_y = radius + bounce(frame_number * 3, static_cast<std::int64_t>(height) - 2 * radius);
+
+            fill(image,
+                 [=](std::uint32_t x, std::uint32_t y)
+                 {
+                     const std::int64_t dx = static_cast<std::int64_t>(x) - circle_x;
+                     const std::int64_t dy = static_cast<std::int64_t>(y) - circle_y;
+
+                     if (dx * dx + dy * dy <= radius * radius)
+                     {
+                         return rgb{ 220, 40, 40 };
+                     }
+
+                     if (x >= box_x && x < box_x + box && y >= box_y && y < box_y + box)
+                     {
+                         return rgb{ 255, 255, 255 };
+                     }
+
+                     return rgb{ 128, 128, 128 };
+                 });
+
+            break;
+        }
+
+        case synthetic_pattern::noise:
+        {
+            const std::uint64_t key = splitmix64((static_cast<std::uint64_t>(m_parameters.seed) << 32) ^ static_cast<std::uint64_t>(frame_number));
+
+            fill(image,
+                 [key, width](std::uint32_t x, std::uint32_t y)
+                 {
+                     const std::uint64_t h = splitmix64(key + static_cast<std::uint64_t>(y) * width + x);
+
+                     return rgb{ static_cast<std::uint8_t>(h), static_cast<std::uint8_t>(h >> 8), static_cast<std::uint8_t>(h >> 16) };
+                 });
+
+            break;
+        }
+    }
+
+    return image;
+}
+
+// manual instantiation of pattern_generator<> for some types
+template class pattern_generator<cvpg::image_gray_8bit>;
+template class pattern_generator<cvpg::image_rgb_8bit>;
+template class pattern_generator<cvpg::image_yuv420_8bit>;
+
+} // namespace cvpg::videoproc::sources
@@ -0,0 +1,40 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_SOURCES_PATTERN_GENERATOR_HPP
+#define LIBCVPG_VIDEOPROC_SOURCES_PATTERN_GENERATOR_HPP
+
+#include <cstdint>
+
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/videoproc/sources/synthetic_parameters.hpp>
+
+namespace cvpg::videoproc::sources {
+
+//
+// A pattern generator creates the images of a synthetic video. The image of a frame is created from
+// the parameters and the number of the frame only, so frames could be generated in any order.
+//
+// Colors are converted to grayscale and YUV images with the full range BT.601 coefficients. The
+// chroma planes of YUV 4:2:0 images take the color of the top left pixel of each 2x2 block.
+//
+template<typename Image>
+class pattern_generator
+{
+public:
+    explicit pattern_generator(synthetic_parameters parameters = synthetic_parameters());
+
+    Image generate(std::int64_t frame_number) const;
+
+private:
+    synthetic_parameters m_parameters;
+};
+
+// suppress automatic instantiation of pattern_generator<> for some types
+extern template class pattern_generator<cvpg::image_gray_8bit>;
+extern template class pattern_generator<cvpg::image_rgb_8bit>;
+extern template class pattern_generator<cvpg::image_yuv420_8bit>;
+
+} // namespace cvpg::videoproc::sources
+
+#endif // LIBCVPG_VIDEOPROC_SOURCES_PATTERN_GENERATOR_HPP
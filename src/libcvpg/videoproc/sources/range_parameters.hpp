@@ -0,0 +1,42 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_SOURCES_RANGE_PARAMETERS_HPP
+#define LIBCVPG_VIDEOPROC_SOURCES_RANGE_PARAMETERS_HPP
+
+namespace cvpg::videoproc::sources {
+
+// unit of the positions of a range
+enum class range_unit
+{
+    // seconds since the start of the stream
+    seconds,
+
+    // frames since the start of the stream ; converted to seconds by the frame rate of the stream
+    frames
+};
+
+//
+// A part of a video that is read by a source stage. The source seeks to the keyframe before the start
+// and drops all decoded frames before the start, so the first frame of the range is the first frame
+// delivered. Frames are selected by their presentation timestamps.
+//
+struct range_parameters
+{
+    range_unit unit = range_unit::seconds;
+
+    // position of the first frame to read
+    double start = 0.0;
+
+    // position after the last frame to read (negative = until the end of the video)
+    double end = -1.0;
+
+    bool enabled() const
+    {
+        return start > 0.0 || end >= 0.0;
+    }
+};
+
+} // namespace cvpg::videoproc::sources
+
+#endif // LIBCVPG_VIDEOPROC_SOURCES_RANGE_PARAMETERS_HPP
@@ -3,7 +3,15 @@
 
 #include <libcvpg/videoproc/sources/rtsp.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <deque>
+#include <thread>
+#include <type_traits>
+
+#include <boost/lockfree/spsc_queue.hpp>
 
 extern "C" {
 #include <libavcodec/avcodec.h>
@@ -16,14 +24,410 @@ extern "C" {
 }
 
 #include <libcvpg/videoproc/stage_data_handler.hpp>
+#include <libcvpg/videoproc/sources/decoded_planes.hpp>
+#include <libcvpg/videoproc/sources/frame_sampler.hpp>
+
+static_assert(AV_NOPTS_VALUE == cvpg::videoproc::frame_timestamps::no_pts, "unknown timestamps of FFmpeg and of frames differ");
 
 namespace {
 
 #undef av_err2str
 #define av_err2str(errnum) av_make_error_string((char*)__builtin_alloca(AV_ERROR_MAX_STRING_SIZE), AV_ERROR_MAX_STRING_SIZE, errnum)
 
+//
+// Estimates the capture time of frames of a live stream from their timestamps. The first frame is
+// assumed to be captured when it was read. If a frame is read earlier than expected by its timestamp
+// (e.g. because of jitter), all later estimates are moved accordingly.
+//
+struct stream_clock
+{
+    std::int64_t first_pts = AV_NOPTS_VALUE;
+
+    std::chrono::steady_clock::time_point first_read;
+
+    std::chrono::steady_clock::time_point capture_time(std::int64_t pts, AVRational time_base, std::chrono::steady_clock::time_point now)
+    {
+        if (pts == AV_NOPTS_VALUE)
+        {
+            return now;
+        }
+
+        if (first_pts == AV_NOPTS_VALUE)
+        {
+            first_pts = pts;
+            first_read = now;
+
+            return now;
+        }
+
+        auto expected = first_read + std::chrono::microseconds(av_rescale_q(pts - first_pts, time_base, AVRational{ 1, 1000000 }));
+
+        if (expected > now)
+        {
+            first_read -= expected - now;
+            expected = now;
+        }
+
+        return expected;
+    }
+};
+
+// a packet received by the receiving thread
+struct received_packet
+{
+    AVPacket * packet = nullptr;
+
+    // first packet after a reconnect ; the decoder has to drop all references to previous packets
+    bool discontinuity = false;
+};
+
+//
+// Receives the packets of a stream at a separate thread, so network jitter doesn't stall the decoder
+// and vice versa. Packets are passed to the decoder by a lock-free single producer single consumer
+// queue. If the decoder runs out of packets, it is notified as soon as new packets arrive.
+//
+class packet_receiver
+{
+public:
+    enum class state
+    {
+        available,  // a packet was taken from the queue
+        pending,    // no packet available yet ; 'notify' will be called when packets arrive
+        finished    // no more packets will arrive
+    };
+
+    ~packet_receiver()
+    {
+        stop();
+
+        received_packet received;
+
+        while (m_packets && m_packets->pop(received))
+        {
+            av_packet_free(&received.packet);
+        }
+    }
+
+    void start(std::size_t queue_size, std::function<void()> notify, std::function<void(packet_receiver &)> receive)
+    {
+        m_packets = std::make_unique<boost::lockfree::spsc_queue<received_packet> >(std::max<std::size_t>(queue_size, 1));
+        m_notify = std::move(notify);
+
+        m_thread = std::thread(
+            [this, receive = std::move(receive)]()
+            {
+                receive(*this);
+
+                m_finished.store(true, std::memory_order_release);
+
+                signal();
+            }
+        );
+    }
+
+    bool started() const
+    {
+        return m_thread.joinable();
+    }
+
+    void stop()
+    {
+        m_stop.store(true, std::memory_order_release);
+
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+    }
+
+    bool stopped() const
+    {
+        return m_stop.load(std::memory_order_acquire);
+    }
+
+    // pointer to the stop flag, used to interrupt blocking calls of FFmpeg
+    std::atomic<bool> * stop_flag()
+    {
+        return &m_stop;
+    }
+
+    // called by the receiving thread ; waits while the queue is full
+    bool push(received_packet received)
+    {
+        while (!m_packets->push(received))
+        {
+            if (stopped())
+            {
+                return false;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        signal();
+
+        return true;
+    }
+
+    // called by the decoder
+    state pop(received_packet & received)
+    {
+        while (true)
+        {
+            if (m_packets->pop(received))
+            {
+                return state::available;
+            }
+
+            if (m_finished.load(std::memory_order_acquire))
+            {
+                // packets could be pushed just before the receiving thread finished
+                return m_packets->pop(received) ? state::available : state::finished;
+            }
+
+            m_waiting.store(true, std::memory_order_release);
+
+            // check again, packets could have arrived before the waiting flag was set
+            if (m_packets->read_available() == 0 && !m_finished.load(std::memory_order_acquire))
+            {
+                return state::pending;
+            }
+
+            if (!m_waiting.exchange(false, std::memory_order_acq_rel))
+            {
+                // the receiving thread already notified the decoder
+                return state::pending;
+            }
+        }
+    }
+
+    // error of the receiving thread ; valid after 'pop' returned 'finished'
+    std::string error;
+
+private:
+    void signal()
+    {
+        if (m_waiting.exchange(false, std::memory_order_acq_rel))
+        {
+            m_notify();
+        }
+    }
+
+    std::unique_ptr<boost::lockfree::spsc_queue<received_packet> > m_packets;
+
+    std::function<void()> m_notify;
+
+    std::thread m_thread;
+
+    std::atomic<bool> m_stop = false;
+    std::atomic<bool> m_finished = false;
+    std::atomic<bool> m_waiting = false;
+};
+
+int interrupt_callback(void * opaque)
+{
+    return static_cast<std::atomic<bool> *>(opaque)->load(std::memory_order_acquire) ? 1 : 0;
+}
+
+//
+// Open a stream with the given connection parameters and read the information of its streams. Blocking
+// calls are interrupted if the flag 'stop' is set. Returns 'nullptr' on error.
+//
+AVFormatContext * open_stream(std::string const & uri, cvpg::videoproc::sources::rtsp_parameters const & parameters, std::atomic<bool> * stop)
+{
+    AVFormatContext * format_context = avformat_alloc_context();
+
+    if (format_context == nullptr)
+    {
+        return nullptr;
+    }
+
+    format_context->interrupt_callback.callback = &interrupt_callback;
+    format_context->interrupt_callback.opaque = stop;
+
+    AVDictionary * options = nullptr;
+
+    if (!parameters.transport.empty())
+    {
+        av_dict_set(&options, "rtsp_transport", parameters.transport.c_str(), 0);
+    }
+
+    if (parameters.buffer_size > 0)
+    {
+        av_dict_set_int(&options, "buffer_size", static_cast<std::int64_t>(parameters.buffer_size), 0);
+    }
+
+    if (parameters.reorder_queue_size >= 0)
+    {
+        av_dict_set_int(&options, "reorder_queue_size", parameters.reorder_queue_size, 0);
+    }
+
+    if (parameters.timeout.count() > 0)
+    {
+        // socket timeout in microseconds ; renamed at FFmpeg 5
+#if LIBAVFORMAT_VERSION_MAJOR >= 59
+        av_dict_set_int(&options, "timeout", std::chrono::duration_cast<std::chrono::microseconds>(parameters.timeout).count(), 0);
+#else
+        av_dict_set_int(&options, "stimeout", std::chrono::duration_cast<std::chrono::microseconds>(parameters.timeout).count(), 0);
+#endif
+    }
+
+    if (parameters.low_latency)
+    {
+        format_context->flags |= AVFMT_FLAG_NOBUFFER;
+        format_context->max_delay = 0;
+    }
+
+    // options not supported by the protocol of 'uri' are left at 'options' and ignored
+    const int res = avformat_open_input(&format_context, uri.c_str(), nullptr, &options);
+
+    av_dict_free(&options);
+
+    if (res < 0)
+    {
+        // 'format_context' is already freed on failure
+        return nullptr;
+    }
+
+    if (avformat_find_stream_info(format_context, nullptr) < 0)
+    {
+        avformat_close_input(&format_context);
+
+        return nullptr;
+    }
+
+    return format_context;
+}
+
+//
+// Receive the packets of the video stream 'stream_index' until the stream ends, the connection is lost
+// (and can't be established again) or the receiver is stopped. The timestamps of all packets are given
+// in 'time_base', also after a reconnect.
+//
+void receive_packets(packet_receiver & receiver,
+                     AVFormatContext *& format_context,
+                     std::string const & uri,
+                     cvpg::videoproc::sources::rtsp_parameters const & parameters,
+                     int stream_index,
+                     AVRational time_base)
+{
+    AVPacket * packet = av_packet_alloc();
+
+    if (packet == nullptr)
+    {
+        receiver.error = "failed to allocate memory for packet";
+
+        return;
+    }
+
+    AVRational stream_time_base = format_context->streams[stream_index]->time_base;
+
+    bool discontinuity = false;
+
+    while (!receiver.stopped())
+    {
+        const int res = av_read_frame(format_context, packet);
+
+        if (res >= 0)
+        {
+            if (packet->stream_index != stream_index)
+            {
+                av_packet_unref(packet);
+
+                continue;
+            }
+
+            av_packet_rescale_ts(packet, stream_time_base, time_base);
+
+            received_packet received;
+            received.packet = av_packet_alloc();
+            received.discontinuity = discontinuity;
+
+            if (received.packet == nullptr)
+            {
+                receiver.error = "failed to allocate memory for packet";
+
+                break;
+            }
+
+            av_packet_move_ref(received.packet, packet);
+
+            if (!receiver.push(received))
+            {
+                av_packet_free(&received.packet);
+
+                break;
+            }
+
+            discontinuity = false;
+
+            continue;
+        }
+
+        if (receiver.stopped())
+        {
+            break;
+        }
+
+        if (parameters.reconnect_attempts == 0)
+        {
+            if (res != AVERROR_EOF)
+            {
+                receiver.error = std::string("failed to read frame (").append(av_err2str(res)).append(")");
+            }
+
+            break;
+        }
+
+        // connection lost or end of stream reached ; try to connect again
+        avformat_close_input(&format_context);
+
+        for (std::size_t attempt = 0; attempt < parameters.reconnect_attempts && format_context == nullptr && !receiver.stopped(); ++attempt)
+        {
+            const auto wake_up = std::chrono::steady_clock::now() + parameters.reconnect_delay;
+
+            while (std::chrono::steady_clock::now() < wake_up && !receiver.stopped())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+
+            format_context = open_stream(uri, parameters, receiver.stop_flag());
+        }
+
+        if (format_context == nullptr)
+        {
+            if (!receiver.stopped())
+            {
+                receiver.error = std::string("lost connection to '").append(uri).append("'");
+            }
+
+            break;
+        }
+
+        stream_index = av_find_best_stream(format_context, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+
+        if (stream_index < 0)
+        {
+            receiver.error = std::string("no video stream after reconnect to '").append(uri).append("'");
+
+            break;
+        }
+
+        stream_time_base = format_context->streams[stream_index]->time_base;
+
+        discontinuity = true;
+    }
+
+    av_packet_free(&packet);
+}
+
+//
+// Decode a packet and append the decoded frames to the given images and their presentation timestamps
+// to the given timestamps. If a sampler is given, frames that are not sampled are dropped before they
+// are converted.
+//
 template<typename Image>
-int decode_packet(AVPacket * packet, AVCodecContext * codec_context, AVFrame * frame, std::vector<Image> & images)
+int decode_packet(AVPacket * packet, AVCodecContext * codec_context, AVFrame * frame, SwsContext *& sws_context, std::vector<Image> & images, std::vector<std::int64_t> & timestamps, cvpg::videoproc::sources::frame_sampler * sampler = nullptr, AVRational time_base = AVRational{ 0, 1 })
 {
     int res = avcodec_send_packet(codec_context, packet);
 
@@ -53,79 +457,128 @@ int decode_packet(AVPacket * packet, AVCodecContext * codec_context, AVFrame * f
             break;
         }
 
-        std::size_t channels = 0;
-        AVPixelFormat pixel_format = AVPixelFormat::AV_PIX_FMT_NONE;
-
-        if constexpr (std::tuple_size<typename Image::channel_array_type>::value == 1)
+        if (sampler != nullptr && sampler->enabled())
         {
-            channels = 1;
-            pixel_format = AVPixelFormat::AV_PIX_FMT_GRAY8;
+            const bool sampled = (frame->best_effort_timestamp != AV_NOPTS_VALUE && time_base.num != 0)
+                               ? sampler->accept(static_cast<double>(frame->best_effort_timestamp) * av_q2d(time_base))
+                               : sampler->accept();
+
+            if (!sampled)
+            {
+                av_frame_unref(frame);
+
+                continue;
+            }
         }
-        else if constexpr (std::tuple_size<typename Image::channel_array_type>::value == 3)
+
+        // unknown timestamps of the decoder and of the frames are the same value
+        timestamps.push_back(frame->best_effort_timestamp);
+
+        if constexpr (std::is_same_v<Image, cvpg::image_yuv420_8bit>)
         {
-            channels = 3;
-            pixel_format = AVPixelFormat::AV_PIX_FMT_RGB24;
+            // YUV 4:2:0 images use the planes of the decoder directly if possible
+            const bool is_yuv420 = frame->format == AVPixelFormat::AV_PIX_FMT_YUV420P || frame->format == AVPixelFormat::AV_PIX_FMT_YUVJ420P;
+
+            if (is_yuv420 && frame->linesize[0] >= frame->width && frame->linesize[1] > 0 && frame->linesize[2] > 0 && cvpg::videoproc::sources::wrap_yuv420_planes(frame, images))
+            {
+                av_frame_unref(frame);
+
+                continue;
+            }
         }
-        else
+        else if constexpr (std::tuple_size<typename Image::channel_array_type>::value == 1)
         {
-            // TODO handle error
-        }
+            // grayscale images use the luma plane of the decoder directly ; limited range luma keeps its
+            // range and is expanded by the consumers of the image
+            if (cvpg::videoproc::sources::has_luma_plane(frame->format) && frame->linesize[0] >= frame->width && cvpg::videoproc::sources::wrap_luma_plane(frame, images))
+            {
+                av_frame_unref(frame);
 
-        Image image(frame->width, frame->height, 0);
+                continue;
+            }
+        }
 
-        // create a SWC context to convert image from source to RGB pixel format
-        auto sws_ctx = sws_getContext(codec_context->width,
-                                      codec_context->height,
-                                      codec_context->pix_fmt,
-                                      image.width(),
-                                      image.height(),
-                                      pixel_format,
-                                      0,
-                                      0,
-                                      0,
-                                      0);
+        Image image(frame->width, frame->height);
 
-        auto raw_data = std::shared_ptr<std::uint8_t>(static_cast<std::uint8_t *>(malloc(image.width() * image.height() * channels)), [](std::uint8_t * ptr){ free(ptr); });
+        AVPixelFormat pixel_format = AVPixelFormat::AV_PIX_FMT_NONE;
 
-        AVFrame * dst = av_frame_alloc();
-        dst->data[0] = raw_data.get();
-        dst->data[1] = nullptr;
-        dst->linesize[0] = image.width() * channels;
-        dst->linesize[1] = 0;
+        // the converted frame is written directly to the channel planes of the image
+        std::uint8_t * dst_data[4] = { nullptr, nullptr, nullptr, nullptr };
+        int dst_linesize[4] = { 0, 0, 0, 0 };
 
-        // perform conversion to RGB raw data
-        sws_scale(sws_ctx,
-                  frame->data,
-                  frame->linesize,
-                  0,
-                  image.height(),
-                  dst->data,
-                  dst->linesize);
+        if constexpr (std::is_same_v<Image, cvpg::image_yuv420_8bit>)
+        {
+            pixel_format = AVPixelFormat::AV_PIX_FMT_YUV420P;
 
-        // convert into cvpg::image format
-        for (std::size_t y = 0; y < image.height(); ++y)
+            for (std::uint8_t p = 0; p < 3; ++p)
+            {
+                dst_data[p] = image.data(p).get();
+                dst_linesize[p] = static_cast<int>(image.stride(p));
+            }
+        }
+        else
         {
-            std::size_t dst_pos = y * image.width();
-            std::size_t src_pos = dst_pos * channels;
+            const int linesize = static_cast<int>(image.width() + image.padding());
 
-            for (std::size_t x = 0; x < image.width(); ++x, ++dst_pos, src_pos += channels)
+            if constexpr (std::tuple_size<typename Image::channel_array_type>::value == 1)
             {
-                if constexpr (std::tuple_size<typename Image::channel_array_type>::value == 1)
-                {
-                    image.data(0).get()[dst_pos] = dst->data[0][src_pos];
-                }
-                else if constexpr (std::tuple_size<typename Image::channel_array_type>::value == 3)
-                {
-                    image.data(0).get()[dst_pos] = dst->data[0][src_pos];
-                    image.data(1).get()[dst_pos] = dst->data[0][src_pos + 1];
-                    image.data(2).get()[dst_pos] = dst->data[0][src_pos + 2];
-                }
+                pixel_format = AVPixelFormat::AV_PIX_FMT_GRAY8;
+
+                dst_data[0] = image.data(0).get();
+                dst_linesize[0] = linesize;
+            }
+            else if constexpr (std::tuple_size<typename Image::channel_array_type>::value == 3)
+            {
+                // planes of GBRP are ordered green, blue, red
+                pixel_format = AVPixelFormat::AV_PIX_FMT_GBRP;
+
+                dst_data[0] = image.data(1).get();
+                dst_data[1] = image.data(2).get();
+                dst_data[2] = image.data(0).get();
+                dst_linesize[0] = linesize;
+                dst_linesize[1] = linesize;
+                dst_linesize[2] = linesize;
+            }
+            else
+            {
+                // TODO handle error
             }
         }
 
-        sws_freeContext(sws_ctx);
+        // the context of the previous frame is reused as long as the frame format doesn't change
+        sws_context = sws_getCachedContext(sws_context,
+                                           frame->width,
+                                           frame->height,
+                                           static_cast<AVPixelFormat>(frame->format),
+                                           image.width(),
+                                           image.height(),
+                                           pixel_format,
+                                           0,
+                                           nullptr,
+                                           nullptr,
+                                           nullptr);
+
+        if (sws_context == nullptr)
+        {
+            av_frame_unref(frame);
+
+            timestamps.pop_back();
+
+            res = AVERROR(EINVAL);
+
+            break;
+        }
+
+        // the range of the decoded frame has precedence over the range of its pixel format
+        cvpg::videoproc::sources::set_source_color_range(sws_context, frame->color_range);
 
-        av_frame_free(&dst);
+        sws_scale(sws_context,
+                  frame->data,
+                  frame->linesize,
+                  0,
+                  frame->height,
+                  dst_data,
+                  dst_linesize);
 
         av_frame_unref(frame);
 
@@ -167,6 +620,9 @@ template<typename Image> struct rtsp<Image>::processing_context
         AVFormatContext * format_context = nullptr;
         AVCodecContext * codec_context = nullptr;
 
+        // context to convert decoded frames to the pixel format of 'Image'
+        SwsContext * sws_context = nullptr;
+
         std::size_t stream_index = 0;
     };
 
@@ -199,13 +655,67 @@ template<typename Image> struct rtsp<Image>::processing_context
 
     callback_info callbacks;
 
+    struct live_info
+    {
+        // reading is driven by the stream itself and not by the next stage
+        bool reading = false;
+
+        // skip all packets until the next keyframe (policy 'keyframes')
+        bool skip_to_keyframe = false;
+
+        // frames skipped by the decoder if the pipeline keeps up ; while falling behind the decoder
+        // skips non-reference frames (policy 'non_reference')
+        AVDiscard skip_frame = AVDISCARD_DEFAULT;
+        bool skipping_non_reference = false;
+
+        stream_clock clock;
+
+        struct pending_frame
+        {
+            Image image;
+
+            std::chrono::steady_clock::time_point captured;
+
+            frame_timestamps timestamps;
+        };
+
+        // decoded frames that are not passed to the stage data handler yet ; they are numbered when passed, so dropped frames leave no gaps
+        std::deque<pending_frame> pending;
+
+        std::size_t frames_dropped = 0;
+    };
+
+    live_info live;
+
+    // receives the packets of the stream ; owns 'video.format_context' while running
+    packet_receiver receiver;
+
+    // selects the decoded frames passed to the next stage
+    frame_sampler sampler;
+
     std::shared_ptr<stage_data_handler<videoproc::frame<Image> > > sdh;
+
+    ~processing_context()
+    {
+        receiver.stop();
+
+        sws_freeContext(video.sws_context);
+
+        avcodec_free_context(&video.codec_context);
+        avformat_close_input(&video.format_context);
+    }
 };
 
 template<typename Image> rtsp<Image>::rtsp(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler,
-                                           std::size_t max_frames_read_buffer)
+                                           std::size_t max_frames_read_buffer,
+                                           rtsp_parameters stream,
+                                           live_parameters live,
+                                           std::shared_ptr<memory_budget> memory_budget)
     : boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>(scheduler)
     , m_max_frames_read_buffer(max_frames_read_buffer)
+    , m_stream(std::move(stream))
+    , m_live(std::move(live))
+    , m_memory_budget(std::move(memory_budget))
     , m_contexts()
 {}
 
@@ -273,15 +783,15 @@ template<typename Image> void rtsp<Image>::init(std::size_t context_id, std::str
             {
                 deliver_done_callback();
             }
-        }
+        },
+        m_memory_budget
     );
 
     m_contexts.insert({ context_id, context });
 
     avformat_network_init();
 
-    context->video.format_context = avformat_alloc_context();
-    avformat_open_input(&context->video.format_context, context->video.uri.c_str(), nullptr, nullptr);
+    context->video.format_context = open_stream(context->video.uri, m_stream, context->receiver.stop_flag());
 
     if (context->video.format_context == nullptr)
     {
@@ -292,8 +802,6 @@ template<typename Image> void rtsp<Image>::init(std::size_t context_id, std::str
 
     context->video.duration = context->video.format_context->duration;
 
-    avformat_find_stream_info(context->video.format_context, nullptr);
-
     AVCodec * codec = nullptr;
     AVCodecParameters * codec_parameters = nullptr;
 
@@ -360,6 +868,34 @@ template<typename Image> void rtsp<Image>::init(std::size_t context_id, std::str
 
     context->frames.pixel_format = context->video.codec_context->pix_fmt;
 
+    if (m_stream.low_latency)
+    {
+        // output frames immediately instead of buffering them for reordering
+        context->video.codec_context->flags |= AV_CODEC_FLAG_LOW_DELAY;
+    }
+
+    {
+        AVStream * stream = context->video.format_context->streams[context->video.stream_index];
+
+        const AVRational framerate = av_guess_frame_rate(context->video.format_context, stream, nullptr);
+
+        context->sampler = frame_sampler(m_stream.sampling, (framerate.num > 0 && framerate.den > 0) ? av_q2d(framerate) : av_q2d(context->video.framerate));
+
+        // frames that are not sampled anyway are skipped by the decoder if possible
+        if (context->sampler.keyframes_only())
+        {
+            context->video.codec_context->skip_frame = AVDISCARD_NONKEY;
+        }
+        else if (context->sampler.discard_non_reference())
+        {
+            context->video.codec_context->skip_frame = AVDISCARD_NONREF;
+        }
+
+        context->live.skip_frame = context->video.codec_context->skip_frame;
+
+        context->video.codec_context->pkt_timebase = stream->time_base;
+    }
+
     if (avcodec_open2(context->video.codec_context, codec, nullptr) < 0)
     {
         avformat_close_input(&context->video.format_context);
@@ -381,6 +917,18 @@ template<typename Image> void rtsp<Image>::init(std::size_t context_id, std::str
         const std::int64_t frames = static_cast<std::int64_t>(static_cast<double>(context->video.format_context->duration) * fps / 1000000.0);
 
         context->video.frames = frames;
+
+        // the frame rate and time base of the source stream are used by later stages (e.g. for encoding)
+        AVStream * stream = context->video.format_context->streams[context->video.stream_index];
+
+        const AVRational framerate = av_guess_frame_rate(context->video.format_context, stream, nullptr);
+
+        if (framerate.num > 0 && framerate.den > 0)
+        {
+            context->video.framerate = framerate;
+        }
+
+        context->video.time_base = stream->time_base;
     }
 
     // start reading packets from stream
@@ -389,11 +937,13 @@ template<typename Image> void rtsp<Image>::init(std::size_t context_id, std::str
     std::map<std::string, std::any> params =
     {
         { "frames.width", context->frames.width },
-        { "frames.height", context->frames.height }
+        { "frames.height", context->frames.height },
+        { "frames.framerate", context->video.framerate },
+        { "frames.time_base", context->video.time_base }
     };
 
     context->callbacks.params(context_id, std::move(params));
-    callbacks.initialized(context_id, context->video.frames);
+    callbacks.initialized(context_id, context->sampler.sampled_frames(context->video.frames));
 }
 
 template<typename Image> void rtsp<Image>::params(std::size_t /*context_id*/, std::map<std::string, std::any> /*p*/)
@@ -415,6 +965,35 @@ template<typename Image> void rtsp<Image>::start(std::size_t context_id)
             return;
         }
 
+        if (!context->receiver.started())
+        {
+            start_receiving(context_id);
+        }
+
+        if (m_live.enabled)
+        {
+            if (!context->live.reading)
+            {
+                context->live.reading = true;
+
+                post_self(
+                    [this, context_id]()
+                    {
+                        read_live(context_id);
+                    },
+                    "sources::rtsp::read_live",
+                    1
+                );
+            }
+            else
+            {
+                // the next stage is ready to receive new data
+                deliver_live(context_id);
+            }
+
+            return;
+        }
+
         // check if input buffer is full
         if (context->sdh->full())
         {
@@ -424,6 +1003,9 @@ template<typename Image> void rtsp<Image>::start(std::size_t context_id)
         std::vector<Image> images;
         images.reserve(m_max_frames_read_buffer);
 
+        std::vector<std::int64_t> timestamps;
+        timestamps.reserve(m_max_frames_read_buffer);
+
         AVFrame * frame = av_frame_alloc();
 
         if (!frame)
@@ -433,92 +1015,416 @@ template<typename Image> void rtsp<Image>::start(std::size_t context_id)
             return;
         }
 
-        AVPacket * packet = av_packet_alloc();
-
-        if (!packet)
+        // decode the received packets to fill the input buffer ; if no packets are available, this function is called again when packets arrive
+        for (std::size_t i = 0; i < context->sdh->free(); /* increment only when really decode */)
         {
-            context->callbacks.failed(context_id, "failed to allocate memory for packet");
+            received_packet received;
 
-            return;
-        }
-        
-        // try to read files to fill a quarter of the input buffer
-        for (auto i = 0; i < context->sdh->free(); /* increment only when really encode */)
-        {
-            int res = av_read_frame(context->video.format_context, packet);
+            const auto state = context->receiver.pop(received);
 
-            if (res < 0)
+            if (state == packet_receiver::state::pending)
             {
-                if (res == AVERROR_EOF)
-                {
-                    context->status.eof_reached = true;
-                }
-                else
+                break;
+            }
+            else if (state == packet_receiver::state::finished)
+            {
+                if (!context->receiver.error.empty())
                 {
-                    context->callbacks.failed(context_id, "failed to read frame");
+                    av_frame_free(&frame);
+
+                    context->callbacks.failed(context_id, context->receiver.error);
 
                     return;
                 }
 
+                context->status.eof_reached = true;
+
                 break;
             }
 
-            if (packet->stream_index == context->video.stream_index)
+            if (received.discontinuity)
+            {
+                // the stream was reconnected, so previous packets must not be referenced and timestamps start again
+                avcodec_flush_buffers(context->video.codec_context);
+
+                context->sampler.reset();
+            }
+
+            // packets of frames that are not decoded at all are not passed to the decoder
+            if (context->sampler.keyframes_only() && (received.packet->flags & AV_PKT_FLAG_KEY) == 0)
+            {
+                av_packet_free(&received.packet);
+
+                continue;
+            }
+
+            context->status.frames_loaded++;
+
+            std::vector<Image> packet_images;
+            std::vector<std::int64_t> packet_timestamps;
+
+            const int res = decode_packet<Image>(received.packet, context->video.codec_context, frame, context->video.sws_context, packet_images, packet_timestamps, &(context->sampler), context->video.time_base);
+
+            // too many non-reference frames in a row for the sampling interval, so all frames are decoded again
+            if (context->live.skip_frame == AVDISCARD_NONREF && !context->sampler.discard_non_reference())
+            {
+                context->live.skip_frame = AVDISCARD_DEFAULT;
+                context->video.codec_context->skip_frame = AVDISCARD_DEFAULT;
+            }
+
+            if (res < 0)
             {
                 ++i;
 
-                context->status.frames_loaded++;
+                context->status.frames_failed++;
+
+                context->callbacks.update_indicator(context_id, videoproc::update_indicator("load", 0, 1));
+            }
+            else
+            {
+                // if frames are sampled, packets are decoded until the sampled frames fill the buffer
+                i += context->sampler.enabled() ? packet_images.size() : 1;
 
-                std::vector<Image> packet_images;
+                images.insert(images.end(), packet_images.begin(), packet_images.end());
+                timestamps.insert(timestamps.end(), packet_timestamps.begin(), packet_timestamps.end());
 
-                if (decode_packet<Image>(packet, context->video.codec_context, frame, packet_images) < 0)
+                if (!packet_images.empty())
                 {
-                    context->status.frames_failed++;
-
-                    context->callbacks.update_indicator(context_id, videoproc::update_indicator("load", 0, 1));
+                    context->callbacks.update_indicator(context_id, videoproc::update_indicator("load", 1, 0));
                 }
-                else
+                else if (!context->sampler.enabled())
                 {
-                    images.insert(images.end(), packet_images.begin(), packet_images.end());
-
-                    if (packet_images.empty())
-                    {
-                        // TODO indicate an empty packet in a separate way !?!?
-                        context->callbacks.update_indicator(context_id, videoproc::update_indicator("load", 0, 1));
-                    }
-                    else
-                    {
-                        context->callbacks.update_indicator(context_id, videoproc::update_indicator("load", 1, 0));
-                    }
+                    // TODO indicate an empty packet in a separate way !?!?
+                    context->callbacks.update_indicator(context_id, videoproc::update_indicator("load", 0, 1));
                 }
             }
-        }
 
-        av_frame_unref(frame);
-        av_packet_unref(packet);
+            av_packet_free(&received.packet);
+        }
 
         av_frame_free(&frame);
-        av_packet_free(&packet);
 
         if (!images.empty())
         {
             std::vector<videoproc::frame<Image> > frames;
             frames.reserve(images.size());
 
-            for (auto & image : images)
+            const auto decoded = frame_timestamps::clock::now();
+
+            for (std::size_t i = 0; i < images.size(); ++i)
             {
-                frames.emplace_back(context->status.frames_processed++, std::move(image));
+                frames.emplace_back(context->status.frames_processed++, std::move(images[i]));
+                frames.back().set_timestamps({ timestamps[i], decoded, {} });
             }
 
             context->sdh->add(std::move(frames));
+        }
+
+        if (context->status.eof_reached && !(context->status.eof_flushed))
+        {
+            // add flush frame when end-of-file reached
+            context->sdh->add(videoproc::frame<Image>(context->status.frames_processed++));
+        }
+    }
+}
+
+template<typename Image> void rtsp<Image>::read_live(std::size_t context_id)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it == m_contexts.end())
+    {
+        return;
+    }
+
+    auto context = it->second;
+
+    auto & pending = context->live.pending;
+
+    // limit the amount of packets per call, so other jobs of this stage are not blocked
+    for (std::size_t n = 0; n < std::max<std::size_t>(m_max_frames_read_buffer, 1); ++n)
+    {
+        received_packet received;
+
+        const auto state = context->receiver.pop(received);
+
+        if (state == packet_receiver::state::pending)
+        {
+            // called again by the receiving thread when packets arrive
+            deliver_live(context_id);
+
+            return;
+        }
+        else if (state == packet_receiver::state::finished)
+        {
+            if (!context->receiver.error.empty())
+            {
+                context->callbacks.failed(context_id, context->receiver.error);
+
+                return;
+            }
+
+            context->status.eof_reached = true;
+
+            // pass all remaining frames followed by the flush frame
+            while (!pending.empty())
+            {
+                videoproc::frame<Image> f(context->status.frames_processed++, std::move(pending.front().image));
+                f.set_timestamps(std::move(pending.front().timestamps));
+
+                context->sdh->add(std::move(f));
+                pending.pop_front();
+            }
 
-            if (context->status.eof_reached && !(context->status.eof_flushed))
+            if (!(context->status.eof_flushed))
             {
-                // add flush frame when end-of-file reached
                 context->sdh->add(videoproc::frame<Image>(context->status.frames_processed++));
             }
+
+            return;
+        }
+
+        if (received.discontinuity)
+        {
+            // the stream was reconnected ; previous packets must not be referenced and timestamps start again
+            avcodec_flush_buffers(context->video.codec_context);
+
+            context->live.clock = stream_clock();
+            context->live.skip_to_keyframe = false;
+
+            context->sampler.reset();
+        }
+
+        AVPacket * packet = received.packet;
+
+        const auto now = std::chrono::steady_clock::now();
+        const auto captured = context->live.clock.capture_time(packet->pts, context->video.time_base, now);
+
+        // the pipeline falls behind if the current or the oldest waiting frame is too old or no more frames could wait
+        const bool behind = (now - captured > m_live.max_latency) ||
+                            (!pending.empty() && (now - pending.front().captured > m_live.max_latency || pending.size() >= m_max_frames_read_buffer));
+
+        const bool keyframe = (packet->flags & AV_PKT_FLAG_KEY) != 0;
+
+        std::size_t dropped = 0;
+
+        // packets of frames that are not decoded at all are not passed to the decoder and are not counted as dropped
+        if (context->sampler.keyframes_only() && !keyframe)
+        {
+            av_packet_free(&received.packet);
+
+            continue;
+        }
+
+        bool decode = true;
+
+        if (m_live.policy == drop_policy::keyframes)
+        {
+            if (behind && !context->live.skip_to_keyframe)
+            {
+                // without a reference all frames until the next keyframe are useless
+                context->live.skip_to_keyframe = true;
+
+                dropped += pending.size();
+                pending.clear();
+            }
+
+            if (context->live.skip_to_keyframe && keyframe)
+            {
+                // the decoder must not reference frames decoded before the skipped packets
+                avcodec_flush_buffers(context->video.codec_context);
+
+                context->live.skip_to_keyframe = false;
+            }
+
+            decode = !(context->live.skip_to_keyframe);
+        }
+        else if (m_live.policy == drop_policy::non_reference)
+        {
+            // most demuxers (e.g. RTP of H.264) don't mark disposable packets, so the decoder skips
+            // non-reference frames itself while falling behind
+            const bool skip_non_reference = behind && context->live.skip_frame < AVDISCARD_NONREF;
+
+            if (skip_non_reference != context->live.skipping_non_reference)
+            {
+                context->video.codec_context->skip_frame = skip_non_reference ? AVDISCARD_NONREF : context->live.skip_frame;
+                context->live.skipping_non_reference = skip_non_reference;
+            }
+
+            // no other frame depends on a disposable frame, so it isn't even passed to the decoder
+            decode = !(behind && (packet->flags & AV_PKT_FLAG_DISPOSABLE) != 0);
+        }
+
+        if (decode)
+        {
+            context->status.frames_loaded++;
+
+            AVFrame * frame = av_frame_alloc();
+
+            if (!frame)
+            {
+                av_packet_free(&received.packet);
+
+                context->callbacks.failed(context_id, "failed to allocate memory for frame");
+
+                return;
+            }
+
+            std::vector<Image> images;
+            std::vector<std::int64_t> timestamps;
+
+            const int res = decode_packet<Image>(packet, context->video.codec_context, frame, context->video.sws_context, images, timestamps, &(context->sampler), context->video.time_base);
+
+            // too many non-reference frames in a row for the sampling interval, so all frames are decoded again ;
+            // while falling behind the decoder keeps skipping them until the pipeline catches up
+            if (context->live.skip_frame == AVDISCARD_NONREF && !context->sampler.discard_non_reference())
+            {
+                context->live.skip_frame = AVDISCARD_DEFAULT;
+
+                if (!context->live.skipping_non_reference)
+                {
+                    context->video.codec_context->skip_frame = AVDISCARD_DEFAULT;
+                }
+            }
+
+            if (res >= 0 && images.empty() && context->live.skipping_non_reference)
+            {
+                // most likely a non-reference frame skipped by the decoder
+                ++dropped;
+            }
+            else if (res < 0 || (images.empty() && !context->sampler.enabled()))
+            {
+                context->status.frames_failed++;
+
+                context->callbacks.update_indicator(context_id, videoproc::update_indicator("load", 0, 1));
+            }
+            else if (!images.empty())
+            {
+                const auto decoded = frame_timestamps::clock::now();
+
+                for (std::size_t i = 0; i < images.size(); ++i)
+                {
+                    pending.push_back({ std::move(images[i]), captured, { timestamps[i], decoded, {} } });
+                }
+
+                context->callbacks.update_indicator(context_id, videoproc::update_indicator("load", 1, 0));
+            }
+
+            av_frame_free(&frame);
+        }
+        else
+        {
+            ++dropped;
+        }
+
+        av_packet_free(&received.packet);
+
+        if (m_live.policy != drop_policy::keyframes)
+        {
+            // drop stale frames ; the oldest frames are dropped first
+            while (!pending.empty() && (now - pending.front().captured > m_live.max_latency || pending.size() > m_max_frames_read_buffer))
+            {
+                pending.pop_front();
+
+                ++dropped;
+            }
+        }
+
+        if (dropped > 0)
+        {
+            context->live.frames_dropped += dropped;
+
+            context->callbacks.update_indicator(context_id, videoproc::update_indicator("drop", dropped, 0));
+        }
+    }
+
+    deliver_live(context_id);
+
+    // more packets could be waiting
+    post_self(
+        [this, context_id]()
+        {
+            read_live(context_id);
+        },
+        "sources::rtsp::read_live",
+        1
+    );
+}
+
+template<typename Image> void rtsp<Image>::start_receiving(std::size_t context_id)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it == m_contexts.end())
+    {
+        return;
+    }
+
+    auto & context = it->second;
+
+    // the packets are decoded at this stage
+    auto notify = make_safe_callback(
+        [this, context_id]()
+        {
+            if (m_live.enabled)
+            {
+                read_live(context_id);
+            }
+            else
+            {
+                start(context_id);
+            }
+        },
+        "sources::rtsp::packets_received",
+        1
+    );
+
+    // the receiving thread ends before the context is destroyed, so it could use the context without owning it
+    processing_context * c = context.get();
+
+    context->receiver.start(
+        m_stream.packet_queue_size,
+        std::move(notify),
+        [c, stream = m_stream](packet_receiver & receiver)
+        {
+            receive_packets(receiver, c->video.format_context, c->video.uri, stream, static_cast<int>(c->video.stream_index), c->video.time_base);
         }
+    );
+}
+
+template<typename Image> void rtsp<Image>::deliver_live(std::size_t context_id)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it == m_contexts.end())
+    {
+        return;
+    }
+
+    auto context = it->second;
+
+    auto & pending = context->live.pending;
+
+    std::size_t free = context->sdh->free();
+
+    if (pending.empty() || free == 0)
+    {
+        return;
+    }
+
+    std::vector<videoproc::frame<Image> > frames;
+    frames.reserve(std::min(free, pending.size()));
+
+    while (!pending.empty() && free > 0)
+    {
+        frames.emplace_back(context->status.frames_processed++, std::move(pending.front().image));
+        frames.back().set_timestamps(std::move(pending.front().timestamps));
+        pending.pop_front();
+
+        --free;
     }
+
+    context->sdh->add(std::move(frames));
 }
 
 template<typename Image> void rtsp<Image>::finish(std::size_t /*context_id*/)
@@ -548,5 +1454,6 @@ template<typename Image> void rtsp<Image>::next(std::size_t context_id, std::siz
 // manual instantiation of rtsp<> for some types
 template class rtsp<cvpg::image_gray_8bit>;
 template class rtsp<cvpg::image_rgb_8bit>;
+template class rtsp<cvpg::image_yuv420_8bit>;
 
 } // namespace cvpg::videoproc::sources
@@ -17,9 +17,12 @@
 #include <libcvpg/core/image.hpp>
 #include <libcvpg/imageproc/scripting/diagnostics/typedefs.hpp>
 #include <libcvpg/videoproc/frame.hpp>
+#include <libcvpg/videoproc/memory_budget.hpp>
 #include <libcvpg/videoproc/packet.hpp>
 #include <libcvpg/videoproc/stage_parameters.hpp>
 #include <libcvpg/videoproc/update_indicator.hpp>
+#include <libcvpg/videoproc/sources/live_parameters.hpp>
+#include <libcvpg/videoproc/sources/rtsp_parameters.hpp>
 
 namespace cvpg::videoproc::sources {
 
@@ -27,7 +30,7 @@ template<typename Image>
 class rtsp : public boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>
 {
 public:
-    rtsp(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler, std::size_t max_frames_read_buffer);
+    rtsp(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler, std::size_t max_frames_read_buffer, rtsp_parameters stream = rtsp_parameters(), live_parameters live = live_parameters(), std::shared_ptr<memory_budget> memory_budget = nullptr);
 
     rtsp(rtsp const &) = delete;
     rtsp(rtsp &&) = delete;
@@ -49,10 +52,26 @@ public:
 
     void next(std::size_t context_id, std::size_t max_new_data);
 
-private:    
+private:
+    // start the thread that receives the packets of the stream
+    void start_receiving(std::size_t context_id);
+
+    // decode the received packets of the stream in live mode ; called again by the receiving thread when new packets arrive
+    void read_live(std::size_t context_id);
+
+    // pass as many decoded frames of the live mode to the stage data handler as it could store
+    void deliver_live(std::size_t context_id);
+
     // amount of frames that will be (tried to) read from video file at once
     std::size_t m_max_frames_read_buffer;
 
+    rtsp_parameters m_stream;
+
+    live_parameters m_live;
+
+    // memory budget shared with the other stages of the pipeline (optional)
+    std::shared_ptr<memory_budget> m_memory_budget;
+
     struct processing_context;
     std::map<std::size_t, std::shared_ptr<processing_context> > m_contexts;
 };
@@ -60,6 +79,7 @@ private:
 // suppress automatic instantiation of rtsp<> for some types
 extern template class rtsp<cvpg::image_gray_8bit>;
 extern template class rtsp<cvpg::image_rgb_8bit>;
+extern template class rtsp<cvpg::image_yuv420_8bit>;
 
 //
 // Hint: Boost.Asynchronous does not support templated proxies. Becaues the servant itself could
@@ -100,6 +120,23 @@ struct image_rgb_8bit_rtsp_proxy : public boost::asynchronous::servant_proxy<ima
     BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
 };
 
+struct image_yuv420_8bit_rtsp_proxy : public boost::asynchronous::servant_proxy<image_yuv420_8bit_rtsp_proxy, rtsp<cvpg::image_yuv420_8bit>, imageproc::scripting::diagnostics::servant_job>
+{
+    using image_type = cvpg::image_yuv420_8bit;
+
+    template<typename... Args>
+    image_yuv420_8bit_rtsp_proxy(Args... args)
+        : boost::asynchronous::servant_proxy<image_yuv420_8bit_rtsp_proxy, rtsp<cvpg::image_yuv420_8bit>, imageproc::scripting::diagnostics::servant_job>(std::forward<Args>(args)...)
+    {}
+
+    BOOST_ASYNC_POST_MEMBER_LOG(init, "init", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(params, "params", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(finish, "finish", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(process, "process", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
+};
+
 } // namespace cvpg::videoproc::sources
 
 #endif // LIBCVPG_VIDEOPROC_SOURCES_RTSP_HPP
@@ -0,0 +1,53 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_SOURCES_RTSP_PARAMETERS_HPP
+#define LIBCVPG_VIDEOPROC_SOURCES_RTSP_PARAMETERS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <libcvpg/videoproc/sources/sampling_parameters.hpp>
+
+namespace cvpg::videoproc::sources {
+
+//
+// Parameters of the connection to a stream used at the RTSP source stage. Options that are not
+// supported by the protocol of the stream (e.g. for local files) are ignored.
+//
+struct rtsp_parameters
+{
+    // lower transport protocol ('tcp', 'udp', 'udp_multicast' or 'http' ; empty = chosen by FFmpeg)
+    std::string transport = "tcp";
+
+    // size of the socket receive buffer in bytes (0 = system default)
+    std::size_t buffer_size = 0;
+
+    // amount of packets buffered to reorder received packets (-1 = FFmpeg default)
+    int reorder_queue_size = -1;
+
+    // maximum time to wait for data of the stream before the connection is treated as lost (0 = no timeout)
+    std::chrono::milliseconds timeout = std::chrono::milliseconds(5000);
+
+    // disable buffering at the demuxer and the decoder ; reduces the latency but could increase the
+    // amount of corrupted frames at lossy connections
+    bool low_latency = false;
+
+    // amount of received packets that are waiting for the decoder
+    std::size_t packet_queue_size = 256;
+
+    // amount of consecutive attempts to reconnect after the connection was lost or the end of the
+    // stream was reached (0 = no reconnect) ; with reconnects a local file is played in a loop
+    std::size_t reconnect_attempts = 0;
+
+    // delay before each attempt to reconnect
+    std::chrono::milliseconds reconnect_delay = std::chrono::milliseconds(1000);
+
+    // frames passed to the next stage ; the sampling starts again after a reconnect
+    sampling_parameters sampling;
+};
+
+} // namespace cvpg::videoproc::sources
+
+#endif // LIBCVPG_VIDEOPROC_SOURCES_RTSP_PARAMETERS_HPP
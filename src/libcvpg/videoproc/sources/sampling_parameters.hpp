@@ -0,0 +1,46 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_SOURCES_SAMPLING_PARAMETERS_HPP
+#define LIBCVPG_VIDEOPROC_SOURCES_SAMPLING_PARAMETERS_HPP
+
+#include <cstddef>
+
+namespace cvpg::videoproc::sources {
+
+// frames passed to the next stage by a source stage
+enum class sampling_mode
+{
+    // all frames
+    all,
+
+    // every Nth frame of the stream
+    every_nth,
+
+    // frames at a target frame rate
+    fps,
+
+    // keyframes only ; all other frames are not decoded at all
+    keyframes
+};
+
+//
+// Parameters of the sampling of frames at a source stage. Frames are sampled by their presentation
+// timestamps. Frames that are not sampled are discarded before they are converted to images. If at
+// most every 2nd frame is sampled, non-reference frames are discarded by the decoder without decoding
+// them.
+//
+struct sampling_parameters
+{
+    sampling_mode mode = sampling_mode::all;
+
+    // distance of sampled frames in frames of the stream (mode 'every_nth')
+    std::size_t every_nth = 1;
+
+    // frame rate of sampled frames (mode 'fps')
+    double fps = 1.0;
+};
+
+} // namespace cvpg::videoproc::sources
+
+#endif // LIBCVPG_VIDEOPROC_SOURCES_SAMPLING_PARAMETERS_HPP
@@ -0,0 +1,251 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#include <libcvpg/videoproc/sources/synthetic.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <libavutil/rational.h>
+}
+
+#include <libcvpg/videoproc/stage_data_handler.hpp>
+#include <libcvpg/videoproc/sources/pattern_generator.hpp>
+
+namespace cvpg::videoproc::sources {
+
+template<typename Image> struct synthetic<Image>::processing_context
+{
+    struct status_info
+    {
+        bool eof_reached = false;
+        bool eof_flushed = false;
+
+        std::size_t next_waiting = 0;
+
+        // number of the next generated frame
+        std::int64_t next_frame = 0;
+
+        std::size_t packet_counter = 0;
+    };
+
+    status_info status;
+
+    struct callback_info
+    {
+        std::function<void(std::size_t, videoproc::packet<videoproc::frame<Image> >)> deliver_packet;
+        std::function<void(std::size_t)> finished;
+        std::function<void(std::size_t, std::string)> failed;
+        std::function<void(std::size_t, videoproc::update_indicator)> update_indicator;
+    };
+
+    callback_info callbacks;
+
+    std::unique_ptr<pattern_generator<Image> > generator;
+
+    std::shared_ptr<stage_data_handler<videoproc::frame<Image> > > sdh;
+};
+
+template<typename Image> synthetic<Image>::synthetic(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler,
+                                                     std::size_t max_frames_read_buffer,
+                                                     synthetic_parameters parameters,
+                                                     std::shared_ptr<memory_budget> memory_budget)
+    : boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>(scheduler)
+    , m_max_frames_read_buffer(max_frames_read_buffer)
+    , m_parameters(std::move(parameters))
+    , m_memory_budget(std::move(memory_budget))
+    , m_contexts()
+{}
+
+template<typename Image> void synthetic<Image>::init(std::size_t context_id, std::string /*uri*/, stage_callbacks<Image> callbacks)
+{
+    // create new processing context
+    auto context = std::make_shared<processing_context>();
+    context->callbacks.deliver_packet = std::move(callbacks.deliver);
+    context->callbacks.finished = std::move(callbacks.finished);
+    context->callbacks.failed = std::move(callbacks.failed);
+    context->callbacks.update_indicator = std::move(callbacks.update);
+    context->generator = std::make_unique<pattern_generator<Image> >(m_parameters);
+
+    context->sdh = std::make_shared<stage_data_handler<videoproc::frame<Image> > >(
+        "sources::synthetic",
+        m_max_frames_read_buffer,
+        [this, context_id, context]()
+        {
+            // start generating new data ...
+            post_self(
+                [this, context_id]()
+                {
+                    start(context_id);
+                },
+                "sources::synthetic::next",
+                1
+            );
+        },
+        [context]()
+        {
+            return context->status.next_waiting;
+        },
+        [context_id, context](std::vector<videoproc::frame<Image> > frames, std::function<void()> deliver_done_callback)
+        {
+            if (frames.empty())
+            {
+                deliver_done_callback();
+                return;
+            }
+
+            context->status.next_waiting = 0;
+
+            videoproc::packet<videoproc::frame<Image> > packet(context->status.packet_counter++);
+
+            bool is_last = false;
+
+            for (auto & frame : frames)
+            {
+                is_last |= frame.flush();
+
+                packet.add_frame(std::move(frame));
+            }
+
+            context->callbacks.deliver_packet(context_id, std::move(packet));
+
+            if (is_last)
+            {
+                context->status.eof_flushed = true;
+                context->callbacks.finished(context_id);
+            }
+            else
+            {
+                deliver_done_callback();
+            }
+        },
+        m_memory_budget
+    );
+
+    m_contexts.insert({ context_id, context });
+
+    if (m_parameters.width == 0 || m_parameters.height == 0 || m_parameters.framerate <= 0.0 || m_parameters.frames < 0)
+    {
+        context->callbacks.failed(context_id, "invalid parameters of synthetic video");
+
+        return;
+    }
+
+    // frames are numbered in units of the frame duration
+    const AVRational framerate = av_d2q(m_parameters.framerate, 1001000);
+
+    std::map<std::string, std::any> params =
+    {
+        { "frames.width", static_cast<std::size_t>(m_parameters.width) },
+        { "frames.height", static_cast<std::size_t>(m_parameters.height) },
+        { "frames.framerate", framerate },
+        { "frames.time_base", av_inv_q(framerate) }
+    };
+
+    callbacks.parameters(context_id, std::move(params));
+    callbacks.initialized(context_id, m_parameters.frames);
+}
+
+template<typename Image> void synthetic<Image>::params(std::size_t /*context_id*/, std::map<std::string, std::any> /*p*/)
+{
+    // not needed here!
+}
+
+template<typename Image> void synthetic<Image>::start(std::size_t context_id)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it != m_contexts.end())
+    {
+        auto & context = it->second;
+
+        // ignore start command if all frames are already generated
+        if (context->status.eof_reached)
+        {
+            return;
+        }
+
+        // check if input buffer is full
+        if (context->sdh->full())
+        {
+            return;
+        }
+
+        const std::size_t amount = context->sdh->free();
+
+        std::vector<videoproc::frame<Image> > frames;
+        frames.reserve(amount + 1);
+
+        const auto generated = frame_timestamps::clock::now();
+
+        for (std::size_t i = 0; i < amount; ++i)
+        {
+            if (m_parameters.frames > 0 && context->status.next_frame >= m_parameters.frames)
+            {
+                context->status.eof_reached = true;
+
+                break;
+            }
+
+            const std::int64_t number = context->status.next_frame++;
+
+            frames.emplace_back(static_cast<std::size_t>(number), context->generator->generate(number));
+            frames.back().set_timestamps({ number, generated, {} });
+        }
+
+        if (!frames.empty())
+        {
+            context->callbacks.update_indicator(context_id, videoproc::update_indicator("load", frames.size(), 0));
+        }
+
+        // the end could be reached exactly at the end of the buffer
+        if (m_parameters.frames > 0 && context->status.next_frame >= m_parameters.frames)
+        {
+            context->status.eof_reached = true;
+        }
+
+        if (context->status.eof_reached && !(context->status.eof_flushed))
+        {
+            // add flush frame after the last frame
+            frames.emplace_back(static_cast<std::size_t>(context->status.next_frame));
+        }
+
+        if (!frames.empty())
+        {
+            context->sdh->add(std::move(frames));
+        }
+    }
+}
+
+template<typename Image> void synthetic<Image>::finish(std::size_t /*context_id*/)
+{
+    // no finish needed here!
+}
+
+template<typename Image> void synthetic<Image>::process(std::size_t /*context_id*/, videoproc::packet<videoproc::frame<Image> > && /*packet*/)
+{
+    // no process needed here!
+}
+
+template<typename Image> void synthetic<Image>::next(std::size_t context_id, std::size_t max_new_data)
+{
+    auto it = m_contexts.find(context_id);
+
+    if (it != m_contexts.end())
+    {
+        auto & context = it->second;
+
+        context->status.next_waiting = max_new_data;
+
+        context->sdh->try_flush();
+    }
+}
+
+// manual instantiation of synthetic<> for some types
+template class synthetic<cvpg::image_gray_8bit>;
+template class synthetic<cvpg::image_rgb_8bit>;
+template class synthetic<cvpg::image_yuv420_8bit>;
+
+} // namespace cvpg::videoproc::sources
@@ -0,0 +1,138 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_SOURCES_SYNTHETIC_HPP
+#define LIBCVPG_VIDEOPROC_SOURCES_SYNTHETIC_HPP
+
+#include <any>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <boost/asynchronous/servant_proxy.hpp>
+#include <boost/asynchronous/trackable_servant.hpp>
+
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/imageproc/scripting/diagnostics/typedefs.hpp>
+#include <libcvpg/videoproc/frame.hpp>
+#include <libcvpg/videoproc/memory_budget.hpp>
+#include <libcvpg/videoproc/packet.hpp>
+#include <libcvpg/videoproc/stage_parameters.hpp>
+#include <libcvpg/videoproc/sources/synthetic_parameters.hpp>
+#include <libcvpg/videoproc/update_indicator.hpp>
+
+namespace cvpg::videoproc::sources {
+
+//
+// A synthetic source generates the frames of a video (see 'pattern_generator') instead of reading
+// them from a file or a stream. Nothing is demuxed or decoded, so the throughput of the following
+// stages could be measured without the costs of a decoder.
+//
+// Frames are generated as fast as the next stage accepts them. The frames get presentation timestamps
+// in units of the frame duration. The URI given at 'init' is not used.
+//
+template<typename Image>
+class synthetic : public boost::asynchronous::trackable_servant<imageproc::scripting::diagnostics::servant_job, imageproc::scripting::diagnostics::servant_job>
+{
+public:
+    synthetic(boost::asynchronous::any_weak_scheduler<imageproc::scripting::diagnostics::servant_job> scheduler, std::size_t max_frames_read_buffer, synthetic_parameters parameters = synthetic_parameters(), std::shared_ptr<memory_budget> memory_budget = nullptr);
+
+    synthetic(synthetic const &) = delete;
+    synthetic(synthetic &&) = delete;
+
+    synthetic & operator=(synthetic const &) = delete;
+    synthetic & operator=(synthetic &&) = delete;
+
+    virtual ~synthetic() = default;
+
+    void init(std::size_t context_id, std::string uri, stage_callbacks<Image> callbacks);
+
+    void params(std::size_t context_id, std::map<std::string, std::any> p);
+
+    void start(std::size_t context_id);
+
+    void finish(std::size_t context_id);
+
+    void process(std::size_t context_id, videoproc::packet<videoproc::frame<Image> > && packet);
+
+    void next(std::size_t context_id, std::size_t max_new_data);
+
+private:
+    // amount of frames that will be generated at once
+    std::size_t m_max_frames_read_buffer;
+
+    synthetic_parameters m_parameters;
+
+    // memory budget shared with the other stages of the pipeline (optional)
+    std::shared_ptr<memory_budget> m_memory_budget;
+
+    struct processing_context;
+    std::map<std::size_t, std::shared_ptr<processing_context> > m_contexts;
+};
+
+// suppress automatic instantiation of synthetic<> for some types
+extern template class synthetic<cvpg::image_gray_8bit>;
+extern template class synthetic<cvpg::image_rgb_8bit>;
+extern template class synthetic<cvpg::image_yuv420_8bit>;
+
+//
+// Hint: Boost.Asynchronous does not support templated proxies. Becaues the servant itself could
+// have template parameters we have to create a proxy for each wanted type.
+//
+
+struct image_gray_8bit_synthetic_proxy : public boost::asynchronous::servant_proxy<image_gray_8bit_synthetic_proxy, synthetic<cvpg::image_gray_8bit>, imageproc::scripting::diagnostics::servant_job>
+{
+    using image_type = cvpg::image_gray_8bit;
+
+    template<typename... Args>
+    image_gray_8bit_synthetic_proxy(Args... args)
+        : boost::asynchronous::servant_proxy<image_gray_8bit_synthetic_proxy, synthetic<cvpg::image_gray_8bit>, imageproc::scripting::diagnostics::servant_job>(std::forward<Args>(args)...)
+    {}
+
+    BOOST_ASYNC_POST_MEMBER_LOG(init, "init", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(params, "params", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(finish, "finish", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(process, "process", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
+};
+
+struct image_rgb_8bit_synthetic_proxy : public boost::asynchronous::servant_proxy<image_rgb_8bit_synthetic_proxy, synthetic<cvpg::image_rgb_8bit>, imageproc::scripting::diagnostics::servant_job>
+{
+    using image_type = cvpg::image_rgb_8bit;
+
+    template<typename... Args>
+    image_rgb_8bit_synthetic_proxy(Args... args)
+        : boost::asynchronous::servant_proxy<image_rgb_8bit_synthetic_proxy, synthetic<cvpg::image_rgb_8bit>, imageproc::scripting::diagnostics::servant_job>(std::forward<Args>(args)...)
+    {}
+
+    BOOST_ASYNC_POST_MEMBER_LOG(init, "init", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(params, "params", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(finish, "finish", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(process, "process", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
+};
+
+struct image_yuv420_8bit_synthetic_proxy : public boost::asynchronous::servant_proxy<image_yuv420_8bit_synthetic_proxy, synthetic<cvpg::image_yuv420_8bit>, imageproc::scripting::diagnostics::servant_job>
+{
+    using image_type = cvpg::image_yuv420_8bit;
+
+    template<typename... Args>
+    image_yuv420_8bit_synthetic_proxy(Args... args)
+        : boost::asynchronous::servant_proxy<image_yuv420_8bit_synthetic_proxy, synthetic<cvpg::image_yuv420_8bit>, imageproc::scripting::diagnostics::servant_job>(std::forward<Args>(args)...)
+    {}
+
+    BOOST_ASYNC_POST_MEMBER_LOG(init, "init", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(params, "params", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(start, "start", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(finish, "finish", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(process, "process", 1)
+    BOOST_ASYNC_POST_MEMBER_LOG(next, "next", 1)
+};
+
+} // namespace cvpg::videoproc::sources
+
+#endif // LIBCVPG_VIDEOPROC_SOURCES_SYNTHETIC_HPP
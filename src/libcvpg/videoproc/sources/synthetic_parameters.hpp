@@ -0,0 +1,50 @@
+// Copyright (c) 2020-2021 Franz Alt
+// This code is licensed under MIT license (see LICENSE.txt for details).
+
+#ifndef LIBCVPG_VIDEOPROC_SOURCES_SYNTHETIC_PARAMETERS_HPP
+#define LIBCVPG_VIDEOPROC_SOURCES_SYNTHETIC_PARAMETERS_HPP
+
+#include <cstdint>
+
+namespace cvpg::videoproc::sources {
+
+// content of the frames generated by a synthetic source
+enum class synthetic_pattern
+{
+    // vertical color bars
+    bars,
+
+    // diagonal color gradient moving by one pixel per frame
+    gradient,
+
+    // a box and a circle moving across a gray background
+    moving_shapes,
+
+    // colored noise, different at each frame
+    noise
+};
+
+//
+// Parameters of a synthetic source. The generated frames only depend on these parameters and the
+// number of a frame, so the same parameters always produce the same video.
+//
+struct synthetic_parameters
+{
+    synthetic_pattern pattern = synthetic_pattern::bars;
+
+    std::uint32_t width = 1920;
+    std::uint32_t height = 1080;
+
+    // frame rate of the generated video ; used for the presentation timestamps of the frames
+    double framerate = 25.0;
+
+    // amount of generated frames (0 = endless)
+    std::int64_t frames = 250;
+
+    // seed of the noise pattern
+    std::uint32_t seed = 0;
+};
+
+} // namespace cvpg::videoproc::sources
+
+#endif // LIBCVPG_VIDEOPROC_SOURCES_SYNTHETIC_PARAMETERS_HPP
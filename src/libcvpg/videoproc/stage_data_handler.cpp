@@ -12,23 +12,37 @@ template<typename T> stage_data_handler<T>::stage_data_handler(std::string name,
                                                                std::size_t max_stored_entries,
                                                                std::function<void()> trigger_new_data_callback,
                                                                std::function<std::size_t()> get_deliver_amount_callback,
-                                                               std::function<void(std::vector<T>, std::function<void()>)> deliver_data_callback)
+                                                               std::function<void(std::vector<T>, std::function<void()>)> deliver_data_callback,
+                                                               std::shared_ptr<memory_budget> memory_budget)
     : m_name(std::move(name))
     , m_max_stored_entries(max_stored_entries)
     , m_trigger_new_data_callback(std::move(trigger_new_data_callback))
     , m_get_deliver_amount_callback(std::move(get_deliver_amount_callback))
     , m_deliver_data_callback(std::move(deliver_data_callback))
-    , m_in_data()
+    , m_in_data(std::make_unique<reorder_buffer<T> >(std::max<std::size_t>(max_stored_entries, 1)))
+    , m_in_overflow()
     , m_out_data()
-    , m_next(0)
+    , m_memory_budget(std::move(memory_budget))
+    , m_capacity(max_stored_entries)
+    , m_stored_bytes(0)
+    , m_entry_bytes(0)
 {
     // reserve space for output buffer for the same size as input buffer
     m_out_data.reserve(max_stored_entries);
 }
 
+template<typename T> stage_data_handler<T>::~stage_data_handler()
+{
+    // give back the bytes of all entries that were never delivered
+    if (m_memory_budget)
+    {
+        m_memory_budget->release(m_stored_bytes);
+    }
+}
+
 template<typename T> void stage_data_handler<T>::add(T && t)
 {
-    m_in_data.push(std::move(t));
+    store(std::move(t));
 
     try_flush();
 }
@@ -37,23 +51,82 @@ template<typename T> void stage_data_handler<T>::add(std::vector<T> && t)
 {
     for (auto & d : t)
     {
-        m_in_data.push(std::move(d));
+        store(std::move(d));
     }
 
     try_flush();
 }
 
+template<typename T> void stage_data_handler<T>::store(T && t)
+{
+    const std::size_t number = t.number();
+
+    if (number < m_in_data->next())
+    {
+        // already delivered
+        return;
+    }
+
+    const std::size_t bytes = t.bytes();
+
+    if (m_in_data->fits(number))
+    {
+        if (!m_in_data->insert(std::move(t)))
+        {
+            // an entry with the same number is already stored
+            return;
+        }
+
+        // an entry with the same number that arrived too early is replaced
+        auto it = m_in_overflow.find(number);
+
+        if (it != m_in_overflow.end())
+        {
+            release(it->second.bytes());
+
+            m_in_overflow.erase(it);
+        }
+    }
+    else
+    {
+        auto [it, inserted] = m_in_overflow.insert_or_assign(number, std::move(t));
+
+        if (!inserted)
+        {
+            // replaced an entry with the same number, so no additional bytes are stored
+            return;
+        }
+    }
+
+    if (m_memory_budget)
+    {
+        m_memory_budget->acquire(bytes);
+    }
+
+    m_stored_bytes += bytes;
+
+    if (bytes > 0)
+    {
+        m_entry_bytes = bytes;
+    }
+}
+
 template<typename T> void stage_data_handler<T>::try_flush()
 {
     try_process_input();
 
-    const std::size_t max_deliver = std::min(m_max_stored_entries, m_get_deliver_amount_callback());
+    const std::size_t requested = m_get_deliver_amount_callback();
+    const std::size_t max_deliver = std::min(m_max_stored_entries, requested);
+
+    adapt_capacity(requested);
 
     if (max_deliver >= m_out_data.size())
     {
         if (!m_out_data.empty())
         {
             // deliver output buffer completly
+            release(m_out_data);
+
             m_deliver_data_callback(std::move(m_out_data), m_trigger_new_data_callback);
             m_out_data.clear();
         }
@@ -74,6 +147,8 @@ template<typename T> void stage_data_handler<T>::try_flush()
             std::move(m_out_data.begin(), m_out_data.begin() + max_deliver, std::back_inserter(moved));
             m_out_data.erase(m_out_data.begin(), m_out_data.begin() + max_deliver);
 
+            release(moved);
+
             m_deliver_data_callback(std::move(moved), m_trigger_new_data_callback);
         }
     }
@@ -81,26 +156,92 @@ template<typename T> void stage_data_handler<T>::try_flush()
 
 template<typename T> void stage_data_handler<T>::try_process_input()
 {
-    bool found = true;
-
-    while (found)
+    while (true)
     {
-        found = !m_in_data.empty() && m_in_data.top().number() == m_next;
+        // move data in order from input to output buffer
+        const std::size_t drained = m_in_data->drain(
+            [this](T && t)
+            {
+                m_out_data.push_back(std::move(t));
+            }
+        );
+
+        // move data that fits now from overflow to reorder buffer ; data with numbers that were delivered
+        // meanwhile would never fit and is dropped
+        std::size_t moved = 0;
 
-        if (found)
+        while (!m_in_overflow.empty() && (m_in_overflow.begin()->first < m_in_data->next() || m_in_data->fits(m_in_overflow.begin()->first)))
         {
-            // move data from input to output buffer
-            m_out_data.push_back(m_in_data.top());
-            m_in_data.pop();
+            T & t = m_in_overflow.begin()->second;
+
+            const std::size_t bytes = t.bytes();
+
+            if (m_in_data->fits(t.number()) && m_in_data->insert(std::move(t)))
+            {
+                ++moved;
+            }
+            else
+            {
+                release(bytes);
+            }
 
-            ++m_next;
+            m_in_overflow.erase(m_in_overflow.begin());
         }
+
+        if (drained == 0 && moved == 0)
+        {
+            break;
+        }
+    }
+}
+
+template<typename T> void stage_data_handler<T>::adapt_capacity(std::size_t requested)
+{
+    if (!m_memory_budget)
+    {
+        return;
+    }
+
+    // keep at least two entries, so the next stage could work on one entry while another one is prepared
+    const std::size_t min_capacity = std::min<std::size_t>(m_max_stored_entries, 2);
+
+    if (requested > 0 && m_out_data.empty())
+    {
+        // next stage waits for data ; allow more entries in flight
+        m_capacity = std::min(m_max_stored_entries, m_capacity + std::max<std::size_t>(m_capacity / 4, 1));
+    }
+    else if (requested == 0 && !m_out_data.empty() && m_capacity > min_capacity)
+    {
+        // next stage is saturated and data is waiting ; entries in flight only cost memory
+        --m_capacity;
+    }
+}
+
+template<typename T> void stage_data_handler<T>::release(std::vector<T> const & data)
+{
+    std::size_t bytes = 0;
+
+    for (auto const & d : data)
+    {
+        bytes += d.bytes();
+    }
+
+    release(bytes);
+}
+
+template<typename T> void stage_data_handler<T>::release(std::size_t bytes)
+{
+    if (m_memory_budget)
+    {
+        m_memory_budget->release(bytes);
     }
+
+    m_stored_bytes -= std::min(bytes, m_stored_bytes);
 }
 
 template<typename T> bool stage_data_handler<T>::empty() const
 {
-    return m_in_data.empty();
+    return m_in_data->empty() && m_in_overflow.empty();
 }
 
 template<typename T> bool stage_data_handler<T>::full() const
@@ -110,11 +251,39 @@ template<typename T> bool stage_data_handler<T>::full() const
 
 template<typename T> std::size_t stage_data_handler<T>::free() const
 {
-    return std::min(m_max_stored_entries - m_in_data.size() + m_out_data.size(), m_max_stored_entries);
+    const std::size_t stored = m_in_data->size() + m_in_overflow.size();
+
+    std::size_t result = std::min(m_capacity - std::min(stored, m_capacity) + m_out_data.size(), m_capacity);
+
+    if (m_memory_budget && m_entry_bytes > 0)
+    {
+        std::size_t budget_entries = m_memory_budget->available() / m_entry_bytes;
+
+        // a stage that holds no data has to accept at least one entry, otherwise the pipeline could stall
+        if (budget_entries == 0 && stored == 0 && m_out_data.empty())
+        {
+            budget_entries = 1;
+        }
+
+        result = std::min(result, budget_entries);
+    }
+
+    return result;
+}
+
+template<typename T> std::size_t stage_data_handler<T>::capacity() const
+{
+    return m_capacity;
+}
+
+template<typename T> reorder_statistics stage_data_handler<T>::statistics() const
+{
+    return m_in_data->statistics();
 }
 
 // manual instantiation of stage_data_handler<> for some types
 template class stage_data_handler<videoproc::frame<image_gray_8bit> >;
 template class stage_data_handler<videoproc::frame<image_rgb_8bit> >;
+template class stage_data_handler<videoproc::frame<image_yuv420_8bit> >;
 
 } // namespace cvpg::videoproc
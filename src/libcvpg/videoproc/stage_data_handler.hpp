@@ -6,11 +6,14 @@
 
 #include <cstdint>
 #include <functional>
+#include <map>
+#include <memory>
 #include <string>
-#include <queue>
 #include <vector>
 
 #include <libcvpg/videoproc/frame.hpp>
+#include <libcvpg/videoproc/memory_budget.hpp>
+#include <libcvpg/videoproc/reorder_buffer.hpp>
 
 namespace cvpg::videoproc {
 
@@ -19,7 +22,16 @@ namespace cvpg::videoproc {
 // processing stage and return the next valid data in the correct order to the stage if the next
 // stage indicates that new data could be send.
 //
-// The template type 'T' has to provide a 'number()' function.
+// Incoming data is stored at a reorder buffer of the size of the maximum stored entries. Data that
+// arrives too early for the reorder buffer is kept separately until it fits. Data with numbers that
+// were already delivered or that are already stored at the reorder buffer is dropped.
+//
+// If a memory budget is given, the bytes of all stored entries are acquired at the budget until they
+// are delivered, and free space is also limited by the bytes available at the budget. In this case the
+// amount of stored entries adapts to the next stage: it shrinks while the next stage doesn't request
+// data that is ready and grows while the next stage requests data that isn't ready yet.
+//
+// The template type 'T' has to provide a 'number()' and a 'bytes()' function.
 //
 template<typename T>
 class stage_data_handler
@@ -29,7 +41,8 @@ public:
                        std::size_t max_stored_entries,
                        std::function<void()> trigger_new_data_callback,
                        std::function<std::size_t()> get_deliver_amount_callback,
-                       std::function<void(std::vector<T>, std::function<void()>)> deliver_data_callback);
+                       std::function<void(std::vector<T>, std::function<void()>)> deliver_data_callback,
+                       std::shared_ptr<memory_budget> memory_budget = nullptr);
 
     stage_data_handler(stage_data_handler const &) = delete;
     stage_data_handler(stage_data_handler &&) = default;
@@ -37,7 +50,7 @@ public:
     stage_data_handler & operator=(stage_data_handler const &) = delete;
     stage_data_handler & operator=(stage_data_handler &&) = default;
 
-    ~stage_data_handler() = default;
+    ~stage_data_handler();
 
     void add(T && t);
     void add(std::vector<T> && t);
@@ -50,9 +63,22 @@ public:
 
     std::size_t free() const;
 
+    // current maximum amount of stored entries ; only differs from the given maximum if a memory budget is used
+    std::size_t capacity() const;
+
+    reorder_statistics statistics() const;
+
 private:
+    void store(T && t);
+
     void try_process_input();
 
+    void adapt_capacity(std::size_t requested);
+
+    void release(std::vector<T> const & data);
+
+    void release(std::size_t bytes);
+
     std::string m_name;
 
     std::size_t m_max_stored_entries;
@@ -61,15 +87,26 @@ private:
     std::function<std::size_t()> m_get_deliver_amount_callback;
     std::function<void(std::vector<T>, std::function<void()>)> m_deliver_data_callback;
 
-    std::priority_queue<T, std::deque<T>, std::greater<T> > m_in_data;
+    std::unique_ptr<reorder_buffer<T> > m_in_data;
+
+    // data that doesn't fit into the reorder buffer at the moment
+    std::map<std::size_t, T> m_in_overflow;
+
     std::vector<T> m_out_data;
 
-    std::size_t m_next;
+    std::shared_ptr<memory_budget> m_memory_budget;
+
+    std::size_t m_capacity;
+
+    // bytes of all stored entries and of the last stored entry with data
+    std::size_t m_stored_bytes;
+    std::size_t m_entry_bytes;
 };
 
 // suppress automatic instantiation of stage_data_handler<> for some types
 extern template class stage_data_handler<videoproc::frame<image_gray_8bit> >;
 extern template class stage_data_handler<videoproc::frame<image_rgb_8bit> >;
+extern template class stage_data_handler<videoproc::frame<image_yuv420_8bit> >;
 
 } // namespace cvpg::videoproc
 
@@ -15,4 +15,45 @@ TEST(test_image, image_creation)
         auto image = cvpg::image_gray_8bit(1920, 1080);
         ASSERT_TRUE(image.width() == 1920 && image.height() == 1080);
     }
+
+    // grayscale images are in the full range unless stated otherwise (e.g. a wrapped luma plane)
+    {
+        auto image = cvpg::image_gray_8bit(16, 16);
+        ASSERT_TRUE(image.range() == cvpg::color_range::full);
+
+        image.set_range(cvpg::color_range::limited);
+
+        auto copy = image;
+        ASSERT_TRUE(copy.range() == cvpg::color_range::limited);
+    }
+}
+
+TEST(test_image, yuv420_image_creation)
+{
+    // default ctor has to create an empty image
+    {
+        auto image = cvpg::image_yuv420_8bit();
+        ASSERT_TRUE(image.width() == 0 && image.height() == 0);
+    }
+
+    // chroma planes have half of the size, rounded up for odd sizes
+    {
+        auto image = cvpg::image_yuv420_8bit(1919, 1081);
+        ASSERT_TRUE(image.width() == 1919 && image.height() == 1081);
+        ASSERT_TRUE(image.plane_width(0) == 1919 && image.plane_height(0) == 1081 && image.stride(0) == 1919);
+        ASSERT_TRUE(image.plane_width(1) == 960 && image.plane_height(1) == 541 && image.stride(1) == 960);
+        ASSERT_TRUE(image.plane_width(2) == 960 && image.plane_height(2) == 541 && image.stride(2) == 960);
+    }
+
+    // images are in the limited range unless stated otherwise
+    {
+        auto image = cvpg::image_yuv420_8bit(16, 16);
+        ASSERT_TRUE(image.range() == cvpg::color_range::limited);
+
+        image.set_range(cvpg::color_range::full);
+        ASSERT_TRUE(image.range() == cvpg::color_range::full);
+
+        auto copy = image;
+        ASSERT_TRUE(copy.range() == cvpg::color_range::full);
+    }
 }
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <libcvpg/imageproc/algorithms/tiling/canny.hpp>
+
+TEST(test_canny, hysteresis_across_tiles)
+{
+    constexpr std::size_t width = 32;
+    constexpr std::size_t height = 32;
+    constexpr std::size_t tile = 16;
+
+    std::vector<std::atomic<std::uint8_t> > states(width * height);
+    std::vector<std::uint8_t> dst(width * height, 0);
+
+    for (auto & state : states)
+    {
+        state.store(cvpg::imageproc::algorithms::canny_none);
+    }
+
+    // a weak diagonal through all tiles, started by a strong pixel at the last tile
+    for (std::size_t i = 0; i < width; ++i)
+    {
+        states[i * width + i].store(cvpg::imageproc::algorithms::canny_weak);
+    }
+
+    states[(height - 1) * width + (width - 1)].store(cvpg::imageproc::algorithms::canny_strong);
+    dst[(height - 1) * width + (width - 1)] = 255;
+
+    // an isolated weak pixel stays suppressed
+    states[width - 1].store(cvpg::imageproc::algorithms::canny_weak);
+
+    cvpg::imageproc::algorithms::tiling_parameters parameters;
+    parameters.image_width = width;
+    parameters.image_height = height;
+
+    for (std::size_t y = 0; y < height; y += tile)
+    {
+        for (std::size_t x = 0; x < width; x += tile)
+        {
+            cvpg::imageproc::algorithms::canny_hysteresis_gray_8bit(dst.data(), states.data(), x, x + tile - 1, y, y + tile - 1, parameters);
+        }
+    }
+
+    for (std::size_t i = 0; i < width - 1; ++i)
+    {
+        ASSERT_EQ(dst[i * width + i], 255);
+
+        // reached pixels are not followed again by the tile they belong to
+        ASSERT_EQ(states[i * width + i].load(), cvpg::imageproc::algorithms::canny_followed);
+    }
+
+    ASSERT_EQ(states[(height - 1) * width + (width - 1)].load(), cvpg::imageproc::algorithms::canny_strong);
+
+    ASSERT_EQ(dst[width - 1], 0);
+    ASSERT_EQ(states[width - 1].load(), cvpg::imageproc::algorithms::canny_weak);
+}
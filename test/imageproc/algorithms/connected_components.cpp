@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+
+#include <any>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asynchronous/servant_proxy.hpp>
+#include <boost/asynchronous/trackable_servant.hpp>
+#include <boost/asynchronous/queue/lockfree_queue.hpp>
+#include <boost/asynchronous/scheduler_shared_proxy.hpp>
+#include <boost/asynchronous/scheduler/multiqueue_threadpool_scheduler.hpp>
+#include <boost/asynchronous/scheduler/single_thread_scheduler.hpp>
+
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/core/meta_data.hpp>
+#include <libcvpg/core/multi_array.hpp>
+#include <libcvpg/imageproc/algorithms/connected_components.hpp>
+
+namespace {
+
+struct connected_components_servant : boost::asynchronous::trackable_servant<>
+{
+    connected_components_servant(boost::asynchronous::any_weak_scheduler<> scheduler, boost::asynchronous::any_shared_scheduler_proxy<> pool)
+        : boost::asynchronous::trackable_servant<>(scheduler, pool)
+    {}
+
+    std::future<cvpg::image_gray_8bit> connected_components(cvpg::image_gray_8bit image, std::int32_t connectivity)
+    {
+        auto promise_alg = std::make_shared<std::promise<cvpg::image_gray_8bit> >();
+        auto future_alg = promise_alg->get_future();
+
+        post_callback(
+            [img = std::move(image), connectivity]() mutable
+            {
+                // use small tiles to get a lot of seams between tiles
+                return cvpg::imageproc::algorithms::connected_components(std::move(img), connectivity, 1, "blobs", 8, 8);
+            },
+            [promise_alg](auto cont_res)
+            {
+                try
+                {
+                    promise_alg->set_value(std::move(cont_res.get()));
+                }
+                catch (...)
+                {
+                    promise_alg->set_exception(std::current_exception());
+                }
+            }
+        );
+
+        return future_alg;
+    }
+};
+
+struct connected_components_servant_proxy : public boost::asynchronous::servant_proxy<connected_components_servant_proxy, connected_components_servant>
+{
+   template<typename... Args>
+   connected_components_servant_proxy(Args... args)
+       : boost::asynchronous::servant_proxy<connected_components_servant_proxy, connected_components_servant>(std::forward<Args>(args)...)
+   {}
+
+   BOOST_ASYNC_FUTURE_MEMBER(connected_components)
+};
+
+cvpg::image_gray_8bit create_test_mask()
+{
+    const std::uint32_t width = 40;
+    const std::uint32_t height = 30;
+
+    cvpg::image_gray_8bit image(width, height);
+
+    std::uint8_t * data = image.data(0).get();
+
+    std::memset(data, 0, width * height);
+
+    // blob 1: a 'U' shape crossing several tiles ; both arms are only connected at the bottom
+    for (std::uint32_t y = 2; y <= 20; ++y)
+    {
+        data[y * width + 3] = 255;
+        data[y * width + 30] = 255;
+    }
+
+    for (std::uint32_t x = 3; x <= 30; ++x)
+    {
+        data[20 * width + x] = 255;
+    }
+
+    // blob 2 and 3: two single pixels that are only connected diagonally
+    data[25 * width + 10] = 255;
+    data[26 * width + 11] = 255;
+
+    return image;
+}
+
+std::vector<float> read_values(cvpg::meta_data const & metadata, std::string key)
+{
+    auto data = std::any_cast<cvpg::multi_array<float> >(metadata.find(key + ".data")->second);
+
+    auto [it, end] = data[0];
+
+    return std::vector<float>(it, end);
+}
+
+}
+
+TEST(test_algorithms, connected_components_8_connected)
+{
+    // create a thread pool with multiple threads to process tiles concurrently
+    auto pool = boost::asynchronous::make_shared_scheduler_proxy<
+                    boost::asynchronous::multiqueue_threadpool_scheduler<
+                        boost::asynchronous::lockfree_queue<> > >(4);
+
+    // create a scheduler
+    auto scheduler = boost::asynchronous::make_shared_scheduler_proxy<
+                        boost::asynchronous::single_thread_scheduler<
+                            boost::asynchronous::lockfree_queue<> > >();
+
+    connected_components_servant_proxy tester(scheduler, pool);
+
+    try
+    {
+        auto f = tester.connected_components(create_test_mask(), 8);
+
+        auto status = f.wait_for(std::chrono::seconds(3));
+
+        ASSERT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+
+        auto image = std::move(f.get().get());
+
+        ASSERT_TRUE(image.has_metadata());
+
+        auto metadata = image.get_metadata();
+
+        ASSERT_TRUE(metadata->contains("blobs.boxes.data"));
+        ASSERT_TRUE(metadata->contains("blobs.boxes.dims"));
+        ASSERT_TRUE(metadata->contains("blobs.boxes.type"));
+        ASSERT_TRUE(metadata->contains("blobs.classes.data"));
+        ASSERT_TRUE(metadata->contains("blobs.scores.data"));
+        ASSERT_TRUE(metadata->contains("labels"));
+
+        auto areas = read_values(*metadata, "blobs.areas");
+
+        // the 'U' and the diagonal pair
+        ASSERT_EQ(areas.size(), 2);
+        ASSERT_EQ(areas[0], 19 + 19 + 26);
+        ASSERT_EQ(areas[1], 2);
+
+        auto boxes = read_values(*metadata, "blobs.boxes");
+
+        ASSERT_EQ(boxes.size(), 8);
+
+        // boxes are stored as [y_min, x_min, y_max, x_max] relative to the image dimensions
+        ASSERT_EQ(static_cast<std::uint32_t>(boxes[0] * image.height()), 2);
+        ASSERT_EQ(static_cast<std::uint32_t>(boxes[1] * image.width()), 3);
+        ASSERT_EQ(static_cast<std::uint32_t>(boxes[2] * image.height()), 20);
+        ASSERT_EQ(static_cast<std::uint32_t>(boxes[3] * image.width()), 30);
+    }
+    catch (std::exception const & e)
+    {
+        std::cerr << e.what() << std::endl << std::flush;
+
+        ASSERT_TRUE(false);
+    }
+    catch(...)
+    {
+        ASSERT_TRUE(false);
+    }
+}
+
+TEST(test_algorithms, connected_components_4_connected)
+{
+    // create a thread pool with multiple threads to process tiles concurrently
+    auto pool = boost::asynchronous::make_shared_scheduler_proxy<
+                    boost::asynchronous::multiqueue_threadpool_scheduler<
+                        boost::asynchronous::lockfree_queue<> > >(4);
+
+    // create a scheduler
+    auto scheduler = boost::asynchronous::make_shared_scheduler_proxy<
+                        boost::asynchronous::single_thread_scheduler<
+                            boost::asynchronous::lockfree_queue<> > >();
+
+    connected_components_servant_proxy tester(scheduler, pool);
+
+    try
+    {
+        auto f = tester.connected_components(create_test_mask(), 4);
+
+        auto status = f.wait_for(std::chrono::seconds(3));
+
+        ASSERT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+
+        auto image = std::move(f.get().get());
+
+        ASSERT_TRUE(image.has_metadata());
+
+        auto areas = read_values(*image.get_metadata(), "blobs.areas");
+
+        // the diagonal pair is split into two blobs
+        ASSERT_EQ(areas.size(), 3);
+        ASSERT_EQ(areas[0], 19 + 19 + 26);
+        ASSERT_EQ(areas[1], 1);
+        ASSERT_EQ(areas[2], 1);
+    }
+    catch (std::exception const & e)
+    {
+        std::cerr << e.what() << std::endl << std::flush;
+
+        ASSERT_TRUE(false);
+    }
+    catch(...)
+    {
+        ASSERT_TRUE(false);
+    }
+}
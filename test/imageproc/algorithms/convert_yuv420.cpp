@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <libcvpg/imageproc/algorithms/tiling/convert_yuv420.hpp>
+
+namespace {
+
+// convert a single pixel (stored as 2x2 block to get a complete chroma sample)
+std::vector<std::uint8_t> to_rgb(std::uint8_t y, std::uint8_t u, std::uint8_t v, cvpg::color_range range)
+{
+    std::vector<std::uint8_t> src_y(4, y);
+    std::uint8_t src_u = u;
+    std::uint8_t src_v = v;
+
+    std::vector<std::uint8_t> r(4), g(4), b(4);
+
+    cvpg::imageproc::algorithms::tiling_parameters parameters;
+    parameters.image_width = 2;
+    parameters.image_height = 2;
+
+    cvpg::imageproc::algorithms::convert_yuv420_to_rgb_8bit(src_y.data(), &src_u, &src_v, 2, 1, range, r.data(), g.data(), b.data(), 0, 1, 0, 1, parameters);
+
+    return { r[3], g[3], b[3] };
+}
+
+std::uint8_t to_gray(std::uint8_t y)
+{
+    // padded luma plane
+    std::vector<std::uint8_t> src_y = { 0, 0, 0, 0, y, 0 };
+    std::vector<std::uint8_t> dst(4, 0);
+
+    cvpg::imageproc::algorithms::tiling_parameters parameters;
+    parameters.image_width = 2;
+    parameters.image_height = 2;
+
+    cvpg::imageproc::algorithms::expand_luma_8bit(src_y.data(), 3, dst.data(), 0, 1, 0, 1, parameters);
+
+    return dst[3];
+}
+
+}
+
+TEST(test_convert_yuv420, limited_range)
+{
+    // black, white and saturation of the limited range
+    ASSERT_TRUE(to_rgb(16, 128, 128, cvpg::color_range::limited) == std::vector<std::uint8_t>({ 0, 0, 0 }));
+    ASSERT_TRUE(to_rgb(235, 128, 128, cvpg::color_range::limited) == std::vector<std::uint8_t>({ 255, 255, 255 }));
+    ASSERT_TRUE(to_rgb(0, 128, 128, cvpg::color_range::limited) == std::vector<std::uint8_t>({ 0, 0, 0 }));
+    ASSERT_TRUE(to_rgb(255, 128, 128, cvpg::color_range::limited) == std::vector<std::uint8_t>({ 255, 255, 255 }));
+
+    // red (BT.601, limited range)
+    ASSERT_TRUE(to_rgb(81, 90, 240, cvpg::color_range::limited) == std::vector<std::uint8_t>({ 255, 0, 0 }));
+}
+
+TEST(test_convert_yuv420, full_range)
+{
+    // luma is used unchanged without chroma
+    for (std::uint32_t y = 0; y < 256; ++y)
+    {
+        const auto v = static_cast<std::uint8_t>(y);
+
+        ASSERT_TRUE(to_rgb(v, 128, 128, cvpg::color_range::full) == std::vector<std::uint8_t>({ v, v, v }));
+    }
+
+    // red (BT.601, full range) ; V of red is 255.5 and cannot be stored exactly
+    {
+        const auto rgb = to_rgb(76, 85, 255, cvpg::color_range::full);
+        ASSERT_TRUE(rgb[0] >= 254 && rgb[1] == 0 && rgb[2] == 0);
+    }
+
+    // the limited range coefficients would exceed black and white
+    ASSERT_TRUE(to_rgb(16, 128, 128, cvpg::color_range::full) == std::vector<std::uint8_t>({ 16, 16, 16 }));
+    ASSERT_TRUE(to_rgb(235, 128, 128, cvpg::color_range::full) == std::vector<std::uint8_t>({ 235, 235, 235 }));
+}
+
+TEST(test_convert_yuv420, gray_matches_rgb)
+{
+    // the expanded luma is the same as the RGB view of a pixel without chroma
+    for (std::uint32_t y = 0; y < 256; ++y)
+    {
+        const auto v = static_cast<std::uint8_t>(y);
+        const auto rgb = to_rgb(v, 128, 128, cvpg::color_range::limited);
+
+        ASSERT_EQ(to_gray(v), rgb[0]);
+        ASSERT_EQ(to_gray(v), rgb[1]);
+        ASSERT_EQ(to_gray(v), rgb[2]);
+    }
+}
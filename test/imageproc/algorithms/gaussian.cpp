@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <libcvpg/imageproc/algorithms/tiling/gaussian.hpp>
+
+TEST(test_gaussian, kernel_sum)
+{
+    for (std::uint32_t scale : { 1u << 8, 1u << 16 })
+    {
+        for (double sigma = 0.1; sigma < 20.0; sigma += 0.01)
+        {
+            const std::int32_t radius = cvpg::imageproc::algorithms::gaussian_radius(sigma);
+
+            const auto kernel = cvpg::imageproc::algorithms::gaussian_kernel(sigma, radius, scale);
+
+            ASSERT_EQ(kernel.size(), static_cast<std::size_t>(2 * radius + 1));
+            ASSERT_EQ(std::accumulate(kernel.begin(), kernel.end(), std::uint64_t(0)), scale);
+
+            for (std::int32_t i = 0; i < radius; ++i)
+            {
+                ASSERT_EQ(kernel[i], kernel[2 * radius - i]);
+                ASSERT_TRUE(kernel[i] <= kernel[radius]);
+            }
+        }
+    }
+}
+
+TEST(test_gaussian, kernel_too_small_scale)
+{
+    // most weights are rounded up, so the outer weights have to be reduced
+    const auto kernel = cvpg::imageproc::algorithms::gaussian_kernel(100.0, 10, 16);
+
+    ASSERT_EQ(std::accumulate(kernel.begin(), kernel.end(), std::uint64_t(0)), 16);
+
+    for (std::size_t i = 0; i < kernel.size(); ++i)
+    {
+        ASSERT_TRUE(kernel[i] <= kernel[10]);
+    }
+}
+
+TEST(test_gaussian, constant_image)
+{
+    constexpr std::size_t width = 64;
+    constexpr std::size_t height = 48;
+
+    // white images must not overflow or be biased
+    for (double sigma : { 0.5, 1.0, 3.44, 4.7, 7.5 })
+    {
+        std::vector<std::uint8_t> src(width * height, 255);
+        std::vector<std::uint8_t> dst(width * height, 0);
+
+        cvpg::imageproc::algorithms::tiling_parameters parameters;
+        parameters.image_width = width;
+        parameters.image_height = height;
+        parameters.real_numbers = { sigma };
+        parameters.border_mode = cvpg::imageproc::algorithms::border_mode::mirror;
+
+        cvpg::imageproc::algorithms::gaussian_gray_8bit(src.data(), dst.data(), 0, width - 1, 0, height - 1, parameters);
+
+        for (auto value : dst)
+        {
+            ASSERT_EQ(value, 255);
+        }
+    }
+}
@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <boost/asynchronous/queue/lockfree_queue.hpp>
+#include <boost/asynchronous/scheduler_shared_proxy.hpp>
+#include <boost/asynchronous/scheduler/multiqueue_threadpool_scheduler.hpp>
+#include <boost/asynchronous/scheduler/single_thread_scheduler.hpp>
+
+#include <libcvpg/imageproc/scripting/image_processor.hpp>
+#include <libcvpg/imageproc/scripting/diagnostics/typedefs.hpp>
+
+TEST(test_scripting_algorithm_gaussian, compile_valid_parameters)
+{
+    // create a thread pool for a single thread
+    auto pool = boost::asynchronous::make_shared_scheduler_proxy<
+                    boost::asynchronous::multiqueue_threadpool_scheduler<
+                        boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(1, std::string("threadpool"));
+
+    // create image processor
+    auto scheduler = boost::asynchronous::make_shared_scheduler_proxy<
+                        boost::asynchronous::single_thread_scheduler<
+                            boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(std::string("image_processor"));
+
+    cvpg::imageproc::scripting::image_processor_proxy image_processor(scheduler, pool);
+
+    // good case
+    {
+        auto promise_compile = std::make_shared<std::promise<std::size_t> >();
+        auto future_compile = promise_compile->get_future();
+
+        image_processor.compile(
+            R"(
+                var input_gray = input("gray", 8)
+                var smoothed = gaussian(input_gray, 1.5)
+                var smoothed_mirror = gaussian(smoothed, 2.5, "mirror")
+                var smoothed_kernel = gaussian(smoothed_mirror, 4.0, "ignore", "kernel")
+                var smoothed_recursive = gaussian(smoothed_kernel, 0.8, "constant", "recursive")
+            )",
+            [promise_compile](std::size_t compile_id)
+            {
+                promise_compile->set_value(compile_id);
+            },
+            [promise_compile](std::size_t compile_id, std::string error)
+            {
+                ASSERT_TRUE(!error.empty());
+                ASSERT_TRUE(false);
+            }
+        );
+
+        auto status = future_compile.wait_for(std::chrono::seconds(3));
+
+        ASSERT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+    }
+}
+
+TEST(test_scripting_algorithm_gaussian, compile_invalid_parameters)
+{
+    // create a thread pool for a single thread
+    auto pool = boost::asynchronous::make_shared_scheduler_proxy<
+                    boost::asynchronous::multiqueue_threadpool_scheduler<
+                        boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(1, std::string("threadpool"));
+
+    // create image processor
+    auto scheduler = boost::asynchronous::make_shared_scheduler_proxy<
+                        boost::asynchronous::single_thread_scheduler<
+                            boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(std::string("image_processor"));
+
+    cvpg::imageproc::scripting::image_processor_proxy image_processor(scheduler, pool);
+
+    // case: invalid standard deviation
+    {
+        auto promise_compile = std::make_shared<std::promise<std::size_t> >();
+        auto future_compile = promise_compile->get_future();
+
+        image_processor.compile(
+            R"(
+                var input_gray = input("gray", 8)
+                var smoothed = gaussian(input_gray, 0.0)
+            )",
+            [promise_compile](std::size_t compile_id)
+            {
+                ASSERT_TRUE(false);
+            },
+            [promise_compile](std::size_t compile_id, std::string error)
+            {
+                ASSERT_TRUE(!error.empty());
+
+                promise_compile->set_value(compile_id);
+            }
+        );
+
+        auto status = future_compile.wait_for(std::chrono::seconds(3));
+
+        ASSERT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+    }
+
+    // case: invalid border mode
+    {
+        auto promise_compile = std::make_shared<std::promise<std::size_t> >();
+        auto future_compile = promise_compile->get_future();
+
+        image_processor.compile(
+            R"(
+                var input_gray = input("gray", 8)
+                var smoothed = gaussian(input_gray, 1.0, "foo")
+            )",
+            [promise_compile](std::size_t compile_id)
+            {
+                ASSERT_TRUE(false);
+            },
+            [promise_compile](std::size_t compile_id, std::string error)
+            {
+                ASSERT_TRUE(!error.empty());
+
+                promise_compile->set_value(compile_id);
+            }
+        );
+
+        auto status = future_compile.wait_for(std::chrono::seconds(3));
+
+        ASSERT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+    }
+
+    // case: invalid mode
+    {
+        auto promise_compile = std::make_shared<std::promise<std::size_t> >();
+        auto future_compile = promise_compile->get_future();
+
+        image_processor.compile(
+            R"(
+                var input_gray = input("gray", 8)
+                var smoothed = gaussian(input_gray, 1.0, "mirror", "foo")
+            )",
+            [promise_compile](std::size_t compile_id)
+            {
+                ASSERT_TRUE(false);
+            },
+            [promise_compile](std::size_t compile_id, std::string error)
+            {
+                ASSERT_TRUE(!error.empty());
+
+                promise_compile->set_value(compile_id);
+            }
+        );
+
+        auto status = future_compile.wait_for(std::chrono::seconds(3));
+
+        ASSERT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+    }
+
+    // case: standard deviation too small for recursive mode
+    {
+        auto promise_compile = std::make_shared<std::promise<std::size_t> >();
+        auto future_compile = promise_compile->get_future();
+
+        image_processor.compile(
+            R"(
+                var input_gray = input("gray", 8)
+                var smoothed = gaussian(input_gray, 0.3, "mirror", "recursive")
+            )",
+            [promise_compile](std::size_t compile_id)
+            {
+                ASSERT_TRUE(false);
+            },
+            [promise_compile](std::size_t compile_id, std::string error)
+            {
+                ASSERT_TRUE(!error.empty());
+
+                promise_compile->set_value(compile_id);
+            }
+        );
+
+        auto status = future_compile.wait_for(std::chrono::seconds(3));
+
+        ASSERT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+    }
+}
+
+TEST(test_scripting_algorithm_gaussian, evaluate_constant_image)
+{
+    // create a thread pool for a single thread
+    auto pool = boost::asynchronous::make_shared_scheduler_proxy<
+                    boost::asynchronous::multiqueue_threadpool_scheduler<
+                        boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(1, std::string("threadpool"));
+
+    // create image processor
+    auto scheduler = boost::asynchronous::make_shared_scheduler_proxy<
+                        boost::asynchronous::single_thread_scheduler<
+                            boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(std::string("image_processor"));
+
+    cvpg::imageproc::scripting::image_processor_proxy image_processor(scheduler, pool);
+
+    // use small tiles to check the handling of the borders between tiles
+    image_processor.add_param("cutoff_x", static_cast<std::uint32_t>(16));
+    image_processor.add_param("cutoff_y", static_cast<std::uint32_t>(16));
+
+    // a constant image has to be kept by both implementations
+    for (std::string mode : { "kernel", "recursive" })
+    {
+        std::size_t compile_id = 0;
+
+        // compile expression
+        {
+            auto promise_compile = std::make_shared<std::promise<std::size_t> >();
+            auto future_compile = promise_compile->get_future();
+
+            image_processor.compile(
+                std::string(R"(
+                    var input_gray = input("gray", 8)
+                    var smoothed = gaussian(input_gray, 2.0, "mirror", ")").append(mode).append(R"(")
+                )"),
+                [promise_compile](std::size_t compile_id)
+                {
+                    promise_compile->set_value(compile_id);
+                },
+                [promise_compile](std::size_t compile_id, std::string error)
+                {
+                    ASSERT_TRUE(false);
+                }
+            );
+
+            auto status = future_compile.wait_for(std::chrono::seconds(3));
+
+            ASSERT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+
+            compile_id = future_compile.get();
+        }
+
+        // evaluate
+        {
+            const std::uint32_t width = 64;
+            const std::uint32_t height = 48;
+
+            cvpg::image_gray_8bit image(width, height);
+
+            std::memset(image.data(0).get(), 100, width * height);
+
+            auto promise_evaluate = std::make_shared<std::promise<cvpg::image_gray_8bit> >();
+            auto future_evaluate = promise_evaluate->get_future();
+
+            image_processor.evaluate(
+                compile_id,
+                std::move(image),
+                [promise_evaluate](cvpg::imageproc::scripting::item item)
+                {
+                    ASSERT_TRUE(item.type() == cvpg::imageproc::scripting::item::types::grayscale_8_bit_image);
+
+                    auto image = std::any_cast<cvpg::image_gray_8bit>(item.value());
+
+                    promise_evaluate->set_value(std::move(image));
+                }
+            );
+
+            auto status = future_evaluate.wait_for(std::chrono::seconds(3));
+
+            ASSERT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+
+            auto smoothed_image = future_evaluate.get();
+
+            ASSERT_TRUE(smoothed_image.width() == width && smoothed_image.height() == height);
+
+            std::uint8_t * smoothed = smoothed_image.data(0).get();
+
+            for (std::uint32_t i = 0; i < width * height; ++i)
+            {
+                ASSERT_EQ(smoothed[i], 100);
+            }
+        }
+    }
+}
@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <cstring>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <boost/asynchronous/queue/lockfree_queue.hpp>
 #include <boost/asynchronous/scheduler_shared_proxy.hpp>
@@ -240,3 +242,285 @@ TEST(test_scripting, evaluate_simple_script)
         ASSERT_TRUE(converted_image.width() == 1024 && converted_image.height() == 768);
     }
 }
+
+TEST(test_scripting, evaluate_yuv420_image)
+{
+    // create a thread pool for a single thread
+    auto pool = boost::asynchronous::make_shared_scheduler_proxy<
+                    boost::asynchronous::multiqueue_threadpool_scheduler<
+                        boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(1, std::string("threadpool"));
+
+    // create image processor
+    auto scheduler = boost::asynchronous::make_shared_scheduler_proxy<
+                        boost::asynchronous::single_thread_scheduler<
+                            boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(std::string("scope"));
+
+    cvpg::imageproc::scripting::image_processor_proxy image_processor(scheduler, pool);
+
+    const std::uint32_t width = 64;
+    const std::uint32_t height = 48;
+
+    auto create_image =
+        [width, height]()
+        {
+            cvpg::image_yuv420_8bit image(width, height);
+
+            for (std::uint32_t y = 0; y < height; ++y)
+            {
+                for (std::uint32_t x = 0; x < width; ++x)
+                {
+                    image.data(0).get()[y * image.stride(0) + x] = static_cast<std::uint8_t>(x + y);
+                }
+            }
+
+            std::memset(image.data(1).get(), 128, image.stride(1) * image.plane_height(1));
+            std::memset(image.data(2).get(), 128, image.stride(2) * image.plane_height(2));
+
+            return image;
+        };
+
+    auto compile =
+        [&image_processor](std::string script)
+        {
+            auto promise_compile = std::make_shared<std::promise<std::size_t> >();
+            auto future_compile = promise_compile->get_future();
+
+            image_processor.compile(
+                std::move(script),
+                [promise_compile](std::size_t compile_id)
+                {
+                    promise_compile->set_value(compile_id);
+                },
+                [promise_compile](std::size_t compile_id, std::string error)
+                {
+                    ASSERT_TRUE(false);
+                }
+            );
+
+            auto status = future_compile.wait_for(std::chrono::seconds(3));
+
+            EXPECT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+
+            return future_compile.get();
+        };
+
+    // case: the grayscale input is the full range luma plane and a grayscale result is converted back to a YUV image
+    {
+        const std::size_t compile_id = compile(R"(var input_gray = input("gray", 8))");
+
+        auto promise_evaluate = std::make_shared<std::promise<cvpg::image_yuv420_8bit> >();
+        auto future_evaluate = promise_evaluate->get_future();
+
+        auto image = create_image();
+        image.set_range(cvpg::color_range::full);
+
+        image_processor.evaluate_convert_if(
+            compile_id,
+            std::move(image),
+            [promise_evaluate](cvpg::image_yuv420_8bit image)
+            {
+                promise_evaluate->set_value(std::move(image));
+            },
+            [](std::size_t compile_id, std::string error)
+            {
+                ASSERT_TRUE(false);
+            }
+        );
+
+        auto status = future_evaluate.wait_for(std::chrono::seconds(3));
+
+        ASSERT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+
+        auto result = future_evaluate.get();
+
+        ASSERT_TRUE(result.width() == width && result.height() == height);
+        ASSERT_TRUE(result.range() == cvpg::color_range::full);
+
+        for (std::uint32_t y = 0; y < height; ++y)
+        {
+            for (std::uint32_t x = 0; x < width; ++x)
+            {
+                ASSERT_EQ(result.data(0).get()[y * result.stride(0) + x], static_cast<std::uint8_t>(x + y));
+            }
+        }
+
+        for (std::uint32_t y = 0; y < result.plane_height(1); ++y)
+        {
+            for (std::uint32_t x = 0; x < result.plane_width(1); ++x)
+            {
+                ASSERT_EQ(result.data(1).get()[y * result.stride(1) + x], 128);
+                ASSERT_EQ(result.data(2).get()[y * result.stride(2) + x], 128);
+            }
+        }
+    }
+
+    // case: the grayscale input of a limited range image is expanded like the RGB input
+    {
+        const std::size_t compile_id = compile(R"(var input_gray = input("gray", 8))");
+
+        auto promise_evaluate = std::make_shared<std::promise<cvpg::image_gray_8bit> >();
+        auto future_evaluate = promise_evaluate->get_future();
+
+        auto image = create_image();
+        std::memset(image.data(0).get(), 128, image.stride(0) * image.plane_height(0));
+
+        image_processor.evaluate(
+            compile_id,
+            std::move(image),
+            [promise_evaluate](cvpg::imageproc::scripting::item item)
+            {
+                ASSERT_TRUE(item.type() == cvpg::imageproc::scripting::item::types::grayscale_8_bit_image);
+
+                promise_evaluate->set_value(std::any_cast<cvpg::image_gray_8bit>(item.value()));
+            }
+        );
+
+        auto status = future_evaluate.wait_for(std::chrono::seconds(3));
+
+        ASSERT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+
+        auto result = future_evaluate.get();
+
+        ASSERT_TRUE(result.width() == width && result.height() == height);
+
+        // same value as the channels of the RGB input below
+        for (std::uint32_t i = 0; i < width * height; ++i)
+        {
+            ASSERT_EQ(result.data(0).get()[i], 130);
+        }
+    }
+
+    // case: the RGB input is converted on demand (BT.601, limited range)
+    {
+        const std::size_t compile_id = compile(R"(
+            var input_rgb = input("rgb", 8)
+            var red = convert_to_gray(input_rgb, "use_red")
+        )");
+
+        auto promise_evaluate = std::make_shared<std::promise<cvpg::image_gray_8bit> >();
+        auto future_evaluate = promise_evaluate->get_future();
+
+        auto image = create_image();
+        std::memset(image.data(0).get(), 128, image.stride(0) * image.plane_height(0));
+
+        image_processor.evaluate(
+            compile_id,
+            std::move(image),
+            [promise_evaluate](cvpg::imageproc::scripting::item item)
+            {
+                ASSERT_TRUE(item.type() == cvpg::imageproc::scripting::item::types::grayscale_8_bit_image);
+
+                promise_evaluate->set_value(std::any_cast<cvpg::image_gray_8bit>(item.value()));
+            }
+        );
+
+        auto status = future_evaluate.wait_for(std::chrono::seconds(3));
+
+        ASSERT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+
+        auto result = future_evaluate.get();
+
+        ASSERT_TRUE(result.width() == width && result.height() == height);
+
+        for (std::uint32_t i = 0; i < width * height; ++i)
+        {
+            ASSERT_EQ(result.data(0).get()[i], 130);
+        }
+    }
+}
+
+TEST(test_scripting, evaluate_window)
+{
+    // create a thread pool for a single thread
+    auto pool = boost::asynchronous::make_shared_scheduler_proxy<
+                    boost::asynchronous::multiqueue_threadpool_scheduler<
+                        boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(1, std::string("threadpool"));
+
+    // create image processor
+    auto scheduler = boost::asynchronous::make_shared_scheduler_proxy<
+                        boost::asynchronous::single_thread_scheduler<
+                            boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(std::string("scope"));
+
+    cvpg::imageproc::scripting::image_processor_proxy image_processor(scheduler, pool);
+
+    const std::uint32_t width = 32;
+    const std::uint32_t height = 16;
+
+    // window of three images ordered like the window of the inter-frame stage: the newest image first
+    auto create_window =
+        [width, height]()
+        {
+            std::vector<cvpg::image_gray_8bit> images;
+
+            for (std::uint8_t value : { 30, 20, 10 })
+            {
+                cvpg::image_gray_8bit image(width, height);
+                std::memset(image.data(0).get(), value, width * height);
+
+                images.push_back(std::move(image));
+            }
+
+            return images;
+        };
+
+    auto evaluate =
+        [&image_processor, &create_window](std::string script)
+        {
+            auto promise_compile = std::make_shared<std::promise<std::size_t> >();
+            auto future_compile = promise_compile->get_future();
+
+            image_processor.compile(
+                std::move(script),
+                [promise_compile](std::size_t compile_id)
+                {
+                    promise_compile->set_value(compile_id);
+                },
+                [promise_compile](std::size_t compile_id, std::string error)
+                {
+                    ASSERT_TRUE(false);
+                }
+            );
+
+            auto status = future_compile.wait_for(std::chrono::seconds(3));
+
+            EXPECT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+
+            auto promise_evaluate = std::make_shared<std::promise<cvpg::image_gray_8bit> >();
+            auto future_evaluate = promise_evaluate->get_future();
+
+            image_processor.evaluate(
+                future_compile.get(),
+                create_window(),
+                [promise_evaluate](cvpg::imageproc::scripting::item item)
+                {
+                    ASSERT_TRUE(item.type() == cvpg::imageproc::scripting::item::types::grayscale_8_bit_image);
+
+                    promise_evaluate->set_value(std::any_cast<cvpg::image_gray_8bit>(item.value()));
+                }
+            );
+
+            status = future_evaluate.wait_for(std::chrono::seconds(3));
+
+            EXPECT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+
+            return future_evaluate.get();
+        };
+
+    // case: 'input(0)' is the newest image
+    {
+        auto result = evaluate(R"(var newest = input(0))");
+
+        ASSERT_TRUE(result.width() == width && result.height() == height);
+        ASSERT_EQ(result.data(0).get()[0], 30);
+        ASSERT_EQ(result.data(0).get()[width * height - 1], 30);
+    }
+
+    // case: 'input(window size - 1)' is the oldest image
+    {
+        auto result = evaluate(R"(var oldest = input(2))");
+
+        ASSERT_TRUE(result.width() == width && result.height() == height);
+        ASSERT_EQ(result.data(0).get()[0], 10);
+        ASSERT_EQ(result.data(0).get()[width * height - 1], 10);
+    }
+}
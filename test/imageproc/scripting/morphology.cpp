@@ -0,0 +1,267 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <boost/asynchronous/queue/lockfree_queue.hpp>
+#include <boost/asynchronous/scheduler_shared_proxy.hpp>
+#include <boost/asynchronous/scheduler/multiqueue_threadpool_scheduler.hpp>
+#include <boost/asynchronous/scheduler/single_thread_scheduler.hpp>
+
+#include <libcvpg/imageproc/scripting/image_processor.hpp>
+#include <libcvpg/imageproc/scripting/diagnostics/typedefs.hpp>
+
+TEST(test_scripting_algorithm_morphology, compile_valid_parameters)
+{
+    // create a thread pool for a single thread
+    auto pool = boost::asynchronous::make_shared_scheduler_proxy<
+                    boost::asynchronous::multiqueue_threadpool_scheduler<
+                        boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(1, std::string("threadpool"));
+
+    // create image processor
+    auto scheduler = boost::asynchronous::make_shared_scheduler_proxy<
+                        boost::asynchronous::single_thread_scheduler<
+                            boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(std::string("image_processor"));
+
+    cvpg::imageproc::scripting::image_processor_proxy image_processor(scheduler, pool);
+
+    // good case
+    {
+        auto promise_compile = std::make_shared<std::promise<std::size_t> >();
+        auto future_compile = promise_compile->get_future();
+
+        image_processor.compile(
+            R"(
+                var input_gray = input("gray", 8)
+                var eroded = erode(input_gray, 3, 5, "ignore")
+                var dilated = dilate(eroded, 5, 3, "mirror")
+                var opened = open(dilated, 7, 7)
+                var closed = close(opened, 9)
+                var edges = gradient(closed, 3, 3, "constant")
+            )",
+            [promise_compile](std::size_t compile_id)
+            {
+                promise_compile->set_value(compile_id);
+            },
+            [promise_compile](std::size_t compile_id, std::string error)
+            {
+                ASSERT_TRUE(!error.empty());
+                ASSERT_TRUE(false);
+            }
+        );
+
+        auto status = future_compile.wait_for(std::chrono::seconds(3));
+
+        ASSERT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+    }
+}
+
+TEST(test_scripting_algorithm_morphology, compile_invalid_parameters)
+{
+    // create a thread pool for a single thread
+    auto pool = boost::asynchronous::make_shared_scheduler_proxy<
+                    boost::asynchronous::multiqueue_threadpool_scheduler<
+                        boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(1, std::string("threadpool"));
+
+    // create image processor
+    auto scheduler = boost::asynchronous::make_shared_scheduler_proxy<
+                        boost::asynchronous::single_thread_scheduler<
+                            boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(std::string("image_processor"));
+
+    cvpg::imageproc::scripting::image_processor_proxy image_processor(scheduler, pool);
+
+    // case: invalid element width (even width)
+    {
+        auto promise_compile = std::make_shared<std::promise<std::size_t> >();
+        auto future_compile = promise_compile->get_future();
+
+        image_processor.compile(
+            R"(
+                var input_gray = input("gray", 8)
+                var eroded = erode(input_gray, 4, 3, "ignore")
+            )",
+            [promise_compile](std::size_t compile_id)
+            {
+                ASSERT_TRUE(false);
+            },
+            [promise_compile](std::size_t compile_id, std::string error)
+            {
+                ASSERT_TRUE(!error.empty());
+
+                promise_compile->set_value(compile_id);
+            }
+        );
+
+        auto status = future_compile.wait_for(std::chrono::seconds(3));
+
+        ASSERT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+    }
+
+    // case: invalid element height (even height)
+    {
+        auto promise_compile = std::make_shared<std::promise<std::size_t> >();
+        auto future_compile = promise_compile->get_future();
+
+        image_processor.compile(
+            R"(
+                var input_gray = input("gray", 8)
+                var opened = open(input_gray, 3, 4, "ignore")
+            )",
+            [promise_compile](std::size_t compile_id)
+            {
+                ASSERT_TRUE(false);
+            },
+            [promise_compile](std::size_t compile_id, std::string error)
+            {
+                ASSERT_TRUE(!error.empty());
+
+                promise_compile->set_value(compile_id);
+            }
+        );
+
+        auto status = future_compile.wait_for(std::chrono::seconds(3));
+
+        ASSERT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+    }
+
+    // case: invalid border mode
+    {
+        auto promise_compile = std::make_shared<std::promise<std::size_t> >();
+        auto future_compile = promise_compile->get_future();
+
+        image_processor.compile(
+            R"(
+                var input_gray = input("gray", 8)
+                var dilated = dilate(input_gray, 3, 3, "foo")
+            )",
+            [promise_compile](std::size_t compile_id)
+            {
+                ASSERT_TRUE(false);
+            },
+            [promise_compile](std::size_t compile_id, std::string error)
+            {
+                ASSERT_TRUE(!error.empty());
+
+                promise_compile->set_value(compile_id);
+            }
+        );
+
+        auto status = future_compile.wait_for(std::chrono::seconds(3));
+
+        ASSERT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+    }
+}
+
+TEST(test_scripting_algorithm_morphology, evaluate_open_removes_small_objects)
+{
+    // create a thread pool for a single thread
+    auto pool = boost::asynchronous::make_shared_scheduler_proxy<
+                    boost::asynchronous::multiqueue_threadpool_scheduler<
+                        boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(1, std::string("threadpool"));
+
+    // create image processor
+    auto scheduler = boost::asynchronous::make_shared_scheduler_proxy<
+                        boost::asynchronous::single_thread_scheduler<
+                            boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(std::string("image_processor"));
+
+    cvpg::imageproc::scripting::image_processor_proxy image_processor(scheduler, pool);
+
+    // use small tiles to check the halo handling between tiles
+    image_processor.add_param("cutoff_x", static_cast<std::uint32_t>(16));
+    image_processor.add_param("cutoff_y", static_cast<std::uint32_t>(16));
+
+    std::size_t compile_id = 0;
+
+    // compile expression
+    {
+        auto promise_compile = std::make_shared<std::promise<std::size_t> >();
+        auto future_compile = promise_compile->get_future();
+
+        image_processor.compile(
+            R"(
+                var input_gray = input("gray", 8)
+                var opened = open(input_gray, 5, 5, "constant")
+            )",
+            [promise_compile](std::size_t compile_id)
+            {
+                promise_compile->set_value(compile_id);
+            },
+            [promise_compile](std::size_t compile_id, std::string error)
+            {
+                ASSERT_TRUE(false);
+            }
+        );
+
+        auto status = future_compile.wait_for(std::chrono::seconds(3));
+
+        ASSERT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+
+        compile_id = future_compile.get();
+    }
+
+    // evaluate mask with a 3x3 object (should be removed) and a 10x10 object (should be kept)
+    {
+        const std::uint32_t width = 64;
+        const std::uint32_t height = 48;
+
+        cvpg::image_gray_8bit image(width, height);
+
+        std::uint8_t * data = image.data(0).get();
+
+        std::memset(data, 0, width * height);
+
+        for (std::uint32_t y = 5; y < 8; ++y)
+        {
+            for (std::uint32_t x = 5; x < 8; ++x)
+            {
+                data[y * width + x] = 255;
+            }
+        }
+
+        for (std::uint32_t y = 12; y < 22; ++y)
+        {
+            for (std::uint32_t x = 10; x < 20; ++x)
+            {
+                data[y * width + x] = 255;
+            }
+        }
+
+        auto promise_evaluate = std::make_shared<std::promise<cvpg::image_gray_8bit> >();
+        auto future_evaluate = promise_evaluate->get_future();
+
+        image_processor.evaluate(
+            compile_id,
+            std::move(image),
+            [promise_evaluate](cvpg::imageproc::scripting::item item)
+            {
+                ASSERT_TRUE(item.type() == cvpg::imageproc::scripting::item::types::grayscale_8_bit_image);
+
+                auto image = std::any_cast<cvpg::image_gray_8bit>(item.value());
+
+                promise_evaluate->set_value(std::move(image));
+            }
+        );
+
+        auto status = future_evaluate.wait_for(std::chrono::seconds(3));
+
+        ASSERT_TRUE(status != std::future_status::deferred && status != std::future_status::timeout);
+
+        auto opened_image = future_evaluate.get();
+
+        ASSERT_TRUE(opened_image.width() == width && opened_image.height() == height);
+
+        std::uint8_t * opened = opened_image.data(0).get();
+
+        for (std::uint32_t y = 0; y < height; ++y)
+        {
+            for (std::uint32_t x = 0; x < width; ++x)
+            {
+                const bool inside = x >= 10 && x < 20 && y >= 12 && y < 22;
+
+                ASSERT_EQ(opened[y * width + x], inside ? 255 : 0);
+            }
+        }
+    }
+}
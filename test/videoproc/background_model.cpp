@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <libcvpg/videoproc/processors/background_model.hpp>
+
+namespace {
+
+constexpr std::uint32_t width = 16;
+constexpr std::uint32_t height = 8;
+
+// a frame with a constant background and an optional bright box at the left top corner
+std::vector<std::uint8_t> create_frame(std::uint8_t background, bool box)
+{
+    std::vector<std::uint8_t> frame(width * height, background);
+
+    if (box)
+    {
+        for (std::uint32_t y = 0; y < 4; ++y)
+        {
+            for (std::uint32_t x = 0; x < 4; ++x)
+            {
+                frame[y * width + x] = 220;
+            }
+        }
+    }
+
+    return frame;
+}
+
+std::size_t count_foreground(std::vector<std::uint8_t> const & mask)
+{
+    std::size_t foreground = 0;
+
+    for (auto m : mask)
+    {
+        foreground += m == 255 ? 1 : 0;
+    }
+
+    return foreground;
+}
+
+}
+
+TEST(test_background_model, running_average)
+{
+    cvpg::videoproc::processors::background_parameters parameters;
+    parameters.method = cvpg::videoproc::processors::background_method::running_average;
+
+    cvpg::videoproc::processors::background_model model(parameters);
+    model.resize(width, height);
+
+    std::vector<std::uint8_t> mask(width * height, 1);
+
+    // the first frame initializes the model
+    auto background = create_frame(50, false);
+
+    model.update(background.data(), width, mask.data(), width);
+
+    ASSERT_EQ(model.frames(), 1);
+    ASSERT_EQ(count_foreground(mask), 0);
+    ASSERT_EQ(mask[0], 0);
+
+    // small changes are no foreground
+    auto brighter = create_frame(60, false);
+
+    model.update(brighter.data(), width, mask.data(), width);
+
+    ASSERT_EQ(count_foreground(mask), 0);
+
+    auto object = create_frame(50, true);
+
+    model.update(object.data(), width, mask.data(), width);
+
+    ASSERT_EQ(count_foreground(mask), 16);
+    ASSERT_EQ(mask[0], 255);
+    ASSERT_EQ(mask[4], 0);
+    ASSERT_EQ(mask[4 * width], 0);
+}
+
+TEST(test_background_model, gaussian_mixture)
+{
+    cvpg::videoproc::processors::background_parameters parameters;
+    parameters.method = cvpg::videoproc::processors::background_method::gaussian_mixture;
+    parameters.learning_rate = 0.05f;
+
+    cvpg::videoproc::processors::background_model model(parameters);
+    model.resize(width, height);
+
+    std::vector<std::uint8_t> mask(width * height);
+
+    auto background = create_frame(50, false);
+
+    for (std::size_t i = 0; i < 10; ++i)
+    {
+        model.update(background.data(), width, mask.data(), width);
+
+        ASSERT_EQ(count_foreground(mask), 0);
+    }
+
+    auto object = create_frame(50, true);
+
+    model.update(object.data(), width, mask.data(), width);
+
+    ASSERT_EQ(count_foreground(mask), 16);
+    ASSERT_EQ(mask[0], 255);
+
+    // an object that doesn't move becomes part of the background
+    for (std::size_t i = 0; i < 20; ++i)
+    {
+        model.update(object.data(), width, mask.data(), width);
+    }
+
+    ASSERT_EQ(count_foreground(mask), 0);
+
+    // the previous background is still known and is background again at once
+    model.update(background.data(), width, mask.data(), width);
+
+    ASSERT_EQ(count_foreground(mask), 0);
+}
+
+TEST(test_background_model, tiles)
+{
+    for (auto method : { cvpg::videoproc::processors::background_method::running_average,
+                         cvpg::videoproc::processors::background_method::gaussian_mixture })
+    {
+        cvpg::videoproc::processors::background_parameters parameters;
+        parameters.method = method;
+
+        cvpg::videoproc::processors::background_model whole(parameters);
+        whole.resize(width, height);
+
+        cvpg::videoproc::processors::background_model tiled(parameters);
+        tiled.resize(width, height);
+
+        std::vector<std::uint8_t> mask_whole(width * height);
+        std::vector<std::uint8_t> mask_tiled(width * height);
+
+        for (std::size_t i = 0; i < 5; ++i)
+        {
+            auto frame = create_frame(static_cast<std::uint8_t>(50 + i), i >= 3);
+
+            whole.update(frame.data(), width, mask_whole.data(), width);
+
+            // tiles are updated in any order
+            tiled.update(frame.data(), width, mask_tiled.data(), width, 5, height);
+            tiled.update(frame.data(), width, mask_tiled.data(), width, 0, 5);
+            tiled.finish_frame();
+
+            ASSERT_TRUE(mask_whole == mask_tiled);
+        }
+
+        ASSERT_EQ(count_foreground(mask_tiled), 16);
+    }
+}
+
+TEST(test_background_model, in_place)
+{
+    cvpg::videoproc::processors::background_model model;
+    model.resize(width, height);
+
+    auto frame = create_frame(50, false);
+    model.update(frame.data(), width, frame.data(), width);
+
+    // the mask could overwrite the intensities
+    frame = create_frame(50, true);
+    model.update(frame.data(), width, frame.data(), width);
+
+    ASSERT_EQ(count_foreground(frame), 16);
+    ASSERT_EQ(frame[0], 255);
+    ASSERT_EQ(frame[width * height - 1], 0);
+
+    // a new size drops the model
+    model.resize(width / 2, height);
+
+    ASSERT_EQ(model.frames(), 0);
+}
+
+TEST(test_background_model, limited_range)
+{
+    cvpg::videoproc::processors::background_parameters parameters;
+    parameters.method = cvpg::videoproc::processors::background_method::running_average;
+    parameters.threshold = 25.0f;
+
+    cvpg::videoproc::processors::background_model full(parameters);
+    full.resize(width, height);
+
+    cvpg::videoproc::processors::background_model limited(parameters);
+    limited.resize(width, height, cvpg::color_range::limited);
+
+    ASSERT_TRUE(limited.range() == cvpg::color_range::limited);
+
+    std::vector<std::uint8_t> mask(width * height);
+
+    auto background = create_frame(50, false);
+
+    full.update(background.data(), width, mask.data(), width);
+    limited.update(background.data(), width, mask.data(), width);
+
+    // a difference of 23 limited range values is about 27 full range values
+    auto brighter = create_frame(73, false);
+
+    full.update(brighter.data(), width, mask.data(), width);
+
+    ASSERT_EQ(count_foreground(mask), 0);
+
+    limited.update(brighter.data(), width, mask.data(), width);
+
+    ASSERT_EQ(count_foreground(mask), width * height);
+
+    // a new range drops the model
+    limited.resize(width, height, cvpg::color_range::full);
+
+    ASSERT_EQ(limited.frames(), 0);
+}
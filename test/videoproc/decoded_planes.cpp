@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <tuple>
+#include <vector>
+
+extern "C" {
+#include <libavutil/frame.h>
+#include <libavutil/pixfmt.h>
+#include <libswscale/swscale.h>
+}
+
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/imageproc/algorithms/tiling/convert_yuv420.hpp>
+#include <libcvpg/videoproc/sources/decoded_planes.hpp>
+
+namespace {
+
+constexpr int width = 64;
+constexpr int height = 32;
+
+// a frame with a horizontal ramp of all luma values and neutral chroma
+AVFrame * create_frame(AVPixelFormat pixel_format, AVColorRange color_range)
+{
+    AVFrame * frame = av_frame_alloc();
+    frame->format = pixel_format;
+    frame->width = width;
+    frame->height = height;
+    frame->color_range = color_range;
+
+    av_frame_get_buffer(frame, 0);
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            frame->data[0][y * frame->linesize[0] + x] = static_cast<std::uint8_t>((y * width + x) % 256);
+        }
+    }
+
+    for (int p = 1; p < 3 && frame->data[p] != nullptr; ++p)
+    {
+        for (int y = 0; y < (height + 1) / 2; ++y)
+        {
+            for (int x = 0; x < frame->linesize[p]; ++x)
+            {
+                frame->data[p][y * frame->linesize[p] + x] = 128;
+            }
+        }
+    }
+
+    return frame;
+}
+
+// grayscale image as converted by a conversion context
+std::vector<std::uint8_t> convert_to_gray(AVFrame const * frame)
+{
+    std::vector<std::uint8_t> gray(width * height);
+
+    SwsContext * sws_context = sws_getContext(width, height, static_cast<AVPixelFormat>(frame->format), width, height, AVPixelFormat::AV_PIX_FMT_GRAY8, 0, nullptr, nullptr, nullptr);
+
+    cvpg::videoproc::sources::set_source_color_range(sws_context, frame->color_range);
+
+    std::uint8_t * dst_data[4] = { gray.data(), nullptr, nullptr, nullptr };
+    int dst_linesize[4] = { width, 0, 0, 0 };
+
+    sws_scale(sws_context, frame->data, frame->linesize, 0, height, dst_data, dst_linesize);
+
+    sws_freeContext(sws_context);
+
+    return gray;
+}
+
+// compare the wrapped luma plane with the converted grayscale image
+void compare_with_conversion(AVPixelFormat pixel_format, AVColorRange color_range)
+{
+    AVFrame * frame = create_frame(pixel_format, color_range);
+
+    ASSERT_TRUE(cvpg::videoproc::sources::has_full_range_luma(pixel_format, color_range));
+
+    std::vector<cvpg::image_gray_8bit> images;
+
+    ASSERT_TRUE(cvpg::videoproc::sources::wrap_luma_plane(frame, images));
+    ASSERT_EQ(images.size(), 1);
+
+    const auto gray = convert_to_gray(frame);
+
+    auto const & image = images.front();
+    const std::size_t stride = image.width() + image.padding();
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            ASSERT_EQ(image.data(0).get()[y * stride + x], gray[y * width + x]);
+        }
+    }
+
+    av_frame_free(&frame);
+}
+
+}
+
+TEST(test_decoded_planes, full_range_luma_matches_conversion)
+{
+    compare_with_conversion(AVPixelFormat::AV_PIX_FMT_GRAY8, AVColorRange::AVCOL_RANGE_UNSPECIFIED);
+    compare_with_conversion(AVPixelFormat::AV_PIX_FMT_YUVJ420P, AVColorRange::AVCOL_RANGE_JPEG);
+    compare_with_conversion(AVPixelFormat::AV_PIX_FMT_YUV420P, AVColorRange::AVCOL_RANGE_JPEG);
+    compare_with_conversion(AVPixelFormat::AV_PIX_FMT_NV12, AVColorRange::AVCOL_RANGE_JPEG);
+}
+
+TEST(test_decoded_planes, limited_range_luma_is_wrapped)
+{
+    for (auto color_range : { AVColorRange::AVCOL_RANGE_UNSPECIFIED, AVColorRange::AVCOL_RANGE_MPEG })
+    {
+        ASSERT_FALSE(cvpg::videoproc::sources::has_full_range_luma(AVPixelFormat::AV_PIX_FMT_YUV420P, color_range));
+        ASSERT_FALSE(cvpg::videoproc::sources::has_full_range_luma(AVPixelFormat::AV_PIX_FMT_NV12, color_range));
+        ASSERT_TRUE(cvpg::videoproc::sources::has_luma_plane(AVPixelFormat::AV_PIX_FMT_YUV420P));
+        ASSERT_TRUE(cvpg::videoproc::sources::has_luma_plane(AVPixelFormat::AV_PIX_FMT_NV12));
+
+        AVFrame * frame = create_frame(AVPixelFormat::AV_PIX_FMT_YUV420P, color_range);
+
+        std::vector<cvpg::image_gray_8bit> images;
+
+        ASSERT_TRUE(cvpg::videoproc::sources::wrap_luma_plane(frame, images));
+        ASSERT_EQ(images.size(), 1);
+
+        // the plane of the decoder is used without copying and keeps its range
+        auto const & image = images.front();
+
+        ASSERT_TRUE(image.data(0).get() == frame->data[0]);
+        ASSERT_TRUE(image.range() == cvpg::color_range::limited);
+
+        // the expansion by the consumers matches the conversion of the decoded frame
+        const auto gray = convert_to_gray(frame);
+
+        // black and white of limited range luma are expanded to the full range
+        ASSERT_EQ(gray[16], 0);
+        ASSERT_EQ(gray[235], 255);
+
+        std::vector<std::uint8_t> expanded(width * height);
+
+        cvpg::imageproc::algorithms::tiling_parameters parameters;
+        parameters.image_width = width;
+        parameters.image_height = height;
+
+        cvpg::imageproc::algorithms::expand_luma_8bit(image.data(0).get(), image.width() + image.padding(), expanded.data(), 0, width - 1, 0, height - 1, parameters);
+
+        for (int i = 0; i < width * height; ++i)
+        {
+            ASSERT_TRUE(std::abs(static_cast<int>(expanded[i]) - static_cast<int>(gray[i])) <= 1);
+        }
+
+        // the plane of the decoder is not modified
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                ASSERT_EQ(frame->data[0][y * frame->linesize[0] + x], static_cast<std::uint8_t>((y * width + x) % 256));
+            }
+        }
+
+        images.clear();
+
+        av_frame_free(&frame);
+    }
+}
+
+TEST(test_decoded_planes, yuv420_planes_keep_color_range)
+{
+    const std::vector<std::tuple<AVPixelFormat, AVColorRange, cvpg::color_range> > formats =
+    {
+        { AVPixelFormat::AV_PIX_FMT_YUV420P, AVColorRange::AVCOL_RANGE_UNSPECIFIED, cvpg::color_range::limited },
+        { AVPixelFormat::AV_PIX_FMT_YUV420P, AVColorRange::AVCOL_RANGE_MPEG, cvpg::color_range::limited },
+        { AVPixelFormat::AV_PIX_FMT_YUV420P, AVColorRange::AVCOL_RANGE_JPEG, cvpg::color_range::full },
+        { AVPixelFormat::AV_PIX_FMT_YUVJ420P, AVColorRange::AVCOL_RANGE_UNSPECIFIED, cvpg::color_range::full }
+    };
+
+    for (auto const & [pixel_format, color_range, expected] : formats)
+    {
+        AVFrame * frame = create_frame(pixel_format, color_range);
+
+        std::vector<cvpg::image_yuv420_8bit> images;
+
+        ASSERT_TRUE(cvpg::videoproc::sources::wrap_yuv420_planes(frame, images));
+        ASSERT_EQ(images.size(), 1);
+        ASSERT_TRUE(images.front().range() == expected);
+
+        av_frame_free(&frame);
+    }
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <libcvpg/videoproc/fair_queue.hpp>
+
+TEST(test_fair_queue, max_running)
+{
+    auto queue = std::make_shared<cvpg::videoproc::fair_queue>(2);
+
+    const auto stream = queue->add_stream("stream");
+
+    std::vector<std::function<void()> > running;
+
+    for (std::size_t i = 0; i < 5; ++i)
+    {
+        queue->submit(stream, 1, [&running](std::function<void()> done){ running.push_back(std::move(done)); });
+    }
+
+    ASSERT_EQ(running.size(), 2);
+
+    // completing a job starts the next one
+    running[0]();
+
+    ASSERT_EQ(running.size(), 3);
+
+    auto statistics = queue->statistics();
+
+    ASSERT_EQ(statistics.size(), 1);
+    ASSERT_EQ(statistics[0].submitted, 5);
+    ASSERT_EQ(statistics[0].completed, 1);
+    ASSERT_EQ(statistics[0].running, 2);
+    ASSERT_EQ(statistics[0].queued, 2);
+}
+
+TEST(test_fair_queue, weighted_streams)
+{
+    auto queue = std::make_shared<cvpg::videoproc::fair_queue>(1);
+
+    const auto stream_a = queue->add_stream("a", 1.0);
+    const auto stream_b = queue->add_stream("b", 3.0);
+
+    std::vector<std::size_t> order;
+    std::vector<std::function<void()> > running;
+
+    auto job =
+        [&order, &running](std::size_t stream)
+        {
+            return [&order, &running, stream](std::function<void()> done)
+                   {
+                       order.push_back(stream);
+                       running.push_back(std::move(done));
+                   };
+        };
+
+    // the first job of stream 'a' starts immediately
+    for (std::size_t i = 0; i < 40; ++i)
+    {
+        queue->submit(stream_a, 100, job(stream_a));
+        queue->submit(stream_b, 100, job(stream_b));
+    }
+
+    for (std::size_t i = 0; i < 40; ++i)
+    {
+        running[i]();
+    }
+
+    ASSERT_EQ(order.size(), 41);
+
+    // stream 'b' gets three times the share of stream 'a'
+    std::size_t started_b = 0;
+
+    for (std::size_t i = 1; i < 41; ++i)
+    {
+        started_b += order[i] == stream_b ? 1 : 0;
+    }
+
+    ASSERT_EQ(started_b, 30);
+}
+
+TEST(test_fair_queue, idle_stream_gets_no_credit)
+{
+    auto queue = std::make_shared<cvpg::videoproc::fair_queue>(1);
+
+    const auto stream_a = queue->add_stream("a");
+    const auto stream_b = queue->add_stream("b");
+
+    std::vector<std::size_t> order;
+    std::vector<std::function<void()> > running;
+
+    auto job =
+        [&order, &running](std::size_t stream)
+        {
+            return [&order, &running, stream](std::function<void()> done)
+                   {
+                       order.push_back(stream);
+                       running.push_back(std::move(done));
+                   };
+        };
+
+    // only stream 'a' is busy for a while
+    for (std::size_t i = 0; i < 10; ++i)
+    {
+        queue->submit(stream_a, 1, job(stream_a));
+        running.back()();
+    }
+
+    for (std::size_t i = 0; i < 10; ++i)
+    {
+        queue->submit(stream_a, 1, job(stream_a));
+        queue->submit(stream_b, 1, job(stream_b));
+    }
+
+    for (std::size_t i = 10; i < 30; ++i)
+    {
+        running[i]();
+    }
+
+    ASSERT_EQ(order.size(), 30);
+
+    // both streams alternate, although stream 'b' was idle before
+    for (std::size_t i = 10; i < 30; i += 2)
+    {
+        ASSERT_NE(order[i], order[i + 1]);
+    }
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/videoproc/frame.hpp>
+#include <libcvpg/videoproc/packet.hpp>
+#include <libcvpg/videoproc/pipelines/fan_out.hpp>
+
+namespace {
+
+using frame_type = cvpg::videoproc::frame<cvpg::image_gray_8bit>;
+using packet_type = cvpg::videoproc::packet<frame_type>;
+
+packet_type create_packet(std::size_t number, std::size_t first_frame, std::size_t frames, bool flush = false)
+{
+    packet_type packet(number);
+
+    for (std::size_t i = 0; i < frames; ++i)
+    {
+        packet.add_frame(frame_type(first_frame + i, cvpg::image_gray_8bit(8, 8)));
+    }
+
+    if (flush)
+    {
+        packet.add_frame(frame_type(first_frame + frames));
+    }
+
+    return packet;
+}
+
+}
+
+TEST(test_fan_out, shared_frames)
+{
+    std::map<std::size_t, std::vector<packet_type> > delivered;
+
+    cvpg::videoproc::pipelines::fan_out<cvpg::image_gray_8bit> fan_out(
+        { cvpg::videoproc::pipelines::branch_policy::block, cvpg::videoproc::pipelines::branch_policy::block },
+        [&delivered](std::size_t branch, packet_type packet)
+        {
+            delivered[branch].push_back(std::move(packet));
+        },
+        [](std::size_t)
+        {}
+    );
+
+    fan_out.next(0, 10);
+    fan_out.next(1, 10);
+
+    auto packet = create_packet(0, 0, 3);
+
+    std::vector<std::uint8_t *> data;
+
+    for (auto const & f : packet.frames())
+    {
+        data.push_back(f.image().data(0).get());
+    }
+
+    fan_out.deliver(std::move(packet));
+
+    ASSERT_EQ(delivered.size(), 2);
+
+    // both branches have to get the same frames without copying the image data
+    for (std::size_t branch = 0; branch < 2; ++branch)
+    {
+        ASSERT_EQ(delivered[branch].size(), 1);
+
+        auto const & frames = delivered[branch].front().frames();
+
+        ASSERT_EQ(frames.size(), 3);
+
+        for (std::size_t i = 0; i < frames.size(); ++i)
+        {
+            ASSERT_EQ(frames[i].number(), i);
+            ASSERT_EQ(frames[i].image().data(0).get(), data[i]);
+        }
+    }
+}
+
+TEST(test_fan_out, combined_backpressure)
+{
+    std::vector<std::size_t> requests;
+
+    cvpg::videoproc::pipelines::fan_out<cvpg::image_gray_8bit> fan_out(
+        { cvpg::videoproc::pipelines::branch_policy::block, cvpg::videoproc::pipelines::branch_policy::block },
+        [](std::size_t, packet_type)
+        {},
+        [&requests](std::size_t max_new_data)
+        {
+            requests.push_back(max_new_data);
+        }
+    );
+
+    // the upstream stage is not asked until all blocking branches are ready
+    fan_out.next(0, 5);
+
+    ASSERT_TRUE(requests.empty());
+
+    // the slowest branch determines the amount of requested frames
+    fan_out.next(1, 2);
+
+    ASSERT_EQ(requests.size(), 1);
+    ASSERT_EQ(requests.back(), 2);
+
+    // the second branch is exhausted after delivering two frames
+    fan_out.deliver(create_packet(0, 0, 2));
+
+    ASSERT_EQ(requests.size(), 1);
+
+    fan_out.next(1, 4);
+
+    ASSERT_EQ(requests.size(), 2);
+    ASSERT_EQ(requests.back(), 3);
+}
+
+TEST(test_fan_out, drop_slow_branch)
+{
+    std::map<std::size_t, std::vector<packet_type> > delivered;
+    std::vector<std::size_t> requests;
+    std::size_t dropped = 0;
+
+    cvpg::videoproc::pipelines::fan_out<cvpg::image_gray_8bit> fan_out(
+        { cvpg::videoproc::pipelines::branch_policy::block, cvpg::videoproc::pipelines::branch_policy::drop },
+        [&delivered](std::size_t branch, packet_type packet)
+        {
+            delivered[branch].push_back(std::move(packet));
+        },
+        [&requests](std::size_t max_new_data)
+        {
+            requests.push_back(max_new_data);
+        },
+        [&dropped](std::size_t branch, std::size_t frames)
+        {
+            ASSERT_EQ(branch, 1);
+
+            dropped += frames;
+        }
+    );
+
+    // a dropping branch doesn't stall the upstream stage
+    fan_out.next(0, 3);
+
+    ASSERT_EQ(requests.size(), 1);
+    ASSERT_EQ(requests.back(), 3);
+
+    fan_out.next(1, 1);
+
+    auto packet = create_packet(0, 0, 3);
+    auto * newest = packet.frames().back().image().data(0).get();
+
+    fan_out.deliver(std::move(packet));
+
+    ASSERT_EQ(delivered[0].front().frames().size(), 3);
+
+    // the dropping branch gets the newest frame only, renumbered without gaps
+    ASSERT_EQ(delivered[1].size(), 1);
+    ASSERT_EQ(delivered[1].front().frames().size(), 1);
+    ASSERT_EQ(delivered[1].front().frames().front().number(), 0);
+    ASSERT_EQ(delivered[1].front().frames().front().image().data(0).get(), newest);
+
+    ASSERT_EQ(dropped, 2);
+    ASSERT_EQ(fan_out.dropped(1), 2);
+
+    // flush frames are never dropped
+    fan_out.next(0, 3);
+    fan_out.deliver(create_packet(1, 3, 2, true));
+
+    ASSERT_EQ(delivered[0].back().frames().size(), 3);
+    ASSERT_TRUE(delivered[0].back().flush());
+
+    ASSERT_EQ(delivered[1].size(), 2);
+    ASSERT_EQ(delivered[1].back().frames().size(), 1);
+    ASSERT_TRUE(delivered[1].back().flush());
+    ASSERT_EQ(delivered[1].back().frames().front().number(), 1);
+
+    ASSERT_EQ(dropped, 4);
+}
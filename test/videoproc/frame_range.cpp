@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <libcvpg/videoproc/sources/frame_range.hpp>
+
+TEST(test_frame_range, exclusive_end)
+{
+    cvpg::videoproc::sources::range_parameters parameters;
+    parameters.start = 1.0;
+    parameters.end = 2.0;
+
+    // 25 fps with a time base of 1/12800 (512 ticks per frame) starting at timestamp 1000
+    auto range = cvpg::videoproc::sources::frame_range::create(parameters, 25.0, 1.0 / 12800.0, 1000);
+
+    ASSERT_EQ(range.start, 1000 + 12800);
+    ASSERT_EQ(range.end, 1000 + 2 * 12800);
+
+    ASSERT_FALSE(range.accept(range.start - 1));
+    ASSERT_TRUE(range.accept(range.start));
+    ASSERT_TRUE(range.accept(range.end - 1));
+    ASSERT_FALSE(range.end_reached);
+
+    // the frame at the end is the first frame of the next range
+    ASSERT_FALSE(range.accept(range.end));
+    ASSERT_TRUE(range.end_reached);
+
+    // frames without a timestamp are never dropped
+    ASSERT_TRUE(range.accept(cvpg::videoproc::frame_timestamps::no_pts));
+}
+
+TEST(test_frame_range, frames_unit)
+{
+    cvpg::videoproc::sources::range_parameters parameters;
+    parameters.unit = cvpg::videoproc::sources::range_unit::frames;
+    parameters.end = 50.0;
+
+    auto range = cvpg::videoproc::sources::frame_range::create(parameters, 25.0, 1.0 / 25.0);
+
+    // a range from the start of the video has no start
+    ASSERT_EQ(range.start, cvpg::videoproc::frame_timestamps::no_pts);
+    ASSERT_EQ(range.end, 50);
+
+    std::size_t accepted = 0;
+
+    for (std::int64_t pts = 0; pts < 100; ++pts)
+    {
+        accepted += range.accept(pts) ? 1 : 0;
+    }
+
+    ASSERT_EQ(accepted, 50);
+}
+
+TEST(test_frame_range, split_tiles_duration)
+{
+    // an odd duration, so the borders of the ranges aren't multiples of the frame duration
+    const double duration = 10.01;
+    const std::size_t chunks = 7;
+
+    const auto ranges = cvpg::videoproc::sources::split_range(duration, chunks);
+
+    ASSERT_EQ(ranges.size(), chunks);
+
+    // the ranges start at 0, follow each other without overlap or gap and the last one is open-ended
+    ASSERT_EQ(ranges.front().start, 0.0);
+    ASSERT_TRUE(ranges.back().end < 0.0);
+
+    for (std::size_t i = 0; i + 1 < ranges.size(); ++i)
+    {
+        ASSERT_EQ(ranges[i].end, ranges[i + 1].start);
+        ASSERT_GT(ranges[i].end, ranges[i].start);
+    }
+
+    // each frame of the video is read by exactly one range
+    const double time_base = 1.0 / 90000.0;
+    const std::int64_t first = 3600;
+    const std::int64_t frame_duration = 3003;
+
+    std::vector<cvpg::videoproc::sources::frame_range> frame_ranges;
+
+    for (auto const & range : ranges)
+    {
+        frame_ranges.push_back(cvpg::videoproc::sources::frame_range::create(range, 29.97, time_base, first));
+    }
+
+    const std::int64_t last = first + static_cast<std::int64_t>(duration / time_base);
+
+    for (std::int64_t pts = first; pts < last; pts += frame_duration)
+    {
+        std::size_t accepted = 0;
+
+        for (auto & frame_range : frame_ranges)
+        {
+            accepted += frame_range.accept(pts) ? 1 : 0;
+        }
+
+        ASSERT_EQ(accepted, 1);
+    }
+
+    // the same holds for every single timestamp at the borders of the ranges
+    for (std::size_t i = 0; i + 1 < frame_ranges.size(); ++i)
+    {
+        const std::int64_t border = frame_ranges[i].end;
+
+        ASSERT_EQ(border, frame_ranges[i + 1].start);
+
+        for (std::int64_t pts = border - 2; pts <= border + 2; ++pts)
+        {
+            ASSERT_EQ(frame_ranges[i].accept(pts), pts < border);
+            ASSERT_EQ(frame_ranges[i + 1].accept(pts), pts >= border);
+        }
+    }
+}
+
+TEST(test_frame_range, single_chunk)
+{
+    const auto ranges = cvpg::videoproc::sources::split_range(5.0, 0);
+
+    ASSERT_EQ(ranges.size(), 1);
+    ASSERT_FALSE(ranges.front().enabled());
+}
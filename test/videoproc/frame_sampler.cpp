@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include <libcvpg/videoproc/sources/frame_sampler.hpp>
+
+TEST(test_frame_sampler, all_frames)
+{
+    cvpg::videoproc::sources::frame_sampler sampler;
+
+    ASSERT_FALSE(sampler.enabled());
+    ASSERT_FALSE(sampler.discard_non_reference());
+
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        ASSERT_TRUE(sampler.accept(static_cast<double>(i) / 25.0));
+    }
+
+    ASSERT_EQ(sampler.sampled_frames(100), 100);
+}
+
+TEST(test_frame_sampler, every_nth)
+{
+    cvpg::videoproc::sources::sampling_parameters parameters;
+    parameters.mode = cvpg::videoproc::sources::sampling_mode::every_nth;
+    parameters.every_nth = 5;
+
+    cvpg::videoproc::sources::frame_sampler sampler(parameters, 25.0);
+
+    ASSERT_TRUE(sampler.enabled());
+    ASSERT_TRUE(sampler.discard_non_reference());
+
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(sampler.accept(static_cast<double>(i) / 25.0), i % 5 == 0);
+    }
+
+    ASSERT_EQ(sampler.accepted(), 20);
+    ASSERT_EQ(sampler.skipped(), 80);
+    ASSERT_EQ(sampler.sampled_frames(100), 20);
+}
+
+TEST(test_frame_sampler, non_reference_frames)
+{
+    // IBBP stream ; with skipped non-reference frames only every 3rd frame is decoded
+    cvpg::videoproc::sources::sampling_parameters parameters;
+    parameters.mode = cvpg::videoproc::sources::sampling_mode::every_nth;
+    parameters.every_nth = 2;
+
+    cvpg::videoproc::sources::frame_sampler every_2nd(parameters, 25.0);
+
+    parameters.every_nth = 3;
+
+    cvpg::videoproc::sources::frame_sampler every_3rd(parameters, 25.0);
+
+    ASSERT_TRUE(every_2nd.discard_non_reference());
+    ASSERT_TRUE(every_3rd.discard_non_reference());
+
+    for (std::size_t i = 0; i < 30; i += 3)
+    {
+        ASSERT_TRUE(every_2nd.accept(static_cast<double>(i) / 25.0));
+        ASSERT_TRUE(every_3rd.accept(static_cast<double>(i) / 25.0));
+    }
+
+    // two B-frames in a row are more than the interval of every 2nd frame
+    ASSERT_FALSE(every_2nd.discard_non_reference());
+    ASSERT_TRUE(every_3rd.discard_non_reference());
+
+    // all frames are decoded again, but the stream keeps its B-frames
+    for (std::size_t i = 30; i < 40; ++i)
+    {
+        every_2nd.accept(static_cast<double>(i) / 25.0);
+    }
+
+    ASSERT_FALSE(every_2nd.discard_non_reference());
+}
+
+TEST(test_frame_sampler, target_fps)
+{
+    cvpg::videoproc::sources::sampling_parameters parameters;
+    parameters.mode = cvpg::videoproc::sources::sampling_mode::fps;
+    parameters.fps = 2.0;
+
+    cvpg::videoproc::sources::frame_sampler sampler(parameters, 30.0);
+
+    // 10 seconds at 30 fps with jittering timestamps
+    std::size_t accepted = 0;
+
+    for (std::size_t i = 0; i < 300; ++i)
+    {
+        const double jitter = (i % 2 == 0) ? 0.004 : -0.004;
+
+        if (sampler.accept(static_cast<double>(i) / 30.0 + jitter))
+        {
+            ++accepted;
+        }
+    }
+
+    ASSERT_EQ(accepted, 20);
+
+    // a gap (e.g. of discarded frames) doesn't cause a burst of sampled frames afterwards
+    ASSERT_TRUE(sampler.accept(20.0));
+    ASSERT_FALSE(sampler.accept(20.0 + 1.0 / 30.0));
+
+    // timestamps starting again restart the sampling
+    ASSERT_TRUE(sampler.accept(0.0));
+    ASSERT_FALSE(sampler.accept(1.0 / 30.0));
+}
+
+TEST(test_frame_sampler, unknown_timestamps)
+{
+    cvpg::videoproc::sources::sampling_parameters parameters;
+    parameters.mode = cvpg::videoproc::sources::sampling_mode::every_nth;
+    parameters.every_nth = 3;
+
+    cvpg::videoproc::sources::frame_sampler sampler(parameters, 25.0);
+
+    for (std::size_t i = 0; i < 30; ++i)
+    {
+        ASSERT_EQ(sampler.accept(), i % 3 == 0);
+    }
+}
+
+TEST(test_frame_sampler, keyframes)
+{
+    cvpg::videoproc::sources::sampling_parameters parameters;
+    parameters.mode = cvpg::videoproc::sources::sampling_mode::keyframes;
+
+    cvpg::videoproc::sources::frame_sampler sampler(parameters, 25.0);
+
+    ASSERT_TRUE(sampler.enabled());
+    ASSERT_TRUE(sampler.keyframes_only());
+
+    // the decoder outputs keyframes only, so all of them are sampled
+    ASSERT_TRUE(sampler.accept(0.0));
+    ASSERT_TRUE(sampler.accept(2.0));
+
+    // the amount of keyframes is unknown
+    ASSERT_EQ(sampler.sampled_frames(100), 0);
+}
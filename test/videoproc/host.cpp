@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+
+#include <boost/asynchronous/queue/lockfree_queue.hpp>
+#include <boost/asynchronous/scheduler_shared_proxy.hpp>
+#include <boost/asynchronous/scheduler/single_thread_scheduler.hpp>
+
+#include <libcvpg/imageproc/scripting/image_processor.hpp>
+#include <libcvpg/imageproc/scripting/diagnostics/typedefs.hpp>
+#include <libcvpg/videoproc/pipelines/host.hpp>
+#include <libcvpg/videoproc/pipelines/host_parameters.hpp>
+
+namespace {
+
+const std::string frame_script = R"(var input = input("rgb", 8))";
+const std::string interframe_script = R"(var newest = input(0))";
+
+bool compile(cvpg::imageproc::scripting::image_processor_proxy & image_processor, std::string script)
+{
+    auto promise_compile = std::make_shared<std::promise<bool> >();
+    auto future_compile = promise_compile->get_future();
+
+    image_processor.compile(
+        std::move(script),
+        [promise_compile](std::size_t)
+        {
+            promise_compile->set_value(true);
+        },
+        [promise_compile](std::size_t, std::string)
+        {
+            promise_compile->set_value(false);
+        }
+    );
+
+    return future_compile.wait_for(std::chrono::seconds(3)) == std::future_status::ready && future_compile.get();
+}
+
+cvpg::videoproc::pipelines::stream_parameters synthetic_stream(std::string name, cvpg::videoproc::sources::synthetic_pattern pattern, std::int64_t frames)
+{
+    cvpg::videoproc::pipelines::stream_parameters parameters;
+    parameters.name = std::move(name);
+    parameters.input = cvpg::videoproc::pipelines::input_type::synthetic;
+    parameters.uri = parameters.name;
+    parameters.synthetic.pattern = pattern;
+    parameters.synthetic.width = 64;
+    parameters.synthetic.height = 48;
+    parameters.synthetic.frames = frames;
+    parameters.frame_script = frame_script;
+    parameters.interframe_script = interframe_script;
+    parameters.sink = cvpg::videoproc::pipelines::sink_type::null;
+
+    return parameters;
+}
+
+}
+
+TEST(test_host, synthetic_streams)
+{
+    cvpg::videoproc::pipelines::host_parameters parameters;
+    parameters.threads = 2;
+    parameters.stream_groups = 4;
+
+    cvpg::videoproc::pipelines::host host(parameters);
+
+    ASSERT_EQ(host.fair_queue_depth(), 4);
+
+    auto scheduler = boost::asynchronous::make_shared_scheduler_proxy<
+                        boost::asynchronous::single_thread_scheduler<
+                            boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(std::string("image_processor"));
+
+    cvpg::imageproc::scripting::image_processor_proxy image_processor(scheduler, host.thread_pool());
+
+    ASSERT_TRUE(compile(image_processor, frame_script));
+    ASSERT_TRUE(compile(image_processor, interframe_script));
+
+    ASSERT_EQ(host.add_stream(synthetic_stream("bars", cvpg::videoproc::sources::synthetic_pattern::bars, 10), image_processor), 0);
+    ASSERT_EQ(host.add_stream(synthetic_stream("gradient", cvpg::videoproc::sources::synthetic_pattern::gradient, 20), image_processor), 1);
+
+    // there are never more groups than streams
+    ASSERT_EQ(host.streams(), 2);
+    ASSERT_EQ(host.groups(), 2);
+
+    host.start();
+
+    const auto results = host.wait_until(std::chrono::steady_clock::now() + std::chrono::seconds(30));
+
+    ASSERT_EQ(results.size(), 2);
+
+    for (auto const & result : results)
+    {
+        ASSERT_TRUE(result.state == cvpg::videoproc::pipelines::host::stream_state::finished);
+        ASSERT_TRUE(result.error.empty());
+    }
+
+    ASSERT_EQ(host.frames_saved(0), 10);
+    ASSERT_EQ(host.frames_saved(1), 20);
+
+    // all frames of both streams are evaluated by the shared fair queue
+    const auto statistics = host.statistics();
+
+    ASSERT_EQ(statistics.size(), 2);
+    ASSERT_EQ(statistics[0].name, "bars");
+    ASSERT_EQ(statistics[1].name, "gradient");
+    ASSERT_GT(statistics[0].completed, 0);
+    ASSERT_GT(statistics[1].completed, 0);
+
+    // waiting again returns the same results
+    const auto again = host.wait_until(std::chrono::steady_clock::now());
+
+    ASSERT_TRUE(again[0].state == cvpg::videoproc::pipelines::host::stream_state::finished);
+    ASSERT_TRUE(again[1].state == cvpg::videoproc::pipelines::host::stream_state::finished);
+}
+
+TEST(test_host, round_robin_groups)
+{
+    cvpg::videoproc::pipelines::host_parameters parameters;
+    parameters.threads = 1;
+    parameters.stream_groups = 2;
+    parameters.fair_sharing = false;
+    parameters.memory_budget = 64 * 1024 * 1024;
+
+    cvpg::videoproc::pipelines::host host(parameters);
+
+    ASSERT_TRUE(host.memory_budget() != nullptr);
+
+    auto scheduler = boost::asynchronous::make_shared_scheduler_proxy<
+                        boost::asynchronous::single_thread_scheduler<
+                            boost::asynchronous::lockfree_queue<cvpg::imageproc::scripting::diagnostics::servant_job> > >(std::string("image_processor"));
+
+    cvpg::imageproc::scripting::image_processor_proxy image_processor(scheduler, host.thread_pool());
+
+    ASSERT_TRUE(compile(image_processor, frame_script));
+    ASSERT_TRUE(compile(image_processor, interframe_script));
+
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        host.add_stream(synthetic_stream("noise" + std::to_string(i), cvpg::videoproc::sources::synthetic_pattern::noise, 5), image_processor);
+    }
+
+    ASSERT_EQ(host.groups(), 2);
+
+    host.start();
+
+    const auto results = host.wait_until(std::chrono::steady_clock::now() + std::chrono::seconds(30));
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        ASSERT_TRUE(results[i].state == cvpg::videoproc::pipelines::host::stream_state::finished);
+        ASSERT_EQ(host.frames_saved(i), 5);
+    }
+
+    // the streams aren't registered at the fair queue
+    ASSERT_TRUE(host.statistics().empty());
+}
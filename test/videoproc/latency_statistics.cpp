@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+
+#include <libcvpg/videoproc/latency_statistics.hpp>
+
+TEST(test_latency_statistics, percentiles)
+{
+    cvpg::videoproc::latency_statistics statistics;
+
+    for (std::int64_t i = 1; i <= 1000; ++i)
+    {
+        statistics.add("stage", std::chrono::microseconds(i * 100));
+    }
+
+    ASSERT_EQ(statistics.count("stage"), 1000);
+    ASSERT_EQ(statistics.max("stage").count(), 100000);
+
+    // the histogram has a relative resolution of about 6%
+    const auto p50 = statistics.percentile("stage", 50.0).count();
+    const auto p99 = statistics.percentile("stage", 99.0).count();
+
+    ASSERT_GE(p50, 47000);
+    ASSERT_LE(p50, 53000);
+    ASSERT_GE(p99, 93000);
+    ASSERT_LE(p99, 100000);
+
+    ASSERT_EQ(statistics.percentile("stage", 100.0).count(), 100000);
+
+    // small latencies are counted exactly
+    statistics.add("fast", std::chrono::microseconds(3));
+
+    ASSERT_EQ(statistics.percentile("fast", 50.0).count(), 3);
+
+    // unknown stages have no latencies
+    ASSERT_EQ(statistics.count("unknown"), 0);
+    ASSERT_EQ(statistics.percentile("unknown", 50.0).count(), 0);
+}
+
+TEST(test_latency_statistics, frame_stages)
+{
+    using clock = cvpg::videoproc::frame_timestamps::clock;
+
+    cvpg::videoproc::latency_statistics statistics;
+
+    const auto decoded = clock::now();
+
+    cvpg::videoproc::frame_timestamps timestamps;
+    timestamps.pts = 3000;
+    timestamps.decoded = decoded;
+    timestamps.stages.push_back({ "processors::frame", decoded + std::chrono::microseconds(10) });
+    timestamps.stages.push_back({ "sinks::file", decoded + std::chrono::microseconds(14) });
+
+    statistics.add(timestamps, decoded + std::chrono::microseconds(15));
+
+    const auto stages = statistics.stages();
+
+    ASSERT_EQ(stages.size(), 4);
+    ASSERT_EQ(stages[0], cvpg::videoproc::latency_statistics::source);
+    ASSERT_EQ(stages[1], "processors::frame");
+    ASSERT_EQ(stages[2], "sinks::file");
+    ASSERT_EQ(stages[3], cvpg::videoproc::latency_statistics::total);
+
+    ASSERT_EQ(statistics.max(cvpg::videoproc::latency_statistics::source).count(), 10);
+    ASSERT_EQ(statistics.max("processors::frame").count(), 4);
+    ASSERT_EQ(statistics.max("sinks::file").count(), 1);
+    ASSERT_EQ(statistics.max(cvpg::videoproc::latency_statistics::total).count(), 15);
+
+    // frames without a decoding time have no source and total latencies
+    cvpg::videoproc::frame_timestamps generated;
+    generated.stages.push_back({ "sinks::file", decoded });
+
+    statistics.add(generated, decoded + std::chrono::microseconds(2));
+
+    ASSERT_EQ(statistics.count("sinks::file"), 2);
+    ASSERT_EQ(statistics.count(cvpg::videoproc::latency_statistics::total), 1);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <libcvpg/videoproc/processors/motion_gate.hpp>
+
+namespace {
+
+constexpr std::uint32_t width = 64;
+constexpr std::uint32_t height = 32;
+
+// a frame with a constant background and a bright box of 8x8 pixels at position 'x'
+std::vector<std::uint8_t> create_frame(std::uint8_t background, std::uint32_t x)
+{
+    std::vector<std::uint8_t> frame(width * height, background);
+
+    for (std::uint32_t y = 8; y < 16; ++y)
+    {
+        for (std::uint32_t i = x; i < x + 8; ++i)
+        {
+            frame[y * width + i] = 200;
+        }
+    }
+
+    return frame;
+}
+
+cvpg::videoproc::processors::gating_parameters create_parameters()
+{
+    cvpg::videoproc::processors::gating_parameters parameters;
+    parameters.mode = cvpg::videoproc::processors::gating_mode::previous_result;
+    parameters.scale = 2;
+    parameters.block_size = 4;
+    parameters.static_threshold = 2.0f;
+    parameters.motion_threshold = 4.0f;
+    parameters.max_skipped = 3;
+
+    return parameters;
+}
+
+}
+
+TEST(test_motion_gate, static_scene)
+{
+    cvpg::videoproc::processors::motion_gate gate(create_parameters());
+
+    auto frame = create_frame(50, 0);
+
+    // the first frame is always processed
+    ASSERT_TRUE(gate.process(frame.data(), width, width, height));
+
+    // frames without changes are skipped until the maximum amount of skipped frames is reached
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        ASSERT_FALSE(gate.process(frame.data(), width, width, height));
+        ASSERT_EQ(gate.skipped(), i + 1);
+    }
+
+    ASSERT_TRUE(gate.process(frame.data(), width, width, height));
+    ASSERT_EQ(gate.skipped(), 0);
+    ASSERT_FALSE(gate.process(frame.data(), width, width, height));
+}
+
+TEST(test_motion_gate, moving_object)
+{
+    cvpg::videoproc::processors::motion_gate gate(create_parameters());
+
+    auto first = create_frame(50, 0);
+
+    ASSERT_TRUE(gate.process(first.data(), width, width, height));
+    ASSERT_FALSE(gate.process(first.data(), width, width, height));
+    ASSERT_FALSE(gate.moving());
+
+    // a small object changes only some blocks of the frame
+    for (std::uint32_t x = 8; x < 40; x += 8)
+    {
+        auto frame = create_frame(50, x);
+
+        ASSERT_TRUE(gate.process(frame.data(), width, width, height));
+        ASSERT_TRUE(gate.moving());
+        ASSERT_GT(gate.change(), 4.0f);
+    }
+}
+
+TEST(test_motion_gate, hysteresis)
+{
+    cvpg::videoproc::processors::motion_gate gate(create_parameters());
+
+    auto dark = create_frame(50, 0);
+    auto bright = create_frame(53, 0);
+
+    // a change between both thresholds keeps a moving scene moving
+    ASSERT_TRUE(gate.process(dark.data(), width, width, height));
+    ASSERT_TRUE(gate.moving());
+
+    ASSERT_TRUE(gate.process(bright.data(), width, width, height));
+    ASSERT_TRUE(gate.moving());
+
+    // ... and a static scene static
+    ASSERT_FALSE(gate.process(bright.data(), width, width, height));
+    ASSERT_FALSE(gate.moving());
+
+    ASSERT_FALSE(gate.process(dark.data(), width, width, height));
+    ASSERT_FALSE(gate.moving());
+}
+
+TEST(test_motion_gate, size_change)
+{
+    cvpg::videoproc::processors::motion_gate gate(create_parameters());
+
+    auto frame = create_frame(50, 0);
+
+    ASSERT_TRUE(gate.process(frame.data(), width, width, height));
+    ASSERT_FALSE(gate.process(frame.data(), width, width, height));
+
+    // a new frame size starts with a new reference frame
+    ASSERT_TRUE(gate.process(frame.data(), width, width / 2, height));
+    ASSERT_FALSE(gate.process(frame.data(), width, width / 2, height));
+
+    // frames smaller than a downscaled pixel are always processed
+    ASSERT_TRUE(gate.process(frame.data(), width, 1, 1));
+    ASSERT_TRUE(gate.process(frame.data(), width, 1, 1));
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+#include <libcvpg/videoproc/sources/packet_forwarder.hpp>
+
+namespace {
+
+// a forwarder of H.264 packets in Annex B format, which are used as they are
+std::unique_ptr<cvpg::videoproc::sources::packet_forwarder> create_forwarder()
+{
+    AVCodecParameters * codec_parameters = avcodec_parameters_alloc();
+    codec_parameters->codec_type = AVMEDIA_TYPE_VIDEO;
+    codec_parameters->codec_id = AV_CODEC_ID_H264;
+
+    auto forwarder = std::make_unique<cvpg::videoproc::sources::packet_forwarder>();
+
+    const bool opened = forwarder->open(codec_parameters, AVRational{ 1, 25 });
+
+    avcodec_parameters_free(&codec_parameters);
+
+    return opened ? std::move(forwarder) : nullptr;
+}
+
+void add_packet(cvpg::videoproc::sources::packet_forwarder & forwarder, std::int64_t pts, std::int64_t dts, bool keyframe)
+{
+    AVPacket * packet = av_packet_alloc();
+
+    av_new_packet(packet, 4);
+    std::memset(packet->data, static_cast<int>(pts & 0xFF), 4);
+
+    packet->pts = pts;
+    packet->dts = dts;
+    packet->flags = keyframe ? AV_PKT_FLAG_KEY : 0;
+
+    forwarder.add(packet);
+
+    av_packet_free(&packet);
+}
+
+}
+
+TEST(test_packet_forwarder, take_packets)
+{
+    auto forwarder = create_forwarder();
+
+    ASSERT_TRUE(forwarder != nullptr);
+
+    // IBBP stream in decode order
+    add_packet(*forwarder, 0, -1, true);
+    add_packet(*forwarder, 3, 0, false);
+    add_packet(*forwarder, 1, 1, false);
+    add_packet(*forwarder, 2, 2, false);
+
+    ASSERT_EQ(forwarder->pending(), 4);
+
+    auto first = forwarder->take(0);
+
+    ASSERT_TRUE(first != nullptr);
+    ASSERT_EQ(first->codec_id, static_cast<int>(AV_CODEC_ID_H264));
+    ASSERT_EQ(first->gop, 0);
+    ASSERT_EQ(first->index, 0);
+    ASSERT_EQ(first->pts, 0);
+    ASSERT_EQ(first->dts, -1);
+    ASSERT_EQ(first->data.size(), 4);
+    ASSERT_EQ(forwarder->pending(), 3);
+
+    // a packet is taken only once
+    ASSERT_TRUE(forwarder->take(0) == nullptr);
+
+    auto second = forwarder->take(1);
+
+    ASSERT_TRUE(second != nullptr);
+    ASSERT_EQ(second->index, 2);
+    ASSERT_EQ(second->data[0], 1);
+}
+
+TEST(test_packet_forwarder, release_dropped_packets)
+{
+    auto forwarder = create_forwarder();
+
+    ASSERT_TRUE(forwarder != nullptr);
+
+    for (std::int64_t pts = 0; pts < 5; ++pts)
+    {
+        add_packet(*forwarder, pts, pts, pts == 0);
+    }
+
+    // the frames before the taken one were dropped, e.g. by sampling
+    auto packet = forwarder->take(3);
+
+    ASSERT_TRUE(packet != nullptr);
+    ASSERT_EQ(packet->index, 3);
+    ASSERT_EQ(forwarder->pending(), 1);
+
+    ASSERT_TRUE(forwarder->take(1) == nullptr);
+    ASSERT_TRUE(forwarder->take(4) != nullptr);
+    ASSERT_EQ(forwarder->pending(), 0);
+}
+
+TEST(test_packet_forwarder, unknown_timestamps)
+{
+    auto forwarder = create_forwarder();
+
+    ASSERT_TRUE(forwarder != nullptr);
+
+    add_packet(*forwarder, 0, 0, true);
+    add_packet(*forwarder, AV_NOPTS_VALUE, 1, false);
+    add_packet(*forwarder, 2, AV_NOPTS_VALUE, false);
+
+    // a packet without a timestamp isn't kept, but counts as part of its GOP
+    ASSERT_EQ(forwarder->pending(), 2);
+    ASSERT_TRUE(forwarder->take(AV_NOPTS_VALUE) == nullptr);
+    ASSERT_TRUE(forwarder->take(7) == nullptr);
+    ASSERT_EQ(forwarder->pending(), 2);
+
+    auto packet = forwarder->take(2);
+
+    ASSERT_TRUE(packet != nullptr);
+    ASSERT_EQ(packet->index, 2);
+
+    // the decode timestamp falls back to the presentation timestamp
+    ASSERT_EQ(packet->dts, 2);
+}
+
+TEST(test_packet_forwarder, gops)
+{
+    auto forwarder = create_forwarder();
+
+    ASSERT_TRUE(forwarder != nullptr);
+
+    // packets before the first keyframe could not be decoded on their own
+    add_packet(*forwarder, 0, 0, false);
+
+    ASSERT_EQ(forwarder->pending(), 0);
+
+    for (std::int64_t pts = 1; pts < 7; ++pts)
+    {
+        add_packet(*forwarder, pts, pts, pts % 3 == 1);
+    }
+
+    for (std::int64_t pts = 1; pts < 7; ++pts)
+    {
+        auto packet = forwarder->take(pts);
+
+        ASSERT_TRUE(packet != nullptr);
+        ASSERT_EQ(packet->gop, static_cast<std::size_t>((pts - 1) / 3));
+        ASSERT_EQ(packet->index, static_cast<std::size_t>((pts - 1) % 3));
+    }
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/videoproc/frame.hpp>
+#include <libcvpg/videoproc/sinks/passthrough.hpp>
+
+namespace {
+
+const int h264 = 27;
+const int hevc = 173;
+
+cvpg::videoproc::frame<cvpg::image_gray_8bit> create_frame(std::size_t gop, std::size_t index, int codec_id = h264, bool modified = false)
+{
+    auto source = std::make_shared<cvpg::videoproc::source_packet>();
+    source->codec_id = codec_id;
+    source->gop = gop;
+    source->index = index;
+    source->pts = static_cast<std::int64_t>(index);
+    source->dts = static_cast<std::int64_t>(index);
+
+    cvpg::videoproc::frame<cvpg::image_gray_8bit> frame(index, cvpg::image_gray_8bit(4, 4));
+    frame.set_source(std::move(source), modified);
+
+    return frame;
+}
+
+// frames of a complete GOP in presentation order of an IBBP stream
+std::vector<cvpg::videoproc::frame<cvpg::image_gray_8bit> > create_gop(std::size_t gop = 0)
+{
+    std::vector<cvpg::videoproc::frame<cvpg::image_gray_8bit> > frames;
+
+    for (std::size_t index : { 0, 2, 3, 1, 5, 6, 4 })
+    {
+        frames.push_back(create_frame(gop, index));
+    }
+
+    return frames;
+}
+
+}
+
+TEST(test_passthrough, complete_gop)
+{
+    ASSERT_TRUE(cvpg::videoproc::sinks::is_passthrough_segment(create_gop(), h264));
+    ASSERT_TRUE(cvpg::videoproc::sinks::is_passthrough_segment(create_gop(3), h264));
+}
+
+TEST(test_passthrough, empty_segment)
+{
+    ASSERT_FALSE(cvpg::videoproc::sinks::is_passthrough_segment(std::vector<cvpg::videoproc::frame<cvpg::image_gray_8bit> >(), h264));
+}
+
+TEST(test_passthrough, modified_frame)
+{
+    auto frames = create_gop();
+    frames[2] = create_frame(0, 3, h264, true);
+
+    ASSERT_FALSE(cvpg::videoproc::sinks::is_passthrough_segment(frames, h264));
+}
+
+TEST(test_passthrough, missing_source)
+{
+    auto frames = create_gop();
+    frames.front() = cvpg::videoproc::frame<cvpg::image_gray_8bit>(0, cvpg::image_gray_8bit(4, 4));
+
+    ASSERT_FALSE(cvpg::videoproc::sinks::is_passthrough_segment(frames, h264));
+
+    frames = create_gop();
+    frames.back() = cvpg::videoproc::frame<cvpg::image_gray_8bit>(6, cvpg::image_gray_8bit(4, 4));
+
+    ASSERT_FALSE(cvpg::videoproc::sinks::is_passthrough_segment(frames, h264));
+}
+
+TEST(test_passthrough, incomplete_gop)
+{
+    // a dropped frame leaves a gap in the packets of the GOP
+    auto frames = create_gop();
+    frames.erase(frames.begin() + 1);
+
+    ASSERT_FALSE(cvpg::videoproc::sinks::is_passthrough_segment(frames, h264));
+
+    // a duplicated frame uses a packet twice
+    frames.push_back(create_frame(0, 0));
+
+    ASSERT_FALSE(cvpg::videoproc::sinks::is_passthrough_segment(frames, h264));
+}
+
+TEST(test_passthrough, mixed_gops)
+{
+    auto frames = create_gop();
+    frames.back() = create_frame(1, 4);
+
+    ASSERT_FALSE(cvpg::videoproc::sinks::is_passthrough_segment(frames, h264));
+}
+
+TEST(test_passthrough, other_codec)
+{
+    ASSERT_FALSE(cvpg::videoproc::sinks::is_passthrough_segment(create_gop(), hevc));
+
+    auto frames = create_gop();
+    frames.back() = create_frame(0, 4, hevc);
+
+    ASSERT_FALSE(cvpg::videoproc::sinks::is_passthrough_segment(frames, h264));
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/videoproc/sources/pattern_generator.hpp>
+
+namespace {
+
+bool equal_planes(cvpg::image_yuv420_8bit const & a, cvpg::image_yuv420_8bit const & b)
+{
+    for (std::uint8_t p = 0; p < 3; ++p)
+    {
+        for (std::uint32_t y = 0; y < a.plane_height(p); ++y)
+        {
+            if (std::memcmp(a.data(p).get() + y * a.stride(p), b.data(p).get() + y * b.stride(p), a.plane_width(p)) != 0)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+}
+
+TEST(test_pattern_generator, bars)
+{
+    cvpg::videoproc::sources::synthetic_parameters parameters;
+    parameters.pattern = cvpg::videoproc::sources::synthetic_pattern::bars;
+    parameters.width = 80;
+    parameters.height = 10;
+
+    cvpg::videoproc::sources::pattern_generator<cvpg::image_rgb_8bit> generator(parameters);
+
+    auto image = generator.generate(0);
+
+    ASSERT_EQ(image.width(), 80);
+    ASSERT_EQ(image.height(), 10);
+
+    // white, yellow, ... , black bars of 10 pixels
+    ASSERT_EQ(image.data(0).get()[5], 255);
+    ASSERT_EQ(image.data(1).get()[5], 255);
+    ASSERT_EQ(image.data(2).get()[5], 255);
+
+    ASSERT_EQ(image.data(0).get()[15], 255);
+    ASSERT_EQ(image.data(1).get()[15], 255);
+    ASSERT_EQ(image.data(2).get()[15], 0);
+
+    ASSERT_EQ(image.data(0).get()[75], 0);
+    ASSERT_EQ(image.data(1).get()[75], 0);
+    ASSERT_EQ(image.data(2).get()[75], 0);
+
+    // grayscale images contain the luma of the bars
+    cvpg::videoproc::sources::pattern_generator<cvpg::image_gray_8bit> gray_generator(parameters);
+
+    auto gray = gray_generator.generate(0);
+
+    ASSERT_EQ(gray.data(0).get()[5], 255);
+    ASSERT_EQ(gray.data(0).get()[75], 0);
+}
+
+TEST(test_pattern_generator, yuv420)
+{
+    cvpg::videoproc::sources::synthetic_parameters parameters;
+    parameters.pattern = cvpg::videoproc::sources::synthetic_pattern::bars;
+    parameters.width = 64;
+    parameters.height = 36;
+
+    cvpg::videoproc::sources::pattern_generator<cvpg::image_yuv420_8bit> generator(parameters);
+
+    auto image = generator.generate(0);
+
+    ASSERT_EQ(image.plane_width(1), 32);
+    ASSERT_EQ(image.plane_height(1), 18);
+
+    // white has a neutral chroma, blue a high U and a low V value
+    ASSERT_EQ(image.data(0).get()[0], 255);
+    ASSERT_EQ(image.data(1).get()[0], 128);
+    ASSERT_EQ(image.data(2).get()[0], 128);
+
+    const std::uint32_t blue = 6 * 64 / 8 / 2;
+
+    ASSERT_GT(image.data(1).get()[blue], 200);
+    ASSERT_LT(image.data(2).get()[blue], 128);
+}
+
+TEST(test_pattern_generator, deterministic)
+{
+    cvpg::videoproc::sources::synthetic_parameters parameters;
+    parameters.width = 64;
+    parameters.height = 48;
+
+    for (auto pattern : { cvpg::videoproc::sources::synthetic_pattern::gradient,
+                          cvpg::videoproc::sources::synthetic_pattern::moving_shapes,
+                          cvpg::videoproc::sources::synthetic_pattern::noise })
+    {
+        parameters.pattern = pattern;
+
+        cvpg::videoproc::sources::pattern_generator<cvpg::image_yuv420_8bit> first(parameters);
+        cvpg::videoproc::sources::pattern_generator<cvpg::image_yuv420_8bit> second(parameters);
+
+        // same frames are equal, even if generated in a different order
+        auto b = second.generate(7);
+        auto a = second.generate(3);
+
+        ASSERT_TRUE(equal_planes(first.generate(3), a));
+        ASSERT_TRUE(equal_planes(first.generate(7), b));
+
+        // the content changes from frame to frame
+        ASSERT_FALSE(equal_planes(a, b));
+    }
+}
+
+TEST(test_pattern_generator, noise_seed)
+{
+    cvpg::videoproc::sources::synthetic_parameters parameters;
+    parameters.pattern = cvpg::videoproc::sources::synthetic_pattern::noise;
+    parameters.width = 32;
+    parameters.height = 32;
+
+    cvpg::videoproc::sources::pattern_generator<cvpg::image_yuv420_8bit> first(parameters);
+
+    parameters.seed = 1;
+
+    cvpg::videoproc::sources::pattern_generator<cvpg::image_yuv420_8bit> second(parameters);
+
+    ASSERT_FALSE(equal_planes(first.generate(0), second.generate(0)));
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/videoproc/frame.hpp>
+#include <libcvpg/videoproc/reorder_buffer.hpp>
+
+TEST(test_reorder_buffer, drain_in_order)
+{
+    using frame = cvpg::videoproc::frame<cvpg::image_gray_8bit>;
+
+    cvpg::videoproc::reorder_buffer<frame> buffer(5);
+
+    // capacity is rounded up to a power of two
+    ASSERT_EQ(buffer.capacity(), 8);
+
+    ASSERT_TRUE(buffer.insert(frame(2)));
+    ASSERT_TRUE(buffer.insert(frame(1)));
+
+    std::vector<std::size_t> numbers;
+
+    auto collect = [&numbers](frame && f){ numbers.push_back(f.number()); };
+
+    // frame #0 is missing
+    ASSERT_EQ(buffer.drain(collect), 0);
+    ASSERT_EQ(buffer.size(), 2);
+
+    ASSERT_TRUE(buffer.insert(frame(0)));
+    ASSERT_EQ(buffer.drain(collect, 2), 2);
+    ASSERT_EQ(buffer.drain(collect), 1);
+
+    ASSERT_EQ(numbers.size(), 3);
+    ASSERT_EQ(numbers[0], 0);
+    ASSERT_EQ(numbers[1], 1);
+    ASSERT_EQ(numbers[2], 2);
+
+    ASSERT_TRUE(buffer.empty());
+    ASSERT_EQ(buffer.next(), 3);
+
+    auto statistics = buffer.statistics();
+    ASSERT_EQ(statistics.inserted, 3);
+    ASSERT_EQ(statistics.out_of_order, 2);
+    ASSERT_EQ(statistics.max_depth, 2);
+    ASSERT_EQ(statistics.sum_depth, 3);
+}
+
+TEST(test_reorder_buffer, reject_entries)
+{
+    using frame = cvpg::videoproc::frame<cvpg::image_gray_8bit>;
+
+    cvpg::videoproc::reorder_buffer<frame> buffer(4, 10);
+
+    // outside of the ring
+    ASSERT_FALSE(buffer.insert(frame(9)));
+    ASSERT_FALSE(buffer.insert(frame(14)));
+
+    // already stored
+    ASSERT_TRUE(buffer.insert(frame(13)));
+    ASSERT_FALSE(buffer.insert(frame(13)));
+
+    ASSERT_EQ(buffer.size(), 1);
+}
+
+TEST(test_reorder_buffer, single_producer_single_consumer)
+{
+    using frame = cvpg::videoproc::frame<cvpg::image_gray_8bit>;
+
+    const std::size_t entries = 100000;
+
+    cvpg::videoproc::reorder_buffer<frame> buffer(16);
+
+    // producer inserts pairs of frames in reversed order
+    std::thread producer(
+        [&buffer, entries]()
+        {
+            for (std::size_t i = 0; i < entries; i += 2)
+            {
+                while (!buffer.insert(frame(i + 1)))
+                {
+                    std::this_thread::yield();
+                }
+
+                while (!buffer.insert(frame(i)))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    );
+
+    std::size_t expected = 0;
+    bool in_order = true;
+
+    while (expected < entries)
+    {
+        buffer.drain(
+            [&expected, &in_order](frame && f)
+            {
+                in_order &= f.number() == expected++;
+            }
+        );
+    }
+
+    producer.join();
+
+    ASSERT_TRUE(in_order);
+    ASSERT_TRUE(buffer.empty());
+}
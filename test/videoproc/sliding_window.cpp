@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include <libcvpg/core/image.hpp>
+#include <libcvpg/videoproc/sliding_window.hpp>
+
+TEST(test_sliding_window, push_and_evict)
+{
+    cvpg::videoproc::sliding_window<int> window(3);
+
+    ASSERT_EQ(window.capacity(), 3);
+    ASSERT_EQ(window.size(), 0);
+    ASSERT_FALSE(window.full());
+
+    window.push(1);
+    window.push(2);
+
+    ASSERT_EQ(window.size(), 2);
+    ASSERT_FALSE(window.full());
+
+    // entry 0 is the newest one
+    ASSERT_EQ(window.at(0), 2);
+    ASSERT_EQ(window.at(1), 1);
+
+    window.push(3);
+
+    ASSERT_TRUE(window.full());
+    ASSERT_EQ(window.at(0), 3);
+    ASSERT_EQ(window.at(2), 1);
+
+    // the oldest entry is evicted
+    window.push(4);
+    window.push(5);
+
+    ASSERT_EQ(window.size(), 3);
+    ASSERT_EQ(window.at(0), 5);
+    ASSERT_EQ(window.at(1), 4);
+    ASSERT_EQ(window.at(2), 3);
+
+    window.clear();
+
+    ASSERT_EQ(window.size(), 0);
+
+    window.push(6);
+
+    ASSERT_EQ(window.at(0), 6);
+}
+
+TEST(test_sliding_window, shared_images)
+{
+    cvpg::videoproc::sliding_window<cvpg::image_gray_8bit> window(2);
+
+    cvpg::image_gray_8bit image(4, 4);
+    image.data(0).get()[0] = 42;
+
+    auto pixels = image.data(0);
+
+    window.push(image);
+
+    // the window shares the pixels of the image
+    ASSERT_EQ(window.at(0).data(0).get(), pixels.get());
+    ASSERT_EQ(pixels.use_count(), 3);
+
+    window.push(cvpg::image_gray_8bit(4, 4));
+    window.push(cvpg::image_gray_8bit(4, 4));
+
+    // the evicted entry releases its reference to the pixels
+    ASSERT_EQ(pixels.use_count(), 2);
+    ASSERT_EQ(pixels.get()[0], 42);
+}
@@ -2,6 +2,7 @@
 
 #include <libcvpg/core/image.hpp>
 #include <libcvpg/videoproc/frame.hpp>
+#include <libcvpg/videoproc/memory_budget.hpp>
 #include <libcvpg/videoproc/stage_data_handler.hpp>
 
 TEST(test_stage_data_handler, add_frames_correct_order)
@@ -176,3 +177,120 @@ TEST(test_stage_data_handler, fill_many_entries)
 
     ASSERT_EQ(deliver_counter, entries);
 }
+
+TEST(test_stage_data_handler, memory_budget)
+{
+    using frame = cvpg::videoproc::frame<cvpg::image_gray_8bit>;
+
+    // budget for 3 frames of 100x10 pixels
+    auto budget = std::make_shared<cvpg::videoproc::memory_budget>(3000);
+
+    std::size_t requested = 0;
+    std::size_t frames_delivered = 0;
+
+    {
+        cvpg::videoproc::stage_data_handler<frame> sdh(
+            "test",
+            10,
+            []()
+            {
+                return true;
+            },
+            [&requested]()
+            {
+                return requested;
+            },
+            [&frames_delivered](auto frames, std::function<void()> deliver_done_callback)
+            {
+                frames_delivered += frames.size();
+            },
+            budget
+        );
+
+        ASSERT_EQ(sdh.free(), 10);
+
+        sdh.add(frame(0, cvpg::image_gray_8bit(100, 10)));
+        sdh.add(frame(2, cvpg::image_gray_8bit(100, 10)));
+
+        ASSERT_EQ(budget->used(), 2000);
+        ASSERT_EQ(sdh.free(), 1);
+
+        sdh.add(frame(1, cvpg::image_gray_8bit(100, 10)));
+
+        // budget is exhausted, although the stage could store more frames
+        ASSERT_EQ(budget->used(), 3000);
+        ASSERT_EQ(sdh.free(), 0);
+        ASSERT_EQ(frames_delivered, 0);
+
+        // delivered frames give back their bytes
+        requested = 2;
+        sdh.try_flush();
+
+        ASSERT_EQ(frames_delivered, 2);
+        ASSERT_EQ(budget->used(), 1000);
+        ASSERT_EQ(sdh.free(), 2);
+
+        sdh.add(frame(3, cvpg::image_gray_8bit(100, 10)));
+
+        ASSERT_EQ(budget->peak(), 3000);
+    }
+
+    // bytes of frames that were never delivered are given back at destruction
+    ASSERT_EQ(budget->used(), 0);
+}
+
+TEST(test_stage_data_handler, duplicate_frames)
+{
+    using frame = cvpg::videoproc::frame<cvpg::image_gray_8bit>;
+
+    std::vector<std::size_t> delivered;
+
+    auto budget = std::make_shared<cvpg::videoproc::memory_budget>(100000);
+
+    {
+        cvpg::videoproc::stage_data_handler<frame> sdh(
+            "test",
+            4,
+            []()
+            {
+                return true;
+            },
+            []()
+            {
+                return 100;
+            },
+            [&delivered](auto frames, std::function<void()> deliver_done_callback)
+            {
+                for (auto const & f : frames)
+                {
+                    delivered.push_back(f.number());
+                }
+            },
+            budget
+        );
+
+        // frame #1 arrives twice while waiting for frame #0
+        sdh.add(frame(1, cvpg::image_gray_8bit(10, 10)));
+        sdh.add(frame(1, cvpg::image_gray_8bit(10, 10)));
+
+        // frame #6 doesn't fit into the reorder buffer yet
+        sdh.add(frame(6, cvpg::image_gray_8bit(10, 10)));
+
+        ASSERT_EQ(budget->used(), 200);
+
+        sdh.add(frame(0, cvpg::image_gray_8bit(10, 10)));
+
+        // frame #1 arrives again after it was delivered
+        sdh.add(frame(1, cvpg::image_gray_8bit(10, 10)));
+
+        for (std::size_t i = 2; i < 6; ++i)
+        {
+            sdh.add(frame(i, cvpg::image_gray_8bit(10, 10)));
+        }
+
+        // all frames are delivered exactly once and the stage could be flushed
+        ASSERT_TRUE(delivered == std::vector<std::size_t>({ 0, 1, 2, 3, 4, 5, 6 }));
+        ASSERT_TRUE(sdh.empty());
+        ASSERT_EQ(budget->used(), 0);
+    }
+}